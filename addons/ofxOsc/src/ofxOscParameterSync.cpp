@@ -4,17 +4,20 @@
 //--------------------------------------------------------------
 ofxOscParameterSync::ofxOscParameterSync(){
 	updatingParameter = false;
+	batchUpdates = false;
 }
 
 //--------------------------------------------------------------
 ofxOscParameterSync::~ofxOscParameterSync(){
 	ofRemoveListener(syncGroup.parameterChangedE(), this, &ofxOscParameterSync::parameterChanged);
+	ofRemoveListener(syncGroup.batchChangedE(), this, &ofxOscParameterSync::batchChanged);
 }
 
 //--------------------------------------------------------------
 void ofxOscParameterSync::setup(ofParameterGroup &group, int localPort, const std::string &host, int remotePort){
 	syncGroup = group;
 	ofAddListener(syncGroup.parameterChangedE(), this, &ofxOscParameterSync::parameterChanged);
+	ofAddListener(syncGroup.batchChangedE(), this, &ofxOscParameterSync::batchChanged);
 	sender.setup(host, remotePort);
 	receiver.setup(localPort);
 }
@@ -23,13 +26,32 @@ void ofxOscParameterSync::setup(ofParameterGroup &group, int localPort, const st
 void ofxOscParameterSync::update(){
 	if(receiver.hasWaitingMessages()){
 		updatingParameter = true;
-		receiver.getParameter(syncGroup);
+		if(batchUpdates){
+			// apply all the received values before notifying anyone
+			ofParameterBatch batch(syncGroup);
+			receiver.getParameter(syncGroup);
+		}else{
+			receiver.getParameter(syncGroup);
+		}
 		updatingParameter = false;
 	}
 }
 
+//--------------------------------------------------------------
+void ofxOscParameterSync::setBatchUpdates(bool batchUpdates){
+	this->batchUpdates = batchUpdates;
+}
+
 //--------------------------------------------------------------
 void ofxOscParameterSync::parameterChanged(ofAbstractParameter &parameter){
 	if(updatingParameter) return;
 	sender.sendParameter(parameter);
 }
+
+//--------------------------------------------------------------
+void ofxOscParameterSync::batchChanged(const ofParameterChanges &changes){
+	if(updatingParameter) return;
+	for(auto & parameter: changes.parameters){
+		sender.sendParameter(*parameter);
+	}
+}
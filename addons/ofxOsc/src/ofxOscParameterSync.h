@@ -21,13 +21,23 @@ public:
 	/// process any incoming messages
 	void update();
 
+	/// apply the values received in each update() as a batch of the group,
+	/// see ofParameterGroup::beginBatch. The group then notifies
+	/// batchChangedE once instead of parameterChangedE for every value.
+	/// Disabled by default
+	void setBatchUpdates(bool batchUpdates);
+
 private:
 
 	/// parameter change callaback
 	void parameterChanged(ofAbstractParameter &parameter);
+
+	/// batch change callback, sends every changed parameter
+	void batchChanged(const ofParameterChanges &changes);
 	
 	ofxOscSender sender; //< sync sender
 	ofxOscReceiver receiver; //< sync receiver
 	ofParameterGroup syncGroup; //< target parameter group
 	bool updatingParameter; //< is a parameter being updated?
+	bool batchUpdates; //< apply received values in a batch?
 };
@@ -136,51 +136,53 @@ bool ofxOscReceiver::getNextMessage(ofxOscMessage &message){
 //--------------------------------------------------------------
 bool ofxOscReceiver::getParameter(ofAbstractParameter &parameter){
 	ofxOscMessage msg;
+	const std::string name = parameter.getEscapedName();
+	ofParameterGroup * group = dynamic_cast<ofParameterGroup*>(&parameter);
 	while(messagesChannel.tryReceive(msg)){
+		// the address is the name of the parameter followed by the path of
+		// the changed value inside it if it's a group
+		const std::string address = msg.getAddress();
+		ofStringView path(address);
+		while(path.starts_with("/")){
+			path.remove_prefix(1);
+		}
+		if(!path.starts_with(name) || (path.size() > name.size() && path[name.size()] != '/')){
+			continue;
+		}
+		path.remove_prefix(name.size());
 		ofAbstractParameter * p = &parameter;
-		std::vector<std::string> address = ofSplitString(msg.getAddress(),"/", true);
-		for(unsigned int i = 0; i < address.size(); i++){
-			if(p){
-				if(address[i] == p->getEscapedName()){
-					if(p->type() == typeid(ofParameterGroup).name()){
-						if(address.size() >= i+1){
-							ofParameterGroup* g = static_cast<ofParameterGroup*>(p);
-							if(g->contains(address[i+1])){
-								p = &g->get(address[i+1]);
-							}
-							else{
-								p = nullptr;
-							}
-						}
-					}
-					else if(p->type() == typeid(ofParameter<int>).name() &&
-						msg.getArgType(0) == OFXOSC_TYPE_INT32){
-						p->cast<int>() = msg.getArgAsInt32(0);
-					}
-					else if(p->type() == typeid(ofParameter<float>).name() &&
-						msg.getArgType(0) == OFXOSC_TYPE_FLOAT){
-						p->cast<float>() = msg.getArgAsFloat(0);
-					}
-					else if(p->type() == typeid(ofParameter<double>).name() &&
-						msg.getArgType(0) == OFXOSC_TYPE_DOUBLE){
-						p->cast<double>() = msg.getArgAsDouble(0);
-					}
-					else if(p->type() == typeid(ofParameter<bool>).name() &&
-						(msg.getArgType(0) == OFXOSC_TYPE_TRUE ||
-						 msg.getArgType(0) == OFXOSC_TYPE_FALSE ||
-						 msg.getArgType(0) == OFXOSC_TYPE_INT32 ||
-						 msg.getArgType(0) == OFXOSC_TYPE_INT64 ||
-						 msg.getArgType(0) == OFXOSC_TYPE_FLOAT ||
-						 msg.getArgType(0) == OFXOSC_TYPE_DOUBLE ||
-						 msg.getArgType(0) == OFXOSC_TYPE_STRING ||
-						 msg.getArgType(0) == OFXOSC_TYPE_SYMBOL)){
-						p->cast<bool>() = msg.getArgAsBool(0);
-					}
-					else if(msg.getArgType(0) == OFXOSC_TYPE_STRING){
-						p->fromString(msg.getArgAsString(0));
-					}
-				}
-			}
+		if(!path.empty()){
+			p = group ? group->findPath(path) : nullptr;
+		}
+		if(!p || dynamic_cast<ofParameterGroup*>(p)){
+			continue;
+		}
+
+		if(p->type() == typeid(ofParameter<int>).name() &&
+			msg.getArgType(0) == OFXOSC_TYPE_INT32){
+			p->cast<int>() = msg.getArgAsInt32(0);
+		}
+		else if(p->type() == typeid(ofParameter<float>).name() &&
+			msg.getArgType(0) == OFXOSC_TYPE_FLOAT){
+			p->cast<float>() = msg.getArgAsFloat(0);
+		}
+		else if(p->type() == typeid(ofParameter<double>).name() &&
+			msg.getArgType(0) == OFXOSC_TYPE_DOUBLE){
+			p->cast<double>() = msg.getArgAsDouble(0);
+		}
+		else if(p->type() == typeid(ofParameter<bool>).name() &&
+			(msg.getArgType(0) == OFXOSC_TYPE_TRUE ||
+			 msg.getArgType(0) == OFXOSC_TYPE_FALSE ||
+			 msg.getArgType(0) == OFXOSC_TYPE_INT32 ||
+			 msg.getArgType(0) == OFXOSC_TYPE_INT64 ||
+			 msg.getArgType(0) == OFXOSC_TYPE_FLOAT ||
+			 msg.getArgType(0) == OFXOSC_TYPE_DOUBLE ||
+			 msg.getArgType(0) == OFXOSC_TYPE_STRING ||
+			 msg.getArgType(0) == OFXOSC_TYPE_SYMBOL)){
+			p->cast<bool>() = msg.getArgAsBool(0);
+		}
+		else if(msg.getArgType(0) == OFXOSC_TYPE_STRING){
+			p->fromString(msg.getArgAsString(0));
 		}
 	}
 	return true;
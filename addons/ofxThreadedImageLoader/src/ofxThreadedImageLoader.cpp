@@ -1,8 +1,8 @@
 #include "ofxThreadedImageLoader.h"
 #include <sstream>
-ofxThreadedImageLoader::ofxThreadedImageLoader(){
+ofxThreadedImageLoader::ofxThreadedImageLoader()
+:alive(std::make_shared<bool>(true)){
 	nextID = 0;
-    ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
     
     startThread();
@@ -11,9 +11,8 @@ ofxThreadedImageLoader::ofxThreadedImageLoader(){
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
 	images_to_load_from_disk.close();
-	images_to_update.close();
 	waitForThread(true);
-    ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
+	alive.reset();
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
 }
 
@@ -50,7 +49,7 @@ void ofxThreadedImageLoader::threadedFunction() {
 	ofImageLoaderEntry entry;
 	while( images_to_load_from_disk.receive(entry) ) {
 		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
+			uploadOnMainThread(entry);
 		}else{
 			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
 		}
@@ -70,7 +69,7 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	if(response.status == 200) {
 		if(it != images_async_loading.end()) {
 			it->second.image->load(response.data);
-			images_to_update.send(it->second);
+			uploadOnMainThread(it->second);
 		}
 	}else{
 		// log error.
@@ -85,14 +84,16 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 }
 
 
-// Check the update queue and update the texture
+// Upload the texture from the main thread. The main job queue spreads
+// the uploads across frames so we don't block the gl thread for too long
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
-	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
-		entry.image->setUseTexture(true);
-		entry.image->update();
-	}
+void ofxThreadedImageLoader::uploadOnMainThread(const ofImageLoaderEntry & entry){
+	std::weak_ptr<bool> loaderAlive = alive;
+	ofImage * image = entry.image;
+	ofRunOnMainThread([loaderAlive, image]{
+		if(loaderAlive.lock()){
+			image->setUseTexture(true);
+			image->update();
+		}
+	});
 }
-
@@ -5,6 +5,7 @@
 #include "ofURLFileLoader.h"
 #include "ofTypes.h" 
 #include "ofThreadChannel.h"
+#include "ofJobQueue.h"
 
 
 using namespace std;
@@ -20,7 +21,6 @@ public:
 
 
 private:
-	void update(ofEventArgs & a);
     virtual void threadedFunction();
 	void urlResponse(ofHttpResponse & response);
     
@@ -42,12 +42,14 @@ private:
 
     typedef map<string, ofImageLoaderEntry>::iterator entry_iterator;
 
+	void uploadOnMainThread(const ofImageLoaderEntry & entry);
+
 	int                 nextID;
     int                 lastUpdate;
 
 	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
 	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
+	std::shared_ptr<bool> alive; // jobs still queued when we are destroyed check it before touching the image
 };
 
 
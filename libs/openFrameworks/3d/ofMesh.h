@@ -273,6 +273,13 @@ public:
 
 	void mergeDuplicateVertices();
 
+	/// \brief Transforms the vertices and normals of the mesh by m.
+	///
+	/// Normals are transformed by the inverse transpose of m and
+	/// normalized. Uses the batch functions in ofTransformPoints.h so it's
+	/// much faster than transforming the vertices one by one.
+	void transform(const glm::mat4 & m);
+
 	/// \returns a ofVec3f defining the centroid of all the vetices in the mesh.
 	V getCentroid() const;
 
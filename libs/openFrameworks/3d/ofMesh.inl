@@ -2,6 +2,7 @@
 #include "ofBaseTypes.h"
 #include "ofMesh.h"
 #include "ofVectorMath.h"
+#include "ofTransformPoints.h"
 #include <map>
 
 //--------------------------------------------------------------
@@ -1025,12 +1026,13 @@ void ofMesh_<V,N,C,T>::append(const ofMesh_<V,N,C,T> & mesh){
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
-	ofFile is(path, ofFile::ReadOnly);
 	auto & data = *this;
 
 
 	std::string error;
-	ofBuffer buffer(is);
+	// lines and numbers are parsed straight from the mapped file, without
+	// copying it or any of its lines
+	auto buffer = ofBufferFromFile(path, ofBufferMode::Mapped);
 	auto backup = data;
 
 	int orderVertices=-1;
@@ -1064,13 +1066,29 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 	};
 	
 	std::vector<Attribute> meshDefinition;
+
+	// values are separated by any number of spaces or tabs, takes the next
+	// one out of rest, false if there are no more
+	auto nextValue = [](ofStringView & rest, ofStringView & value){
+		auto isSeparator = [](char c){ return c == ' ' || c == '\t'; };
+		while(!rest.empty() && isSeparator(rest.front())){
+			rest.remove_prefix(1);
+		}
+		std::size_t size = 0;
+		while(size < rest.size() && !isSeparator(rest[size])){
+			size++;
+		}
+		value = rest.substr(0, size);
+		rest.remove_prefix(size);
+		return size > 0;
+	};
 	
 	data.clear();
 	State state = Header;
 
 	int lineNum = 0;
-	ofBuffer::Lines lines = buffer.getLines();
-	ofBuffer::Line line = lines.begin();
+	auto lines = buffer.lines();
+	auto line = lines.begin();
 	lineNum++;
 	if(*line!="ply"){
 		error = "wrong format, expecting 'ply'";
@@ -1086,39 +1104,39 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 
 	for(;line != lines.end(); ++line){
 		lineNum++;
-		std::string lineStr = *line;
-		if(lineStr.find("comment")==0 || lineStr.empty()){
+		ofStringView lineStr = *line;
+		if(lineStr.starts_with("comment") || lineStr.empty()){
 			continue;
 		}
 
-		if((state==Header || state==FaceDef) && lineStr.find("element vertex")==0){
+		if((state==Header || state==FaceDef) && lineStr.starts_with("element vertex")){
 			state = VertexDef;
 			orderVertices = MAX(orderIndices, 0)+1;
-			data.getVertices().resize(ofTo<size_t>(lineStr.substr(15)));
+			data.getVertices().resize(ofToInt64(lineStr.substr(15)));
 			continue;
 		}
 
-		if((state==Header || state==VertexDef) && lineStr.find("element face")==0){
+		if((state==Header || state==VertexDef) && lineStr.starts_with("element face")){
 			state = FaceDef;
 			orderIndices = MAX(orderVertices, 0)+1;
-			data.getIndices().resize(ofTo<size_t>(lineStr.substr(13))*3);
+			data.getIndices().resize(ofToInt64(lineStr.substr(13))*3);
 			continue;
 		}
 
-		if(state==VertexDef && (lineStr.find("property float x")==0 || lineStr.find("property float y")==0 || lineStr.find("property float z")==0)){
+		if(state==VertexDef && (lineStr.starts_with("property float x") || lineStr.starts_with("property float y") || lineStr.starts_with("property float z"))){
 			meshDefinition.push_back(Position);
 			vertexCoordsFound++;
 			continue;
 		}
 
-		if(state==VertexDef && (lineStr.find("property float r")==0 || lineStr.find("property float g")==0 || lineStr.find("property float b")==0 || lineStr.find("property float a")==0)){
+		if(state==VertexDef && (lineStr.starts_with("property float r") || lineStr.starts_with("property float g") || lineStr.starts_with("property float b") || lineStr.starts_with("property float a"))){
 			colorCompsFound++;
 			meshDefinition.push_back(Color);
 			data.getColors().resize(data.getVertices().size());
 			continue;
 		}
 
-		if(state==VertexDef && (lineStr.find("property uchar red")==0 || lineStr.find("property uchar green")==0 || lineStr.find("property uchar blue")==0 || lineStr.find("property uchar alpha")==0)){
+		if(state==VertexDef && (lineStr.starts_with("property uchar red") || lineStr.starts_with("property uchar green") || lineStr.starts_with("property uchar blue") || lineStr.starts_with("property uchar alpha"))){
 			colorTypeIsUChar = true;
 			colorCompsFound++;
 			meshDefinition.push_back(Color);
@@ -1126,21 +1144,21 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 			continue;
 		}
 
-		if(state==VertexDef && (lineStr.find("property float u")==0 || lineStr.find("property float v")==0|| lineStr.find("property float s")==0 || lineStr.find("property float t")==0)){
+		if(state==VertexDef && (lineStr.starts_with("property float u") || lineStr.starts_with("property float v")|| lineStr.starts_with("property float s") || lineStr.starts_with("property float t"))){
 			texCoordsFound++;
 			meshDefinition.push_back(TexCoord);
 			data.getTexCoords().resize(data.getVertices().size());
 			continue;
 		}
 
-		if(state==VertexDef && (lineStr.find("property float nx")==0 || lineStr.find("property float ny")==0 || lineStr.find("property float nz")==0)){
+		if(state==VertexDef && (lineStr.starts_with("property float nx") || lineStr.starts_with("property float ny") || lineStr.starts_with("property float nz"))){
 			normalsCoordsFound++;
 			meshDefinition.push_back(Normal);
 			if (normalsCoordsFound==3) data.getNormals().resize(data.getVertices().size());
 			continue;
 		}
 
-		if(state==FaceDef && lineStr.find("property list")!=0 && lineStr!="end_header"){
+		if(state==FaceDef && !lineStr.starts_with("property list") && lineStr!="end_header"){
 			error = "wrong face definition";
 			goto clean;
 		}
@@ -1173,7 +1191,8 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 				error = "found more vertices: " + ofToString(currentVertex+1) + " than specified in header: " + ofToString(data.getNumVertices());
 				goto clean;
 			}
-			std::stringstream sline(lineStr);
+			ofStringView rest = lineStr;
+			ofStringView value;
 			
 			// read in a line of vertex elements
 			// and split it into attributes,
@@ -1183,24 +1202,26 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 			ofIndexType tAttr = 0;
 			ofIndexType cAttr = 0;
 			for(auto s:meshDefinition){
+				if(!nextValue(rest, value)){
+					error = "vertex has fewer values than specified in header: " + ofToString(meshDefinition.size());
+					goto clean;
+				}
 				switch (s) {
 					case Position:
-						sline >> *(&data.getVertices()[currentVertex].x + (vAttr++)%vertexCoordsFound);
+						*(&data.getVertices()[currentVertex].x + (vAttr++)%vertexCoordsFound) = ofToFloat(value);
 						break;
 					case Color:
 						if (colorTypeIsUChar){
-							int c = 0;
-							sline >> c;
-							*(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound) = c/255.f;
+							*(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound) = ofToInt(value)/255.f;
 						} else {
-							sline >> *(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound);
+							*(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound) = ofToFloat(value);
 						}
 						break;
 					case Normal:
-						sline >> *(&data.getNormals()[currentVertex].x + (nAttr++)%normalsCoordsFound);
+						*(&data.getNormals()[currentVertex].x + (nAttr++)%normalsCoordsFound) = ofToFloat(value);
 						break;
 					case TexCoord:
-						sline >> *(&data.getTexCoords()[currentVertex].x + (tAttr++)%texCoordsFound);
+						*(&data.getTexCoords()[currentVertex].x + (tAttr++)%texCoordsFound) = ofToFloat(value);
 						break;
 					default:
 						break;
@@ -1227,20 +1248,19 @@ void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
 				error = "found more faces than specified in header";
 				goto clean;
 			}
-			std::stringstream sline(lineStr);
-			int numV;
-			sline >> numV;
-			if(numV!=3){
+			ofStringView rest = lineStr;
+			ofStringView value;
+			if(!nextValue(rest, value) || ofToInt(value)!=3){
 				error = "face not a triangle";
 				goto clean;
 			}
-			ofIndexType i;
-			sline >> i;
-			data.getIndices()[currentFace*3] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+1] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+2] = i;
+			for(int i=0;i<3;i++){
+				if(!nextValue(rest, value)){
+					error = "face has fewer than 3 indices";
+					goto clean;
+				}
+				data.getIndices()[currentFace*3+i] = ofToInt64(value);
+			}
 
 			currentFace++;
 			if(currentFace==data.getNumIndices()/3){
@@ -1452,6 +1472,23 @@ ofMesh_<V,N,C,T> ofMesh_<V,N,C,T>::getMeshForIndices( ofIndexType startIndex, of
 }
 
 
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+void ofMesh_<V,N,C,T>::transform(const glm::mat4 & m){
+	static_assert(sizeof(V) == sizeof(glm::vec3), "ofMesh_::transform() needs 3D vertices");
+	static_assert(sizeof(N) == sizeof(glm::vec3), "ofMesh_::transform() needs 3D normals");
+	if(!vertices.empty()){
+		auto v = reinterpret_cast<glm::vec3*>(vertices.data());
+		ofTransformPoints(m, v, v, vertices.size());
+		bVertsChanged = true;
+	}
+	if(!normals.empty()){
+		auto n = reinterpret_cast<glm::vec3*>(normals.data());
+		ofTransformNormals(m, n, n, normals.size());
+		bNormalsChanged = true;
+	}
+}
+
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::mergeDuplicateVertices() {
@@ -3,6 +3,7 @@
 #include "ofMath.h"
 #include "ofLog.h"
 #include "of3dGraphics.h"
+#include "ofTransformHierarchy.h"
 
 //----------------------------------------
 ofNode::ofNode()
@@ -46,6 +47,7 @@ ofNode::ofNode(const ofNode & node)
 	position.disableEvents();
 	scale.disableEvents();
 	orientation.disableEvents();
+	updateFollowedHierarchy();
 }
 
 //----------------------------------------
@@ -57,10 +59,14 @@ ofNode::ofNode(ofNode && node)
 ,axis(std::move(node.axis))
 ,localTransformMatrix(std::move(node.localTransformMatrix))
 ,legacyCustomDrawOverrided(std::move(node.legacyCustomDrawOverrided))
-,children(std::move(node.children)){
+,children(std::move(node.children))
+,hierarchy(node.hierarchy)
+,hierarchySlot(node.hierarchySlot){
 	if(parent){
 		parent->addListener(*this);
 	}
+	node.hierarchy = nullptr;
+	updateFollowedHierarchy();
 }
 
 //----------------------------------------
@@ -79,6 +85,8 @@ ofNode & ofNode::operator=(const ofNode & node){
 	if(parent){
 		parent->addListener(*this);
 	}
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
 	return *this;
 }
 
@@ -93,9 +101,14 @@ ofNode & ofNode::operator=(ofNode && node){
 	localTransformMatrix = std::move(node.localTransformMatrix);
 	legacyCustomDrawOverrided = std::move(node.legacyCustomDrawOverrided);
 	children = std::move(node.children);
+	hierarchy = node.hierarchy;
+	hierarchySlot = node.hierarchySlot;
+	node.hierarchy = nullptr;
 	if(parent){
 		parent->addListener(*this);
 	}
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
 	return *this;
 }
 
@@ -143,6 +156,8 @@ void ofNode::setParent(ofNode& parent, bool bMaintainGlobalTransform) {
 		parent.addListener(*this);
 	}
 	this->parent = &parent;
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
 }
 
 //----------------------------------------
@@ -161,7 +176,8 @@ void ofNode::clearParent(bool bMaintainGlobalTransform) {
 	}else{
 		this->parent = nullptr;
 	}
-
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
 }
 
 //----------------------------------------
@@ -548,10 +564,75 @@ const glm::mat4& ofNode::getLocalTransformMatrix() const {
 	return localTransformMatrix;
 }
 
+//----------------------------------------
+void ofNode::invalidateGlobalTransform() {
+	// a node is only ever clean if all its parents are, so if this one is
+	// already dirty so are all of its children
+	if(globalTransformDirty) return;
+	globalTransformDirty = true;
+	for(auto child: children){
+		child->invalidateGlobalTransform();
+	}
+}
+
+//----------------------------------------
+bool ofNode::isGlobalTransformCached() const {
+	return !globalTransformDirty.load(std::memory_order_acquire) &&
+		(!followedHierarchy || followedHierarchy->getVersion() == followedHierarchyVersion.load(std::memory_order_acquire));
+}
+
+//----------------------------------------
+void ofNode::getGlobalTransform(glm::mat4 & matrix, glm::vec3 & scale) const {
+	if(hierarchy){
+		// the hierarchy can change without this node knowing so don't
+		// rely on the dirty flag, the hierarchy has its own cache
+		matrix = hierarchy->getGlobalTransformMatrix(hierarchySlot);
+		scale = hierarchy->getGlobalScale(hierarchySlot);
+	}else if(isGlobalTransformCached()){
+		matrix = globalTransformMatrix;
+		scale = globalScale;
+	}else{
+		auto version = followedHierarchy ? followedHierarchy->getVersion() : 0;
+		if(parent){
+			glm::mat4 parentMatrix;
+			glm::vec3 parentScale;
+			parent->getGlobalTransform(parentMatrix, parentScale);
+			matrix = parentMatrix * getLocalTransformMatrix();
+			scale = getScale() * parentScale;
+		}else{
+			matrix = getLocalTransformMatrix();
+			scale = getScale();
+		}
+		// threads reading at once can all get here, only the first one
+		// stores the result since others may be reading it already
+		std::unique_lock<std::mutex> lock(globalTransformMutex);
+		if(!isGlobalTransformCached()){
+			globalTransformMatrix = matrix;
+			globalScale = scale;
+			followedHierarchyVersion.store(version, std::memory_order_release);
+			globalTransformDirty.store(false, std::memory_order_release);
+		}
+	}
+}
+
+//----------------------------------------
+void ofNode::updateFollowedHierarchy() {
+	if(parent){
+		followedHierarchy = parent->hierarchy ? parent->hierarchy : parent->followedHierarchy;
+	}else{
+		followedHierarchy = nullptr;
+	}
+	for(auto child: children){
+		child->updateFollowedHierarchy();
+	}
+}
+
 //----------------------------------------
 glm::mat4 ofNode::getGlobalTransformMatrix() const {
-	if(parent) return parent->getGlobalTransformMatrix() * getLocalTransformMatrix();
-	else return getLocalTransformMatrix();
+	glm::mat4 matrix;
+	glm::vec3 scale;
+	getGlobalTransform(matrix, scale);
+	return matrix;
 }
 
 //----------------------------------------
@@ -561,14 +642,19 @@ glm::vec3 ofNode::getGlobalPosition() const {
 
 //----------------------------------------
 glm::quat ofNode::getGlobalOrientation() const {
-	auto rot = glm::scale(getGlobalTransformMatrix(), 1.f/getGlobalScale());
+	glm::mat4 matrix;
+	glm::vec3 scale;
+	getGlobalTransform(matrix, scale);
+	auto rot = glm::scale(matrix, 1.f/scale);
 	return glm::toQuat(rot);
 }
 
 //----------------------------------------
 glm::vec3 ofNode::getGlobalScale() const {
-	if(parent) return getScale()*parent->getGlobalScale();
-	else return getScale();
+	glm::mat4 matrix;
+	glm::vec3 scale;
+	getGlobalTransform(matrix, scale);
+	return scale;
 }
 
 //----------------------------------------
@@ -677,6 +763,42 @@ void ofNode::createMatrix() {
 	localTransformMatrix = glm::scale(localTransformMatrix, toGlm(scale));
 	
 	updateAxis();
+	invalidateGlobalTransform();
+
+	if(hierarchy){
+		hierarchy->setTransform(hierarchySlot, position.get(), orientation.get(), scale.get());
+	}
+}
+
+//----------------------------------------
+void ofNode::attachToHierarchy(ofTransformHierarchy & hierarchy, std::size_t slot) {
+	if(!hierarchy.isValid(slot)){
+		ofLogError("ofNode") << "attachToHierarchy(): slot " << slot << " doesn't exist in the hierarchy";
+		return;
+	}
+	this->hierarchy = &hierarchy;
+	hierarchySlot = slot;
+	hierarchy.setTransform(slot, position.get(), orientation.get(), scale.get());
+	// the children now follow this hierarchy
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
+}
+
+//----------------------------------------
+void ofNode::detachFromHierarchy() {
+	hierarchy = nullptr;
+	updateFollowedHierarchy();
+	invalidateGlobalTransform();
+}
+
+//----------------------------------------
+ofTransformHierarchy * ofNode::getHierarchy() const {
+	return hierarchy;
+}
+
+//----------------------------------------
+std::size_t ofNode::getHierarchySlot() const {
+	return hierarchySlot;
 }
 
 
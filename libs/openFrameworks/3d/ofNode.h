@@ -6,9 +6,17 @@
 #include "ofAppRunner.h"
 #include "ofParameter.h"
 #include <array>
+#include <atomic>
+#include <mutex>
 
+class ofTransformHierarchy;
 
 /// \brief A generic 3d object in space with transformation (position, rotation, scale).
+///
+/// The global transform is cached and updated lazily by the const getters.
+/// They can be called from several threads at once as long as no thread
+/// modifies the node, its parents or the hierarchy they are attached to
+/// at the same time.
 
 class ofNode {
 public:
@@ -144,11 +152,11 @@ public:
 	/// \sa https://open.gl/transformations
 	const glm::mat4& getLocalTransformMatrix() const;
 	
-	// TODO: optimize and cache these
-	// (parent would need to know about its children so it can inform them 
-	// to update their global matrices if it itself transforms)
-	
 	/// \brief Get node's global transformations (position, orientation, scale).
+	///
+	/// The global matrix is cached and only recalculated when this node
+	/// or any of its parents has changed since the last call.
+	///
 	/// \returns A refrence to mat4 containing node's global transformations.
 	/// \sa https://open.gl/transformations
 	glm::mat4 getGlobalTransformMatrix() const;
@@ -425,6 +433,32 @@ public:
 	/// \brief Reset this node's transformations, position, rotation and scale.
 	void resetTransform();
 	
+	/// \}
+	/// \name Transform Hierarchy
+	/// \{
+
+	/// \brief Use a slot of an ofTransformHierarchy as this node's transform.
+	///
+	/// The node's current local transform is copied to the slot and from then
+	/// on every change to it is written to the slot too. Global transforms are
+	/// read from the hierarchy so the slot's parent in the hierarchy, not
+	/// getParent(), defines where the node is in the world. Nodes parented
+	/// to an attached node recalculate their global transform when it's read
+	/// after anything in that hierarchy changed.
+	///
+	/// \param hierarchy The hierarchy to attach to, it has to outlive the node.
+	/// \param slot The slot in the hierarchy as returned by ofTransformHierarchy::add().
+	void attachToHierarchy(ofTransformHierarchy & hierarchy, std::size_t slot);
+
+	/// \brief Stop using a transform hierarchy slot, the slot isn't removed.
+	void detachFromHierarchy();
+
+	/// \returns the hierarchy this node is attached to or nullptr.
+	ofTransformHierarchy * getHierarchy() const;
+
+	/// \returns the slot this node is attached to in its hierarchy.
+	std::size_t getHierarchySlot() const;
+
 	/// \}
 	/// \name Drawing
 	/// \{
@@ -452,6 +486,14 @@ public:
 protected:
 	void createMatrix();
 	void updateAxis();
+
+	/// \brief Mark the cached global transform of this node and all
+	/// its children as outdated.
+	void invalidateGlobalTransform();
+
+	/// \brief Find the hierarchy of the closest parent attached to one for
+	/// this node and all its children.
+	void updateFollowedHierarchy();
 	
 	/// \brief classes extending ofNode can override this method to get
 	/// notified when the position changed.
@@ -482,5 +524,21 @@ private:
 
 	void addListener(ofNode & node);
 	void removeListener(ofNode & node);
-//	glm::mat4 globalTransformMatrix;
+	void getGlobalTransform(glm::mat4 & matrix, glm::vec3 & scale) const;
+	bool isGlobalTransformCached() const;
+
+	// written once per change by the first getter to compute them, the
+	// flag is cleared after they are stored
+	mutable glm::mat4 globalTransformMatrix;
+	mutable glm::vec3 globalScale;
+	mutable std::atomic<bool> globalTransformDirty{true};
+	mutable std::mutex globalTransformMutex;
+
+	ofTransformHierarchy * hierarchy = nullptr;
+	std::size_t hierarchySlot = 0;
+
+	// hierarchy of the closest attached parent, its changes don't notify
+	// this node so the cache is also outdated when its version changes
+	const ofTransformHierarchy * followedHierarchy = nullptr;
+	mutable std::atomic<std::uint64_t> followedHierarchyVersion{0};
 };
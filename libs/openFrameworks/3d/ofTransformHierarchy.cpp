@@ -0,0 +1,364 @@
+#include "ofTransformHierarchy.h"
+#include "ofLog.h"
+#include "ofTaskPool.h"
+#include <limits>
+
+const std::size_t ofTransformHierarchy::noParent = std::numeric_limits<std::size_t>::max();
+const std::size_t ofTransformHierarchy::invalidIndex = std::numeric_limits<std::size_t>::max();
+
+namespace{
+	glm::mat4 composeTransform(const glm::vec3 & position, const glm::quat & orientation, const glm::vec3 & scale){
+		auto m = glm::translate(glm::mat4(1.0), position);
+		m = m * glm::toMat4(orientation);
+		return glm::scale(m, scale);
+	}
+
+	template<typename T>
+	void permute(std::vector<T> & values, const std::vector<std::size_t> & order){
+		std::vector<T> sorted(values.size());
+		for(std::size_t i = 0; i < order.size(); i++){
+			sorted[i] = values[order[i]];
+		}
+		values.swap(sorted);
+	}
+
+	template<typename T>
+	void moveLastTo(std::vector<T> & values, std::size_t index){
+		values[index] = values.back();
+		values.pop_back();
+	}
+
+	template<typename F>
+	void parallelFor(std::size_t begin, std::size_t end, std::size_t threshold, F f){
+		if(end - begin < threshold){
+			for(auto i = begin; i < end; i++){
+				f(i);
+			}
+		}else{
+			ofParallelFor(begin, end, f, 256);
+		}
+	}
+}
+
+//----------------------------------------
+std::size_t ofTransformHierarchy::add(std::size_t parent){
+	if(parent != noParent && !isValid(parent)){
+		ofLogError("ofTransformHierarchy") << "add(): parent slot " << parent << " doesn't exist, adding as root";
+		parent = noParent;
+	}
+
+	std::size_t slot;
+	if(!freeSlots.empty()){
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}else{
+		slot = slotToIndex.size();
+		slotToIndex.push_back(invalidIndex);
+	}
+
+	slotToIndex[slot] = positions.size();
+	positions.emplace_back(0.f);
+	orientations.emplace_back(1.f, 0.f, 0.f, 0.f);
+	scales.emplace_back(1.f);
+	localMatrices.emplace_back(1.f);
+	globalMatrices.emplace_back(1.f);
+	globalScales.emplace_back(1.f);
+	parentSlots.push_back(parent);
+	parentIndices.push_back(invalidIndex);
+	localDirty.push_back(0);
+	indexToSlot.push_back(slot);
+
+	orderDirty = true;
+	dirty = true;
+	version++;
+	return slot;
+}
+
+//----------------------------------------
+void ofTransformHierarchy::remove(std::size_t slot){
+	if(!isValid(slot)){
+		ofLogError("ofTransformHierarchy") << "remove(): slot " << slot << " doesn't exist";
+		return;
+	}
+
+	for(auto & parent: parentSlots){
+		if(parent == slot){
+			parent = noParent;
+		}
+	}
+
+	auto index = slotToIndex[slot];
+	moveLastTo(positions, index);
+	moveLastTo(orientations, index);
+	moveLastTo(scales, index);
+	moveLastTo(localMatrices, index);
+	moveLastTo(globalMatrices, index);
+	moveLastTo(globalScales, index);
+	moveLastTo(parentSlots, index);
+	moveLastTo(parentIndices, index);
+	moveLastTo(localDirty, index);
+	moveLastTo(indexToSlot, index);
+	if(index < indexToSlot.size()){
+		slotToIndex[indexToSlot[index]] = index;
+	}
+
+	slotToIndex[slot] = invalidIndex;
+	freeSlots.push_back(slot);
+	orderDirty = true;
+	dirty = true;
+	version++;
+}
+
+//----------------------------------------
+void ofTransformHierarchy::clear(){
+	positions.clear();
+	orientations.clear();
+	scales.clear();
+	localMatrices.clear();
+	globalMatrices.clear();
+	globalScales.clear();
+	parentSlots.clear();
+	parentIndices.clear();
+	localDirty.clear();
+	indexToSlot.clear();
+	levelOffsets.clear();
+	slotToIndex.clear();
+	freeSlots.clear();
+	orderDirty = false;
+	dirty = false;
+	version++;
+}
+
+//----------------------------------------
+std::size_t ofTransformHierarchy::size() const{
+	return positions.size();
+}
+
+//----------------------------------------
+bool ofTransformHierarchy::isValid(std::size_t slot) const{
+	return slot < slotToIndex.size() && slotToIndex[slot] != invalidIndex;
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setParent(std::size_t slot, std::size_t parent){
+	if(!isValid(slot) || (parent != noParent && !isValid(parent))){
+		ofLogError("ofTransformHierarchy") << "setParent(): slot " << slot << " or parent " << parent << " doesn't exist";
+		return;
+	}
+	for(auto ancestor = parent; ancestor != noParent; ancestor = getParent(ancestor)){
+		if(ancestor == slot){
+			ofLogError("ofTransformHierarchy") << "setParent(): can't parent slot " << slot << " to itself or one of its children";
+			return;
+		}
+	}
+	parentSlots[indexOf(slot)] = parent;
+	orderDirty = true;
+	dirty = true;
+	version++;
+}
+
+//----------------------------------------
+std::size_t ofTransformHierarchy::getParent(std::size_t slot) const{
+	return parentSlots[indexOf(slot)];
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setPosition(std::size_t slot, const glm::vec3 & position){
+	auto index = indexOf(slot);
+	positions[index] = position;
+	markDirty(index);
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setOrientation(std::size_t slot, const glm::quat & orientation){
+	auto index = indexOf(slot);
+	orientations[index] = orientation;
+	markDirty(index);
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setScale(std::size_t slot, const glm::vec3 & scale){
+	auto index = indexOf(slot);
+	scales[index] = scale;
+	markDirty(index);
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setTransform(std::size_t slot, const glm::vec3 & position, const glm::quat & orientation, const glm::vec3 & scale){
+	auto index = indexOf(slot);
+	positions[index] = position;
+	orientations[index] = orientation;
+	scales[index] = scale;
+	markDirty(index);
+}
+
+//----------------------------------------
+const glm::vec3 & ofTransformHierarchy::getPosition(std::size_t slot) const{
+	return positions[indexOf(slot)];
+}
+
+//----------------------------------------
+const glm::quat & ofTransformHierarchy::getOrientation(std::size_t slot) const{
+	return orientations[indexOf(slot)];
+}
+
+//----------------------------------------
+const glm::vec3 & ofTransformHierarchy::getScale(std::size_t slot) const{
+	return scales[indexOf(slot)];
+}
+
+//----------------------------------------
+glm::mat4 ofTransformHierarchy::getLocalTransformMatrix(std::size_t slot) const{
+	auto index = indexOf(slot);
+	if(localDirty[index]){
+		return composeTransform(positions[index], orientations[index], scales[index]);
+	}else{
+		return localMatrices[index];
+	}
+}
+
+//----------------------------------------
+glm::mat4 ofTransformHierarchy::getGlobalTransformMatrix(std::size_t slot) const{
+	if(!dirty){
+		return globalMatrices[indexOf(slot)];
+	}
+	auto m = getLocalTransformMatrix(slot);
+	for(auto parent = getParent(slot); parent != noParent; parent = getParent(parent)){
+		m = getLocalTransformMatrix(parent) * m;
+	}
+	return m;
+}
+
+//----------------------------------------
+glm::vec3 ofTransformHierarchy::getGlobalPosition(std::size_t slot) const{
+	return getGlobalTransformMatrix(slot)[3].xyz();
+}
+
+//----------------------------------------
+glm::vec3 ofTransformHierarchy::getGlobalScale(std::size_t slot) const{
+	if(!dirty){
+		return globalScales[indexOf(slot)];
+	}
+	auto scale = getScale(slot);
+	for(auto parent = getParent(slot); parent != noParent; parent = getParent(parent)){
+		scale *= getScale(parent);
+	}
+	return scale;
+}
+
+//----------------------------------------
+void ofTransformHierarchy::update(){
+	if(!dirty){
+		return;
+	}
+	if(orderDirty){
+		sortByLevel();
+	}
+
+	// every level only depends on the one above so all the transforms in
+	// a level can be calculated in parallel
+	for(std::size_t level = 0; level + 1 < levelOffsets.size(); level++){
+		parallelFor(levelOffsets[level], levelOffsets[level + 1], parallelThreshold, [this](std::size_t i){
+			if(localDirty[i]){
+				localMatrices[i] = composeTransform(positions[i], orientations[i], scales[i]);
+				localDirty[i] = 0;
+			}
+			auto parent = parentIndices[i];
+			if(parent == invalidIndex){
+				globalMatrices[i] = localMatrices[i];
+				globalScales[i] = scales[i];
+			}else{
+				globalMatrices[i] = globalMatrices[parent] * localMatrices[i];
+				globalScales[i] = globalScales[parent] * scales[i];
+			}
+		});
+	}
+	dirty = false;
+}
+
+//----------------------------------------
+bool ofTransformHierarchy::needsUpdate() const{
+	return dirty;
+}
+
+//----------------------------------------
+std::uint64_t ofTransformHierarchy::getVersion() const{
+	return version;
+}
+
+//----------------------------------------
+void ofTransformHierarchy::setParallelThreshold(std::size_t threshold){
+	parallelThreshold = std::max(threshold, std::size_t(1));
+}
+
+//----------------------------------------
+void ofTransformHierarchy::sortByLevel(){
+	auto n = positions.size();
+	for(std::size_t i = 0; i < n; i++){
+		parentIndices[i] = parentSlots[i] == noParent ? invalidIndex : slotToIndex[parentSlots[i]];
+	}
+
+	// depth of every transform, walking up only until a known depth is found
+	std::vector<std::size_t> levels(n, invalidIndex);
+	std::vector<std::size_t> stack;
+	std::size_t numLevels = 0;
+	for(std::size_t i = 0; i < n; i++){
+		auto j = i;
+		while(levels[j] == invalidIndex && parentIndices[j] != invalidIndex && levels[parentIndices[j]] == invalidIndex){
+			stack.push_back(j);
+			j = parentIndices[j];
+		}
+		if(levels[j] == invalidIndex){
+			levels[j] = parentIndices[j] == invalidIndex ? 0 : levels[parentIndices[j]] + 1;
+		}
+		while(!stack.empty()){
+			auto k = stack.back();
+			stack.pop_back();
+			levels[k] = levels[parentIndices[k]] + 1;
+		}
+		numLevels = std::max(numLevels, levels[i] + 1);
+	}
+
+	// counting sort by depth, keeping the previous order inside each level
+	levelOffsets.assign(numLevels + 1, 0);
+	for(auto level: levels){
+		levelOffsets[level + 1]++;
+	}
+	for(std::size_t level = 0; level < numLevels; level++){
+		levelOffsets[level + 1] += levelOffsets[level];
+	}
+	std::vector<std::size_t> order(n);
+	auto next = levelOffsets;
+	for(std::size_t i = 0; i < n; i++){
+		order[next[levels[i]]++] = i;
+	}
+
+	permute(positions, order);
+	permute(orientations, order);
+	permute(scales, order);
+	permute(localMatrices, order);
+	permute(globalMatrices, order);
+	permute(globalScales, order);
+	permute(parentSlots, order);
+	permute(localDirty, order);
+	permute(indexToSlot, order);
+	for(std::size_t i = 0; i < n; i++){
+		slotToIndex[indexToSlot[i]] = i;
+	}
+	for(std::size_t i = 0; i < n; i++){
+		parentIndices[i] = parentSlots[i] == noParent ? invalidIndex : slotToIndex[parentSlots[i]];
+	}
+	orderDirty = false;
+}
+
+//----------------------------------------
+std::size_t ofTransformHierarchy::indexOf(std::size_t slot) const{
+	return slotToIndex[slot];
+}
+
+//----------------------------------------
+void ofTransformHierarchy::markDirty(std::size_t index){
+	localDirty[index] = 1;
+	dirty = true;
+	version++;
+}
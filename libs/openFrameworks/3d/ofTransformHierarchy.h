@@ -0,0 +1,129 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofVectorMath.h"
+
+/// \brief Flat storage for big hierarchies of transforms.
+///
+/// ofNode keeps its transform in ofParameters, notifies its children through
+/// events and finds its global transform by following pointers to its
+/// parents. That's convenient for a few objects but too slow for crowds of
+/// hundreds of thousands of transforms updated every frame.
+///
+/// ofTransformHierarchy stores the local position, orientation and scale
+/// and the resulting local and global matrices of every transform in
+/// contiguous arrays sorted by depth in the hierarchy, so parents always come
+/// before their children. update() then recalculates all the global matrices
+/// one level at a time, splitting each level across the threads of
+/// ofGetTaskPool().
+///
+/// Transforms are identified by a slot returned by add() which stays valid
+/// until it's removed, no matter how the storage is reordered internally.
+///
+/// An ofNode can be attached to a slot with ofNode::attachToHierarchy() so
+/// cameras, primitives... can be part of the hierarchy and keep working as
+/// usual.
+///
+/// ~~~~{.cpp}
+/// ofTransformHierarchy hierarchy;
+/// auto body = hierarchy.add();
+/// auto head = hierarchy.add(body);
+/// hierarchy.setPosition(head, {0, 10, 0});
+/// hierarchy.update();
+/// auto headMatrix = hierarchy.getGlobalTransformMatrix(head);
+/// ~~~~
+class ofTransformHierarchy{
+public:
+	/// \brief Slot value meaning no transform, used for transforms without parent.
+	static const std::size_t noParent;
+
+	/// \brief Add a new identity transform.
+	/// \param parent slot of the parent transform or noParent.
+	/// \returns the slot identifying the new transform.
+	std::size_t add(std::size_t parent = noParent);
+
+	/// \brief Remove a transform, its children become roots of the hierarchy.
+	void remove(std::size_t slot);
+
+	/// \brief Remove every transform.
+	void clear();
+
+	/// \returns the number of transforms in the hierarchy.
+	std::size_t size() const;
+
+	/// \returns true if slot identifies a transform in this hierarchy.
+	bool isValid(std::size_t slot) const;
+
+	/// \brief Change the parent of a transform.
+	///
+	/// Fails with an error if parent is slot itself or one of its children.
+	void setParent(std::size_t slot, std::size_t parent);
+	std::size_t getParent(std::size_t slot) const;
+
+	void setPosition(std::size_t slot, const glm::vec3 & position);
+	void setOrientation(std::size_t slot, const glm::quat & orientation);
+	void setScale(std::size_t slot, const glm::vec3 & scale);
+	void setTransform(std::size_t slot, const glm::vec3 & position, const glm::quat & orientation, const glm::vec3 & scale);
+
+	const glm::vec3 & getPosition(std::size_t slot) const;
+	const glm::quat & getOrientation(std::size_t slot) const;
+	const glm::vec3 & getScale(std::size_t slot) const;
+
+	glm::mat4 getLocalTransformMatrix(std::size_t slot) const;
+
+	/// \brief Get the global transform of a slot.
+	///
+	/// After update() this is just a lookup. If anything changed since the
+	/// last update the matrix is calculated walking up the parents of the
+	/// slot so the result is always up to date.
+	glm::mat4 getGlobalTransformMatrix(std::size_t slot) const;
+	glm::vec3 getGlobalPosition(std::size_t slot) const;
+	glm::vec3 getGlobalScale(std::size_t slot) const;
+
+	/// \brief Recalculate every global matrix that might have changed.
+	void update();
+
+	/// \returns true if something changed since the last call to update().
+	bool needsUpdate() const;
+
+	/// \returns a number that changes every time a transform is added,
+	/// removed, reparented or modified, ofNode uses it to know when the
+	/// children of attached nodes have to recalculate their global transform.
+	std::uint64_t getVersion() const;
+
+	/// \brief Set the minimum number of transforms in a level to update it
+	/// using more than one thread. Defaults to 4096.
+	void setParallelThreshold(std::size_t threshold);
+
+private:
+	// index of removed slots, of the parent of roots and of levels that
+	// aren't known yet
+	static const std::size_t invalidIndex;
+
+	void sortByLevel();
+	std::size_t indexOf(std::size_t slot) const;
+	void markDirty(std::size_t index);
+
+	// per transform data, sorted by level after update()
+	std::vector<glm::vec3> positions;
+	std::vector<glm::quat> orientations;
+	std::vector<glm::vec3> scales;
+	std::vector<glm::mat4> localMatrices;
+	std::vector<glm::mat4> globalMatrices;
+	std::vector<glm::vec3> globalScales;
+	std::vector<std::size_t> parentSlots;
+	std::vector<std::size_t> parentIndices;
+	std::vector<std::uint8_t> localDirty;
+	std::vector<std::size_t> indexToSlot;
+
+	// level l occupies [levelOffsets[l], levelOffsets[l+1])
+	std::vector<std::size_t> levelOffsets;
+
+	std::vector<std::size_t> slotToIndex;
+	std::vector<std::size_t> freeSlots;
+
+	bool orderDirty = false;
+	bool dirty = false;
+	std::uint64_t version = 0;
+	std::size_t parallelThreshold = 4096;
+};
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <functional>
 #include "ofTypes.h"
+#include "ofEventQueue.h"
 
 
 /*! \cond PRIVATE */
@@ -142,6 +143,72 @@ namespace priv{
 	};
 
 
+	// -------------------------------------
+	// Epoch based reclamation for the lists of listeners notify() iterates
+	// over. A thread announces the epoch it's in when it starts notifying
+	// and clears it when it's done, nested notifies reuse the outermost
+	// announcement. A replaced list is retired with the epoch it was
+	// replaced in and deleted once every thread that announced that epoch
+	// or an earlier one is done, so notify only loads the epoch and writes
+	// to memory no other thread writes to.
+	class EventEpochs{
+	public:
+		struct Thread{
+			Thread();
+			~Thread();
+			std::atomic<std::uint64_t> epoch{0};
+			std::size_t depth = 0;
+		};
+
+		class ReadGuard{
+		public:
+			ReadGuard()
+			:thread(current()){
+				if(thread.depth++ == 0){
+					thread.epoch.store(epoch.load());
+				}
+			}
+
+			~ReadGuard(){
+				if(--thread.depth == 0){
+					thread.epoch.store(0, std::memory_order_release);
+					if(hasRetired.load(std::memory_order_relaxed)){
+						collect();
+					}
+				}
+			}
+
+			ReadGuard(const ReadGuard &) = delete;
+			ReadGuard & operator=(const ReadGuard &) = delete;
+
+		private:
+			Thread & thread;
+		};
+
+		// ptr has to be unreachable for notifies starting after this
+		template<typename T>
+		static void retire(const T * ptr){
+			retire(ptr, [](const void * ptr){
+				delete static_cast<const T*>(ptr);
+			});
+		}
+
+		static void retire(const void * ptr, void(*destroy)(const void*));
+
+		// deletes the retired pointers no thread can be using anymore
+		static void collect();
+
+	private:
+		static Thread & current(){
+			static thread_local Thread thread;
+			return thread;
+		}
+
+		static std::atomic<std::uint64_t> epoch;
+		static std::atomic<bool> hasRetired;
+	};
+
+
 	// -------------------------------------
 	template<typename Function, typename Mutex=std::recursive_mutex>
 	class BaseEvent{
@@ -151,6 +218,7 @@ namespace priv{
 		BaseEvent(const BaseEvent & mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = mom.self->functions;
+			self->publish();
 		}
 
 		BaseEvent & operator=(const BaseEvent & mom){
@@ -161,6 +229,7 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->publish();
 			return *this;
 		}
 
@@ -168,6 +237,9 @@ namespace priv{
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = std::move(mom.self->functions);
 			self->enabled = std::move(mom.self->enabled);
+			mom.self->functions.clear();
+			mom.self->publish();
+			self->publish();
 		}
 
 		BaseEvent & operator=(BaseEvent && mom){
@@ -178,6 +250,7 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->publish();
 			return *this;
 		}
 
@@ -200,10 +273,40 @@ namespace priv{
 	protected:
 
 		struct Data{
+			typedef std::vector<std::shared_ptr<Function>> Functions;
+
 			Mutex mtx;
-			std::vector<std::shared_ptr<Function>> functions;
+			Functions functions;
 			bool enabled = true;
 
+			// notify() doesn't lock or copy functions, it iterates over
+			// an immutable copy of it that is replaced, never modified,
+			// every time a listener is added or removed. Replaced copies
+			// are retired to EventEpochs which deletes them once every
+			// notify that could be using them has finished.
+			std::atomic<const Functions*> published{nullptr};
+
+			~Data(){
+				// a listener can destroy the event while it's notified
+				auto last = published.load();
+				if(last){
+					EventEpochs::retire(last);
+				}
+			}
+
+			// needs mtx to be locked
+			void publish(){
+				auto next = functions.empty() ? nullptr : new Functions(functions);
+				auto prev = published.exchange(next);
+				if(prev){
+					EventEpochs::retire(prev);
+				}
+			}
+
+			bool hasListeners() const{
+				return published.load(std::memory_order_relaxed) != nullptr;
+			}
+
 			void remove(const BaseFunctionId & id){
 				std::unique_lock<Mutex> lck(mtx);
 				auto it = functions.begin();
@@ -212,6 +315,7 @@ namespace priv{
 					if(*f->id == id){
 						f->disable();
 						functions.erase(it);
+						publish();
 						break;
 					}
 				}
@@ -219,6 +323,26 @@ namespace priv{
 		};
 		std::shared_ptr<Data> self{new Data};
 
+		// Pins the published listeners while notify iterates over them, even
+		// if a listener destroys the event. An uncontended notify loads the
+		// epoch and the list and stores to its own thread's epoch, it
+		// doesn't take a reference to the event or count itself in a
+		// counter shared with other threads.
+		class Snapshot{
+		public:
+			Snapshot(const std::shared_ptr<Data> & data){
+				// loaded once guard announced this thread
+				functions = data->published.load();
+			}
+
+			Snapshot(const Snapshot &) = delete;
+			Snapshot & operator=(const Snapshot &) = delete;
+
+			const typename Data::Functions * functions;
+		private:
+			EventEpochs::ReadGuard guard;
+		};
+
 		class EventToken: public AbstractEventToken{
 			public:
 				EventToken() {};
@@ -253,6 +377,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->publish();
 		}
 
 		template<typename TFunction>
@@ -263,6 +388,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->publish();
 			return make_token(*f);
 		}
 	};
@@ -375,6 +501,16 @@ enum ofEventOrder{
 	OF_EVENT_ORDER_AFTER_APP=200
 };
 
+// -------------------------------------
+/// How ofEvent::notifyDeferred() queues a notification
+enum ofEventDeferMode{
+	/// every notification is delivered
+	OF_EVENT_DEFER_QUEUE,
+	/// only the last notification of the event since the queue was
+	/// last drained is delivered
+	OF_EVENT_DEFER_COALESCE
+};
+
 // -------------------------------------
 class ofEventListener{
 public:
@@ -484,6 +620,22 @@ protected:
 
 	using of::priv::BaseEvent<of::priv::Function<T,Mutex>,Mutex>::addFunction;
 	using of::priv::BaseEvent<of::priv::Function<T,Mutex>,Mutex>::addNoToken;
+	typedef typename of::priv::BaseEvent<of::priv::Function<T,Mutex>,Mutex>::Snapshot Snapshot;
+	typedef typename of::priv::BaseEvent<of::priv::Function<T,Mutex>,Mutex>::Data Data;
+
+	static bool dispatch(const std::shared_ptr<Data> & data, const void* sender, T & param){
+		if(data->enabled && data->hasListeners()){
+			Snapshot snapshot(data);
+			if(snapshot.functions){
+				for(auto & f: *snapshot.functions){
+					if(f->notify(sender,param)){
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
 
 public:
 	template<class TObj, typename TMethod>
@@ -517,31 +669,36 @@ public:
 	}
 
 	inline bool notify(const void* sender, T & param){
-		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<T,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-                if(f->notify(sender,param)){
-					return true;
-                }
-			}
-		}
-		return false;
+		return dispatch(ofEvent<T,Mutex>::self, sender, param);
 	}
 
 	inline bool notify(T & param){
-		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<T,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(nullptr,param)){
-					return true;
-				}
+		return notify(nullptr, param);
+	}
+
+	/// \brief Notify the listeners later, on the thread that drains queue.
+	///
+	/// By default the listeners are called from the main thread at the
+	/// beginning of the next frame, which is the usual way to send results
+	/// from a thread to the app. param is copied. Nothing happens if the
+	/// event is destroyed before the queue is drained.
+	void notifyDeferred(const void* sender, const T & param, ofEventDeferMode mode = OF_EVENT_DEFER_QUEUE, ofEventQueue & queue = ofGetMainEventQueue()){
+		std::weak_ptr<Data> weak = ofEvent<T,Mutex>::self;
+		auto f = [weak, sender, value = typename std::remove_const<T>::type(param)]() mutable{
+			auto data = weak.lock();
+			if(data){
+				dispatch(data, sender, value);
 			}
+		};
+		if(mode == OF_EVENT_DEFER_COALESCE){
+			queue.postCoalesced(weak, f);
+		}else{
+			queue.post(f);
 		}
-		return false;
+	}
+
+	void notifyDeferred(const T & param, ofEventDeferMode mode = OF_EVENT_DEFER_QUEUE, ofEventQueue & queue = ofGetMainEventQueue()){
+		notifyDeferred(nullptr, param, mode, queue);
 	}
 };
 
@@ -642,6 +799,22 @@ protected:
 
 	using of::priv::BaseEvent<of::priv::Function<void,Mutex>,Mutex>::addFunction;
 	using of::priv::BaseEvent<of::priv::Function<void,Mutex>,Mutex>::addNoToken;
+	typedef typename of::priv::BaseEvent<of::priv::Function<void,Mutex>,Mutex>::Snapshot Snapshot;
+	typedef typename of::priv::BaseEvent<of::priv::Function<void,Mutex>,Mutex>::Data Data;
+
+	static bool dispatch(const std::shared_ptr<Data> & data, const void* sender){
+		if(data->enabled && data->hasListeners()){
+			Snapshot snapshot(data);
+			if(snapshot.functions){
+				for(auto & f: *snapshot.functions){
+					if(f->notify(sender)){
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
 
 public:
 	template<class TObj, typename TMethod>
@@ -675,31 +848,31 @@ public:
 	}
 
 	bool notify(const void* sender){
-		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<void,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(sender)){
-					return true;
-				}
-			}
-		}
-		return false;
+		return dispatch(ofEvent<void,Mutex>::self, sender);
 	}
 
 	bool notify(){
-		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<void,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(nullptr)){
-					return true;
-				}
+		return notify(nullptr);
+	}
+
+	/// \brief Notify the listeners later, on the thread that drains queue.
+	///
+	/// By default the listeners are called from the main thread at the
+	/// beginning of the next frame. Nothing happens if the event is
+	/// destroyed before the queue is drained.
+	void notifyDeferred(const void* sender = nullptr, ofEventDeferMode mode = OF_EVENT_DEFER_QUEUE, ofEventQueue & queue = ofGetMainEventQueue()){
+		std::weak_ptr<Data> weak = ofEvent<void,Mutex>::self;
+		auto f = [weak, sender]{
+			auto data = weak.lock();
+			if(data){
+				dispatch(data, sender);
 			}
+		};
+		if(mode == OF_EVENT_DEFER_COALESCE){
+			queue.postCoalesced(weak, f);
+		}else{
+			queue.post(f);
 		}
-		return false;
 	}
 };
 
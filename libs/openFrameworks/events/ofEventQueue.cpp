@@ -0,0 +1,154 @@
+#include "ofEventQueue.h"
+#include <cstdint>
+
+//--------------------------------------------------------------
+ofEventQueue::ofEventQueue(std::size_t capacity){
+	std::size_t size = 2;
+	while(size < capacity){
+		size <<= 1;
+	}
+	cells.reset(new Cell[size]);
+	mask = size - 1;
+	for(std::size_t i = 0; i < size; i++){
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+//--------------------------------------------------------------
+void ofEventQueue::post(std::function<void()> f){
+	// anything in the overflow list runs after the ring, so once something
+	// is there later posts have to follow it until it's drained
+	if(hasOverflow){
+		std::unique_lock<std::mutex> lock(overflowMutex);
+		if(hasOverflow){
+			overflow.push_back(std::move(f));
+			return;
+		}
+	}
+	if(!tryPush(f)){
+		std::unique_lock<std::mutex> lock(overflowMutex);
+		overflow.push_back(std::move(f));
+		hasOverflow = true;
+	}
+}
+
+//--------------------------------------------------------------
+void ofEventQueue::postCoalesced(const std::weak_ptr<const void> & key, std::function<void()> f){
+	{
+		std::unique_lock<std::mutex> lock(coalescedMutex);
+		auto it = coalesced.find(key);
+		if(it != coalesced.end()){
+			it->second = std::move(f);
+			return;
+		}
+		coalesced[key] = std::move(f);
+	}
+	post([this, key]{
+		std::function<void()> f;
+		{
+			std::unique_lock<std::mutex> lock(coalescedMutex);
+			auto it = coalesced.find(key);
+			f = std::move(it->second);
+			coalesced.erase(it);
+		}
+		f();
+	});
+}
+
+//--------------------------------------------------------------
+std::size_t ofEventQueue::drain(){
+	// only what's in the ring now, so listeners posting again don't keep
+	// us here forever
+	auto pending = enqueuePos.load(std::memory_order_acquire) - dequeuePos.load(std::memory_order_relaxed);
+	std::size_t count = 0;
+	std::function<void()> f;
+	while(count < pending && tryPop(f)){
+		f();
+		f = nullptr;
+		count++;
+	}
+
+	if(hasOverflow){
+		// whatever is still in the ring was posted before anything in the
+		// overflow list, later posts go to the list, so it has to run first
+		while(tryPop(f)){
+			f();
+			f = nullptr;
+			count++;
+		}
+
+		std::deque<std::function<void()>> overflowed;
+		{
+			std::unique_lock<std::mutex> lock(overflowMutex);
+			overflowed.swap(overflow);
+			hasOverflow = false;
+		}
+		for(auto & task: overflowed){
+			task();
+		}
+		count += overflowed.size();
+	}
+	return count;
+}
+
+//--------------------------------------------------------------
+bool ofEventQueue::empty() const{
+	return enqueuePos.load() == dequeuePos.load() && !hasOverflow;
+}
+
+//--------------------------------------------------------------
+bool ofEventQueue::tryPush(std::function<void()> & f){
+	auto pos = enqueuePos.load(std::memory_order_relaxed);
+	Cell * cell;
+	while(true){
+		cell = &cells[pos & mask];
+		auto sequence = cell->sequence.load(std::memory_order_acquire);
+		auto diff = std::intptr_t(sequence) - std::intptr_t(pos);
+		if(diff == 0){
+			if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+				break;
+			}
+		}else if(diff < 0){
+			// full
+			return false;
+		}else{
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	cell->f = std::move(f);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofEventQueue::tryPop(std::function<void()> & f){
+	auto pos = dequeuePos.load(std::memory_order_relaxed);
+	Cell * cell;
+	while(true){
+		cell = &cells[pos & mask];
+		auto sequence = cell->sequence.load(std::memory_order_acquire);
+		auto diff = std::intptr_t(sequence) - std::intptr_t(pos + 1);
+		if(diff == 0){
+			if(dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+				break;
+			}
+		}else if(diff < 0){
+			// empty
+			return false;
+		}else{
+			pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+	f = std::move(cell->f);
+	cell->f = nullptr;
+	cell->sequence.store(pos + mask + 1, std::memory_order_release);
+	return true;
+}
+
+//--------------------------------------------------------------
+ofEventQueue & ofGetMainEventQueue(){
+	// never destroyed so events notified from static destructors or
+	// threads still running at exit don't post to a dead queue
+	static ofEventQueue * queue = new ofEventQueue;
+	return *queue;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/// \brief Queue of notifications to run later on a specific thread.
+///
+/// Any thread can post to the queue. Whatever was posted runs when the
+/// queue is drained, always on the thread calling drain(). It's what
+/// ofEvent::notifyDeferred() uses to move notifications from worker threads
+/// to the main thread.
+///
+/// The main queue returned by ofGetMainEventQueue() is drained at the
+/// beginning of every frame, before update, with any kind of window.
+/// Other threads can have their own queue and drain it whenever they see
+/// fit.
+///
+/// Posting is lock free unless the queue is full, in which case the
+/// notification goes into an overflow list guarded by a mutex so nothing is
+/// ever lost. Once something overflowed every post goes to that list until
+/// the next drain so notifications still run in the order they were posted.
+/// Coalesced posts also use a mutex to find the notification they replace.
+class ofEventQueue{
+public:
+	/// \param capacity size of the lock free ring, rounded up to a power of 2.
+	ofEventQueue(std::size_t capacity = 4096);
+	ofEventQueue(const ofEventQueue &) = delete;
+	ofEventQueue & operator=(const ofEventQueue &) = delete;
+
+	/// \brief Run f the next time the queue is drained.
+	void post(std::function<void()> f);
+
+	/// \brief Run f the next time the queue is drained replacing anything
+	/// else posted with the same key that didn't run yet.
+	///
+	/// Useful to deliver only the last value of something that changes
+	/// faster than the queue is drained. key identifies the object the
+	/// notifications belong to, usually a weak pointer to data it owns, so a new
+	/// object allocated where a destroyed one was never shares its key.
+	void postCoalesced(const std::weak_ptr<const void> & key, std::function<void()> f);
+
+	/// \brief Run everything that was posted until now on the calling thread.
+	///
+	/// Anything posted while draining waits for the next call.
+	/// \returns the number of notifications that ran.
+	std::size_t drain();
+
+	/// \returns true if there's nothing waiting to be drained.
+	bool empty() const;
+
+private:
+	bool tryPush(std::function<void()> & f);
+	bool tryPop(std::function<void()> & f);
+
+	// bounded multi producer ring, every cell has a sequence number that
+	// tells producers and consumers whose turn it is to use the cell
+	struct Cell{
+		std::atomic<std::size_t> sequence;
+		std::function<void()> f;
+	};
+	std::unique_ptr<Cell[]> cells;
+	std::size_t mask;
+	std::atomic<std::size_t> enqueuePos{0};
+	std::atomic<std::size_t> dequeuePos{0};
+
+	std::mutex overflowMutex;
+	std::deque<std::function<void()>> overflow;
+	std::atomic<bool> hasOverflow{false};
+
+	std::mutex coalescedMutex;
+	std::map<std::weak_ptr<const void>, std::function<void()>, std::owner_less<std::weak_ptr<const void>>> coalesced;
+};
+
+/// \brief Queue drained by the main loop at the beginning of every frame.
+ofEventQueue & ofGetMainEventQueue();
@@ -1,5 +1,7 @@
 #include "ofEvents.h"
 #include "ofAppRunner.h"
+#include "ofJobQueue.h"
+#include <limits>
 
 using namespace std;
 
@@ -116,6 +118,12 @@ int ofGetPreviousMouseY(){
 	}
 }
 
+//------------------------------------------
+// the main thread queues run from the update of one window, the first one
+// to update, so they run once per frame with every kind of window including
+// the ones that implement their own loop like GLUT, iOS or Android
+static ofCoreEvents * mainQueuesEvents = nullptr;
+
 ofCoreEvents::ofCoreEvents()
 :targetRate(0)
 ,bFrameRateSet(false)
@@ -128,6 +136,13 @@ ofCoreEvents::ofCoreEvents()
 
 }
 
+//------------------------------------------
+ofCoreEvents::~ofCoreEvents(){
+	if(mainQueuesEvents == this){
+		mainQueuesEvents = nullptr;
+	}
+}
+
 //------------------------------------------
 void ofCoreEvents::disable(){
 	setup.disable();
@@ -281,6 +296,15 @@ bool ofCoreEvents::notifySetup(){
 #include "ofGraphics.h"
 //------------------------------------------
 bool ofCoreEvents::notifyUpdate(){
+	if(!mainQueuesEvents){
+		mainQueuesEvents = this;
+	}
+	if(mainQueuesEvents == this){
+		// notifications deferred from other threads arrive before update
+		ofGetMainEventQueue().drain();
+		// main thread work from other threads, spread across frames
+		ofGetMainJobQueue().runFrame();
+	}
 	return ofNotifyEvent( update, voidEventArgs );
 }
 
@@ -622,10 +646,82 @@ bool ofSendMessage(string messageString){
 }
 
 //------------------------------------------
+namespace{
+	struct RetiredPointer{
+		std::uint64_t epoch;
+		const void * ptr;
+		void(*destroy)(const void*);
+	};
+
+	struct EventEpochsState{
+		std::mutex mutex;
+		std::vector<of::priv::EventEpochs::Thread*> threads;
+		std::vector<RetiredPointer> retired;
+	};
+
+	EventEpochsState & eventEpochsState(){
+		static EventEpochsState state;
+		return state;
+	}
+}
+
 namespace of{
 	namespace priv{
 		std::atomic<uint_fast64_t> StdFunctionId::nextId;
 
+		std::atomic<std::uint64_t> EventEpochs::epoch{1};
+		std::atomic<bool> EventEpochs::hasRetired{false};
+
+		EventEpochs::Thread::Thread(){
+			auto & state = eventEpochsState();
+			std::unique_lock<std::mutex> lck(state.mutex);
+			state.threads.push_back(this);
+		}
+
+		EventEpochs::Thread::~Thread(){
+			auto & state = eventEpochsState();
+			std::unique_lock<std::mutex> lck(state.mutex);
+			state.threads.erase(std::find(state.threads.begin(), state.threads.end(), this));
+		}
+
+		void EventEpochs::retire(const void * ptr, void(*destroy)(const void*)){
+			{
+				auto & state = eventEpochsState();
+				std::unique_lock<std::mutex> lck(state.mutex);
+				// notifies that announce a later epoch load ptr's
+				// replacement
+				state.retired.push_back({epoch.fetch_add(1), ptr, destroy});
+				hasRetired = true;
+			}
+			collect();
+		}
+
+		void EventEpochs::collect(){
+			std::vector<RetiredPointer> expired;
+			{
+				auto & state = eventEpochsState();
+				std::unique_lock<std::mutex> lck(state.mutex);
+				auto oldest = std::numeric_limits<std::uint64_t>::max();
+				for(auto thread: state.threads){
+					auto announced = thread->epoch.load();
+					if(announced != 0){
+						oldest = std::min(oldest, announced);
+					}
+				}
+				auto firstExpired = std::partition(state.retired.begin(), state.retired.end(), [&](const RetiredPointer & retired){
+					return retired.epoch >= oldest;
+				});
+				expired.assign(firstExpired, state.retired.end());
+				state.retired.erase(firstExpired, state.retired.end());
+				hasRetired = !state.retired.empty();
+			}
+			// deleting listeners can add or remove others, which retires
+			// more lists
+			for(auto & retired: expired){
+				retired.destroy(retired.ptr);
+			}
+		}
+
 		AbstractEventToken::~AbstractEventToken(){}
 
 		BaseFunctionId::~BaseFunctionId(){}
@@ -238,6 +238,7 @@ enum ofTimeMode{
 class ofCoreEvents {
   public:
 	ofCoreEvents();
+	~ofCoreEvents();
 	ofEvent<ofEventArgs> 		setup;
 	ofEvent<ofEventArgs> 		update;
 	ofEvent<ofEventArgs> 		draw;
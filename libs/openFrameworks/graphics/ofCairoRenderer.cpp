@@ -26,6 +26,8 @@ ofCairoRenderer::ofCairoRenderer()
 	page = 0;
 	multiPage = false;
 	b3D = false;
+	tiled = false;
+	tileSize = 1024;
 	currentMatrixMode=OF_MATRIX_MODELVIEW;
 }
 
@@ -82,7 +84,12 @@ void ofCairoRenderer::setup(string _filename, Type _type, bool multiPage_, bool
 	case IMAGE:
 		imageBuffer.allocate(outputsize.width, outputsize.height, OF_PIXELS_BGRA);
 		imageBuffer.set(0);
-		surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,outputsize.width, outputsize.height,outputsize.width*4);
+		if(tiled){
+			cairo_rectangle_t extents{0, 0, outputsize.width, outputsize.height};
+			surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+		}else{
+			surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,outputsize.width, outputsize.height,outputsize.width*4);
+		}
 		break;
 	case FROM_FILE_EXTENSION:
 		ofLogFatalError("ofCairoRenderer") << "setup(): couldn't determine type from extension for filename: \"" << _filename << "\"!";
@@ -93,6 +100,11 @@ void ofCairoRenderer::setup(string _filename, Type _type, bool multiPage_, bool
 	}
 
 	cr = cairo_create(surface);
+	if(tiled && type==IMAGE){
+		// drawing goes to a group that is swapped on every flush so each
+		// replay only contains what was drawn since the previous one
+		cairo_push_group_with_content(cr, CAIRO_CONTENT_COLOR_ALPHA);
+	}
 	cairo_set_antialias(cr,CAIRO_ANTIALIAS_SUBPIXEL);
 	viewportRect = outputsize;
 	originalViewport = outputsize;
@@ -106,15 +118,142 @@ void ofCairoRenderer::setupMemoryOnly(Type _type, bool multiPage_, bool b3D_, of
 	setup("",_type,multiPage_,b3D_,outputsize);
 }
 
+void ofCairoRenderer::setTiledRendering(bool tiled, int tileSize){
+	if(surface){
+		ofLogError("ofCairoRenderer") << "setTiledRendering(): has to be called before setup()";
+		return;
+	}
+	this->tiled = tiled;
+	this->tileSize = std::max(tileSize, 1);
+}
+
+bool ofCairoRenderer::isTiledRendering() const{
+	return tiled;
+}
+
+void ofCairoRenderer::renderTiles(){
+	auto recording = cairo_get_group_target(cr);
+	cairo_surface_flush(recording);
+
+	// only the tiles touched by the recorded commands need to be replayed
+	double inkX, inkY, inkW, inkH;
+	cairo_recording_surface_ink_extents(recording, &inkX, &inkY, &inkW, &inkH);
+	if(inkW <= 0 || inkH <= 0){
+		return;
+	}
+
+	int width = imageBuffer.getWidth();
+	int height = imageBuffer.getHeight();
+	int x0 = std::max(0, int(floor(inkX)));
+	int y0 = std::max(0, int(floor(inkY)));
+	int x1 = std::min(width, int(ceil(inkX + inkW)));
+	int y1 = std::min(height, int(ceil(inkY + inkH)));
+
+	std::vector<ofRectangle> tiles;
+	for(int y = y0 - y0 % tileSize; y < y1; y += tileSize){
+		for(int x = x0 - x0 % tileSize; x < x1; x += tileSize){
+			tiles.emplace_back(x, y, std::min(tileSize, width - x), std::min(tileSize, height - y));
+		}
+	}
+	if(tiles.empty()){
+		return;
+	}
+
+	// each tile is an image surface pointing into its region of the output
+	// pixels, so nothing needs to be stitched afterwards. The recording holds
+	// everything drawn since the last flush on top of the pixels rendered
+	// until then, so it replaces the tile contents whatever blend modes were
+	// used. Tiles are replayed one after another: cairo keeps scratch state
+	// in the recording surface while replaying it and has no way to copy a
+	// recording for each thread, so it can't be shared by threads
+	int stride = width * 4;
+	for(auto & tile: tiles){
+		auto data = imageBuffer.getData() + int(tile.y) * stride + int(tile.x) * 4;
+		auto tileSurface = cairo_image_surface_create_for_data(data, CAIRO_FORMAT_ARGB32, tile.width, tile.height, stride);
+		auto tileCr = cairo_create(tileSurface);
+		cairo_set_operator(tileCr, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface(tileCr, recording, -tile.x, -tile.y);
+		cairo_paint(tileCr);
+		cairo_destroy(tileCr);
+		cairo_surface_flush(tileSurface);
+		cairo_surface_destroy(tileSurface);
+	}
+}
+
+void ofCairoRenderer::restartRecording(){
+	// replayed commands are already in the output pixels, start a new group
+	// from those pixels keeping the current state of the context, which
+	// cairo_pop_group() restores to the one before the group was pushed
+	cairo_save(cr);
+	cairo_identity_matrix(cr);
+	auto clip = cairo_copy_clip_rectangle_list(cr);
+	cairo_restore(cr);
+
+	cairo_matrix_t matrix;
+	cairo_get_matrix(cr, &matrix);
+	auto source = cairo_pattern_reference(cairo_get_source(cr));
+	auto antialias = cairo_get_antialias(cr);
+	auto op = cairo_get_operator(cr);
+	auto fillRule = cairo_get_fill_rule(cr);
+	auto lineWidth = cairo_get_line_width(cr);
+	auto lineCap = cairo_get_line_cap(cr);
+	auto lineJoin = cairo_get_line_join(cr);
+	auto miterLimit = cairo_get_miter_limit(cr);
+	auto tolerance = cairo_get_tolerance(cr);
+
+	// only the area drawn so far can be different from the previous pixels
+	double inkX, inkY, inkW, inkH;
+	cairo_recording_surface_ink_extents(cairo_get_group_target(cr), &inkX, &inkY, &inkW, &inkH);
+	cairo_pattern_destroy(cairo_pop_group(cr));
+	cairo_push_group_with_content(cr, CAIRO_CONTENT_COLOR_ALPHA);
+
+	// the recording keeps its own copy of the pixels once the source surface
+	// is destroyed
+	if(inkW > 0 && inkH > 0){
+		auto previous = cairo_image_surface_create_for_data(imageBuffer.getData(), CAIRO_FORMAT_ARGB32, imageBuffer.getWidth(), imageBuffer.getHeight(), imageBuffer.getWidth() * 4);
+		cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface(cr, previous, 0, 0);
+		cairo_rectangle(cr, floor(inkX), floor(inkY), ceil(inkX + inkW) - floor(inkX), ceil(inkY + inkH) - floor(inkY));
+		cairo_fill(cr);
+		cairo_surface_destroy(previous);
+	}
+	if(clip->status == CAIRO_STATUS_SUCCESS){
+		for(int i = 0; i < clip->num_rectangles; i++){
+			auto & r = clip->rectangles[i];
+			cairo_rectangle(cr, r.x, r.y, r.width, r.height);
+		}
+		cairo_clip(cr);
+	}
+	cairo_rectangle_list_destroy(clip);
+	cairo_set_matrix(cr, &matrix);
+	cairo_set_source(cr, source);
+	cairo_pattern_destroy(source);
+	cairo_set_antialias(cr, antialias);
+	cairo_set_operator(cr, op);
+	cairo_set_fill_rule(cr, fillRule);
+	cairo_set_line_width(cr, lineWidth);
+	cairo_set_line_cap(cr, lineCap);
+	cairo_set_line_join(cr, lineJoin);
+	cairo_set_miter_limit(cr, miterLimit);
+	cairo_set_tolerance(cr, tolerance);
+}
+
 void ofCairoRenderer::flush(){
 	if(surface){
 		cairo_surface_flush(surface);
+		if(tiled && type==IMAGE){
+			renderTiles();
+			restartRecording();
+		}
 	}
 }
 
 void ofCairoRenderer::close(){
 	if(surface){
 		cairo_surface_flush(surface);
+		if(tiled && type==IMAGE){
+			renderTiles();
+		}
 		if(type==IMAGE && filename!=""){
 			ofSaveImage(imageBuffer,filename);
 		}
@@ -145,7 +284,7 @@ void ofCairoRenderer::startRender(){
 }
 
 void ofCairoRenderer::finishRender(){
-	cairo_surface_flush(surface);
+	flush();
 }
 
 void ofCairoRenderer::setStyle(const ofStyle & style){
@@ -1359,6 +1498,8 @@ cairo_surface_t * ofCairoRenderer::getCairoSurface(){
 ofPixels & ofCairoRenderer::getImageSurfacePixels(){
 	if(type!=IMAGE){
 		ofLogError("ofCairoRenderer") << "getImageSurfacePixels(): can only get pixels from image surface";
+	}else if(tiled && surface){
+		flush();
 	}
 	return imageBuffer;
 }
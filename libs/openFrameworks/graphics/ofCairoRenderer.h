@@ -27,6 +27,26 @@ public:
 	};
 	void setup(std::string filename, Type type=ofCairoRenderer::FROM_FILE_EXTENSION, bool multiPage=true, bool b3D=false, ofRectangle outputsize = ofRectangle(0,0,0,0));
 	void setupMemoryOnly(Type _type, bool multiPage=true, bool b3D=false, ofRectangle viewport = ofRectangle(0,0,0,0));
+
+	/// \brief Rasterize IMAGE surfaces in tiles.
+	///
+	/// Has to be called before setup(). Instead of drawing into the output
+	/// pixels directly, drawing commands are recorded and replayed tile by
+	/// tile into the output ofPixels when the frame is finished
+	/// (finishRender(), flush(), close() or getImageSurfacePixels()). Only
+	/// the tiles touched by the drawing are rasterized and each one only
+	/// replays the commands recorded since the previous flush that cover
+	/// it. Tiles are replayed one after another on the calling thread so
+	/// this isn't faster than drawing into the pixels directly.
+	///
+	/// Drawing goes to a cairo group pushed on getCairoContext(), so
+	/// cairo_save() and cairo_restore() calls on it have to be balanced
+	/// before each flush.
+	///
+	/// \param tiled enable or disable tiled rendering
+	/// \param tileSize width and height of each tile in pixels
+	void setTiledRendering(bool tiled, int tileSize=1024);
+	bool isTiledRendering() const;
 	void close();
 	void flush();
 
@@ -171,6 +191,8 @@ private:
 	glm::vec3 transform(glm::vec3 vec) const;
 	static _cairo_status stream_function(void *closure,const unsigned char *data, unsigned int length);
 	void draw(const ofPixels & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void renderTiles();
+	void restartRecording();
 
 	mutable std::deque<glm::vec3> curvePoints;
 	cairo_t * cr;
@@ -183,6 +205,9 @@ private:
 	int page;
 	bool multiPage;
 
+	bool tiled;
+	int tileSize;
+
 	// 3d transformation
 	bool b3D;
 	glm::mat4 projection;
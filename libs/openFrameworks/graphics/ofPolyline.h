@@ -345,6 +345,12 @@ public:
     /// points removed.
 	void simplify(float tolerance=0.3f);
 
+	/// \brief Transforms every vertex of the polyline by m.
+	///
+	/// Uses ofTransformPoints so it's much faster than transforming the
+	/// vertices one by one.
+	void transform(const glm::mat4 & m);
+
 	/// \}
 	/// \name Polyline State
 	/// \{
@@ -2,6 +2,7 @@
 #include "ofAppRunner.h"
 #include "ofPolyline.h"
 #include "ofVectorMath.h"
+#include "ofTransformPoints.h"
 
 //----------------------------------------------------------
 template<class T>
@@ -778,6 +779,15 @@ void ofPolyline_<T>::simplify(float tol){
     
 }
 
+//--------------------------------------------------
+template<class T>
+void ofPolyline_<T>::transform(const glm::mat4 & m){
+	static_assert(sizeof(T) == sizeof(glm::vec3), "ofPolyline_::transform() needs 3D vertices");
+	auto vertices = reinterpret_cast<glm::vec3*>(points.data());
+	ofTransformPoints(m, vertices, vertices, points.size());
+	flagHasChanged();
+}
+
 //--------------------------------------------------
 template<class T>
 void ofPolyline_<T>::draw() const{
@@ -538,6 +538,8 @@ ofTrueTypeFont::ofTrueTypeFont()
 	ascenderHeight = 0;
 	descenderHeight = 0;
 	lineHeight = 0;
+	stringMeshCacheSize = 0;
+	layoutVersion = 0;
 }
 
 //------------------------------------------------------------------
@@ -577,6 +579,8 @@ ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont& mom)
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+	stringMeshCacheSize = mom.stringMeshCacheSize;
+	layoutVersion = 0;
 }
 
 //------------------------------------------------------------------
@@ -609,6 +613,8 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont& mom){
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+	stringMeshCacheSize = mom.stringMeshCacheSize;
+	layoutChanged();
 
 	return *this;
 }
@@ -642,6 +648,8 @@ ofTrueTypeFont::ofTrueTypeFont(ofTrueTypeFont&& mom)
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+	stringMeshCacheSize = mom.stringMeshCacheSize;
+	layoutVersion = 0;
 }
 
 //------------------------------------------------------------------
@@ -673,6 +681,8 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+	stringMeshCacheSize = mom.stringMeshCacheSize;
+	layoutChanged();
 	return *this;
 }
 
@@ -791,6 +801,7 @@ bool ofTrueTypeFont::load(const ofTrueTypeFont::Settings & _settings){
 	}
 
 	bLoadedOk = false;
+	layoutChanged();
 
 	//--------------- load the library and typeface
 	FT_Face loadFace;
@@ -976,6 +987,7 @@ int ofTrueTypeFont::getSize() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	layoutChanged();
 }
 
 //-----------------------------------------------------------
@@ -1001,6 +1013,7 @@ const ofRectangle & ofTrueTypeFont::getGlyphBBox() const {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	layoutChanged();
 }
 
 //-----------------------------------------------------------
@@ -1011,6 +1024,7 @@ float ofTrueTypeFont::getLetterSpacing() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	layoutChanged();
 }
 
 //-----------------------------------------------------------
@@ -1045,6 +1059,11 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(uint32_t character, bool vfl
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const{
+	drawChar(c, x, y, vFlipped, stringQuads);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped, ofMesh & mesh) const{
 
 	if (!isValidGlyph(c)){
 		//ofLogError("ofTrueTypeFont") << "drawChar(): char " << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
@@ -1073,24 +1092,24 @@ void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const
 	ymin += y;
 	ymax += y;
 
-	ofIndexType firstIndex = stringQuads.getVertices().size();
+	ofIndexType firstIndex = mesh.getVertices().size();
 
-	stringQuads.addVertex(glm::vec3(xmin,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymax,0.f));
-	stringQuads.addVertex(glm::vec3(xmin,ymax,0.f));
+	mesh.addVertex(glm::vec3(xmin,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymax,0.f));
+	mesh.addVertex(glm::vec3(xmin,ymax,0.f));
 
-	stringQuads.addTexCoord(glm::vec2(t1,v1));
-	stringQuads.addTexCoord(glm::vec2(t2,v1));
-	stringQuads.addTexCoord(glm::vec2(t2,v2));
-	stringQuads.addTexCoord(glm::vec2(t1,v2));
+	mesh.addTexCoord(glm::vec2(t1,v1));
+	mesh.addTexCoord(glm::vec2(t2,v1));
+	mesh.addTexCoord(glm::vec2(t2,v2));
+	mesh.addTexCoord(glm::vec2(t1,v2));
 
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
+	mesh.addIndex(firstIndex);
+	mesh.addIndex(firstIndex+1);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+3);
+	mesh.addIndex(firstIndex);
 }
 
 //-----------------------------------------------------------
@@ -1106,7 +1125,12 @@ int ofTrueTypeFont::getKerning(uint32_t c, uint32_t prevC) const{
 
 void ofTrueTypeFont::iterateString(const string & str, float x, float y, bool vFlipped, std::function<void(uint32_t, glm::vec2)> f) const{
 	glm::vec2 pos(x,y);
+	uint32_t prevC = 0;
+	iterateString(str, x, vFlipped, pos, prevC, f);
+}
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::iterateString(const string & str, float x, bool vFlipped, glm::vec2 & pos, uint32_t & prevC, std::function<void(uint32_t, glm::vec2)> f) const{
 	int newLineDirection		= 1;
 	if(!vFlipped){
 		// this would align multiline texts to the last line when vflip is disabled
@@ -1117,7 +1141,6 @@ void ofTrueTypeFont::iterateString(const string & str, float x, float y, bool vF
 
 	int directionX = settings.direction == Settings::Direction::LeftToRight?1:-1;
 
-	uint32_t prevC = 0;
 	for(auto c: ofUTF8Iterator(str)){
 		try{
 			if (c == '\n') {
@@ -1156,6 +1179,7 @@ void ofTrueTypeFont::iterateString(const string & str, float x, float y, bool vF
 //-----------------------------------------------------------
 void ofTrueTypeFont::setDirection(ofTrueTypeFont::Settings::Direction direction){
 	settings.direction = direction;
+	layoutChanged();
 }
 
 //-----------------------------------------------------------
@@ -1267,16 +1291,108 @@ float ofTrueTypeFont::stringHeight(const std::string& c) const{
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y, bool vflip) const{
-	iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2 pos){
-		drawChar(c, pos.x, pos.y, vflip);
+	glm::vec2 pos(x,y);
+	uint32_t prevC = 0;
+	appendStringMesh(stringQuads, str, x, vflip, pos, prevC);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendStringMesh(ofMesh & mesh, const std::string& str, float lineStartX, bool vflip, glm::vec2 & pen, uint32_t & prevC) const{
+	iterateString(str,lineStartX,vflip,pen,prevC,[&](uint32_t c, glm::vec2 pos){
+		drawChar(c, pos.x, pos.y, vflip, mesh);
 	});
 }
 
+//-----------------------------------------------------------
+static std::size_t stringMeshHash(const std::string & str, float x, float y, bool vFlipped){
+	auto combine = [](std::size_t seed, std::size_t value){
+		return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+	};
+	std::size_t hash = std::hash<std::string>()(str);
+	hash = combine(hash, std::hash<float>()(x));
+	hash = combine(hash, std::hash<float>()(y));
+	return combine(hash, vFlipped);
+}
+
 //-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(const std::string& c, float x, float y, bool vFlipped) const{
-	stringQuads.clear();
-	createStringMesh(c,x,y,vFlipped);
-	return stringQuads;
+	if(stringMeshCacheSize == 0){
+		stringQuads.clear();
+		createStringMesh(c,x,y,vFlipped);
+		return stringQuads;
+	}
+
+	auto hash = stringMeshHash(c, x, y, vFlipped);
+	auto range = stringMeshCacheIndex.equal_range(hash);
+	for(auto it = range.first; it != range.second; ++it){
+		auto cached = it->second;
+		if(cached->x == x && cached->y == y && cached->vFlipped == vFlipped && cached->str == c){
+			stringMeshCache.splice(stringMeshCache.begin(), stringMeshCache, cached);
+			return cached->mesh;
+		}
+	}
+
+	// reuse the least recently used entry when the cache is full so its
+	// mesh keeps the memory it already allocated
+	if(stringMeshCache.size() >= stringMeshCacheSize){
+		auto last = std::prev(stringMeshCache.end());
+		removeFromStringMeshIndex(last);
+		stringMeshCache.splice(stringMeshCache.begin(), stringMeshCache, last);
+		stringMeshCache.front().mesh.clear();
+	}else{
+		stringMeshCache.emplace_front();
+		stringMeshCache.front().mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	}
+
+	auto & cached = stringMeshCache.front();
+	cached.str = c;
+	cached.x = x;
+	cached.y = y;
+	cached.vFlipped = vFlipped;
+	cached.hash = hash;
+	glm::vec2 pos(x,y);
+	uint32_t prevC = 0;
+	appendStringMesh(cached.mesh, c, x, vFlipped, pos, prevC);
+	stringMeshCacheIndex.emplace(hash, stringMeshCache.begin());
+	return cached.mesh;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::removeFromStringMeshIndex(std::list<cachedStringMesh>::iterator cached) const{
+	auto range = stringMeshCacheIndex.equal_range(cached->hash);
+	for(auto it = range.first; it != range.second; ++it){
+		if(it->second == cached){
+			stringMeshCacheIndex.erase(it);
+			return;
+		}
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setStringMeshCacheSize(std::size_t size){
+	stringMeshCacheSize = size;
+	while(stringMeshCache.size() > stringMeshCacheSize){
+		auto last = std::prev(stringMeshCache.end());
+		removeFromStringMeshIndex(last);
+		stringMeshCache.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+std::size_t ofTrueTypeFont::getStringMeshCacheSize() const{
+	return stringMeshCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearStringMeshCache(){
+	stringMeshCache.clear();
+	stringMeshCacheIndex.clear();
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::layoutChanged(){
+	clearStringMeshCache();
+	layoutVersion++;
 }
 
 //-----------------------------------------------------------
@@ -1402,3 +1518,136 @@ void ofTrueTypeFont::drawStringAsShapes(const std::string& str, float x, float y
 std::size_t ofTrueTypeFont::getNumCharacters() const{
 	return cps.size();
 }
+
+//-----------------------------------------------------------
+ofTextLayout::ofTextLayout()
+:font(nullptr)
+,position(0,0)
+,vFlipped(true)
+,pen(0,0)
+,prevC(0)
+,dirty(true)
+,fontLayoutVersion(0){
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
+//-----------------------------------------------------------
+ofTextLayout::ofTextLayout(const ofTrueTypeFont & font, const std::string & text, float x, float y, bool vFlipped)
+:font(&font)
+,text(text)
+,position(x,y)
+,vFlipped(vFlipped)
+,pen(x,y)
+,prevC(0)
+,dirty(true)
+,fontLayoutVersion(font.layoutVersion){
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setFont(const ofTrueTypeFont & font){
+	this->font = &font;
+	dirty = true;
+}
+
+//-----------------------------------------------------------
+const ofTrueTypeFont * ofTextLayout::getFont() const{
+	return font;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setText(const std::string & text){
+	if(this->text != text){
+		this->text = text;
+		dirty = true;
+	}
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::appendText(const std::string & text){
+	this->text += text;
+	if(!dirty && font && font->layoutVersion == fontLayoutVersion){
+		font->appendStringMesh(mesh, text, position.x, vFlipped, pen, prevC);
+	}else{
+		dirty = true;
+	}
+}
+
+//-----------------------------------------------------------
+const std::string & ofTextLayout::getText() const{
+	return text;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setPosition(float x, float y){
+	if(position.x != x || position.y != y){
+		position = {x, y};
+		dirty = true;
+	}
+}
+
+//-----------------------------------------------------------
+glm::vec2 ofTextLayout::getPosition() const{
+	return position;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setVFlipped(bool vFlipped){
+	if(this->vFlipped != vFlipped){
+		this->vFlipped = vFlipped;
+		dirty = true;
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTextLayout::isVFlipped() const{
+	return vFlipped;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::update() const{
+	if(!font){
+		mesh.clear();
+		return;
+	}
+	if(dirty || font->layoutVersion != fontLayoutVersion){
+		mesh.clear();
+		pen = position;
+		prevC = 0;
+		font->appendStringMesh(mesh, text, position.x, vFlipped, pen, prevC);
+		fontLayoutVersion = font->layoutVersion;
+		dirty = false;
+	}
+}
+
+//-----------------------------------------------------------
+const ofMesh & ofTextLayout::getMesh() const{
+	update();
+	return mesh;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::appendTo(ofMesh & dst) const{
+	update();
+	dst.append(mesh);
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::draw() const{
+	if(!font || !font->isLoaded()){
+		ofLogError("ofTextLayout") << "draw(): font not allocated";
+		return;
+	}
+	auto blendMode = ofGetStyle().blendingMode;
+	ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+	font->getFontTexture().bind();
+	getMesh().draw();
+	font->getFontTexture().unbind();
+	ofEnableBlendMode(blendMode);
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::clear(){
+	text.clear();
+	dirty = true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <list>
 #include "ofRectangle.h"
 #include "ofConstants.h"
 #include "ofPath.h"
@@ -112,6 +113,8 @@ public:
 	static const std::initializer_list<ofUnicode::range> Cyrillic;
 };
 
+class ofTextLayout;
+
 class ofTrueTypeFont{
 
 public:
@@ -348,6 +351,27 @@ public:
 	bool isValidGlyph(uint32_t) const;
 	/// \}
 
+	/// \name String Mesh Cache
+	/// \{
+
+	/// \brief Set how many string meshes getStringMesh() and drawString() keep around.
+	///
+	/// Strings that are drawn again with the same position and orientation
+	/// reuse their cached glyph quads instead of being laid out every frame.
+	/// The least recently used mesh is dropped when the cache is full. Any
+	/// change to the font's spacing, direction or line height clears it.
+	///
+	/// \param size Maximum number of cached meshes, 0 disables the cache.
+	void setStringMeshCacheSize(std::size_t size);
+
+	/// \returns the maximum number of string meshes kept in the cache.
+	std::size_t getStringMeshCacheSize() const;
+
+	/// \brief Drop every cached string mesh.
+	void clearStringMeshCache();
+
+	/// \}
+
 	void setDirection(Settings::Direction direction);
 protected:
 	/// \cond INTERNAL
@@ -393,16 +417,33 @@ protected:
 
     int getKerning(uint32_t c, uint32_t prevC) const;
 	void drawChar(uint32_t c, float x, float y, bool vFlipped) const;
+	void drawChar(uint32_t c, float x, float y, bool vFlipped, ofMesh & mesh) const;
 	void drawCharAsShape(uint32_t c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(const std::string & s, float x, float y, bool vFlipped) const;
 	glyph loadGlyph(uint32_t utf8) const;
 	const glyphProps & getGlyphProperties(uint32_t glyph) const;
 	void iterateString(const std::string & str, float x, float y, bool vFlipped, std::function<void(uint32_t, glm::vec2)> f) const;
+	void iterateString(const std::string & str, float lineStartX, bool vFlipped, glm::vec2 & pos, uint32_t & prevC, std::function<void(uint32_t, glm::vec2)> f) const;
+	void appendStringMesh(ofMesh & mesh, const std::string & s, float lineStartX, bool vFlipped, glm::vec2 & pen, uint32_t & prevC) const;
 	size_t indexForGlyph(uint32_t glyph) const;
+	void layoutChanged();
 
 	ofTexture texAtlas;
 	mutable ofMesh stringQuads;
 
+	struct cachedStringMesh{
+		std::string str;
+		float x, y;
+		bool vFlipped;
+		std::size_t hash;
+		ofMesh mesh;
+	};
+	mutable std::list<cachedStringMesh> stringMeshCache;
+	mutable std::unordered_multimap<std::size_t, std::list<cachedStringMesh>::iterator> stringMeshCacheIndex;
+	std::size_t stringMeshCacheSize;
+	std::size_t layoutVersion;
+	void removeFromStringMeshIndex(std::list<cachedStringMesh>::iterator cached) const;
+
 	/// \endcond
 
 private:
@@ -418,5 +459,77 @@ private:
 	static void finishLibraries();
 
 	friend void ofExitCallback();
+	friend class ofTextLayout;
+
+};
 
+/// \brief A string laid out with an ofTrueTypeFont whose glyph quads are kept between frames.
+///
+/// ofTrueTypeFont::drawString() walks the string and builds its mesh on
+/// every call. An ofTextLayout only does that when its text, position or
+/// font settings change, and appendText() lays out just the new characters.
+/// Layouts that share a font can be appended into one mesh with appendTo()
+/// and drawn with a single draw call while the font texture is bound:
+///
+/// ~~~~{.cpp}
+/// ofMesh labels;
+/// for(auto & layout: layouts){
+///     layout.appendTo(labels);
+/// }
+/// font.getFontTexture().bind();
+/// labels.draw();
+/// font.getFontTexture().unbind();
+/// ~~~~
+///
+/// The font has to outlive every layout that uses it.
+class ofTextLayout{
+public:
+	ofTextLayout();
+	ofTextLayout(const ofTrueTypeFont & font, const std::string & text, float x=0, float y=0, bool vFlipped=true);
+
+	void setFont(const ofTrueTypeFont & font);
+	const ofTrueTypeFont * getFont() const;
+
+	/// \brief Replace the text, the mesh is rebuilt the next time it's needed.
+	void setText(const std::string & text);
+
+	/// \brief Add text to the end of the layout.
+	///
+	/// If the mesh is up to date only the appended characters are laid out.
+	void appendText(const std::string & text);
+	const std::string & getText() const;
+
+	void setPosition(float x, float y);
+	glm::vec2 getPosition() const;
+
+	/// \brief Lay out the text for a vertically flipped (y down) coordinate system.
+	///
+	/// Defaults to true which matches ofTrueTypeFont::getStringMesh().
+	void setVFlipped(bool vFlipped);
+	bool isVFlipped() const;
+
+	/// \returns the glyph quads for the current text, laying them out again only if something changed.
+	const ofMesh & getMesh() const;
+
+	/// \brief Append this layout's quads to mesh so several layouts can be drawn at once.
+	void appendTo(ofMesh & mesh) const;
+
+	/// \brief Draw the layout binding its font texture.
+	void draw() const;
+
+	void clear();
+
+private:
+	void update() const;
+
+	const ofTrueTypeFont * font;
+	std::string text;
+	glm::vec2 position;
+	bool vFlipped;
+
+	mutable ofMesh mesh;
+	mutable glm::vec2 pen;
+	mutable uint32_t prevC;
+	mutable bool dirty;
+	mutable std::size_t fontLayoutVersion;
 };
@@ -0,0 +1,470 @@
+#include "ofBatchNoise.h"
+#include "ofNoise.h"
+#include "ofPixels.h"
+#include "ofTaskPool.h"
+#include "ofLog.h"
+#include <algorithm>
+
+#if defined(OF_USE_SSE)
+	#include <emmintrin.h>
+#elif defined(OF_USE_NEON)
+	#include <arm_neon.h>
+#endif
+
+// The kernels are the same simplex noise as _slang_library_noise2/3 in
+// ofNoise.h written for 4 samples at a time. The permutation table lookups
+// are still done one lane at a time since neither SSE2 nor NEON can gather.
+
+namespace{
+#if defined(OF_USE_SSE)
+	typedef __m128 Float4;
+	typedef __m128i Int4;
+	typedef __m128i Mask4;
+
+	inline Float4 set(float f){ return _mm_set1_ps(f); }
+	inline Float4 load(const float * p){ return _mm_loadu_ps(p); }
+	inline void store(float * p, Float4 v){ _mm_storeu_ps(p, v); }
+	inline Float4 add(Float4 a, Float4 b){ return _mm_add_ps(a, b); }
+	inline Float4 sub(Float4 a, Float4 b){ return _mm_sub_ps(a, b); }
+	inline Float4 mul(Float4 a, Float4 b){ return _mm_mul_ps(a, b); }
+	inline Mask4 greater(Float4 a, Float4 b){ return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+	inline Mask4 greaterEqual(Float4 a, Float4 b){ return _mm_castps_si128(_mm_cmpge_ps(a, b)); }
+	inline Float4 select(Mask4 m, Float4 a, Float4 b){
+		auto mf = _mm_castsi128_ps(m);
+		return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+	}
+	inline Float4 negateIf(Mask4 m, Float4 v){
+		return _mm_xor_ps(v, _mm_castsi128_ps(_mm_and_si128(m, _mm_set1_epi32(0x80000000))));
+	}
+	inline Int4 seti(int i){ return _mm_set1_epi32(i); }
+	inline Int4 loadi(const int32_t * p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	inline void storei(int32_t * p, Int4 v){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	inline Int4 addi(Int4 a, Int4 b){ return _mm_add_epi32(a, b); }
+	inline Int4 andi(Int4 a, Int4 b){ return _mm_and_si128(a, b); }
+	inline Mask4 equali(Int4 a, Int4 b){ return _mm_cmpeq_epi32(a, b); }
+	inline Mask4 lessi(Int4 a, Int4 b){ return _mm_cmplt_epi32(a, b); }
+	inline Mask4 maskAnd(Mask4 a, Mask4 b){ return _mm_and_si128(a, b); }
+	inline Mask4 maskOr(Mask4 a, Mask4 b){ return _mm_or_si128(a, b); }
+	inline Mask4 maskNot(Mask4 m){ return _mm_xor_si128(m, _mm_set1_epi32(-1)); }
+	inline Int4 maskToInt(Mask4 m){ return m; }
+	inline Float4 toFloat(Int4 i){ return _mm_cvtepi32_ps(i); }
+	inline Int4 truncate(Float4 v){ return _mm_cvttps_epi32(v); }
+#elif defined(OF_USE_NEON)
+	typedef float32x4_t Float4;
+	typedef int32x4_t Int4;
+	typedef uint32x4_t Mask4;
+
+	inline Float4 set(float f){ return vdupq_n_f32(f); }
+	inline Float4 load(const float * p){ return vld1q_f32(p); }
+	inline void store(float * p, Float4 v){ vst1q_f32(p, v); }
+	inline Float4 add(Float4 a, Float4 b){ return vaddq_f32(a, b); }
+	inline Float4 sub(Float4 a, Float4 b){ return vsubq_f32(a, b); }
+	inline Float4 mul(Float4 a, Float4 b){ return vmulq_f32(a, b); }
+	inline Mask4 greater(Float4 a, Float4 b){ return vcgtq_f32(a, b); }
+	inline Mask4 greaterEqual(Float4 a, Float4 b){ return vcgeq_f32(a, b); }
+	inline Float4 select(Mask4 m, Float4 a, Float4 b){ return vbslq_f32(m, a, b); }
+	inline Float4 negateIf(Mask4 m, Float4 v){
+		return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vandq_u32(m, vdupq_n_u32(0x80000000))));
+	}
+	inline Int4 seti(int i){ return vdupq_n_s32(i); }
+	inline Int4 loadi(const int32_t * p){ return vld1q_s32(p); }
+	inline void storei(int32_t * p, Int4 v){ vst1q_s32(p, v); }
+	inline Int4 addi(Int4 a, Int4 b){ return vaddq_s32(a, b); }
+	inline Int4 andi(Int4 a, Int4 b){ return vandq_s32(a, b); }
+	inline Mask4 equali(Int4 a, Int4 b){ return vceqq_s32(a, b); }
+	inline Mask4 lessi(Int4 a, Int4 b){ return vcltq_s32(a, b); }
+	inline Mask4 maskAnd(Mask4 a, Mask4 b){ return vandq_u32(a, b); }
+	inline Mask4 maskOr(Mask4 a, Mask4 b){ return vorrq_u32(a, b); }
+	inline Mask4 maskNot(Mask4 m){ return vmvnq_u32(m); }
+	inline Int4 maskToInt(Mask4 m){ return vreinterpretq_s32_u32(m); }
+	inline Float4 toFloat(Int4 i){ return vcvtq_f32_s32(i); }
+	inline Int4 truncate(Float4 v){ return vcvtq_s32_f32(v); }
+#else
+	// plain 4 lane emulation so the same kernels work everywhere
+	struct Float4{ float v[4]; };
+	struct Int4{ int32_t v[4]; };
+	struct Mask4{ int32_t v[4]; };
+
+	template<typename R, typename A, typename F>
+	inline R lanes(const A & a, F f){
+		R r;
+		for(int l = 0; l < 4; l++){
+			r.v[l] = f(a.v[l]);
+		}
+		return r;
+	}
+
+	template<typename R, typename A, typename B, typename F>
+	inline R lanes(const A & a, const B & b, F f){
+		R r;
+		for(int l = 0; l < 4; l++){
+			r.v[l] = f(a.v[l], b.v[l]);
+		}
+		return r;
+	}
+
+	inline Float4 set(float f){ return {{f, f, f, f}}; }
+	inline Float4 load(const float * p){ return {{p[0], p[1], p[2], p[3]}}; }
+	inline void store(float * p, Float4 v){ std::copy(v.v, v.v + 4, p); }
+	inline Float4 add(Float4 a, Float4 b){ return lanes<Float4>(a, b, [](float x, float y){ return x + y; }); }
+	inline Float4 sub(Float4 a, Float4 b){ return lanes<Float4>(a, b, [](float x, float y){ return x - y; }); }
+	inline Float4 mul(Float4 a, Float4 b){ return lanes<Float4>(a, b, [](float x, float y){ return x * y; }); }
+	inline Mask4 greater(Float4 a, Float4 b){ return lanes<Mask4>(a, b, [](float x, float y){ return x > y ? -1 : 0; }); }
+	inline Mask4 greaterEqual(Float4 a, Float4 b){ return lanes<Mask4>(a, b, [](float x, float y){ return x >= y ? -1 : 0; }); }
+	inline Float4 select(Mask4 m, Float4 a, Float4 b){
+		Float4 r;
+		for(int l = 0; l < 4; l++){
+			r.v[l] = m.v[l] ? a.v[l] : b.v[l];
+		}
+		return r;
+	}
+	inline Float4 negateIf(Mask4 m, Float4 v){ return select(m, lanes<Float4>(v, [](float x){ return -x; }), v); }
+	inline Int4 seti(int i){ return {{i, i, i, i}}; }
+	inline Int4 loadi(const int32_t * p){ return {{p[0], p[1], p[2], p[3]}}; }
+	inline void storei(int32_t * p, Int4 v){ std::copy(v.v, v.v + 4, p); }
+	inline Int4 addi(Int4 a, Int4 b){ return lanes<Int4>(a, b, [](int32_t x, int32_t y){ return x + y; }); }
+	inline Int4 andi(Int4 a, Int4 b){ return lanes<Int4>(a, b, [](int32_t x, int32_t y){ return x & y; }); }
+	inline Mask4 equali(Int4 a, Int4 b){ return lanes<Mask4>(a, b, [](int32_t x, int32_t y){ return x == y ? -1 : 0; }); }
+	inline Mask4 lessi(Int4 a, Int4 b){ return lanes<Mask4>(a, b, [](int32_t x, int32_t y){ return x < y ? -1 : 0; }); }
+	inline Mask4 maskAnd(Mask4 a, Mask4 b){ return lanes<Mask4>(a, b, [](int32_t x, int32_t y){ return x & y; }); }
+	inline Mask4 maskOr(Mask4 a, Mask4 b){ return lanes<Mask4>(a, b, [](int32_t x, int32_t y){ return x | y; }); }
+	inline Mask4 maskNot(Mask4 m){ return lanes<Mask4>(m, [](int32_t x){ return ~x; }); }
+	inline Int4 maskToInt(Mask4 m){ return lanes<Int4>(m, [](int32_t x){ return x; }); }
+	inline Float4 toFloat(Int4 i){ return lanes<Float4>(i, [](int32_t x){ return float(x); }); }
+	inline Int4 truncate(Float4 v){ return lanes<Int4>(v, [](float x){ return int32_t(x); }); }
+#endif
+
+	// same as FASTFLOOR in ofNoise.h, including returning -1 for 0
+	inline Int4 fastFloor(Float4 v){
+		return addi(truncate(v), maskToInt(maskNot(greater(v, set(0.f)))));
+	}
+
+	inline Int4 zeroOrOne(Mask4 m){
+		return andi(maskToInt(m), seti(1));
+	}
+
+	inline Mask4 bitSet(Int4 h, int bit){
+		return maskNot(equali(andi(h, seti(bit)), seti(0)));
+	}
+
+	inline Float4 grad2(Int4 h, Float4 x, Float4 y){
+		auto low = lessi(h, seti(4));
+		auto u = select(low, x, y);
+		auto v = mul(set(2.f), select(low, y, x));
+		return add(negateIf(bitSet(h, 1), u), negateIf(bitSet(h, 2), v));
+	}
+
+	inline Float4 grad3(Int4 h, Float4 x, Float4 y, Float4 z){
+		auto u = select(lessi(h, seti(8)), x, y);
+		auto xz = select(maskOr(equali(h, seti(12)), equali(h, seti(14))), x, z);
+		auto v = select(lessi(h, seti(4)), y, xz);
+		return add(negateIf(bitSet(h, 1), u), negateIf(bitSet(h, 2), v));
+	}
+
+	// t^4 * gradient or 0 if the sample is outside the corner's radius
+	inline Float4 corner(Float4 t, Float4 gradient){
+		auto t2 = mul(t, t);
+		return select(greater(set(0.f), t), set(0.f), mul(mul(t2, t2), gradient));
+	}
+
+	const float skew2 = 0.366025403f;
+	const float unskew2 = 0.211324865f;
+	const float skew3 = 0.333333333f;
+	const float unskew3 = 0.166666667f;
+
+	Float4 simplex2(Float4 x, Float4 y){
+		auto s = mul(add(x, y), set(skew2));
+		auto i = fastFloor(add(x, s));
+		auto j = fastFloor(add(y, s));
+		auto t = mul(toFloat(addi(i, j)), set(unskew2));
+		auto x0 = sub(x, sub(toFloat(i), t));
+		auto y0 = sub(y, sub(toFloat(j), t));
+
+		auto lower = greater(x0, y0);
+		auto i1 = zeroOrOne(lower);
+		auto j1 = zeroOrOne(maskNot(lower));
+
+		auto x1 = add(sub(x0, toFloat(i1)), set(unskew2));
+		auto y1 = add(sub(y0, toFloat(j1)), set(unskew2));
+		auto x2 = add(sub(x0, set(1.f)), set(2.f * unskew2));
+		auto y2 = add(sub(y0, set(1.f)), set(2.f * unskew2));
+
+		int32_t is[4], js[4], i1s[4], j1s[4];
+		storei(is, andi(i, seti(255)));
+		storei(js, andi(j, seti(255)));
+		storei(i1s, i1);
+		storei(j1s, j1);
+		int32_t h0[4], h1[4], h2[4];
+		for(int l = 0; l < 4; l++){
+			auto ii = is[l];
+			auto jj = js[l];
+			h0[l] = perm[ii + perm[jj]] & 7;
+			h1[l] = perm[ii + i1s[l] + perm[jj + j1s[l]]] & 7;
+			h2[l] = perm[ii + 1 + perm[jj + 1]] & 7;
+		}
+
+		auto n0 = corner(sub(sub(set(0.5f), mul(x0, x0)), mul(y0, y0)), grad2(loadi(h0), x0, y0));
+		auto n1 = corner(sub(sub(set(0.5f), mul(x1, x1)), mul(y1, y1)), grad2(loadi(h1), x1, y1));
+		auto n2 = corner(sub(sub(set(0.5f), mul(x2, x2)), mul(y2, y2)), grad2(loadi(h2), x2, y2));
+		return mul(set(40.f), add(add(n0, n1), n2));
+	}
+
+	Float4 simplex3(Float4 x, Float4 y, Float4 z){
+		auto s = mul(add(add(x, y), z), set(skew3));
+		auto i = fastFloor(add(x, s));
+		auto j = fastFloor(add(y, s));
+		auto k = fastFloor(add(z, s));
+		auto t = mul(toFloat(addi(addi(i, j), k)), set(unskew3));
+		auto x0 = sub(x, sub(toFloat(i), t));
+		auto y0 = sub(y, sub(toFloat(j), t));
+		auto z0 = sub(z, sub(toFloat(k), t));
+
+		// branchless version of the simplex selection in _slang_library_noise3
+		auto xy = greaterEqual(x0, y0);
+		auto yz = greaterEqual(y0, z0);
+		auto xz = greaterEqual(x0, z0);
+		auto i1 = zeroOrOne(maskAnd(xy, maskOr(yz, xz)));
+		auto j1 = zeroOrOne(maskAnd(maskNot(xy), yz));
+		auto k1 = zeroOrOne(maskAnd(maskNot(yz), maskNot(maskAnd(xy, xz))));
+		auto i2 = zeroOrOne(maskOr(xy, maskAnd(yz, xz)));
+		auto j2 = zeroOrOne(maskOr(maskNot(xy), yz));
+		auto k2 = zeroOrOne(maskNot(maskAnd(yz, xz)));
+
+		auto x1 = add(sub(x0, toFloat(i1)), set(unskew3));
+		auto y1 = add(sub(y0, toFloat(j1)), set(unskew3));
+		auto z1 = add(sub(z0, toFloat(k1)), set(unskew3));
+		auto x2 = add(sub(x0, toFloat(i2)), set(2.f * unskew3));
+		auto y2 = add(sub(y0, toFloat(j2)), set(2.f * unskew3));
+		auto z2 = add(sub(z0, toFloat(k2)), set(2.f * unskew3));
+		auto x3 = add(sub(x0, set(1.f)), set(3.f * unskew3));
+		auto y3 = add(sub(y0, set(1.f)), set(3.f * unskew3));
+		auto z3 = add(sub(z0, set(1.f)), set(3.f * unskew3));
+
+		int32_t is[4], js[4], ks[4];
+		int32_t i1s[4], j1s[4], k1s[4], i2s[4], j2s[4], k2s[4];
+		storei(is, andi(i, seti(255)));
+		storei(js, andi(j, seti(255)));
+		storei(ks, andi(k, seti(255)));
+		storei(i1s, i1);
+		storei(j1s, j1);
+		storei(k1s, k1);
+		storei(i2s, i2);
+		storei(j2s, j2);
+		storei(k2s, k2);
+		int32_t h0[4], h1[4], h2[4], h3[4];
+		for(int l = 0; l < 4; l++){
+			auto ii = is[l];
+			auto jj = js[l];
+			auto kk = ks[l];
+			h0[l] = perm[ii + perm[jj + perm[kk]]] & 15;
+			h1[l] = perm[ii + i1s[l] + perm[jj + j1s[l] + perm[kk + k1s[l]]]] & 15;
+			h2[l] = perm[ii + i2s[l] + perm[jj + j2s[l] + perm[kk + k2s[l]]]] & 15;
+			h3[l] = perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]] & 15;
+		}
+
+		auto t0 = sub(sub(sub(set(0.6f), mul(x0, x0)), mul(y0, y0)), mul(z0, z0));
+		auto t1 = sub(sub(sub(set(0.6f), mul(x1, x1)), mul(y1, y1)), mul(z1, z1));
+		auto t2 = sub(sub(sub(set(0.6f), mul(x2, x2)), mul(y2, y2)), mul(z2, z2));
+		auto t3 = sub(sub(sub(set(0.6f), mul(x3, x3)), mul(y3, y3)), mul(z3, z3));
+		auto n0 = corner(t0, grad3(loadi(h0), x0, y0, z0));
+		auto n1 = corner(t1, grad3(loadi(h1), x1, y1, z1));
+		auto n2 = corner(t2, grad3(loadi(h2), x2, y2, z2));
+		auto n3 = corner(t3, grad3(loadi(h3), x3, y3, z3));
+		return mul(set(32.f), add(add(add(n0, n1), n2), n3));
+	}
+
+	// applies octaves and the output range to a noise function
+	template<typename Noise>
+	Float4 fractal(Noise noise, const ofNoiseSettings & settings){
+		Float4 value;
+		if(settings.octaves <= 1){
+			value = noise(1.f);
+		}else{
+			auto sum = set(0.f);
+			float frequency = 1.f;
+			float amplitude = 1.f;
+			float total = 0.f;
+			for(int o = 0; o < settings.octaves; o++){
+				sum = add(sum, mul(noise(frequency), set(amplitude)));
+				total += amplitude;
+				frequency *= settings.lacunarity;
+				amplitude *= settings.gain;
+			}
+			value = mul(sum, set(1.f / total));
+		}
+		if(settings.signedNoise){
+			return value;
+		}else{
+			return add(mul(value, set(0.5f)), set(0.5f));
+		}
+	}
+
+	Float4 sample2(Float4 x, Float4 y, const ofNoiseSettings & settings){
+		return fractal([&](float frequency){
+			if(frequency == 1.f){
+				return simplex2(x, y);
+			}
+			return simplex2(mul(x, set(frequency)), mul(y, set(frequency)));
+		}, settings);
+	}
+
+	Float4 sample3(Float4 x, Float4 y, Float4 z, const ofNoiseSettings & settings){
+		return fractal([&](float frequency){
+			if(frequency == 1.f){
+				return simplex3(x, y, z);
+			}
+			auto f = set(frequency);
+			return simplex3(mul(x, f), mul(y, f), mul(z, f));
+		}, settings);
+	}
+
+	// stores only the first count lanes
+	inline void storePartial(float * out, Float4 v, std::size_t count){
+		float values[4];
+		store(values, v);
+		std::copy(values, values + count, out);
+	}
+
+	// samples per task when running in parallel
+	const std::size_t grainSize = 4096;
+
+	template<typename F>
+	void run(std::size_t count, std::size_t samplesPerItem, const ofNoiseSettings & settings, F f){
+		auto work = count * samplesPerItem * std::max(settings.octaves, 1);
+		if(settings.parallel && work >= grainSize * 4){
+			ofParallelForRange(0, count, f, std::max(grainSize / samplesPerItem, std::size_t(1)));
+		}else{
+			f(0, count);
+		}
+	}
+
+	template<int Dimensions, typename Vec, typename Sample>
+	void noisePoints(const Vec * points, float * out, std::size_t count, const ofNoiseSettings & settings, Sample sample){
+		// blocks of 4 points so every task starts at a multiple of 4
+		run((count + 3) / 4, 4, settings, [&](std::size_t blockBegin, std::size_t blockEnd){
+			auto end = std::min(blockEnd * 4, count);
+			for(auto i = blockBegin * 4; i < end; i += 4){
+				auto n = std::min(end - i, std::size_t(4));
+				float coords[Dimensions][4];
+				for(std::size_t l = 0; l < 4; l++){
+					auto & p = points[i + std::min(l, n - 1)];
+					for(int c = 0; c < Dimensions; c++){
+						coords[c][l] = p[c];
+					}
+				}
+				auto value = sample(coords);
+				if(n == 4){
+					store(out + i, value);
+				}else{
+					storePartial(out + i, value, n);
+				}
+			}
+		});
+	}
+
+	// rows of a grid, row r is at y = r % height and z = r / height, every
+	// value is written to the channels consecutive floats of its pixel
+	void noiseGrid(float * out, std::size_t channels, std::size_t width, std::size_t height, std::size_t depth, const glm::vec3 & origin, const glm::vec3 & step, bool is3D, const ofNoiseSettings & settings){
+		run(height * depth, width, settings, [&](std::size_t rowBegin, std::size_t rowEnd){
+			const int32_t laneIndices[4] = {0, 1, 2, 3};
+			auto lanes = toFloat(loadi(laneIndices));
+			float values[4];
+			for(auto r = rowBegin; r < rowEnd; r++){
+				auto y = set(origin.y + float(r % height) * step.y);
+				auto z = set(origin.z + float(r / height) * step.z);
+				auto row = out + r * width * channels;
+				for(std::size_t i = 0; i < width; i += 4){
+					auto x = add(set(origin.x), mul(add(set(float(i)), lanes), set(step.x)));
+					auto value = is3D ? sample3(x, y, z, settings) : sample2(x, y, settings);
+					auto n = std::min(width - i, std::size_t(4));
+					if(channels == 1 && n == 4){
+						store(row + i, value);
+					}else{
+						store(values, value);
+						for(std::size_t l = 0; l < n; l++){
+							std::fill(row + (i + l) * channels, row + (i + l + 1) * channels, values[l]);
+						}
+					}
+				}
+			}
+		});
+	}
+}
+
+//--------------------------------------------------------------
+void ofNoise(const glm::vec2 * points, float * out, std::size_t count, const ofNoiseSettings & settings){
+	noisePoints<2>(points, out, count, settings, [&](float (&coords)[2][4]){
+		return sample2(load(coords[0]), load(coords[1]), settings);
+	});
+}
+
+//--------------------------------------------------------------
+void ofNoise(const std::vector<glm::vec2> & points, std::vector<float> & out, const ofNoiseSettings & settings){
+	out.resize(points.size());
+	ofNoise(points.data(), out.data(), points.size(), settings);
+}
+
+//--------------------------------------------------------------
+void ofNoise(const glm::vec3 * points, float * out, std::size_t count, const ofNoiseSettings & settings){
+	noisePoints<3>(points, out, count, settings, [&](float (&coords)[3][4]){
+		return sample3(load(coords[0]), load(coords[1]), load(coords[2]), settings);
+	});
+}
+
+//--------------------------------------------------------------
+void ofNoise(const std::vector<glm::vec3> & points, std::vector<float> & out, const ofNoiseSettings & settings){
+	out.resize(points.size());
+	ofNoise(points.data(), out.data(), points.size(), settings);
+}
+
+//--------------------------------------------------------------
+void ofSignedNoise(const glm::vec2 * points, float * out, std::size_t count, ofNoiseSettings settings){
+	settings.signedNoise = true;
+	ofNoise(points, out, count, settings);
+}
+
+//--------------------------------------------------------------
+void ofSignedNoise(const std::vector<glm::vec2> & points, std::vector<float> & out, ofNoiseSettings settings){
+	settings.signedNoise = true;
+	ofNoise(points, out, settings);
+}
+
+//--------------------------------------------------------------
+void ofSignedNoise(const glm::vec3 * points, float * out, std::size_t count, ofNoiseSettings settings){
+	settings.signedNoise = true;
+	ofNoise(points, out, count, settings);
+}
+
+//--------------------------------------------------------------
+void ofSignedNoise(const std::vector<glm::vec3> & points, std::vector<float> & out, ofNoiseSettings settings){
+	settings.signedNoise = true;
+	ofNoise(points, out, settings);
+}
+
+//--------------------------------------------------------------
+void ofNoiseGrid2D(float * out, std::size_t width, std::size_t height, const glm::vec2 & origin, const glm::vec2 & step, const ofNoiseSettings & settings){
+	noiseGrid(out, 1, width, height, 1, glm::vec3(origin, 0.f), glm::vec3(step, 0.f), false, settings);
+}
+
+//--------------------------------------------------------------
+void ofNoiseGrid2D(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step, const ofNoiseSettings & settings){
+	if(!pixels.isAllocated()){
+		ofLogError("ofNoiseGrid2D") << "pixels need to be allocated";
+		return;
+	}
+	noiseGrid(pixels.getData(), pixels.getNumChannels(), pixels.getWidth(), pixels.getHeight(), 1, glm::vec3(origin, 0.f), glm::vec3(step, 0.f), false, settings);
+}
+
+//--------------------------------------------------------------
+void ofNoiseGrid3D(float * out, std::size_t width, std::size_t height, std::size_t depth, const glm::vec3 & origin, const glm::vec3 & step, const ofNoiseSettings & settings){
+	noiseGrid(out, 1, width, height, depth, origin, step, true, settings);
+}
+
+//--------------------------------------------------------------
+void ofNoiseGrid3D(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step, const ofNoiseSettings & settings){
+	if(!pixels.isAllocated()){
+		ofLogError("ofNoiseGrid3D") << "pixels need to be allocated";
+		return;
+	}
+	noiseGrid(pixels.getData(), pixels.getNumChannels(), pixels.getWidth(), pixels.getHeight(), 1, origin, glm::vec3(step, 0.f), true, settings);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofConstants.h"
+
+template<typename T>
+class ofPixels_;
+typedef ofPixels_<float> ofFloatPixels;
+
+/// \file
+/// Batch versions of ofNoise and ofSignedNoise.
+///
+/// Filling a noise texture or displacing every vertex of a mesh with
+/// ofNoise goes through the whole simplex noise algorithm one sample at a
+/// time. These functions evaluate 4 samples at once using SSE or NEON when
+/// available (see OF_USE_SSE / OF_USE_NEON in ofConstants.h) and split big
+/// batches across the threads of ofGetTaskPool(). The results are the
+/// same as calling ofNoise or ofSignedNoise for every sample.
+
+/// \brief Options for the batch noise functions.
+struct ofNoiseSettings{
+	/// Number of layers of noise added together (fractal brownian motion).
+	/// Every octave has lacunarity times the frequency and gain times the
+	/// amplitude of the previous one. The sum is normalized so the range
+	/// of the result doesn't change.
+	int octaves = 1;
+	float lacunarity = 2.f;
+	float gain = 0.5f;
+
+	/// Results in [-1, 1] like ofSignedNoise instead of [0, 1] like ofNoise.
+	bool signedNoise = false;
+
+	/// Split big batches across the threads of ofGetTaskPool().
+	bool parallel = true;
+};
+
+/// \brief Noise at count 2D points.
+void ofNoise(const glm::vec2 * points, float * out, std::size_t count, const ofNoiseSettings & settings = ofNoiseSettings());
+void ofNoise(const std::vector<glm::vec2> & points, std::vector<float> & out, const ofNoiseSettings & settings = ofNoiseSettings());
+
+/// \brief Noise at count 3D points.
+///
+/// ~~~~{.cpp}
+/// std::vector<float> displacement;
+/// ofNoise(mesh.getVertices(), displacement);
+/// ~~~~
+void ofNoise(const glm::vec3 * points, float * out, std::size_t count, const ofNoiseSettings & settings = ofNoiseSettings());
+void ofNoise(const std::vector<glm::vec3> & points, std::vector<float> & out, const ofNoiseSettings & settings = ofNoiseSettings());
+
+/// \brief Same as ofNoise with settings.signedNoise = true.
+void ofSignedNoise(const glm::vec2 * points, float * out, std::size_t count, ofNoiseSettings settings = ofNoiseSettings());
+void ofSignedNoise(const std::vector<glm::vec2> & points, std::vector<float> & out, ofNoiseSettings settings = ofNoiseSettings());
+void ofSignedNoise(const glm::vec3 * points, float * out, std::size_t count, ofNoiseSettings settings = ofNoiseSettings());
+void ofSignedNoise(const std::vector<glm::vec3> & points, std::vector<float> & out, ofNoiseSettings settings = ofNoiseSettings());
+
+/// \brief 2D noise over a width x height grid.
+///
+/// out[y * width + x] is the noise at origin + vec2(x, y) * step.
+void ofNoiseGrid2D(float * out, std::size_t width, std::size_t height, const glm::vec2 & origin, const glm::vec2 & step, const ofNoiseSettings & settings = ofNoiseSettings());
+
+/// \brief 2D noise over a grid the size of pixels, every channel gets the
+/// same value. pixels have to be allocated.
+///
+/// ~~~~{.cpp}
+/// ofFloatPixels pixels;
+/// pixels.allocate(1024, 1024, OF_PIXELS_GRAY);
+/// ofNoiseGrid2D(pixels, {0, 0}, {0.01, 0.01});
+/// texture.loadData(pixels);
+/// ~~~~
+void ofNoiseGrid2D(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step, const ofNoiseSettings & settings = ofNoiseSettings());
+
+/// \brief 3D noise over a width x height x depth volume.
+///
+/// out[(z * height + y) * width + x] is the noise at
+/// origin + vec3(x, y, z) * step.
+void ofNoiseGrid3D(float * out, std::size_t width, std::size_t height, std::size_t depth, const glm::vec3 & origin, const glm::vec3 & step, const ofNoiseSettings & settings = ofNoiseSettings());
+
+/// \brief Slice of 3D noise at origin.z over a grid the size of pixels,
+/// every channel gets the same value. pixels have to be allocated.
+///
+/// Moving origin.z over time animates the noise smoothly.
+void ofNoiseGrid3D(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step, const ofNoiseSettings & settings = ofNoiseSettings());
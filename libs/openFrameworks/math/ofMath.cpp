@@ -2,10 +2,6 @@
 #include "ofUtils.h"
 #include "float.h"
 
-#ifndef TARGET_WIN32
-	#include <sys/time.h>
-#endif
-
 #include "ofNoise.h"
 #include "ofPolyline.h"
 
@@ -19,55 +15,6 @@ int ofNextPow2(int a){
 	return rval;
 }
 
-//--------------------------------------------------
-void ofSeedRandom() {
-
-	// good info here:
-	// http://stackoverflow.com/questions/322938/recommended-way-to-initialize-srand
-
-	#ifdef TARGET_WIN32
-		srand(GetTickCount());
-	#elif !defined(TARGET_EMSCRIPTEN)
-		// use XOR'd second, microsecond precision AND pid as seed
-		struct timeval tv;
-		gettimeofday(&tv, 0);
-		long int n = (tv.tv_sec ^ tv.tv_usec) ^ getpid();
-		srand(n);
-	#else
-		struct timeval tv;
-		gettimeofday(&tv, 0);
-		long int n = (tv.tv_sec ^ tv.tv_usec);
-		srand(n);
-	#endif
-}
-
-//--------------------------------------------------
-void ofSeedRandom(int val) {
-	srand((long) val);
-}
-
-//--------------------------------------------------
-float ofRandom(float max) {
-	return (max * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
-}
-
-//--------------------------------------------------
-float ofRandom(float x, float y) {
-	float high = MAX(x, y);
-	float low = MIN(x, y);
-	return max(low, (low + ((high - low) * rand() / float(RAND_MAX))) * (1.0f - std::numeric_limits<float>::epsilon()));
-}
-
-//--------------------------------------------------
-float ofRandomf() {
-	return -1.0f + (2.0f * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
-}
-
-//--------------------------------------------------
-float ofRandomuf() {
-	return (rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
-}
-
 //---- new to 006
 //from the forums http://www.openframeworks.cc/forum/viewtopic.php?t=1413
 
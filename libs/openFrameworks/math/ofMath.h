@@ -1,15 +1,13 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofRandomEngine.h"
 
 /// \file
 /// ofMath provides a collection of mathematical utilities and functions.
 ///
-/// \warning Many ofRandom-style functions wrap `rand()` which is not reentrant
-/// or thread safe.  To generate random numbers simultaneously in multiple
-/// threads, consider using c++11 uniform_real_distribution.
-///
-/// \sa http://en.cppreference.com/w/cpp/numeric/random/uniform_real_distribution
+/// The ofRandom-style functions use a random engine per thread so they can
+/// be called from several threads at the same time, see ofRandomEngine.h.
 
 /// \name Random Numbers
 /// \{
@@ -24,8 +22,6 @@
 /// float randomNumber = ofRandom(20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps C++'s `rand()` which is not reentrant or thread safe.
-///
 /// \param max The maximum value of the random number.
 float ofRandom(float max); 
 
@@ -39,8 +35,6 @@ float ofRandom(float max);
 /// float randomNumber = ofRandom(-30, 20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \param val0 the minimum value of the random number.
 /// \param val1 The maximum value of the random number.
 /// \returns A random floating point number between val0 and val1.
@@ -48,15 +42,11 @@ float ofRandom(float val0, float val1);
 
 /// \brief Get a random floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between -1 and 1.
 float ofRandomf();
 
 /// \brief Get a random unsigned floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between 0 and 1.
 float ofRandomuf();
 
@@ -65,8 +55,6 @@ float ofRandomuf();
 ///
 /// A random number in the range [0, ofGetWidth()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetWidth().
 float ofRandomWidth();
 
@@ -74,8 +62,6 @@ float ofRandomWidth();
 ///
 /// A random number in the range [0, ofGetHeight()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetHeight().
 float ofRandomHeight();
 
@@ -89,7 +75,8 @@ void ofSeedRandom();
 ///
 /// If the user would like to repeat the same random sequence, a known random
 /// seed can be used to initialize the random number generator during app
-/// setup.  This can be useful for debugging and testing.
+/// setup.  This can be useful for debugging and testing. Other threads get
+/// their own sequences, see ofGetRandomEngine().
 ///
 /// \param val The value with which to seed the generator.
 void ofSeedRandom(int val);
@@ -7,6 +7,12 @@
 #include <stdlib.h>
 #include "ofConstants.h"
 
+#if defined(OF_USE_SSE)
+	#include <xmmintrin.h>
+#elif defined(OF_USE_NEON)
+	#include <arm_neon.h>
+#endif
+
 using namespace std;
 
 #if (_MSC_VER)
@@ -19,6 +25,246 @@ inline bool equivalent(double lhs,double rhs,double epsilon=1e-6)
 template<typename T>
 inline T square(T v) { return v*v; }
 
+namespace{
+#if defined(OF_USE_SSE)
+	typedef __m128 float4;
+
+	inline float4 load(const ofVec4f & v){
+		return _mm_loadu_ps(&v.x);
+	}
+
+	inline void store(float4 v, ofVec4f & dst){
+		_mm_storeu_ps(&dst.x, v);
+	}
+
+	// writes only x, y, z so dst can be an element in the middle of an array
+	inline void store3(float4 v, ofVec3f & dst){
+		_mm_storel_pi(reinterpret_cast<__m64*>(&dst.x), v);
+		_mm_store_ss(&dst.z, _mm_movehl_ps(v, v));
+	}
+
+	inline float4 splat(float f){
+		return _mm_set1_ps(f);
+	}
+
+	inline float4 add(float4 a, float4 b){
+		return _mm_add_ps(a, b);
+	}
+
+	inline float4 sub(float4 a, float4 b){
+		return _mm_sub_ps(a, b);
+	}
+
+	inline float4 mul(float4 a, float4 b){
+		return _mm_mul_ps(a, b);
+	}
+
+	// x y z w -> y x w z
+	inline float4 swapPairs(float4 v){
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2,3,0,1));
+	}
+
+	// x y z w -> z w x y
+	inline float4 swapHalves(float4 v){
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1,0,3,2));
+	}
+
+	inline float getX(float4 v){
+		return _mm_cvtss_f32(v);
+	}
+
+	inline float getW(float4 v){
+		return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)));
+	}
+
+	inline void transpose(float4 & r0, float4 & r1, float4 & r2, float4 & r3){
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	}
+#elif defined(OF_USE_NEON)
+	typedef float32x4_t float4;
+
+	inline float4 load(const ofVec4f & v){
+		return vld1q_f32(&v.x);
+	}
+
+	inline void store(float4 v, ofVec4f & dst){
+		vst1q_f32(&dst.x, v);
+	}
+
+	// writes only x, y, z so dst can be an element in the middle of an array
+	inline void store3(float4 v, ofVec3f & dst){
+		vst1_f32(&dst.x, vget_low_f32(v));
+		dst.z = vgetq_lane_f32(v, 2);
+	}
+
+	inline float4 splat(float f){
+		return vdupq_n_f32(f);
+	}
+
+	inline float4 add(float4 a, float4 b){
+		return vaddq_f32(a, b);
+	}
+
+	inline float4 sub(float4 a, float4 b){
+		return vsubq_f32(a, b);
+	}
+
+	inline float4 mul(float4 a, float4 b){
+		return vmulq_f32(a, b);
+	}
+
+	// x y z w -> y x w z
+	inline float4 swapPairs(float4 v){
+		return vrev64q_f32(v);
+	}
+
+	// x y z w -> z w x y
+	inline float4 swapHalves(float4 v){
+		return vextq_f32(v, v, 2);
+	}
+
+	inline float getX(float4 v){
+		return vgetq_lane_f32(v, 0);
+	}
+
+	inline float getW(float4 v){
+		return vgetq_lane_f32(v, 3);
+	}
+
+	inline void transpose(float4 & r0, float4 & r1, float4 & r2, float4 & r3){
+		auto t01 = vtrnq_f32(r0, r1);
+		auto t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+#endif
+
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	struct Rows{
+		float4 r0, r1, r2, r3;
+	};
+
+	inline Rows rows(const ofMatrix4x4 & m){
+		return {load(m._mat[0]), load(m._mat[1]), load(m._mat[2]), load(m._mat[3])};
+	}
+
+	inline Rows columns(const ofMatrix4x4 & m){
+		auto c = rows(m);
+		transpose(c.r0, c.r1, c.r2, c.r3);
+		return c;
+	}
+
+	// x * m.r0 + y * m.r1 + z * m.r2 + w * m.r3, added in the same order
+	// as the scalar code so the results are the same
+	inline float4 combine(const Rows & m, float x, float y, float z, float w){
+		return add(add(add(mul(splat(x), m.r0), mul(splat(y), m.r1)), mul(splat(z), m.r2)), mul(splat(w), m.r3));
+	}
+
+	// x * m.r0 + y * m.r1 + z * m.r2 + m.r3
+	inline float4 combinePoint(const Rows & m, const ofVec3f & v){
+		return add(add(add(mul(splat(v.x), m.r0), mul(splat(v.y), m.r1)), mul(splat(v.z), m.r2)), m.r3);
+	}
+
+	// x * m.r0 + y * m.r1 + z * m.r2
+	inline float4 combineDirection(const Rows & m, const ofVec3f & v){
+		return add(add(mul(splat(v.x), m.r0), mul(splat(v.y), m.r1)), mul(splat(v.z), m.r2));
+	}
+
+	inline float4 divideByW(float4 v){
+		return mul(v, splat(1.0f / getW(v)));
+	}
+
+	// out = a * b. All of b and every row of a are read before the same
+	// row of out is written so out can be a or b
+	inline void multiply(const ofMatrix4x4 & a, const ofMatrix4x4 & b, ofMatrix4x4 & out){
+		auto m = rows(b);
+		for(int row = 0; row < 4; ++row){
+			auto r = a._mat[row];
+			store(combine(m, r.x, r.y, r.z, r.w), out._mat[row]);
+		}
+	}
+
+	// Cramer's rule, from Intel's "Streaming SIMD Extensions - Inverse of
+	// 4x4 Matrix". Only uses shuffles that are a single instruction on neon.
+	// In float precision it loses too many digits for nearly singular
+	// matrices so it fails, without touching dst, when the determinant is
+	// small compared to the size of the elements, the caller then uses the
+	// pivoted invert_4x4 instead
+	bool invertCramer(const ofMatrix4x4 & src, ofMatrix4x4 & dst){
+		auto m = rows(src);
+		auto row0 = m.r0, row1 = m.r1, row2 = m.r2, row3 = m.r3;
+		transpose(row0, row1, row2, row3);
+		row1 = swapHalves(row1);
+		row3 = swapHalves(row3);
+
+		auto tmp = swapPairs(mul(row2, row3));
+		auto minor0 = mul(row1, tmp);
+		auto minor1 = mul(row0, tmp);
+		tmp = swapHalves(tmp);
+		minor0 = sub(mul(row1, tmp), minor0);
+		minor1 = swapHalves(sub(mul(row0, tmp), minor1));
+
+		tmp = swapPairs(mul(row1, row2));
+		minor0 = add(mul(row3, tmp), minor0);
+		auto minor3 = mul(row0, tmp);
+		tmp = swapHalves(tmp);
+		minor0 = sub(minor0, mul(row3, tmp));
+		minor3 = swapHalves(sub(mul(row0, tmp), minor3));
+
+		tmp = swapPairs(mul(swapHalves(row1), row3));
+		row2 = swapHalves(row2);
+		minor0 = add(mul(row2, tmp), minor0);
+		auto minor2 = mul(row0, tmp);
+		tmp = swapHalves(tmp);
+		minor0 = sub(minor0, mul(row2, tmp));
+		minor2 = swapHalves(sub(mul(row0, tmp), minor2));
+
+		tmp = swapPairs(mul(row0, row1));
+		minor2 = add(mul(row3, tmp), minor2);
+		minor3 = sub(mul(row2, tmp), minor3);
+		tmp = swapHalves(tmp);
+		minor2 = sub(mul(row3, tmp), minor2);
+		minor3 = sub(minor3, mul(row2, tmp));
+
+		tmp = swapPairs(mul(row0, row3));
+		minor1 = sub(minor1, mul(row2, tmp));
+		minor2 = add(mul(row1, tmp), minor2);
+		tmp = swapHalves(tmp);
+		minor1 = add(mul(row2, tmp), minor1);
+		minor2 = sub(minor2, mul(row1, tmp));
+
+		tmp = swapPairs(mul(row0, row2));
+		minor1 = add(mul(row3, tmp), minor1);
+		minor3 = sub(minor3, mul(row1, tmp));
+		tmp = swapHalves(tmp);
+		minor1 = sub(minor1, mul(row3, tmp));
+		minor3 = add(mul(row1, tmp), minor3);
+
+		auto det = mul(row0, minor0);
+		det = add(swapHalves(det), det);
+		det = add(swapPairs(det), det);
+		auto d = getX(det);
+		float norm = 0.0f;
+		for(int row = 0; row < 4; ++row){
+			for(int col = 0; col < 4; ++col){
+				norm = std::max(norm, std::abs(src._mat[row][col]));
+			}
+		}
+		if(!(std::abs(d) > 1e-6f * square(square(norm)))){
+			return false;
+		}
+		auto oneOverDet = splat(1.0f / d);
+		store(mul(oneOverDet, minor0), dst._mat[0]);
+		store(mul(oneOverDet, minor1), dst._mat[1]);
+		store(mul(oneOverDet, minor2), dst._mat[2]);
+		store(mul(oneOverDet, minor3), dst._mat[3]);
+		return true;
+	}
+#endif
+}
+
 #define SET_ROW(row, v1, v2, v3, v4 )    \
 _mat[(row)][0] = (v1); \
 _mat[(row)][1] = (v2); \
@@ -452,6 +698,9 @@ void ofMatrix4x4::makeFromMultiplicationOf( const ofMatrix4x4& lhs, const ofMatr
 
 	// PRECONDITION: We assume neither &lhs nor &rhs == this
 	// if it did, use preMult or postMult instead
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	multiply(lhs, rhs, *this);
+#else
     _mat[0][0] = INNER_PRODUCT(lhs, rhs, 0, 0);
     _mat[0][1] = INNER_PRODUCT(lhs, rhs, 0, 1);
     _mat[0][2] = INNER_PRODUCT(lhs, rhs, 0, 2);
@@ -468,6 +717,7 @@ void ofMatrix4x4::makeFromMultiplicationOf( const ofMatrix4x4& lhs, const ofMatr
     _mat[3][1] = INNER_PRODUCT(lhs, rhs, 3, 1);
     _mat[3][2] = INNER_PRODUCT(lhs, rhs, 3, 2);
     _mat[3][3] = INNER_PRODUCT(lhs, rhs, 3, 3);
+#endif
 }
 
 void ofMatrix4x4::preMult( const ofMatrix4x4& other )
@@ -476,6 +726,9 @@ void ofMatrix4x4::preMult( const ofMatrix4x4& other )
     //ofMatrix4x4 tmp(other* *this);
     // *this = tmp;
 
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    multiply(other, *this, *this);
+#else
     // more efficient method just use a float[4] for temporary storage.
     float t[4];
     for(int col=0; col<4; ++col) {
@@ -488,7 +741,7 @@ void ofMatrix4x4::preMult( const ofMatrix4x4& other )
         _mat[2][col] = t[2];
         _mat[3][col] = t[3];
     }
-
+#endif
 }
 
 void ofMatrix4x4::postMult( const ofMatrix4x4& other )
@@ -497,6 +750,9 @@ void ofMatrix4x4::postMult( const ofMatrix4x4& other )
     //ofMatrix4x4 tmp(*this * other);
     // *this = tmp;
 
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    multiply(*this, other, *this);
+#else
     // more efficient method just use a float[4] for temporary storage.
     float t[4];
     for(int row=0; row<4; ++row)
@@ -507,10 +763,97 @@ void ofMatrix4x4::postMult( const ofMatrix4x4& other )
         t[3] = INNER_PRODUCT( *this, other, row, 3 );
         SET_ROW(row, t[0], t[1], t[2], t[3] )
     }
+#endif
 }
 
 #undef INNER_PRODUCT
 
+void ofMatrix4x4::preMult( const ofVec3f * in, ofVec3f * out, std::size_t count ) const
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto m = rows(*this);
+    for(std::size_t i=0; i<count; ++i) {
+        store3(divideByW(combinePoint(m, in[i])), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = preMult(in[i]);
+    }
+#endif
+}
+
+void ofMatrix4x4::preMult( const ofVec4f * in, ofVec4f * out, std::size_t count ) const
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto m = rows(*this);
+    for(std::size_t i=0; i<count; ++i) {
+        auto v = in[i];
+        store(combine(m, v.x, v.y, v.z, v.w), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = preMult(in[i]);
+    }
+#endif
+}
+
+void ofMatrix4x4::postMult( const ofVec3f * in, ofVec3f * out, std::size_t count ) const
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto m = columns(*this);
+    for(std::size_t i=0; i<count; ++i) {
+        store3(divideByW(combinePoint(m, in[i])), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = postMult(in[i]);
+    }
+#endif
+}
+
+void ofMatrix4x4::postMult( const ofVec4f * in, ofVec4f * out, std::size_t count ) const
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto m = columns(*this);
+    for(std::size_t i=0; i<count; ++i) {
+        auto v = in[i];
+        store(combine(m, v.x, v.y, v.z, v.w), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = postMult(in[i]);
+    }
+#endif
+}
+
+void ofMatrix4x4::transform3x3( const ofVec3f * in, ofVec3f * out, std::size_t count, const ofMatrix4x4& m )
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto r = rows(m);
+    for(std::size_t i=0; i<count; ++i) {
+        store3(combineDirection(r, in[i]), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = transform3x3(in[i], m);
+    }
+#endif
+}
+
+void ofMatrix4x4::transform3x3( const ofMatrix4x4& m, const ofVec3f * in, ofVec3f * out, std::size_t count )
+{
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+    auto c = columns(m);
+    for(std::size_t i=0; i<count; ++i) {
+        store3(combineDirection(c, in[i]), out[i]);
+    }
+#else
+    for(std::size_t i=0; i<count; ++i) {
+        out[i] = transform3x3(m, in[i]);
+    }
+#endif
+}
+
 // orthoNormalize the 3x3 rotation matrix
 void ofMatrix4x4::makeOrthoNormalOf(const ofMatrix4x4& rhs)
 {
@@ -580,7 +923,11 @@ bool invert_4x4( const ofMatrix4x4& rhs, ofMatrix4x4 & dst);
 
 bool ofMatrix4x4::makeInvertOf(const ofMatrix4x4 & rhs){
 	bool is_4x3 = (rhs._mat[0][3] == 0.0f && rhs._mat[1][3] == 0.0f &&  rhs._mat[2][3] == 0.0f && rhs._mat[3][3] == 1.0f);
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	return is_4x3 ? invert_4x3(rhs,*this) :  (invertCramer(rhs,*this) || invert_4x4(rhs,*this));
+#else
 	return is_4x3 ? invert_4x3(rhs,*this) :  invert_4x4(rhs,*this);
+#endif
 }
 
 ofMatrix4x4 ofMatrix4x4::getInverse() const
@@ -528,6 +528,20 @@ public:
 	/// This matrix becomes `other * this`.
 	void preMult( const ofMatrix4x4& );
 
+	/// \brief Matrix * vector multiplication of count vectors.
+	///
+	/// Same as `out[i] = postMult(in[i])` but faster for many vectors.
+	/// in and out can be the same array.
+	void postMult( const ofVec3f * in, ofVec3f * out, std::size_t count ) const;
+	void postMult( const ofVec4f * in, ofVec4f * out, std::size_t count ) const;
+
+	/// \brief Vector * matrix multiplication of count vectors.
+	///
+	/// Same as `out[i] = preMult(in[i])` but faster for many vectors.
+	/// in and out can be the same array.
+	void preMult( const ofVec3f * in, ofVec3f * out, std::size_t count ) const;
+	void preMult( const ofVec4f * in, ofVec4f * out, std::size_t count ) const;
+
 	/// \brief The *= operation for matrices.
 	/// 
 	/// This is equivalent to calling postMult(other), but it allows you to do
@@ -661,6 +675,14 @@ public:
 	/// \brief Apply a 3x3 transform (no translation) of M * v.
 	inline static ofVec3f transform3x3(const ofMatrix4x4& m, const ofVec3f& v);
 
+	/// \brief Apply a 3x3 transform (no translation) of v * M to count
+	/// vectors. in and out can be the same array.
+	static void transform3x3(const ofVec3f * in, ofVec3f * out, std::size_t count, const ofMatrix4x4& m);
+
+	/// \brief Apply a 3x3 transform (no translation) of M * v to count
+	/// vectors. in and out can be the same array.
+	static void transform3x3(const ofMatrix4x4& m, const ofVec3f * in, ofVec3f * out, std::size_t count);
+
 	/// \}
 	
 };
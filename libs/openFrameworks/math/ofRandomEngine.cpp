@@ -0,0 +1,359 @@
+#include "ofRandomEngine.h"
+#include "ofMath.h"
+#include <atomic>
+#include <mutex>
+
+#ifndef TARGET_WIN32
+	#include <sys/time.h>
+#endif
+
+#if defined(OF_USE_SSE)
+	#include <emmintrin.h>
+#elif defined(OF_USE_NEON)
+	#include <arm_neon.h>
+#endif
+
+namespace{
+	uint64_t splitMix64(uint64_t & x){
+		auto z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// 4 xoshiro128+ generators running side by side, seeded from a scalar
+	// engine. next() writes 4 floats in [0, 1) scaled to [min, max)
+#if defined(OF_USE_SSE)
+	class Engine4{
+	public:
+		Engine4(ofRandomEngine & engine){
+			for(auto & s: state){
+				uint32_t values[4] = {engine(), engine(), engine(), engine()};
+				s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+			}
+			// an all zero state would only produce zeros
+			state[0] = _mm_or_si128(state[0], _mm_set1_epi32(1));
+		}
+
+		void next(float * out, float min, float range, float last){
+			auto result = _mm_add_epi32(state[0], state[3]);
+			auto t = _mm_slli_epi32(state[1], 9);
+			state[2] = _mm_xor_si128(state[2], state[0]);
+			state[3] = _mm_xor_si128(state[3], state[1]);
+			state[1] = _mm_xor_si128(state[1], state[2]);
+			state[0] = _mm_xor_si128(state[0], state[3]);
+			state[2] = _mm_xor_si128(state[2], t);
+			state[3] = _mm_or_si128(_mm_slli_epi32(state[3], 11), _mm_srli_epi32(state[3], 21));
+
+			auto u = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), _mm_set1_ps(1.f / 16777216.f));
+			auto value = _mm_add_ps(_mm_set1_ps(min), _mm_mul_ps(_mm_set1_ps(range), u));
+			_mm_storeu_ps(out, _mm_min_ps(value, _mm_set1_ps(last)));
+		}
+
+	private:
+		__m128i state[4];
+	};
+#elif defined(OF_USE_NEON)
+	class Engine4{
+	public:
+		Engine4(ofRandomEngine & engine){
+			for(auto & s: state){
+				uint32_t values[4] = {engine(), engine(), engine(), engine()};
+				s = vld1q_u32(values);
+			}
+			// an all zero state would only produce zeros
+			state[0] = vorrq_u32(state[0], vdupq_n_u32(1));
+		}
+
+		void next(float * out, float min, float range, float last){
+			auto result = vaddq_u32(state[0], state[3]);
+			auto t = vshlq_n_u32(state[1], 9);
+			state[2] = veorq_u32(state[2], state[0]);
+			state[3] = veorq_u32(state[3], state[1]);
+			state[1] = veorq_u32(state[1], state[2]);
+			state[0] = veorq_u32(state[0], state[3]);
+			state[2] = veorq_u32(state[2], t);
+			state[3] = vorrq_u32(vshlq_n_u32(state[3], 11), vshrq_n_u32(state[3], 21));
+
+			auto u = vmulq_f32(vcvtq_f32_u32(vshrq_n_u32(result, 8)), vdupq_n_f32(1.f / 16777216.f));
+			auto value = vaddq_f32(vdupq_n_f32(min), vmulq_f32(vdupq_n_f32(range), u));
+			vst1q_f32(out, vminq_f32(value, vdupq_n_f32(last)));
+		}
+
+	private:
+		uint32x4_t state[4];
+	};
+#else
+	class Engine4{
+	public:
+		Engine4(ofRandomEngine & engine){
+			for(std::size_t i = 0; i < 4; i++){
+				lanes[i].seed((uint64_t(engine()) << 32) | engine());
+			}
+		}
+
+		void next(float * out, float min, float range, float last){
+			for(std::size_t i = 0; i < 4; i++){
+				out[i] = std::min(min + range * lanes[i].uniform(), last);
+			}
+		}
+
+	private:
+		ofRandomEngine lanes[4];
+	};
+#endif
+
+	// below this many values seeding the 4 wide engine isn't worth it
+	const std::size_t minSimdCount = 64;
+
+	void fillUniform(float * out, std::size_t count, float min, float max, ofRandomEngine & engine){
+		auto low = std::min(min, max);
+		auto high = std::max(min, max);
+		auto range = high - low;
+		// largest float below high so the results never reach it
+		auto last = std::nextafter(high, low);
+		std::size_t i = 0;
+		if(count >= minSimdCount){
+			Engine4 engine4(engine);
+			for(; i + 4 <= count; i += 4){
+				engine4.next(out + i, low, range, last);
+			}
+		}
+		for(; i < count; i++){
+			out[i] = std::min(low + range * engine.uniform(), last);
+		}
+	}
+
+	struct SeedState{
+		std::mutex mutex;
+		uint64_t seed = 0;
+		uint64_t nextStream = 1;
+		std::atomic<uint64_t> generation{0};
+	};
+
+	SeedState & getSeedState(){
+		static SeedState * state = new SeedState;
+		return *state;
+	}
+
+	struct ThreadEngine{
+		ofRandomEngine engine;
+		uint64_t generation = std::numeric_limits<uint64_t>::max();
+	};
+
+#ifdef HAS_TLS
+	thread_local ThreadEngine threadEngine;
+	ThreadEngine & getThreadEngine(){
+		return threadEngine;
+	}
+#else
+	// without thread local storage every thread shares the same engine
+	// which isn't thread safe, same as rand()
+	ThreadEngine & getThreadEngine(){
+		static ThreadEngine * engine = new ThreadEngine;
+		return *engine;
+	}
+#endif
+
+	// the calling thread gets stream 0, other threads the following streams
+	// as they use a random function for the first time after this
+	void seedEngines(uint64_t seed){
+		auto & local = getThreadEngine();
+		auto & seedState = getSeedState();
+		std::unique_lock<std::mutex> lock(seedState.mutex);
+		seedState.seed = seed;
+		seedState.nextStream = 1;
+		local.engine.seed(seed, 0);
+		local.generation = seedState.generation.fetch_add(1, std::memory_order_release) + 1;
+	}
+}
+
+//--------------------------------------------------------------
+ofRandomEngine::ofRandomEngine(uint64_t seed, uint64_t stream){
+	this->seed(seed, stream);
+}
+
+//--------------------------------------------------------------
+void ofRandomEngine::seed(uint64_t seed, uint64_t stream){
+	auto x = seed;
+	x = splitMix64(x) ^ stream;
+	auto a = splitMix64(x);
+	auto b = splitMix64(x);
+	state[0] = uint32_t(a);
+	state[1] = uint32_t(a >> 32);
+	state[2] = uint32_t(b);
+	state[3] = uint32_t(b >> 32);
+	if(a == 0 && b == 0){
+		state[0] = 1;
+	}
+	hasSpareGaussian = false;
+}
+
+//--------------------------------------------------------------
+float ofRandomEngine::uniform(float min, float max){
+	auto low = std::min(min, max);
+	auto high = std::max(min, max);
+	return std::min(low + (high - low) * uniform(), std::nextafter(high, low));
+}
+
+//--------------------------------------------------------------
+float ofRandomEngine::gaussian(float mean, float stddev){
+	// box-muller gives 2 values at a time, keep the second for the next call
+	if(hasSpareGaussian){
+		hasSpareGaussian = false;
+		return mean + stddev * spareGaussian;
+	}
+	auto radius = std::sqrt(-2.f * std::log(1.f - uniform()));
+	auto angle = float(TWO_PI) * uniform();
+	spareGaussian = radius * std::sin(angle);
+	hasSpareGaussian = true;
+	return mean + stddev * radius * std::cos(angle);
+}
+
+//--------------------------------------------------------------
+ofRandomEngine & ofGetRandomEngine(){
+	auto & local = getThreadEngine();
+	auto & seedState = getSeedState();
+	if(local.generation != seedState.generation.load(std::memory_order_acquire)){
+		std::unique_lock<std::mutex> lock(seedState.mutex);
+		local.engine.seed(seedState.seed, seedState.nextStream++);
+		local.generation = seedState.generation;
+	}
+	return local.engine;
+}
+
+//--------------------------------------------------------------
+void ofSeedRandom() {
+
+	// good info here:
+	// http://stackoverflow.com/questions/322938/recommended-way-to-initialize-srand
+
+	#ifdef TARGET_WIN32
+		long int n = GetTickCount();
+	#elif !defined(TARGET_EMSCRIPTEN)
+		// use XOR'd second, microsecond precision AND pid as seed
+		struct timeval tv;
+		gettimeofday(&tv, 0);
+		long int n = (tv.tv_sec ^ tv.tv_usec) ^ getpid();
+	#else
+		struct timeval tv;
+		gettimeofday(&tv, 0);
+		long int n = (tv.tv_sec ^ tv.tv_usec);
+	#endif
+	// rand() is still seeded for code that uses it directly
+	srand(n);
+	seedEngines(n);
+}
+
+//--------------------------------------------------------------
+void ofSeedRandom(int val) {
+	srand((long) val);
+	seedEngines(val);
+}
+
+//--------------------------------------------------------------
+float ofRandom(float max) {
+	return ofGetRandomEngine().uniform(0.f, max);
+}
+
+//--------------------------------------------------------------
+float ofRandom(float x, float y) {
+	return ofGetRandomEngine().uniform(x, y);
+}
+
+//--------------------------------------------------------------
+float ofRandomf() {
+	return ofGetRandomEngine().uniform(-1.f, 1.f);
+}
+
+//--------------------------------------------------------------
+float ofRandomuf() {
+	return ofGetRandomEngine().uniform();
+}
+
+//--------------------------------------------------------------
+float ofRandomGaussian(float mean, float stddev){
+	return ofGetRandomEngine().gaussian(mean, stddev);
+}
+
+//--------------------------------------------------------------
+glm::vec3 ofRandomUnitVector(){
+	return ofRandomUnitVector(ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+glm::vec3 ofRandomUnitVector(ofRandomEngine & engine){
+	auto z = engine.uniform(-1.f, 1.f);
+	auto angle = engine.uniform(0.f, float(TWO_PI));
+	auto radius = std::sqrt(std::max(1.f - z * z, 0.f));
+	return {radius * std::cos(angle), radius * std::sin(angle), z};
+}
+
+//--------------------------------------------------------------
+void ofRandomFill(float * out, std::size_t count, float min, float max){
+	fillUniform(out, count, min, max, ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+void ofRandomFill(float * out, std::size_t count, float min, float max, ofRandomEngine & engine){
+	fillUniform(out, count, min, max, engine);
+}
+
+//--------------------------------------------------------------
+void ofRandomFill(std::vector<float> & out, float min, float max){
+	fillUniform(out.data(), out.size(), min, max, ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+void ofRandomGaussianFill(float * out, std::size_t count, float mean, float stddev){
+	ofRandomGaussianFill(out, count, mean, stddev, ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+void ofRandomGaussianFill(float * out, std::size_t count, float mean, float stddev, ofRandomEngine & engine){
+	// uniform values in (0, 1) so the log is always defined, then
+	// box-muller on every pair
+	auto pairs = count / 2;
+	fillUniform(out, pairs * 2, std::numeric_limits<float>::min(), 1.f, engine);
+	for(std::size_t i = 0; i < pairs * 2; i += 2){
+		auto radius = stddev * std::sqrt(-2.f * std::log(out[i]));
+		auto angle = float(TWO_PI) * out[i + 1];
+		out[i] = mean + radius * std::cos(angle);
+		out[i + 1] = mean + radius * std::sin(angle);
+	}
+	if(count % 2){
+		out[count - 1] = engine.gaussian(mean, stddev);
+	}
+}
+
+//--------------------------------------------------------------
+void ofRandomGaussianFill(std::vector<float> & out, float mean, float stddev){
+	ofRandomGaussianFill(out.data(), out.size(), mean, stddev, ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+void ofRandomUnitVectorFill(glm::vec3 * out, std::size_t count){
+	ofRandomUnitVectorFill(out, count, ofGetRandomEngine());
+}
+
+//--------------------------------------------------------------
+void ofRandomUnitVectorFill(glm::vec3 * out, std::size_t count, ofRandomEngine & engine){
+	// z and angle for a block of vectors at a time
+	const std::size_t blockSize = 256;
+	float values[blockSize * 2];
+	for(std::size_t i = 0; i < count; i += blockSize){
+		auto n = std::min(blockSize, count - i);
+		fillUniform(values, n * 2, 0.f, 1.f, engine);
+		for(std::size_t j = 0; j < n; j++){
+			auto z = 1.f - 2.f * values[j * 2];
+			auto angle = float(TWO_PI) * values[j * 2 + 1];
+			auto radius = std::sqrt(std::max(1.f - z * z, 0.f));
+			out[i + j] = {radius * std::cos(angle), radius * std::sin(angle), z};
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofRandomUnitVectorFill(std::vector<glm::vec3> & out){
+	ofRandomUnitVectorFill(out.data(), out.size(), ofGetRandomEngine());
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <limits>
+
+/// \file
+/// The random number generator behind ofRandom.
+///
+/// Every thread has its own ofRandomEngine so calling ofRandom from several
+/// threads at the same time doesn't need any locking, and the fill functions
+/// generate many numbers at once, 4 at a time using SSE or NEON when
+/// available.
+
+/// \brief Small and fast random number generator (xoshiro128+).
+///
+/// It can be used with the standard library distributions and algorithms:
+///
+/// ~~~~{.cpp}
+/// ofRandomEngine engine(42);
+/// std::normal_distribution<float> normal(0, 10);
+/// float x = normal(engine);
+/// std::shuffle(values.begin(), values.end(), engine);
+/// ~~~~
+///
+/// Engines with the same seed and different streams produce independent
+/// sequences, which is useful to get reproducible results from parallel
+/// code by giving every task its own engine:
+///
+/// ~~~~{.cpp}
+/// ofParallelFor(0, particles.size(), [&](std::size_t i){
+/// 	ofRandomEngine engine(seed, i);
+/// 	particles[i].velocity = ofRandomUnitVector(engine) * speed;
+/// });
+/// ~~~~
+class ofRandomEngine{
+public:
+	typedef uint32_t result_type;
+
+	ofRandomEngine(uint64_t seed = 0, uint64_t stream = 0);
+
+	void seed(uint64_t seed, uint64_t stream = 0);
+
+	/// \returns a random 32 bit number.
+	inline uint32_t operator()(){
+		auto result = state[0] + state[3];
+		auto t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = (state[3] << 11) | (state[3] >> 21);
+		return result;
+	}
+
+	/// \returns a random float in [0, 1).
+	inline float uniform(){
+		return ((*this)() >> 8) * (1.f / 16777216.f);
+	}
+
+	/// \returns a random float in [min, max).
+	float uniform(float min, float max);
+
+	/// \returns a random float from a normal distribution.
+	float gaussian(float mean = 0.f, float stddev = 1.f);
+
+	static constexpr uint32_t min(){ return 0; }
+	static constexpr uint32_t max(){ return std::numeric_limits<uint32_t>::max(); }
+
+private:
+	uint32_t state[4];
+	float spareGaussian;
+	bool hasSpareGaussian = false;
+};
+
+/// \brief The random engine of the calling thread, used by ofRandom and
+/// the other random functions.
+///
+/// After ofSeedRandom(val) the thread that called it repeats the same
+/// sequence every time. Other threads get their own sequence derived from
+/// the same seed the first time they use a random function after seeding.
+/// It depends on the order in which threads do so, use your own
+/// ofRandomEngine when that order isn't fixed.
+ofRandomEngine & ofGetRandomEngine();
+
+/// \brief Random float from a normal distribution.
+float ofRandomGaussian(float mean = 0.f, float stddev = 1.f);
+
+/// \brief Random direction, a point on the surface of the unit sphere.
+glm::vec3 ofRandomUnitVector();
+glm::vec3 ofRandomUnitVector(ofRandomEngine & engine);
+
+/// \brief Fills out with count random floats in [min, max).
+///
+/// ~~~~{.cpp}
+/// std::vector<float> sizes(particles.size());
+/// ofRandomFill(sizes, 1, 5);
+/// ~~~~
+void ofRandomFill(float * out, std::size_t count, float min, float max);
+void ofRandomFill(float * out, std::size_t count, float min, float max, ofRandomEngine & engine);
+void ofRandomFill(std::vector<float> & out, float min, float max);
+
+/// \brief Fills out with count random floats from a normal distribution.
+void ofRandomGaussianFill(float * out, std::size_t count, float mean = 0.f, float stddev = 1.f);
+void ofRandomGaussianFill(float * out, std::size_t count, float mean, float stddev, ofRandomEngine & engine);
+void ofRandomGaussianFill(std::vector<float> & out, float mean = 0.f, float stddev = 1.f);
+
+/// \brief Fills out with count random directions.
+void ofRandomUnitVectorFill(glm::vec3 * out, std::size_t count);
+void ofRandomUnitVectorFill(glm::vec3 * out, std::size_t count, ofRandomEngine & engine);
+void ofRandomUnitVectorFill(std::vector<glm::vec3> & out);
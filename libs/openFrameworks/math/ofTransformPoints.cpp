@@ -0,0 +1,248 @@
+#include "ofTransformPoints.h"
+#include "ofTaskPool.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(OF_USE_SSE)
+	#include <emmintrin.h>
+#elif defined(OF_USE_NEON)
+	#include <arm_neon.h>
+#endif
+
+namespace{
+#if defined(OF_USE_SSE)
+	typedef __m128 float4;
+
+	inline float4 load(const glm::vec4 & v){
+		return _mm_loadu_ps(&v.x);
+	}
+
+	inline float4 splat(float f){
+		return _mm_set1_ps(f);
+	}
+
+	// a * b + c
+	inline float4 madd(float4 a, float4 b, float4 c){
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+	inline float4 mul(float4 a, float4 b){
+		return _mm_mul_ps(a, b);
+	}
+
+	// writes only x, y, z so dst can be an element in the middle of an array
+	inline void store3(float4 v, glm::vec3 & dst){
+		_mm_storel_pi(reinterpret_cast<__m64*>(&dst.x), v);
+		_mm_store_ss(&dst.z, _mm_movehl_ps(v, v));
+	}
+
+	inline float4 divideByW(float4 v){
+		return _mm_div_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)));
+	}
+
+	// expects w == 0
+	inline float4 normalize3(float4 v){
+		auto sq = _mm_mul_ps(v, v);
+		auto sum = _mm_add_ps(sq, _mm_movehl_ps(sq, sq));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1,1,1,1)));
+		auto length = _mm_sqrt_ss(sum);
+		return _mm_div_ps(v, _mm_shuffle_ps(length, length, _MM_SHUFFLE(0,0,0,0)));
+	}
+#elif defined(OF_USE_NEON)
+	typedef float32x4_t float4;
+
+	inline float4 load(const glm::vec4 & v){
+		return vld1q_f32(&v.x);
+	}
+
+	inline float4 splat(float f){
+		return vdupq_n_f32(f);
+	}
+
+	// a * b + c
+	inline float4 madd(float4 a, float4 b, float4 c){
+		return vmlaq_f32(c, a, b);
+	}
+
+	inline float4 mul(float4 a, float4 b){
+		return vmulq_f32(a, b);
+	}
+
+	// writes only x, y, z so dst can be an element in the middle of an array
+	inline void store3(float4 v, glm::vec3 & dst){
+		vst1_f32(&dst.x, vget_low_f32(v));
+		dst.z = vgetq_lane_f32(v, 2);
+	}
+
+	inline float4 divideByW(float4 v){
+		return vmulq_n_f32(v, 1.f / vgetq_lane_f32(v, 3));
+	}
+
+	// expects w == 0
+	inline float4 normalize3(float4 v){
+		auto sq = vmulq_f32(v, v);
+		auto length = std::sqrt(vgetq_lane_f32(sq, 0) + vgetq_lane_f32(sq, 1) + vgetq_lane_f32(sq, 2));
+		return vmulq_n_f32(v, 1.f / length);
+	}
+#endif
+
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	struct Columns{
+		float4 c0, c1, c2, c3;
+	};
+
+	inline Columns columns(const glm::mat4 & m){
+		return {load(m[0]), load(m[1]), load(m[2]), load(m[3])};
+	}
+
+	inline float4 transformPoint(const Columns & m, const glm::vec3 & p){
+		return madd(m.c0, splat(p.x), madd(m.c1, splat(p.y), madd(m.c2, splat(p.z), m.c3)));
+	}
+
+	inline float4 transformDirection(const Columns & m, const glm::vec3 & d){
+		return madd(m.c0, splat(d.x), madd(m.c1, splat(d.y), mul(m.c2, splat(d.z))));
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count){
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	auto cols = columns(m);
+	for(std::size_t i = 0; i < count; i++){
+		store3(transformPoint(cols, src[i]), dst[i]);
+	}
+#else
+	for(std::size_t i = 0; i < count; i++){
+		dst[i] = glm::vec3(m * glm::vec4(src[i], 1.f));
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst){
+	dst.resize(src.size());
+	ofTransformPoints(m, src.data(), dst.data(), src.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat4 & m, std::vector<glm::vec3> & points){
+	ofTransformPoints(m, points.data(), points.data(), points.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat3 & m, const glm::vec2 * src, glm::vec2 * dst, std::size_t count){
+	std::size_t i = 0;
+#if defined(OF_USE_SSE)
+	// two points per iteration: x0 y0 x1 y1
+	auto a = _mm_setr_ps(m[0][0], m[0][1], m[0][0], m[0][1]);
+	auto b = _mm_setr_ps(m[1][0], m[1][1], m[1][0], m[1][1]);
+	auto c = _mm_setr_ps(m[2][0], m[2][1], m[2][0], m[2][1]);
+	for(; i + 2 <= count; i += 2){
+		auto p = _mm_loadu_ps(&src[i].x);
+		auto xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2,2,0,0));
+		auto ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3,3,1,1));
+		_mm_storeu_ps(&dst[i].x, madd(a, xs, madd(b, ys, c)));
+	}
+#elif defined(OF_USE_NEON)
+	// four points per iteration, deinterleaved into xs and ys
+	auto cx = vdupq_n_f32(m[2][0]);
+	auto cy = vdupq_n_f32(m[2][1]);
+	for(; i + 4 <= count; i += 4){
+		auto p = vld2q_f32(&src[i].x);
+		float32x4x2_t r;
+		r.val[0] = vmlaq_n_f32(vmlaq_n_f32(cx, p.val[0], m[0][0]), p.val[1], m[1][0]);
+		r.val[1] = vmlaq_n_f32(vmlaq_n_f32(cy, p.val[0], m[0][1]), p.val[1], m[1][1]);
+		vst2q_f32(&dst[i].x, r);
+	}
+#endif
+	for(; i < count; i++){
+		auto p = src[i];
+		dst[i].x = m[0][0] * p.x + m[1][0] * p.y + m[2][0];
+		dst[i].y = m[0][1] * p.x + m[1][1] * p.y + m[2][1];
+	}
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat3 & m, const std::vector<glm::vec2> & src, std::vector<glm::vec2> & dst){
+	dst.resize(src.size());
+	ofTransformPoints(m, src.data(), dst.data(), src.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformPoints(const glm::mat3 & m, std::vector<glm::vec2> & points){
+	ofTransformPoints(m, points.data(), points.data(), points.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformPointsProjective(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count){
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	auto cols = columns(m);
+	for(std::size_t i = 0; i < count; i++){
+		store3(divideByW(transformPoint(cols, src[i])), dst[i]);
+	}
+#else
+	for(std::size_t i = 0; i < count; i++){
+		auto p = m * glm::vec4(src[i], 1.f);
+		dst[i] = glm::vec3(p) / p.w;
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofTransformPointsProjective(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst){
+	dst.resize(src.size());
+	ofTransformPointsProjective(m, src.data(), dst.data(), src.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformDirections(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count){
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	auto cols = columns(m);
+	for(std::size_t i = 0; i < count; i++){
+		store3(transformDirection(cols, src[i]), dst[i]);
+	}
+#else
+	glm::mat3 rotationScale(m);
+	for(std::size_t i = 0; i < count; i++){
+		dst[i] = rotationScale * src[i];
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofTransformDirections(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst){
+	dst.resize(src.size());
+	ofTransformDirections(m, src.data(), dst.data(), src.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformNormals(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count){
+	auto normalMatrix = glm::inverseTranspose(glm::mat3(m));
+#if defined(OF_USE_SSE) || defined(OF_USE_NEON)
+	// mat4(mat3) has 0 in the w of every column so w stays 0 for normalize3
+	auto cols = columns(glm::mat4(normalMatrix));
+	for(std::size_t i = 0; i < count; i++){
+		store3(normalize3(transformDirection(cols, src[i])), dst[i]);
+	}
+#else
+	for(std::size_t i = 0; i < count; i++){
+		dst[i] = glm::normalize(normalMatrix * src[i]);
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofTransformNormals(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst){
+	dst.resize(src.size());
+	ofTransformNormals(m, src.data(), dst.data(), src.size());
+}
+
+//--------------------------------------------------------------
+void ofTransformPointsParallel(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count){
+	// smaller chunks cost more to schedule than what they save
+	const std::size_t minPointsPerTask = 1 << 14;
+	ofParallelForRange(0, count, [&](std::size_t begin, std::size_t end){
+		ofTransformPoints(m, src + begin, dst + begin, end - begin);
+	}, minPointsPerTask);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ofConstants.h"
+
+/// \file
+/// Batch versions of the usual matrix * vector operations.
+///
+/// Transforming every vertex of a big mesh or polyline one at a time with
+/// glm goes through a full 4x4 multiplication per point. These functions
+/// transform whole arrays at once using SSE or NEON when available (see
+/// OF_USE_SSE / OF_USE_NEON in ofConstants.h) and a plain loop otherwise.
+///
+/// All of them accept src == dst to transform the points in place. The
+/// std::vector versions resize dst to the size of src.
+
+/// \brief Transform count points by m as m * vec4(p, 1) dropping w.
+void ofTransformPoints(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count);
+void ofTransformPoints(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst);
+void ofTransformPoints(const glm::mat4 & m, std::vector<glm::vec3> & points);
+
+/// \brief Transform count 2D points by a 2D affine transform, the last
+/// row of m is ignored.
+void ofTransformPoints(const glm::mat3 & m, const glm::vec2 * src, glm::vec2 * dst, std::size_t count);
+void ofTransformPoints(const glm::mat3 & m, const std::vector<glm::vec2> & src, std::vector<glm::vec2> & dst);
+void ofTransformPoints(const glm::mat3 & m, std::vector<glm::vec2> & points);
+
+/// \brief Transform count points by m dividing by the resulting w, as
+/// needed for projection matrices.
+void ofTransformPointsProjective(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count);
+void ofTransformPointsProjective(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst);
+
+/// \brief Transform count directions by m as m * vec4(d, 0), ignoring the
+/// translation.
+void ofTransformDirections(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count);
+void ofTransformDirections(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst);
+
+/// \brief Transform count normals by the inverse transpose of the upper 3x3
+/// of m and normalize them, so they stay perpendicular to surfaces
+/// transformed with m even under non uniform scales.
+void ofTransformNormals(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count);
+void ofTransformNormals(const glm::mat4 & m, const std::vector<glm::vec3> & src, std::vector<glm::vec3> & dst);
+
+/// \brief Same as ofTransformPoints but splits big arrays across the
+/// threads of ofGetTaskPool(). Only worth it for hundreds of thousands of
+/// points.
+void ofTransformPointsParallel(const glm::mat4 & m, const glm::vec3 * src, glm::vec3 * dst, std::size_t count);
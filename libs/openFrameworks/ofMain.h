@@ -10,15 +10,22 @@
 #include "ofURLFileLoader.h"
 
 #include "ofUtils.h"
+#include "ofStringView.h"
 
 #if !defined(TARGET_EMSCRIPTEN)
 #include "ofThread.h"
 #include "ofThreadChannel.h"
 #endif
+#include "ofTaskPool.h"
+#include "ofParallelForLines.h"
+#include "ofAsyncFile.h"
+#include "ofDirectoryScanner.h"
+#include "ofJobQueue.h"
 
 #include "ofFpsCounter.h"
 #include "ofJson.h"
 #include "ofXml.h"
+#include "ofXmlReader.h"
 
 //--------------------------
 // types
@@ -29,11 +36,15 @@
 #include "ofRectangle.h"
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
+#include "ofParameterSnapshot.h"
 
 //--------------------------
 // math
 #include "ofMath.h"
 #include "ofVectorMath.h"
+#include "ofTransformPoints.h"
+#include "ofBatchNoise.h"
+#include "ofRandomEngine.h"
 
 //--------------------------
 // communication
@@ -110,6 +121,7 @@
 #include "ofEasyCam.h"
 #include "ofMesh.h"
 #include "ofNode.h"
+#include "ofTransformHierarchy.h"
 
 //--------------------------
 using namespace std;
@@ -1978,6 +1978,14 @@ public:
 	/// \return HTTP response on success or failure
 	virtual ofHttpResponse handleRequest(const ofHttpRequest & request) = 0;
 	virtual int handleRequestAsync(const ofHttpRequest& request)=0; // returns id
+
+	/// \brief set how many requests run at the same time, for loaders that
+	/// run several at once
+	virtual void setMaxConcurrentRequests(std::size_t){}
+
+	/// \brief set how many connections can be open to the same host, for
+	/// loaders that keep connections open
+	virtual void setMaxConnectionsPerHost(std::size_t){}
 	
 };
 
@@ -8,26 +8,26 @@ string ofAbstractParameter::getEscapedName() const{
 
 
 string ofAbstractParameter::escape(const string& _str) const{
-
 	std::string str(_str);
+	for(auto & c: str){
+		c = of::priv::escapeParameterChar(c);
+	}
+	return str;
+}
 
-	ofStringReplace(str, " ", "_");
-	ofStringReplace(str, "<", "_");
-	ofStringReplace(str, ">", "_");
-	ofStringReplace(str, "{", "_");
-	ofStringReplace(str, "}", "_");
-	ofStringReplace(str, "[", "_");
-	ofStringReplace(str, "]", "_");
-	ofStringReplace(str, ",", "_");
-	ofStringReplace(str, "(", "_");
-	ofStringReplace(str, ")", "_");
-	ofStringReplace(str, "/", "_");
-	ofStringReplace(str, "\\", "_");
-	ofStringReplace(str, ".", "_");
 
-	return str;
+void ofAbstractParameter::toBinary(vector<char> & data) const{
+	of::priv::writeBinaryString(data, toString());
 }
 
+bool ofAbstractParameter::fromBinary(ofStringView & data){
+	string str;
+	if(!of::priv::readBinaryString(data, str)){
+		return false;
+	}
+	fromString(str);
+	return true;
+}
 
 string ofAbstractParameter::type() const{
 	return typeid(*this).name();
@@ -80,6 +80,7 @@ ofParameter<void>::ofParameter(const string& name)
 
 void ofParameter<void>::setName(const string & name){
 	obj->name = name;
+	ofParameterGroup::parameterRenamed(obj->parents);
 }
 
 string ofParameter<void>::getName() const{
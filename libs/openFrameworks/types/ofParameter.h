@@ -7,6 +7,7 @@
 #include "ofVectorMath.h"
 #include "ofPoint.h"
 #include <map>
+#include <unordered_set>
 
 template<typename ParameterType>
 class ofParameter;
@@ -28,6 +29,20 @@ public:
 	virtual std::string toString() const = 0;
 	virtual void fromString(const std::string & str) = 0;
 
+	/// \brief Appends the value to data in the compact binary form used by
+	/// ofParameterSnapshot.
+	///
+	/// Numbers, vectors, colors and other plain types are copied as they
+	/// are in memory, strings are prefixed by their length and anything
+	/// else is stored as its toString().
+	virtual void toBinary(std::vector<char> & data) const;
+
+	/// \brief Sets the value from the start of data, as written by toBinary,
+	/// and moves data past it.
+	///
+	/// \returns false if data doesn't start with a valid value.
+	virtual bool fromBinary(ofStringView & data);
+
 	virtual std::string type() const;
 	virtual std::string getEscapedName() const;
 	virtual std::string valueType() const = 0;
@@ -72,6 +87,21 @@ protected:
 	virtual void setSerializable(bool serializable)=0;
 	virtual std::string escape(const std::string& str) const;
 	virtual const void* getInternalObject() const = 0;
+
+	/// Notifies the listeners of this parameter with its current value,
+	/// used when a batch that changed it ends
+	virtual void notifyListeners(){}
+
+	friend class ofParameterGroup;
+};
+
+
+
+//----------------------------------------------------------------------
+/// Parameters changed during a batch, see ofParameterGroup::beginBatch
+struct ofParameterChanges{
+	/// Every parameter that was set, once, in the order they were first set
+	std::vector<std::shared_ptr<ofAbstractParameter>> parameters;
 };
 
 
@@ -226,6 +256,26 @@ public:
 
 	bool contains(const std::string& name) const;
 
+	/// \brief Finds a parameter by name without allocating.
+	///
+	/// Names are compared escaped, like get(name) does.
+	///
+	/// \returns the parameter or nullptr if there's none with that name.
+	ofAbstractParameter * find(ofStringView name);
+	const ofAbstractParameter * find(ofStringView name) const;
+
+	/// \brief Finds a parameter in this group or its subgroups by its path
+	/// relative to this group, ie. "sub/param".
+	///
+	/// Resolved paths are cached, so looking up the same path again, like
+	/// the address of every OSC message for a parameter, is a single hash
+	/// lookup. The const version doesn't use the cache so it can be called
+	/// from several threads at the same time.
+	///
+	/// \returns the parameter or nullptr if the path doesn't exist.
+	ofAbstractParameter * findPath(ofStringView path);
+	const ofAbstractParameter * findPath(ofStringView path) const;
+
 	ofAbstractParameter & back();
 	ofAbstractParameter & front();
 	const ofAbstractParameter & back() const;
@@ -242,6 +292,33 @@ public:
 
 	ofEvent<ofAbstractParameter> & parameterChangedE();
 
+	/// \brief Starts a batch of changes.
+	///
+	/// While a group is in a batch, setting a parameter in it or in its
+	/// subgroups only stores the new value. When the batch ends every
+	/// parameter that was set notifies its listeners once, with its last
+	/// value, and instead of notifying parameterChangedE for each of them
+	/// this group and the groups that contain it notify batchChangedE once
+	/// with all the parameters that changed.
+	///
+	/// Subgroups, and other groups that contain the same parameters, don't
+	/// notify parameterChangedE for changes done during the batch.
+	///
+	/// Batches can be nested, the changes are notified when the outermost
+	/// one ends, and groups whose batch ended inside it notify batchChangedE
+	/// after that. See also ofParameterBatch to end it automatically.
+	///
+	/// ~~~~{.cpp}
+	/// parameters.beginBatch();
+	/// preset.restore(parameters);
+	/// parameters.endBatch();
+	/// ~~~~
+	void beginBatch();
+	void endBatch();
+	bool isInBatch() const;
+
+	ofEvent<const ofParameterChanges> & batchChangedE();
+
 	std::vector<std::shared_ptr<ofAbstractParameter> >::iterator begin();
 	std::vector<std::shared_ptr<ofAbstractParameter> >::iterator end();
 	std::vector<std::shared_ptr<ofAbstractParameter> >::const_iterator begin() const;
@@ -257,17 +334,50 @@ protected:
 private:
 	class Value{
 	public:
-		Value()
-		:serializable(true){}
+		Value();
+		~Value();
 
 		void notifyParameterChanged(ofAbstractParameter & param);
-
-		std::map<std::string,std::size_t> parametersIndex;
+		void notifyBatchChanged(const ofParameterChanges & changes);
+		bool addToBatch(ofAbstractParameter & param);
+		std::shared_ptr<Value> parentInBatch() const;
+		int find(ofStringView name) const;
+		ofAbstractParameter * findPath(ofStringView path) const;
+		void removeAt(std::size_t position);
+		void buildIndex();
+		void structureChanged();
+		void namesChanged();
+
+		struct CachedPath{
+			std::string path;
+			ofAbstractParameter * parameter;
+			uint64_t version;
+		};
+
+		// hash of the escaped name to position, the escaped names are
+		// computed once when adding so looking up a name doesn't allocate
+		std::unordered_multimap<std::size_t,std::size_t> parametersIndex;
+		std::vector<std::string> escapedNames;
+		std::unordered_multimap<std::size_t,CachedPath> pathCache;
 		std::vector<std::shared_ptr<ofAbstractParameter> > parameters;
 		std::string name;
 		bool serializable;
 		std::vector<std::weak_ptr<Value>> parents;
 		ofEvent<ofAbstractParameter> parameterChangedE;
+		// changes every time a parameter is added, removed or renamed in
+		// this group or any of its subgroups, anything cached from its
+		// structure before that has to be computed again. Unique across
+		// groups so a new group can't be mistaken for a destroyed one
+		uint64_t structureVersion;
+
+		int batchDepth;
+		ofParameterChanges batchChanges;
+		// internal objects of the parameters in batchChanges
+		std::unordered_set<const void*> batchChanged;
+		ofEvent<const ofParameterChanges> batchChangedE;
+		// batches of groups inside this one that ended during its batch,
+		// they notify once this batch's parameters have
+		std::vector<std::pair<std::weak_ptr<Value>, ofParameterChanges>> nestedBatches;
 	};
 	std::shared_ptr<Value> obj;
 	ofParameterGroup(std::shared_ptr<Value> obj)
@@ -279,9 +389,50 @@ private:
 	template<typename T, typename F>
 	friend class ofReadOnlyParameter;
 
+	friend class ofParameterSnapshot;
+
+	uint64_t getStructureVersion() const;
+
+	// a parameter in parents was renamed
+	static void parameterRenamed(const std::vector<std::weak_ptr<Value>> & parents);
+
+	// adds param to the batches of any of parents, or their parents, that
+	// are in a batch, returns false if none is
+	static bool addToBatch(const std::vector<std::weak_ptr<Value>> & parents, ofAbstractParameter & param);
+
 	const ofParameterGroup getFirstParent() const;
 };
 
+/// \brief Keeps a group in a batch until it goes out of scope.
+///
+/// ~~~~{.cpp}
+/// {
+/// 	ofParameterBatch batch(parameters);
+/// 	for(auto & value: received){
+/// 		...
+/// 	}
+/// } // listeners are notified here
+/// ~~~~
+///
+/// \sa ofParameterGroup::beginBatch
+class ofParameterBatch{
+public:
+	ofParameterBatch(ofParameterGroup & group)
+	:group(group){
+		group.beginBatch();
+	}
+
+	~ofParameterBatch(){
+		group.endBatch();
+	}
+
+	ofParameterBatch(const ofParameterBatch &) = delete;
+	ofParameterBatch & operator=(const ofParameterBatch &) = delete;
+
+private:
+	ofParameterGroup & group;
+};
+
 template<typename ParameterType>
 const ofParameter<ParameterType> & ofParameterGroup::get(const std::string& name) const{
 	return static_cast<const ofParameter<ParameterType>& >(get(name));
@@ -327,6 +478,18 @@ ofReadOnlyParameter<ParameterType, Friend> & ofParameterGroup::getReadOnly(std::
 /*! \cond PRIVATE */
 namespace of{
 namespace priv{
+	//----------------------------------------------------------------------
+	// Characters replaced by '_' in escaped parameter names
+	inline char escapeParameterChar(char c){
+		switch(c){
+		case ' ': case '<': case '>': case '{': case '}': case '[': case ']':
+		case ',': case '(': case ')': case '/': case '\\': case '.':
+			return '_';
+		default:
+			return c;
+		}
+	}
+
 	//----------------------------------------------------------------------
 	// Mechanism to provide min and max default values for types where it makes sense
 	template<typename T, bool B>
@@ -461,6 +624,112 @@ namespace priv{
 		throw std::exception();
 
 	}
+
+	//----------------------------------------------------------------------
+	// Binary form of parameter values used by ofParameterSnapshot, values are
+	// in the native byte order
+	inline void writeBinary(std::vector<char> & data, const void * src, std::size_t size){
+		auto bytes = static_cast<const char*>(src);
+		data.insert(data.end(), bytes, bytes + size);
+	}
+
+	inline bool readBinary(ofStringView & data, void * dst, std::size_t size){
+		if(data.size() < size){
+			return false;
+		}
+		if(size){
+			memcpy(dst, data.data(), size);
+		}
+		data.remove_prefix(size);
+		return true;
+	}
+
+	inline void writeBinaryString(std::vector<char> & data, const std::string & str){
+		uint32_t size = str.size();
+		writeBinary(data, &size, sizeof(size));
+		writeBinary(data, str.data(), str.size());
+	}
+
+	inline bool readBinaryString(ofStringView & data, std::string & str){
+		uint32_t size;
+		if(!readBinary(data, &size, sizeof(size)) || data.size() < size){
+			return false;
+		}
+		str.assign(data.data(), size);
+		data.remove_prefix(size);
+		return true;
+	}
+
+	// Types without a more specific form resolve to this and are stored as
+	// their string representation. read() overwrites a value that already
+	// exists so T doesn't need a default constructor
+	template<typename T, typename Enable = void>
+	struct BinaryCodec{
+		static void write(std::vector<char> & data, const T & value){
+			writeBinaryString(data, toStringImpl(value));
+		}
+
+		static bool read(ofStringView & data, T & value){
+			std::string str;
+			if(!readBinaryString(data, str)){
+				return false;
+			}
+			value = fromStringImpl<T>(str);
+			return true;
+		}
+	};
+
+	// Numbers, vectors, colors... are copied as they are in memory
+	template<typename T>
+	struct BinaryCodec<T, typename std::enable_if<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>::type>{
+		static void write(std::vector<char> & data, const T & value){
+			writeBinary(data, &value, sizeof(T));
+		}
+
+		static bool read(ofStringView & data, T & value){
+			return readBinary(data, &value, sizeof(T));
+		}
+	};
+
+	// an address means nothing once restored so pointers aren't serializable
+	template<typename T>
+	struct BinaryCodec<T, typename std::enable_if<std::is_pointer<T>::value>::type>{
+		static void write(std::vector<char> &, const T &){
+			throw std::exception();
+		}
+
+		static bool read(ofStringView &, T &){
+			throw std::exception();
+		}
+	};
+
+	// any other byte than 0 or 1 would be an invalid bool
+	template<>
+	struct BinaryCodec<bool>{
+		static void write(std::vector<char> & data, const bool & value){
+			data.push_back(value ? 1 : 0);
+		}
+
+		static bool read(ofStringView & data, bool & value){
+			if(data.empty() || (data[0] != 0 && data[0] != 1)){
+				return false;
+			}
+			value = data[0] == 1;
+			data.remove_prefix(1);
+			return true;
+		}
+	};
+
+	template<>
+	struct BinaryCodec<std::string>{
+		static void write(std::vector<char> & data, const std::string & value){
+			writeBinaryString(data, value);
+		}
+
+		static bool read(ofStringView & data, std::string & value){
+			return readBinaryString(data, value);
+		}
+	};
 }
 }
 /*! \endcond */
@@ -501,6 +770,9 @@ public:
 	std::string toString() const;
 	void fromString(const std::string & name);
 
+	void toBinary(std::vector<char> & data) const;
+	bool fromBinary(ofStringView & data);
+
 	template<class ListenerClass, typename ListenerMethod>
 	void addListener(ListenerClass * listener, ListenerMethod method, int prio=OF_EVENT_ORDER_AFTER_APP){
 		ofAddListener(obj->changedE,listener,method,prio);
@@ -584,6 +856,7 @@ public:
 	const void* getInternalObject() const;
 
 protected:
+	void notifyListeners();
 
 private:
 	class Value{
@@ -722,6 +995,12 @@ inline void ofParameter<ParameterType>::eventsSetValue(const ParameterType & v){
 	}
 	else
 	{
+		// Inside a batch the listeners are notified when it ends.
+		if(!obj->parents.empty() && ofParameterGroup::addToBatch(obj->parents, *this)){
+			obj->value = v;
+			return;
+		}
+
 		// Mark the object as in its notification loop.
 		obj->bInNotify = true;
 
@@ -760,6 +1039,16 @@ inline void ofParameter<ParameterType>::noEventsSetValue(const ParameterType & v
 	obj->value = v;
 }
 
+template<typename ParameterType>
+void ofParameter<ParameterType>::notifyListeners(){
+	if(obj->bInNotify){
+		return;
+	}
+	obj->bInNotify = true;
+	ofNotifyEvent(obj->changedE,obj->value,this);
+	obj->bInNotify = false;
+}
+
 
 template<typename ParameterType>
 void ofParameter<ParameterType>::setSerializable(bool serializable){
@@ -809,6 +1098,7 @@ inline ofParameter<ParameterType>::operator const ParameterType & () const{
 template<typename ParameterType>
 void ofParameter<ParameterType>::setName(const std::string & name){
 	obj->name = name;
+	ofParameterGroup::parameterRenamed(obj->parents);
 }
 
 template<typename ParameterType>
@@ -835,6 +1125,30 @@ inline void ofParameter<ParameterType>::fromString(const std::string & str){
 	}
 }
 
+template<typename ParameterType>
+inline void ofParameter<ParameterType>::toBinary(std::vector<char> & data) const{
+	try{
+		of::priv::BinaryCodec<ParameterType>::write(data, obj->value);
+	}catch(...){
+		ofLogError("ofParameter") << "Trying to serialize non-serializable parameter";
+	}
+}
+
+template<typename ParameterType>
+inline bool ofParameter<ParameterType>::fromBinary(ofStringView & data){
+	try{
+		ParameterType value = obj->value;
+		if(!of::priv::BinaryCodec<ParameterType>::read(data, value)){
+			return false;
+		}
+		set(value);
+		return true;
+	}catch(...){
+		ofLogError("ofParameter") << "Trying to de-serialize non-serializable parameter";
+		return false;
+	}
+}
+
 template<typename ParameterType>
 void ofParameter<ParameterType>::enableEvents(){
 	setMethod = std::bind(&ofParameter<ParameterType>::eventsSetValue, this, std::placeholders::_1);
@@ -1091,6 +1405,7 @@ public:
 	ParameterType getMax() const;
 
 	std::string toString() const;
+	void toBinary(std::vector<char> & data) const;
 
 	template<class ListenerClass, typename ListenerMethod>
 	void addListener(ListenerClass * listener, ListenerMethod method, int prio=OF_EVENT_ORDER_AFTER_APP);
@@ -1158,6 +1473,7 @@ protected:
 	void setMax(const ParameterType & max);
 
 	void fromString(const std::string & str);
+	bool fromBinary(ofStringView & data);
 
 	void setParent(ofParameterGroup & _parent);
 
@@ -1169,6 +1485,10 @@ protected:
 		return parameter.getInternalObject();
 	}
 
+	void notifyListeners(){
+		parameter.notifyListeners();
+	}
+
 	ofParameter<ParameterType> parameter;
 
 	template<typename T>
@@ -1458,6 +1778,16 @@ inline void ofReadOnlyParameter<ParameterType,Friend>::fromString(const std::str
 	parameter.fromString(str);
 }
 
+template<typename ParameterType,typename Friend>
+inline void ofReadOnlyParameter<ParameterType,Friend>::toBinary(std::vector<char> & data) const{
+	parameter.toBinary(data);
+}
+
+template<typename ParameterType,typename Friend>
+inline bool ofReadOnlyParameter<ParameterType,Friend>::fromBinary(ofStringView & data){
+	return parameter.fromBinary(data);
+}
+
 template<typename ParameterType,typename Friend>
 std::shared_ptr<ofAbstractParameter> ofReadOnlyParameter<ParameterType,Friend>::newReference() const{
 	return std::make_shared<ofReadOnlyParameter<ParameterType,Friend>>(*this);
@@ -1,8 +1,53 @@
 #include "ofUtils.h"
 #include "ofParameter.h"
+#include <atomic>
 
 using namespace std;
 
+namespace{
+	// source of the structure versions of every group
+	std::atomic<uint64_t> nextStructureVersion{0};
+
+	// number of groups in a batch, so setting a parameter only looks for
+	// batches in its parents while there's any
+	std::atomic<int> activeBatches{0};
+
+	// FNV-1a of the escaped name, escaping is idempotent so hashing a name
+	// or its escaped version gives the same result
+	std::size_t hashEscaped(ofStringView name){
+		uint64_t hash = 14695981039346656037ULL;
+		for(auto c: name){
+			hash ^= static_cast<unsigned char>(of::priv::escapeParameterChar(c));
+			hash *= 1099511628211ULL;
+		}
+		return std::size_t(hash);
+	}
+
+	bool equalsEscaped(ofStringView name, const std::string & escapedName){
+		if(name.size() != escapedName.size()){
+			return false;
+		}
+		for(std::size_t i = 0; i < name.size(); i++){
+			if(of::priv::escapeParameterChar(name[i]) != escapedName[i]){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::size_t hashPath(ofStringView path){
+		uint64_t hash = 14695981039346656037ULL;
+		for(auto c: path){
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ULL;
+		}
+		return std::size_t(hash);
+	}
+
+	// so an OSC server receiving random addresses can't make it grow forever
+	const std::size_t maxCachedPaths = 4096;
+}
+
 ofParameterGroup::ofParameterGroup()
 :obj(new Value)
 {
@@ -11,41 +56,51 @@ ofParameterGroup::ofParameterGroup()
 
 void ofParameterGroup::add(ofAbstractParameter & parameter){
 	shared_ptr<ofAbstractParameter> param = parameter.newReference();
-	const std::string name = param->getEscapedName();
-	if(obj->parametersIndex.find(name) != obj->parametersIndex.end()){
+	std::string name = param->getEscapedName();
+	if(obj->find(name) != -1){
 		ofLogWarning() << "Adding another parameter with same name '" << param->getName() << "' to group '" << getName() << "'";
 	}
 	obj->parameters.push_back(param);
-	obj->parametersIndex[name] = obj->parameters.size()-1;
+	obj->parametersIndex.emplace(hashEscaped(name), obj->parameters.size()-1);
+	obj->escapedNames.push_back(std::move(name));
+	obj->structureChanged();
 	param->setParent(*this);
 }
 
 void ofParameterGroup::remove(ofAbstractParameter &param){
-	std::for_each(obj->parameters.begin(), obj->parameters.end(), [&](shared_ptr<ofAbstractParameter>& p){
-		if(p->isReferenceTo(param)){
-			remove(param.getName());
-		}
+	auto found = std::find_if(obj->parameters.begin(), obj->parameters.end(), [&](shared_ptr<ofAbstractParameter>& p){
+		return p->isReferenceTo(param);
 	});
+	if(found != obj->parameters.end()){
+		obj->removeAt(found - obj->parameters.begin());
+	}
 }
 
 void ofParameterGroup::remove(size_t index){
-	if(index>obj->parameters.size()){
+	if(index>=obj->parameters.size()){
 		return;
 	}
-	remove(obj->parameters[index]->getName());
+	obj->removeAt(index);
 }
 
 void ofParameterGroup::remove(const string &name){
-	if(!contains(name)){
+	auto position = obj->find(name);
+	if(position == -1){
 		return;
 	}
-	obj->parameters.erase(obj->parameters.begin() + obj->parametersIndex[name]);
-	obj->parametersIndex.erase(name);
+	obj->removeAt(position);
 }
 
 void ofParameterGroup::clear(){
 	auto name = this->getName();
+	// the batch started on this group has to end on the new value, the old
+	// one releases its own when it's destroyed
+	auto batchDepth = obj->batchDepth;
 	obj.reset(new Value);
+	if(batchDepth > 0){
+		obj->batchDepth = batchDepth;
+		activeBatches++;
+	}
 	setName(name);
 }
 
@@ -315,9 +370,7 @@ string ofParameterGroup::getType(std::size_t position) const{
 
 
 int ofParameterGroup::getPosition(const string& name) const{
-	if(obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end())
-		return obj->parametersIndex.find(escape(name))->second;
-	return -1;
+	return obj->find(name);
 }
 
 string ofParameterGroup::getName() const{
@@ -326,6 +379,7 @@ string ofParameterGroup::getName() const{
 
 void ofParameterGroup::setName(const string & name){
 	obj->name = name;
+	parameterRenamed(obj->parents);
 }
 
 string ofParameterGroup::getEscapedName() const{
@@ -348,9 +402,11 @@ void ofParameterGroup::fromString(const string & name){
 
 
 const ofAbstractParameter & ofParameterGroup::get(const string& name) const{
-	map<string,std::size_t>::const_iterator it = obj->parametersIndex.find(escape(name));
-	std::size_t index = it->second;
-	return get(index);
+	auto parameter = find(name);
+	if(!parameter){
+		throw std::out_of_range(("get(): no parameter named " + name + " in group " + getName()).c_str());
+	}
+	return *parameter;
 }
 
 const ofAbstractParameter & ofParameterGroup::get(std::size_t pos) const{
@@ -367,9 +423,11 @@ const ofAbstractParameter & ofParameterGroup::operator[](std::size_t pos) const{
 }
 
 ofAbstractParameter & ofParameterGroup::get(const string& name){
-	map<string,std::size_t>::const_iterator it = obj->parametersIndex.find(escape(name));
-	std::size_t index = it->second;
-	return get(index);
+	auto parameter = find(name);
+	if(!parameter){
+		throw std::out_of_range(("get(): no parameter named " + name + " in group " + getName()).c_str());
+	}
+	return *parameter;
 }
 
 ofAbstractParameter & ofParameterGroup::get(std::size_t pos){
@@ -401,7 +459,166 @@ ostream& operator<<(ostream& os, const ofParameterGroup& group) {
 }
 
 bool ofParameterGroup::contains(const string& name) const{
-	return obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end();
+	return obj->find(name) != -1;
+}
+
+ofAbstractParameter * ofParameterGroup::find(ofStringView name){
+	auto position = obj->find(name);
+	return position == -1 ? nullptr : obj->parameters[position].get();
+}
+
+const ofAbstractParameter * ofParameterGroup::find(ofStringView name) const{
+	auto position = obj->find(name);
+	return position == -1 ? nullptr : obj->parameters[position].get();
+}
+
+ofAbstractParameter * ofParameterGroup::findPath(ofStringView path){
+	auto hash = hashPath(path);
+	auto version = getStructureVersion();
+	auto cached = obj->pathCache.equal_range(hash);
+	for(auto it = cached.first; it != cached.second; ++it){
+		if(it->second.path == path){
+			if(it->second.version == version){
+				return it->second.parameter;
+			}
+			obj->pathCache.erase(it);
+			break;
+		}
+	}
+
+	auto parameter = obj->findPath(path);
+	if(parameter){
+		if(obj->pathCache.size() >= maxCachedPaths){
+			obj->pathCache.clear();
+		}
+		obj->pathCache.emplace(hash, Value::CachedPath{std::string(path), parameter, version});
+	}
+	return parameter;
+}
+
+const ofAbstractParameter * ofParameterGroup::findPath(ofStringView path) const{
+	return obj->findPath(path);
+}
+
+uint64_t ofParameterGroup::getStructureVersion() const{
+	return obj->structureVersion;
+}
+
+void ofParameterGroup::parameterRenamed(const std::vector<std::weak_ptr<Value>> & parents){
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(parent) parent->namesChanged();
+	}
+}
+
+ofParameterGroup::Value::Value()
+:serializable(true)
+,structureVersion(nextStructureVersion++)
+,batchDepth(0){}
+
+int ofParameterGroup::Value::find(ofStringView name) const{
+	// if there's more than one with the same name the last one added wins
+	int found = -1;
+	auto candidates = parametersIndex.equal_range(hashEscaped(name));
+	for(auto it = candidates.first; it != candidates.second; ++it){
+		if(equalsEscaped(name, escapedNames[it->second])){
+			found = std::max(found, int(it->second));
+		}
+	}
+	return found;
+}
+
+ofAbstractParameter * ofParameterGroup::Value::findPath(ofStringView path) const{
+	ofAbstractParameter * parameter = nullptr;
+	const Value * group = this;
+	ofStringTokenizer components(path, "/", true);
+	ofStringView component;
+	while(components.next(component)){
+		if(!group){
+			// the path continues after a parameter that isn't a group
+			return nullptr;
+		}
+		auto position = group->find(component);
+		if(position == -1){
+			return nullptr;
+		}
+		parameter = group->parameters[position].get();
+		auto subgroup = dynamic_cast<ofParameterGroup*>(parameter);
+		group = subgroup ? subgroup->obj.get() : nullptr;
+	}
+	return parameter;
+}
+
+void ofParameterGroup::Value::removeAt(std::size_t position){
+	parameters.erase(parameters.begin() + position);
+	escapedNames.erase(escapedNames.begin() + position);
+	buildIndex();
+	structureChanged();
+}
+
+void ofParameterGroup::Value::buildIndex(){
+	parametersIndex.clear();
+	for(std::size_t i = 0; i < escapedNames.size(); i++){
+		parametersIndex.emplace(hashEscaped(escapedNames[i]), i);
+	}
+}
+
+void ofParameterGroup::Value::structureChanged(){
+	structureVersion = nextStructureVersion++;
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(parent) parent->structureChanged();
+	}
+}
+
+void ofParameterGroup::Value::namesChanged(){
+	for(std::size_t i = 0; i < parameters.size(); i++){
+		escapedNames[i] = parameters[i]->getEscapedName();
+	}
+	buildIndex();
+	structureChanged();
+}
+
+ofParameterGroup::Value::~Value(){
+	if(batchDepth > 0){
+		activeBatches--;
+	}
+}
+
+bool ofParameterGroup::Value::addToBatch(ofAbstractParameter & param){
+	bool added = false;
+	if(batchDepth > 0){
+		if(batchChanged.insert(param.getInternalObject()).second){
+			batchChanges.parameters.push_back(param.newReference());
+		}
+		added = true;
+	}
+	return ofParameterGroup::addToBatch(parents, param) || added;
+}
+
+shared_ptr<ofParameterGroup::Value> ofParameterGroup::Value::parentInBatch() const{
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(!parent){
+			continue;
+		}
+		if(parent->batchDepth > 0){
+			return parent;
+		}
+		auto ancestor = parent->parentInBatch();
+		if(ancestor){
+			return ancestor;
+		}
+	}
+	return nullptr;
+}
+
+void ofParameterGroup::Value::notifyBatchChanged(const ofParameterChanges & changes){
+	ofNotifyEvent(batchChangedE,changes);
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(parent) parent->notifyBatchChanged(changes);
+	}
 }
 
 void ofParameterGroup::Value::notifyParameterChanged(ofAbstractParameter & param){
@@ -426,6 +643,79 @@ ofEvent<ofAbstractParameter> & ofParameterGroup::parameterChangedE(){
 	return obj->parameterChangedE;
 }
 
+void ofParameterGroup::beginBatch(){
+	if(obj->batchDepth++ == 0){
+		activeBatches++;
+	}
+}
+
+void ofParameterGroup::endBatch(){
+	if(obj->batchDepth == 0){
+		ofLogWarning("ofParameterGroup") << "endBatch(): group " << getName() << " isn't in a batch";
+		return;
+	}
+	if(--obj->batchDepth > 0){
+		return;
+	}
+	activeBatches--;
+
+	ofParameterChanges changes;
+	std::swap(changes, obj->batchChanges);
+	obj->batchChanged.clear();
+	decltype(obj->nestedBatches) nestedBatches;
+	std::swap(nestedBatches, obj->nestedBatches);
+	if(changes.parameters.empty()){
+		return;
+	}
+
+	auto outer = obj->parentInBatch();
+	if(outer){
+		// the parent notifies the changes when its batch ends. It only
+		// recorded the ones done since it started, if it started after this
+		// batch the earlier ones are added now
+		for(auto & parameter: changes.parameters){
+			addToBatch(obj->parents, *parameter);
+		}
+		nestedBatches.emplace_back(obj, std::move(changes));
+		for(auto & batch: nestedBatches){
+			outer->nestedBatches.push_back(std::move(batch));
+		}
+		return;
+	}
+	for(auto & parameter: changes.parameters){
+		parameter->notifyListeners();
+	}
+	obj->notifyBatchChanged(changes);
+	for(auto & batch: nestedBatches){
+		auto group = batch.first.lock();
+		if(group){
+			ofNotifyEvent(group->batchChangedE, batch.second);
+		}
+	}
+}
+
+bool ofParameterGroup::isInBatch() const{
+	return obj->batchDepth > 0;
+}
+
+ofEvent<const ofParameterChanges> & ofParameterGroup::batchChangedE(){
+	return obj->batchChangedE;
+}
+
+bool ofParameterGroup::addToBatch(const std::vector<std::weak_ptr<Value>> & parents, ofAbstractParameter & param){
+	if(activeBatches == 0){
+		return false;
+	}
+	bool added = false;
+	for(auto & p: parents){
+		auto parent = p.lock();
+		if(parent && parent->addToBatch(param)){
+			added = true;
+		}
+	}
+	return added;
+}
+
 ofAbstractParameter & ofParameterGroup::back(){
 	return *obj->parameters.back();
 }
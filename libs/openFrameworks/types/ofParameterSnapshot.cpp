@@ -0,0 +1,358 @@
+#include "ofParameterSnapshot.h"
+
+struct ofParameterSnapshot::Layout{
+	// group this layout was created from and the structure version at that
+	// time, parameters can only be used while both are the same
+	const void * source = nullptr;
+	uint64_t version = 0;
+	std::vector<ofAbstractParameter*> parameters;
+
+	std::vector<std::string> paths;
+	std::vector<std::string> types;
+	uint64_t hash = 14695981039346656037ULL;
+
+	void add(ofStringView path, ofStringView type){
+		paths.emplace_back(path.data(), path.size());
+		types.emplace_back(type.data(), type.size());
+		// FNV-1a of every path and type so snapshots of groups with the same
+		// structure can be compared without comparing all the names
+		for(auto str: {path, type}){
+			for(auto c: str){
+				mix(c);
+			}
+			mix('\0');
+		}
+	}
+
+	void addGroup(const ofParameterGroup & group, const std::string & prefix){
+		for(auto & parameter: group){
+			if(!parameter->isSerializable()){
+				continue;
+			}
+			auto path = prefix + parameter->getEscapedName();
+			auto subgroup = dynamic_cast<const ofParameterGroup*>(parameter.get());
+			if(subgroup){
+				addGroup(*subgroup, path + "/");
+			}else{
+				parameters.push_back(parameter.get());
+				add(path, parameter->valueType());
+			}
+		}
+	}
+
+private:
+	void mix(char c){
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+};
+
+namespace{
+	const char magic[4] = {'o','f','p','s'};
+	const uint8_t formatVersion = 1;
+	const uint8_t deltaFlag = 1;
+	const uint8_t bigEndianFlag = 2;
+
+	bool isBigEndian(){
+		const uint16_t one = 1;
+		return reinterpret_cast<const char*>(&one)[0] == 0;
+	}
+}
+
+ofParameterSnapshot::ofParameterSnapshot()
+:delta(false){}
+
+ofParameterSnapshot::ofParameterSnapshot(const ofParameterGroup & group)
+:delta(false){
+	capture(group);
+}
+
+std::shared_ptr<const ofParameterSnapshot::Layout> ofParameterSnapshot::createLayout(const ofParameterGroup & group){
+	auto layout = std::make_shared<Layout>();
+	layout->source = group.obj.get();
+	layout->version = group.getStructureVersion();
+	layout->addGroup(group, "");
+	return layout;
+}
+
+bool ofParameterSnapshot::isCurrent(const Layout & layout, const ofParameterGroup & group){
+	return layout.source == group.obj.get() && layout.version == group.getStructureVersion();
+}
+
+void ofParameterSnapshot::capture(const ofParameterGroup & group){
+	if(!layout || !isCurrent(*layout, group)){
+		layout = createLayout(group);
+	}
+	delta = false;
+	indices.clear();
+	offsets.clear();
+	offsets.reserve(layout->parameters.size() + 1);
+	data.clear();
+	for(auto parameter: layout->parameters){
+		offsets.push_back(data.size());
+		parameter->toBinary(data);
+	}
+	offsets.push_back(data.size());
+}
+
+std::size_t ofParameterSnapshot::restore(ofParameterGroup & group) const{
+	if(!layout){
+		return 0;
+	}
+
+	// parameters in group for each position in the layout, nullptr for the
+	// ones that aren't in the group anymore
+	std::shared_ptr<const Layout> current;
+	std::vector<ofAbstractParameter*> matched;
+	const std::vector<ofAbstractParameter*> * parameters = &layout->parameters;
+	if(!isCurrent(*layout, group)){
+		current = createLayout(group);
+		parameters = &current->parameters;
+		if(current->hash != layout->hash || current->paths.size() != layout->paths.size()){
+			std::unordered_map<std::string, std::size_t> positions;
+			for(std::size_t i = 0; i < current->paths.size(); i++){
+				positions[current->paths[i]] = i;
+			}
+			matched.resize(layout->paths.size(), nullptr);
+			for(std::size_t i = 0; i < layout->paths.size(); i++){
+				auto position = positions.find(layout->paths[i]);
+				if(position != positions.end() && current->types[position->second] == layout->types[i]){
+					matched[i] = current->parameters[position->second];
+				}
+			}
+			parameters = &matched;
+		}
+	}
+
+	// so listeners are notified once after setting every value
+	ofParameterBatch batch(group);
+	std::size_t restored = 0;
+	for(std::size_t i = 0; i < size(); i++){
+		auto parameter = (*parameters)[getIndex(i)];
+		if(!parameter){
+			continue;
+		}
+		auto value = getValue(i);
+		if(parameter->fromBinary(value)){
+			restored++;
+		}else{
+			ofLogError("ofParameterSnapshot") << "restore(): couldn't read the value of " << layout->paths[getIndex(i)];
+		}
+	}
+	return restored;
+}
+
+ofParameterSnapshot ofParameterSnapshot::diff(const ofParameterSnapshot & base) const{
+	if(!layout){
+		return ofParameterSnapshot();
+	}
+	if(!base.layout || base.delta || base.layout->hash != layout->hash || base.layout->paths.size() != layout->paths.size()){
+		ofLogWarning("ofParameterSnapshot") << "diff(): base isn't a full snapshot of the same group, the result will hold every value";
+		return *this;
+	}
+
+	ofParameterSnapshot changes;
+	changes.layout = layout;
+	changes.delta = true;
+	changes.offsets.push_back(0);
+	for(std::size_t i = 0; i < size(); i++){
+		auto index = getIndex(i);
+		auto value = getValue(i);
+		if(value != base.getValue(index)){
+			changes.indices.push_back(index);
+			changes.data.insert(changes.data.end(), value.begin(), value.end());
+			changes.offsets.push_back(changes.data.size());
+		}
+	}
+	return changes;
+}
+
+void ofParameterSnapshot::apply(const ofParameterSnapshot & changes){
+	if(!changes.layout){
+		return;
+	}
+	if(!layout){
+		*this = changes;
+		return;
+	}
+	if(changes.layout->hash != layout->hash || changes.layout->paths.size() != layout->paths.size()){
+		ofLogError("ofParameterSnapshot") << "apply(): the changes are from a group with a different structure";
+		return;
+	}
+
+	// merge both sorted lists of values, the ones in changes replace the
+	// ones at the same position in this snapshot
+	std::vector<uint32_t> mergedIndices;
+	std::vector<uint32_t> mergedOffsets{0};
+	std::vector<char> mergedData;
+	mergedData.reserve(data.size());
+	std::size_t i = 0, j = 0;
+	while(i < size() || j < changes.size()){
+		std::size_t index;
+		ofStringView value;
+		if(j == changes.size() || (i < size() && getIndex(i) < changes.getIndex(j))){
+			index = getIndex(i);
+			value = getValue(i++);
+		}else{
+			if(i < size() && getIndex(i) == changes.getIndex(j)){
+				i++;
+			}
+			index = changes.getIndex(j);
+			value = changes.getValue(j++);
+		}
+		mergedIndices.push_back(index);
+		mergedData.insert(mergedData.end(), value.begin(), value.end());
+		mergedOffsets.push_back(mergedData.size());
+	}
+
+	if(delta){
+		indices = std::move(mergedIndices);
+	}
+	offsets = std::move(mergedOffsets);
+	data = std::move(mergedData);
+}
+
+bool ofParameterSnapshot::isDelta() const{
+	return delta;
+}
+
+std::size_t ofParameterSnapshot::size() const{
+	return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+bool ofParameterSnapshot::empty() const{
+	return size() == 0;
+}
+
+std::vector<std::string> ofParameterSnapshot::getPaths() const{
+	std::vector<std::string> paths;
+	paths.reserve(size());
+	for(std::size_t i = 0; i < size(); i++){
+		paths.push_back(layout->paths[getIndex(i)]);
+	}
+	return paths;
+}
+
+std::size_t ofParameterSnapshot::getIndex(std::size_t value) const{
+	return delta ? indices[value] : value;
+}
+
+ofStringView ofParameterSnapshot::getValue(std::size_t value) const{
+	return ofStringView(data.data() + offsets[value], offsets[value + 1] - offsets[value]);
+}
+
+ofBuffer ofParameterSnapshot::toBuffer() const{
+	std::vector<char> header;
+	of::priv::writeBinary(header, magic, sizeof(magic));
+	uint8_t flags = (delta ? deltaFlag : 0) | (isBigEndian() ? bigEndianFlag : 0);
+	of::priv::writeBinary(header, &formatVersion, 1);
+	of::priv::writeBinary(header, &flags, 1);
+
+	uint32_t numParameters = layout ? layout->paths.size() : 0;
+	of::priv::writeBinary(header, &numParameters, sizeof(numParameters));
+	for(uint32_t i = 0; i < numParameters; i++){
+		of::priv::writeBinaryString(header, layout->paths[i]);
+		of::priv::writeBinaryString(header, layout->types[i]);
+	}
+
+	uint32_t numValues = size();
+	of::priv::writeBinary(header, &numValues, sizeof(numValues));
+
+	ofBuffer buffer;
+	buffer.reserve(header.size() + (indices.size() + offsets.size()) * sizeof(uint32_t) + data.size());
+	buffer.append(header.data(), header.size());
+	if(delta){
+		buffer.append(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+	}
+	if(numValues){
+		buffer.append(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+		buffer.append(data.data(), data.size());
+	}
+	return buffer;
+}
+
+bool ofParameterSnapshot::fromBuffer(const ofBuffer & buffer){
+	ofStringView source(buffer.getData(), buffer.size());
+	char fileMagic[4];
+	uint8_t version, flags;
+	if(!of::priv::readBinary(source, fileMagic, sizeof(fileMagic)) || memcmp(fileMagic, magic, sizeof(magic)) != 0 ||
+	   !of::priv::readBinary(source, &version, 1) || !of::priv::readBinary(source, &flags, 1)){
+		ofLogError("ofParameterSnapshot") << "fromBuffer(): not a parameter snapshot";
+		return false;
+	}
+	if(version != formatVersion){
+		ofLogError("ofParameterSnapshot") << "fromBuffer(): unsupported version " << int(version);
+		return false;
+	}
+	if(bool(flags & bigEndianFlag) != isBigEndian()){
+		ofLogError("ofParameterSnapshot") << "fromBuffer(): snapshot saved on a machine with a different byte order";
+		return false;
+	}
+
+	auto invalid = [&]{
+		ofLogError("ofParameterSnapshot") << "fromBuffer(): corrupted snapshot";
+		return false;
+	};
+
+	auto newLayout = std::make_shared<Layout>();
+	uint32_t numParameters;
+	if(!of::priv::readBinary(source, &numParameters, sizeof(numParameters))){
+		return invalid();
+	}
+	std::string path, type;
+	for(uint32_t i = 0; i < numParameters; i++){
+		if(!of::priv::readBinaryString(source, path) || !of::priv::readBinaryString(source, type)){
+			return invalid();
+		}
+		newLayout->add(path, type);
+	}
+
+	uint32_t numValues;
+	if(!of::priv::readBinary(source, &numValues, sizeof(numValues))){
+		return invalid();
+	}
+	bool newDelta = flags & deltaFlag;
+	if((!newDelta && numValues != numParameters) || numValues > numParameters){
+		return invalid();
+	}
+	std::vector<uint32_t> newIndices(newDelta ? numValues : 0);
+	std::vector<uint32_t> newOffsets(numValues ? numValues + 1 : 0);
+	if(!of::priv::readBinary(source, newIndices.data(), newIndices.size() * sizeof(uint32_t)) ||
+	   !of::priv::readBinary(source, newOffsets.data(), newOffsets.size() * sizeof(uint32_t))){
+		return invalid();
+	}
+	for(std::size_t i = 0; i < newIndices.size(); i++){
+		if(newIndices[i] >= numParameters || (i > 0 && newIndices[i] <= newIndices[i - 1])){
+			return invalid();
+		}
+	}
+	for(std::size_t i = 0; i < newOffsets.size(); i++){
+		if((i == 0 && newOffsets[i] != 0) || (i > 0 && newOffsets[i] < newOffsets[i - 1])){
+			return invalid();
+		}
+	}
+	std::size_t dataSize = newOffsets.empty() ? 0 : newOffsets.back();
+	if(source.size() != dataSize){
+		return invalid();
+	}
+
+	layout = newLayout;
+	delta = newDelta;
+	indices = std::move(newIndices);
+	offsets = std::move(newOffsets);
+	data.assign(source.begin(), source.end());
+	return true;
+}
+
+bool ofParameterSnapshot::save(const std::filesystem::path & path) const{
+	return ofBufferToFile(path, toBuffer(), true);
+}
+
+bool ofParameterSnapshot::load(const std::filesystem::path & path){
+	ofBuffer buffer = ofBufferFromFile(path, ofBufferMode::Mapped);
+	if(!buffer.size()){
+		ofLogError("ofParameterSnapshot") << "load(): couldn't read " << path;
+		return false;
+	}
+	return fromBuffer(buffer);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ofParameter.h"
+#include "ofFileUtils.h"
+
+/// \file
+/// Binary snapshots of the values in an ofParameterGroup.
+///
+/// ~~~~{.cpp}
+/// ofParameterSnapshot preset(parameters);
+/// preset.save("preset.bin");
+/// ...
+/// ofParameterSnapshot loaded;
+/// if(loaded.load("preset.bin")){
+/// 	loaded.restore(parameters);
+/// }
+/// ~~~~
+///
+/// Or to send only what changed every frame:
+///
+/// ~~~~{.cpp}
+/// current.capture(parameters);
+/// auto changes = current.diff(previous);
+/// if(!changes.empty()){
+/// 	send(changes.toBuffer());
+/// }
+/// std::swap(previous, current);
+/// ~~~~
+
+/// \brief The values of every serializable parameter in a group and its
+/// subgroups, in a compact binary form.
+///
+/// Values are stored with ofAbstractParameter::toBinary, so numbers,
+/// vectors and colors are copied as they are in memory instead of being
+/// converted to text. The names and types of the parameters are only
+/// computed again when the structure of the group changes, and are shared
+/// by snapshots of the same group so capturing a group every frame only
+/// copies its values.
+///
+/// A snapshot can also be a delta, created by diff, that holds only the
+/// values that changed since another snapshot.
+///
+/// Binary files are in the native byte order and use the type names
+/// returned by ofAbstractParameter::valueType, so they can only be loaded
+/// by applications built with the same compiler on machines with the same
+/// endianness.
+class ofParameterSnapshot{
+public:
+	ofParameterSnapshot();
+	ofParameterSnapshot(const ofParameterGroup & group);
+
+	/// \brief Stores the current values of the parameters in group.
+	void capture(const ofParameterGroup & group);
+
+	/// \brief Sets the parameters in group to the stored values.
+	///
+	/// Parameters are matched by position if group has the same structure
+	/// it had when the snapshot was captured, otherwise by path and type so
+	/// parameters that were added or removed since are skipped.
+	///
+	/// The values are set in a batch, so each parameter notifies its
+	/// listeners once and the group notifies batchChangedE with every
+	/// parameter that was set, see ofParameterGroup::beginBatch.
+	///
+	/// \returns the number of parameters that were set.
+	std::size_t restore(ofParameterGroup & group) const;
+
+	/// \brief Creates a delta with the values in this snapshot that are
+	/// different in base.
+	///
+	/// base has to be a full snapshot of a group with the same structure,
+	/// otherwise the result holds every value in this one.
+	ofParameterSnapshot diff(const ofParameterSnapshot & base) const;
+
+	/// \brief Replaces the values in this snapshot with the ones in delta.
+	void apply(const ofParameterSnapshot & delta);
+
+	/// \returns true if this snapshot was created by diff and only holds
+	/// some of the values.
+	bool isDelta() const;
+
+	/// \returns the number of values stored.
+	std::size_t size() const;
+	bool empty() const;
+
+	/// \returns the paths of the parameters with a stored value, relative to
+	/// the captured group, ie. "sub/param".
+	std::vector<std::string> getPaths() const;
+
+	ofBuffer toBuffer() const;
+
+	/// \returns false if buffer doesn't contain a valid snapshot.
+	bool fromBuffer(const ofBuffer & buffer);
+
+	bool save(const std::filesystem::path & path) const;
+	bool load(const std::filesystem::path & path);
+
+private:
+	struct Layout;
+
+	static std::shared_ptr<const Layout> createLayout(const ofParameterGroup & group);
+	static bool isCurrent(const Layout & layout, const ofParameterGroup & group);
+	std::size_t getIndex(std::size_t value) const;
+	ofStringView getValue(std::size_t value) const;
+
+	std::shared_ptr<const Layout> layout;
+	// position in the layout of each value, only for deltas, full snapshots
+	// have every value in order
+	std::vector<uint32_t> indices;
+	// start of each value in data plus the end of the last one
+	std::vector<uint32_t> offsets;
+	std::vector<char> data;
+	bool delta;
+};
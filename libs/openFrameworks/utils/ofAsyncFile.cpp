@@ -0,0 +1,722 @@
+#include "ofAsyncFile.h"
+#include "ofLog.h"
+#include "ofTaskPool.h"
+#include "ofUtils.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#ifdef TARGET_WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
+// io_uring is used through its system calls directly so it doesn't need
+// liburing, only kernel headers recent enough to have it
+#if defined(TARGET_LINUX) && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+		#include <linux/io_uring.h>
+		#include <sys/mman.h>
+		#include <sys/syscall.h>
+		#include <sys/uio.h>
+		#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+			#define OF_ASYNC_FILE_IO_URING
+		#endif
+	#endif
+#endif
+
+using namespace std;
+
+//--------------------------------------------------------------
+struct ofAsyncFile::Handle{
+#ifdef TARGET_WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	~Handle(){
+		if(file != INVALID_HANDLE_VALUE){
+			CloseHandle(file);
+		}
+	}
+#else
+	int fd = -1;
+	~Handle(){
+		if(fd != -1){
+			::close(fd);
+		}
+	}
+#endif
+};
+
+//--------------------------------------------------------------
+struct ofAsyncFileService::Request{
+	bool write = false;
+	// keeps the file open until the request completes
+	std::shared_ptr<ofAsyncFile::Handle> file;
+	char * data = nullptr;
+	std::size_t size = 0;
+	uint64_t offset = 0;
+	ofAsyncFileResult result;
+	ofAsyncFile::Callback callback;
+	ofEventQueue * queue = nullptr;
+#ifdef OF_ASYNC_FILE_IO_URING
+	iovec iov;
+#endif
+};
+
+//--------------------------------------------------------------
+class ofAsyncFileService::Backend{
+public:
+	virtual ~Backend(){}
+	virtual void submit(std::vector<std::unique_ptr<Request>> & requests) = 0;
+	virtual bool isIoUring() const = 0;
+};
+
+namespace{
+	typedef ofAsyncFileService::Request Request;
+
+#ifdef TARGET_WIN32
+	const int notOpenError = ERROR_INVALID_HANDLE;
+#else
+	const int notOpenError = EBADF;
+#endif
+
+#ifdef HAS_TLS
+	thread_local ofAsyncFileBatch * currentBatch = nullptr;
+#endif
+
+	void complete(std::unique_ptr<Request> request){
+		auto result = request->result;
+		auto callback = std::move(request->callback);
+		auto queue = request->queue;
+		// release the file before notifying so closing it in the callback
+		// really closes it
+		request.reset();
+		if(!callback){
+			return;
+		}
+		if(queue){
+			queue->post([callback, result]{
+				callback(result);
+			});
+		}else{
+			try{
+				callback(result);
+			}catch(std::exception & e){
+				ofLogError("ofAsyncFile") << "exception in completion callback: " << e.what();
+			}catch(...){
+				ofLogError("ofAsyncFile") << "unknown exception in completion callback";
+			}
+		}
+	}
+
+	// blocking read or write of a whole request, stops early only at the
+	// end of the file or on error
+	void transfer(Request & request){
+		while(request.result.bytes < request.size){
+			auto data = request.data + request.result.bytes;
+			auto remaining = request.size - request.result.bytes;
+			auto offset = request.offset + request.result.bytes;
+#ifdef TARGET_WIN32
+			OVERLAPPED overlapped;
+			memset(&overlapped, 0, sizeof(overlapped));
+			overlapped.Offset = DWORD(offset);
+			overlapped.OffsetHigh = DWORD(offset >> 32);
+			DWORD chunk = DWORD(std::min<std::size_t>(remaining, 1 << 30));
+			DWORD transferred = 0;
+			auto ok = request.write ?
+				WriteFile(request.file->file, data, chunk, &transferred, &overlapped) :
+				ReadFile(request.file->file, data, chunk, &transferred, &overlapped);
+			if(!ok){
+				auto error = GetLastError();
+				if(error != ERROR_HANDLE_EOF){
+					request.result.error = error;
+				}
+				return;
+			}
+#else
+			auto transferred = request.write ?
+				pwrite(request.file->fd, data, remaining, offset) :
+				pread(request.file->fd, data, remaining, offset);
+			if(transferred < 0){
+				if(errno == EINTR){
+					continue;
+				}
+				request.result.error = errno;
+				return;
+			}
+#endif
+			if(transferred == 0){
+				return;
+			}
+			request.result.bytes += transferred;
+		}
+	}
+
+	// blocking reads and writes in a pool of threads of its own, so they
+	// don't take the threads of the shared task pool
+	class ThreadBackend: public ofAsyncFileService::Backend{
+	public:
+		ThreadBackend(std::size_t numThreads)
+		:pool(std::max(numThreads, std::size_t(1)))
+		,group(pool){}
+
+		~ThreadBackend(){
+			group.wait();
+		}
+
+		void submit(std::vector<std::unique_ptr<Request>> & requests){
+			for(auto & request: requests){
+				auto r = request.release();
+				group.run([r]{
+					std::unique_ptr<Request> request(r);
+					transfer(*request);
+					complete(std::move(request));
+				});
+			}
+		}
+
+		bool isIoUring() const{
+			return false;
+		}
+
+	private:
+		ofTaskPool pool;
+		ofTaskGroup group;
+	};
+
+#ifdef OF_ASYNC_FILE_IO_URING
+	int ioUringSetup(unsigned entries, io_uring_params & params){
+		return syscall(__NR_io_uring_setup, entries, &params);
+	}
+
+	int ioUringEnter(int ring, unsigned toSubmit, unsigned minComplete, unsigned flags){
+		return syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, 0);
+	}
+
+	// one submission and one completion ring shared with the kernel.
+	// submitting threads fill the submission ring under a mutex and a
+	// thread of its own waits for completions
+	class IoUringBackend: public ofAsyncFileService::Backend{
+	public:
+		IoUringBackend(std::size_t numThreads)
+		:numThreads(numThreads){}
+
+		~IoUringBackend(){
+			if(ring == -1){
+				return;
+			}
+			if(reaper.joinable()){
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					idle.wait(lock, [this]{
+						return inFlight == 0 && waiting.empty();
+					});
+					stopping = true;
+				}
+				pending.notify_all();
+				reaper.join();
+			}
+			// requests the ring couldn't take
+			fallback.reset();
+			if(sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+			if(cqRing != MAP_FAILED) munmap(cqRing, cqRingSize);
+			if(sqes != MAP_FAILED) munmap(sqes, sqesSize);
+			::close(ring);
+		}
+
+		bool setup(unsigned depth){
+			io_uring_params params;
+			memset(&params, 0, sizeof(params));
+			ring = ioUringSetup(depth, params);
+			if(ring < 0){
+				ring = -1;
+				return false;
+			}
+			entries = params.sq_entries;
+			sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+			cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+			sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+			if(sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED){
+				return false;
+			}
+			auto sq = static_cast<char*>(sqRing);
+			sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+			sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+			sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+			auto cq = static_cast<char*>(cqRing);
+			cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+			cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+			cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+			cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+			reaper = std::thread(&IoUringBackend::reap, this);
+			return true;
+		}
+
+		void submit(std::vector<std::unique_ptr<Request>> & requests){
+			std::unique_lock<std::mutex> lock(mutex);
+			for(auto & request: requests){
+				waiting.push_back(request.release());
+			}
+			fill();
+		}
+
+		bool isIoUring() const{
+			return true;
+		}
+
+	private:
+		// moves waiting requests to the submission ring while there's room
+		// and submits them with a single call. the completion ring is twice
+		// as big as the submission ring so it can't overflow while no more
+		// than entries requests are in flight
+		void fill(){
+			if(fallback){
+				std::vector<std::unique_ptr<Request>> requests;
+				for(auto request: waiting){
+					requests.emplace_back(request);
+				}
+				waiting.clear();
+				// partial transfers continue from the bytes already done
+				fallback->submit(requests);
+				return;
+			}
+			unsigned count = 0;
+			auto tail = *sqTail;
+			auto sqeArray = static_cast<io_uring_sqe*>(sqes);
+			while(inFlight < entries && !waiting.empty()){
+				auto request = waiting.front();
+				waiting.pop_front();
+				auto index = tail & sqMask;
+				auto & sqe = sqeArray[index];
+				memset(&sqe, 0, sizeof(sqe));
+				request->iov.iov_base = request->data + request->result.bytes;
+				request->iov.iov_len = request->size - request->result.bytes;
+				sqe.opcode = request->write ? IORING_OP_WRITEV : IORING_OP_READV;
+				sqe.fd = request->file->fd;
+				sqe.addr = uint64_t(uintptr_t(&request->iov));
+				sqe.len = 1;
+				sqe.off = request->offset + request->result.bytes;
+				sqe.user_data = uint64_t(uintptr_t(request));
+				sqArray[index] = index;
+				tail++;
+				count++;
+				inFlight++;
+			}
+			if(count == 0){
+				return;
+			}
+			__atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+			while(count > 0){
+				auto submitted = ioUringEnter(ring, count, 0, 0);
+				if(submitted < 0){
+					if(errno == EINTR || errno == EAGAIN){
+						continue;
+					}
+					ofLogError("ofAsyncFile") << "io_uring submit failed: " << strerror(errno) << ", using threads";
+					useThreads(tail, count);
+					break;
+				}
+				count -= submitted;
+			}
+			pending.notify_all();
+		}
+
+		// the kernel didn't take the last count entries before tail, take
+		// them back and run them and every later request on threads
+		void useThreads(unsigned tail, unsigned count){
+			auto sqeArray = static_cast<io_uring_sqe*>(sqes);
+			for(auto i = tail; i != tail - count; i--){
+				waiting.push_front(reinterpret_cast<Request*>(uintptr_t(sqeArray[(i - 1) & sqMask].user_data)));
+			}
+			__atomic_store_n(sqTail, tail - count, __ATOMIC_RELEASE);
+			inFlight -= count;
+			fallback.reset(new ThreadBackend(numThreads));
+			fill();
+			if(inFlight == 0){
+				idle.notify_all();
+			}
+		}
+
+		void reap(){
+			std::vector<std::unique_ptr<Request>> done;
+			std::vector<Request*> partial;
+			while(true){
+				{
+					// only wait in the kernel while there's something to
+					// wait for, so stopping doesn't need a request
+					std::unique_lock<std::mutex> lock(mutex);
+					pending.wait(lock, [this]{
+						return inFlight > 0 || stopping;
+					});
+					if(inFlight == 0){
+						return;
+					}
+				}
+				if(ioUringEnter(ring, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR){
+					ofLogError("ofAsyncFile") << "io_uring wait failed: " << strerror(errno);
+					return;
+				}
+				auto head = *cqHead;
+				auto tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+				unsigned reaped = 0;
+				for(; head != tail; head++, reaped++){
+					auto & cqe = cqes[head & cqMask];
+					auto request = reinterpret_cast<Request*>(uintptr_t(cqe.user_data));
+					if(cqe.res == -EINTR || cqe.res == -EAGAIN){
+						partial.push_back(request);
+					}else if(cqe.res < 0){
+						request->result.error = -cqe.res;
+						done.emplace_back(request);
+					}else{
+						request->result.bytes += cqe.res;
+						if(cqe.res == 0 || request->result.bytes == request->size){
+							done.emplace_back(request);
+						}else{
+							// short read or write, submit the rest like transfer() does
+							partial.push_back(request);
+						}
+					}
+				}
+				__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					inFlight -= reaped;
+					for(auto request: partial){
+						waiting.push_front(request);
+					}
+					fill();
+				}
+				partial.clear();
+
+				for(auto & request: done){
+					complete(std::move(request));
+				}
+				done.clear();
+
+				std::unique_lock<std::mutex> lock(mutex);
+				if(inFlight == 0 && waiting.empty()){
+					idle.notify_all();
+				}
+			}
+		}
+
+		int ring = -1;
+		unsigned entries = 0;
+		void * sqRing = MAP_FAILED;
+		void * cqRing = MAP_FAILED;
+		void * sqes = MAP_FAILED;
+		std::size_t sqRingSize = 0;
+		std::size_t cqRingSize = 0;
+		std::size_t sqesSize = 0;
+		unsigned * sqTail = nullptr;
+		unsigned * sqArray = nullptr;
+		unsigned sqMask = 0;
+		unsigned * cqHead = nullptr;
+		unsigned * cqTail = nullptr;
+		unsigned cqMask = 0;
+		io_uring_cqe * cqes = nullptr;
+
+		std::mutex mutex;
+		std::condition_variable idle;
+		std::condition_variable pending;
+		std::deque<Request*> waiting;
+		unsigned inFlight = 0;
+		bool stopping = false;
+		std::thread reaper;
+		std::size_t numThreads;
+		std::unique_ptr<ThreadBackend> fallback;
+	};
+#endif
+}
+
+//--------------------------------------------------------------
+ofAsyncFileService::ofAsyncFileService(const ofAsyncFileSettings & settings)
+:settings(settings){
+#ifdef OF_ASYNC_FILE_IO_URING
+	if(settings.useIoUring){
+		std::unique_ptr<IoUringBackend> ioUring(new IoUringBackend(settings.numThreads));
+		if(ioUring->setup(std::max(settings.queueDepth, std::size_t(1)))){
+			backend = std::move(ioUring);
+		}else{
+			ofLogVerbose("ofAsyncFile") << "io_uring not available, using threads";
+		}
+	}
+#endif
+	if(!backend){
+		backend.reset(new ThreadBackend(settings.numThreads));
+	}
+}
+
+//--------------------------------------------------------------
+ofAsyncFileService::~ofAsyncFileService(){
+}
+
+//--------------------------------------------------------------
+bool ofAsyncFileService::isUsingIoUring() const{
+	return backend->isIoUring();
+}
+
+//--------------------------------------------------------------
+const ofAsyncFileSettings & ofAsyncFileService::getSettings() const{
+	return settings;
+}
+
+//--------------------------------------------------------------
+void ofAsyncFileService::submit(std::unique_ptr<Request> request){
+	std::vector<std::unique_ptr<Request>> requests;
+	requests.push_back(std::move(request));
+	submit(requests);
+}
+
+//--------------------------------------------------------------
+void ofAsyncFileService::submit(std::vector<std::unique_ptr<Request>> & requests){
+	if(!requests.empty()){
+		backend->submit(requests);
+		requests.clear();
+	}
+}
+
+//--------------------------------------------------------------
+ofAsyncFileService & ofGetAsyncFileService(){
+	static ofAsyncFileService * service = new ofAsyncFileService;
+	return *service;
+}
+
+//--------------------------------------------------------------
+ofAsyncFile::ofAsyncFile(ofAsyncFileService & service)
+:service(&service){
+}
+
+//--------------------------------------------------------------
+ofAsyncFile::ofAsyncFile(const std::filesystem::path & path, ofFile::Mode mode, ofAsyncFileService & service)
+:service(&service){
+	open(path, mode);
+}
+
+//--------------------------------------------------------------
+bool ofAsyncFile::open(const std::filesystem::path & path, ofFile::Mode mode){
+	close();
+	auto fullPath = std::filesystem::path(ofToDataPath(path));
+	auto file = std::make_shared<Handle>();
+#ifdef TARGET_WIN32
+	DWORD access = 0;
+	DWORD creation = 0;
+	switch(mode){
+	case ofFile::ReadOnly:
+		access = GENERIC_READ;
+		creation = OPEN_EXISTING;
+		break;
+	case ofFile::WriteOnly:
+		access = GENERIC_WRITE;
+		creation = CREATE_ALWAYS;
+		break;
+	case ofFile::ReadWrite:
+		access = GENERIC_READ | GENERIC_WRITE;
+		creation = OPEN_ALWAYS;
+		break;
+	case ofFile::Append:
+		access = FILE_APPEND_DATA;
+		creation = OPEN_ALWAYS;
+		break;
+	default:
+		ofLogError("ofAsyncFile") << "open(): can't open \"" << path.string() << "\" as a reference";
+		return false;
+	}
+	file->file = CreateFileW(fullPath.wstring().c_str(), access, FILE_SHARE_READ, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file->file == INVALID_HANDLE_VALUE){
+		ofLogError("ofAsyncFile") << "open(): couldn't open \"" << path.string() << "\", error " << GetLastError();
+		return false;
+	}
+#else
+	int flags = 0;
+	switch(mode){
+	case ofFile::ReadOnly:
+		flags = O_RDONLY;
+		break;
+	case ofFile::WriteOnly:
+		flags = O_WRONLY | O_CREAT | O_TRUNC;
+		break;
+	case ofFile::ReadWrite:
+		flags = O_RDWR | O_CREAT;
+		break;
+	case ofFile::Append:
+		flags = O_WRONLY | O_CREAT | O_APPEND;
+		break;
+	default:
+		ofLogError("ofAsyncFile") << "open(): can't open \"" << path.string() << "\" as a reference";
+		return false;
+	}
+	file->fd = ::open(fullPath.c_str(), flags | O_CLOEXEC, 0644);
+	if(file->fd == -1){
+		ofLogError("ofAsyncFile") << "open(): couldn't open \"" << path.string() << "\": " << strerror(errno);
+		return false;
+	}
+#endif
+	handle = file;
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofAsyncFile::close(){
+	handle.reset();
+}
+
+//--------------------------------------------------------------
+bool ofAsyncFile::isOpen() const{
+	return handle != nullptr;
+}
+
+//--------------------------------------------------------------
+uint64_t ofAsyncFile::getSize() const{
+	if(!handle){
+		return 0;
+	}
+#ifdef TARGET_WIN32
+	LARGE_INTEGER size;
+	return GetFileSizeEx(handle->file, &size) ? size.QuadPart : 0;
+#else
+	struct stat info;
+	return fstat(handle->fd, &info) == 0 ? info.st_size : 0;
+#endif
+}
+
+//--------------------------------------------------------------
+std::future<ofAsyncFileResult> ofAsyncFile::read(void * data, std::size_t size, uint64_t offset){
+	auto promise = std::make_shared<std::promise<ofAsyncFileResult>>();
+	auto future = promise->get_future();
+	read(data, size, offset, [promise](const ofAsyncFileResult & result){
+		promise->set_value(result);
+	});
+	return future;
+}
+
+//--------------------------------------------------------------
+void ofAsyncFile::read(void * data, std::size_t size, uint64_t offset, Callback callback, ofEventQueue * queue){
+	std::unique_ptr<ofAsyncFileService::Request> request(new ofAsyncFileService::Request);
+	request->data = static_cast<char*>(data);
+	request->size = size;
+	request->offset = offset;
+	request->callback = std::move(callback);
+	request->queue = queue;
+	submit(std::move(request));
+}
+
+//--------------------------------------------------------------
+std::future<ofAsyncFileResult> ofAsyncFile::write(const void * data, std::size_t size, uint64_t offset){
+	auto promise = std::make_shared<std::promise<ofAsyncFileResult>>();
+	auto future = promise->get_future();
+	write(data, size, offset, [promise](const ofAsyncFileResult & result){
+		promise->set_value(result);
+	});
+	return future;
+}
+
+//--------------------------------------------------------------
+void ofAsyncFile::write(const void * data, std::size_t size, uint64_t offset, Callback callback, ofEventQueue * queue){
+	std::unique_ptr<ofAsyncFileService::Request> request(new ofAsyncFileService::Request);
+	request->write = true;
+	// the kernel and the io threads never write to the data of a write
+	request->data = const_cast<char*>(static_cast<const char*>(data));
+	request->size = size;
+	request->offset = offset;
+	request->callback = std::move(callback);
+	request->queue = queue;
+	submit(std::move(request));
+}
+
+//--------------------------------------------------------------
+void ofAsyncFile::submit(std::unique_ptr<ofAsyncFileService::Request> request){
+	if(!handle){
+		ofLogError("ofAsyncFile") << "trying to read or write a file that isn't open";
+		request->result.error = notOpenError;
+		complete(std::move(request));
+		return;
+	}
+	if(request->size == 0){
+		complete(std::move(request));
+		return;
+	}
+	request->file = handle;
+#ifdef HAS_TLS
+	if(currentBatch && &currentBatch->service == service){
+		currentBatch->requests.push_back(std::move(request));
+		return;
+	}
+#endif
+	service->submit(std::move(request));
+}
+
+//--------------------------------------------------------------
+ofAsyncFileBatch::ofAsyncFileBatch(ofAsyncFileService & service)
+:service(service)
+,previous(nullptr){
+#ifdef HAS_TLS
+	previous = currentBatch;
+	currentBatch = this;
+#endif
+}
+
+//--------------------------------------------------------------
+ofAsyncFileBatch::~ofAsyncFileBatch(){
+	submit();
+#ifdef HAS_TLS
+	currentBatch = previous;
+#endif
+}
+
+//--------------------------------------------------------------
+void ofAsyncFileBatch::submit(){
+	service.submit(requests);
+}
+
+//--------------------------------------------------------------
+std::future<ofBuffer> ofBufferFromFileAsync(const std::filesystem::path & path, ofAsyncFileService & service){
+	auto promise = std::make_shared<std::promise<ofBuffer>>();
+	auto future = promise->get_future();
+	auto file = std::make_shared<ofAsyncFile>(service);
+	if(!file->open(path, ofFile::ReadOnly)){
+		promise->set_value(ofBuffer());
+		return future;
+	}
+	auto buffer = std::make_shared<ofBuffer>();
+	buffer->allocate(file->getSize());
+	file->read(buffer->getData(), buffer->size(), 0, [promise, buffer, file, path](const ofAsyncFileResult & result){
+		if(!result.success()){
+			ofLogError("ofAsyncFile") << "ofBufferFromFileAsync(): couldn't read \"" << path.string() << "\", error " << result.error;
+			buffer->clear();
+		}else{
+			buffer->resize(result.bytes);
+		}
+		file->close();
+		promise->set_value(std::move(*buffer));
+	});
+	return future;
+}
+
+//--------------------------------------------------------------
+std::future<bool> ofBufferToFileAsync(const std::filesystem::path & path, ofBuffer buffer, ofAsyncFileService & service){
+	auto promise = std::make_shared<std::promise<bool>>();
+	auto future = promise->get_future();
+	auto file = std::make_shared<ofAsyncFile>(service);
+	if(!file->open(path, ofFile::WriteOnly)){
+		promise->set_value(false);
+		return future;
+	}
+	auto data = std::make_shared<ofBuffer>(std::move(buffer));
+	file->write(data->getData(), data->size(), 0, [promise, data, file, path](const ofAsyncFileResult & result){
+		if(!result.success()){
+			ofLogError("ofAsyncFile") << "ofBufferToFileAsync(): couldn't write \"" << path.string() << "\", error " << result.error;
+		}
+		file->close();
+		promise->set_value(result.success() && result.bytes == data->size());
+	});
+	return future;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include "ofEventQueue.h"
+#include <functional>
+#include <future>
+
+/// \file
+/// Reads and writes files without blocking the calling thread.
+///
+/// ~~~~{.cpp}
+/// ofAsyncFile file("recording.raw", ofFile::WriteOnly);
+/// file.write(frame.getData(), frame.size(), frameNum * frame.size(),
+/// 	[](const ofAsyncFileResult & result){
+/// 		if(!result.success()) ofLogError() << "couldn't write frame";
+/// 	});
+/// ~~~~
+///
+/// Requests go to an ofAsyncFileService, which uses io_uring on linux
+/// when the kernel supports it and a few threads doing blocking reads and
+/// writes anywhere else. The data passed to a read or write has to stay
+/// valid until it completes.
+
+/// \brief Result of an asynchronous read or write.
+struct ofAsyncFileResult{
+	/// Bytes read or written. Less than requested only at the end of the
+	/// file or on error.
+	std::size_t bytes = 0;
+
+	/// 0 on success, otherwise the errno, or GetLastError() on windows, of
+	/// the failure.
+	int error = 0;
+
+	bool success() const{
+		return error == 0;
+	}
+};
+
+/// \brief Settings for an ofAsyncFileService.
+struct ofAsyncFileSettings{
+	/// Maximum number of requests in flight at once with io_uring, more
+	/// requests wait in a queue until others complete.
+	std::size_t queueDepth = 64;
+
+	/// Threads doing the reads and writes when io_uring isn't available.
+	std::size_t numThreads = 4;
+
+	/// Set to false to always use threads.
+	bool useIoUring = true;
+};
+
+/// \brief Does the reads and writes of ofAsyncFile.
+///
+/// Usually there's no need to create one, ofGetAsyncFileService() returns
+/// a service shared by the whole application.
+class ofAsyncFileService{
+public:
+	ofAsyncFileService(const ofAsyncFileSettings & settings = ofAsyncFileSettings());
+
+	/// \brief Waits for every pending request to complete.
+	~ofAsyncFileService();
+	ofAsyncFileService(const ofAsyncFileService &) = delete;
+	ofAsyncFileService & operator=(const ofAsyncFileService &) = delete;
+
+	/// \returns true if requests go through io_uring, false if they use
+	/// threads.
+	bool isUsingIoUring() const;
+
+	const ofAsyncFileSettings & getSettings() const;
+
+	class Backend;
+	struct Request;
+
+private:
+	friend class ofAsyncFile;
+	friend class ofAsyncFileBatch;
+	void submit(std::unique_ptr<Request> request);
+	void submit(std::vector<std::unique_ptr<Request>> & requests);
+
+	ofAsyncFileSettings settings;
+	std::unique_ptr<Backend> backend;
+};
+
+/// \brief Service shared by the whole application.
+ofAsyncFileService & ofGetAsyncFileService();
+
+/// \brief A file to read from and write to without blocking.
+///
+/// Every read and write has an explicit offset, so many of them can be in
+/// flight at once. Completions come as a future or as a callback that
+/// runs on an I/O thread, or on the thread that drains an ofEventQueue if
+/// one is passed. Passing &ofGetMainEventQueue() runs it on the main
+/// thread when that queue is drained, at the beginning of the next frame
+/// before the update listeners, so only while the main loop is running.
+///
+/// Closing the file or destroying it while requests are pending is safe,
+/// the file is closed once they complete.
+class ofAsyncFile{
+public:
+	typedef std::function<void(const ofAsyncFileResult &)> Callback;
+
+	ofAsyncFile(ofAsyncFileService & service = ofGetAsyncFileService());
+	ofAsyncFile(const std::filesystem::path & path, ofFile::Mode mode = ofFile::ReadOnly, ofAsyncFileService & service = ofGetAsyncFileService());
+
+	/// \brief Opens a file relative to the data folder.
+	///
+	/// WriteOnly truncates the file, ReadWrite and Append create it if it
+	/// doesn't exist.
+	bool open(const std::filesystem::path & path, ofFile::Mode mode = ofFile::ReadOnly);
+	void close();
+	bool isOpen() const;
+
+	/// \returns the size of the file in bytes.
+	uint64_t getSize() const;
+
+	/// \brief Read size bytes at offset into data.
+	std::future<ofAsyncFileResult> read(void * data, std::size_t size, uint64_t offset);
+	void read(void * data, std::size_t size, uint64_t offset, Callback callback, ofEventQueue * queue = nullptr);
+
+	/// \brief Write size bytes from data at offset.
+	///
+	/// Files opened in Append mode ignore offset and always write at the
+	/// end of the file, like the operating system does for them. Several
+	/// writes in flight at once can land in any order.
+	std::future<ofAsyncFileResult> write(const void * data, std::size_t size, uint64_t offset);
+	void write(const void * data, std::size_t size, uint64_t offset, Callback callback, ofEventQueue * queue = nullptr);
+
+	struct Handle;
+
+private:
+	void submit(std::unique_ptr<ofAsyncFileService::Request> request);
+
+	ofAsyncFileService * service;
+	std::shared_ptr<Handle> handle;
+};
+
+/// \brief Submits the requests made from this thread while it's alive all
+/// at once, with a single system call when using io_uring.
+///
+/// ~~~~{.cpp}
+/// {
+/// 	ofAsyncFileBatch batch;
+/// 	for(std::size_t i = 0; i < tiles.size(); i++){
+/// 		file.read(tiles[i].data(), tileSize, i * tileSize, onTileLoaded);
+/// 	}
+/// } // all the reads are submitted here
+/// ~~~~
+///
+/// Batches only collect requests to the same service they were created
+/// with. Without thread local storage requests are submitted right away.
+class ofAsyncFileBatch{
+public:
+	ofAsyncFileBatch(ofAsyncFileService & service = ofGetAsyncFileService());
+	~ofAsyncFileBatch();
+	ofAsyncFileBatch(const ofAsyncFileBatch &) = delete;
+	ofAsyncFileBatch & operator=(const ofAsyncFileBatch &) = delete;
+
+	/// \brief Submits the requests collected until now.
+	void submit();
+
+private:
+	friend class ofAsyncFile;
+	ofAsyncFileService & service;
+	ofAsyncFileBatch * previous;
+	std::vector<std::unique_ptr<ofAsyncFileService::Request>> requests;
+};
+
+/// \brief Reads a whole file without blocking the calling thread.
+std::future<ofBuffer> ofBufferFromFileAsync(const std::filesystem::path & path, ofAsyncFileService & service = ofGetAsyncFileService());
+
+/// \brief Writes a buffer to a file without blocking the calling thread.
+/// \returns a future that becomes true if the whole buffer was written.
+std::future<bool> ofBufferToFileAsync(const std::filesystem::path & path, ofBuffer buffer, ofAsyncFileService & service = ofGetAsyncFileService());
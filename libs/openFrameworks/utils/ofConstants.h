@@ -423,6 +423,17 @@ typedef TESSindex ofIndexType;
 	#endif
 #endif
 
+//------------------------------------------------ simd
+// instruction sets that can be used without any extra compiler flags,
+// x86_64 always has sse2 and arm64 always has neon
+#if !defined(OF_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define OF_USE_SSE 1
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		#define OF_USE_NEON 1
+	#endif
+#endif
+
 //we don't want to break old code that uses ofSimpleApp
 //so we forward declare ofBaseApp and make ofSimpleApp mean the same thing
 class ofBaseApp;
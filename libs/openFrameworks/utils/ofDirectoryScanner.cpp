@@ -0,0 +1,865 @@
+#include "ofDirectoryScanner.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <mutex>
+#include <set>
+
+#ifdef TARGET_WIN32
+	#include <windows.h>
+#else
+	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
+#ifdef TARGET_LINUX
+	#include <sys/inotify.h>
+#endif
+
+using namespace std;
+
+namespace{
+	char toLower(char c){
+		return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+	}
+
+	bool equalsIgnoreCase(ofStringView a, ofStringView b){
+		if(a.size() != b.size()){
+			return false;
+		}
+		for(std::size_t i = 0; i < a.size(); i++){
+			if(toLower(a[i]) != toLower(b[i])){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	ofStringView extensionOf(ofStringView name){
+		for(auto i = name.size(); i > 0; i--){
+			if(name[i - 1] == '.'){
+				return name.substr(i);
+			}
+		}
+		return ofStringView();
+	}
+
+	std::string join(const std::string & relativeDirectory, ofStringView name){
+		std::string path;
+		path.reserve(relativeDirectory.size() + 1 + name.size());
+		if(!relativeDirectory.empty()){
+			path += relativeDirectory;
+			path += '/';
+		}
+		path.append(name.data(), name.size());
+		return path;
+	}
+
+	bool isUnder(ofStringView path, ofStringView directory){
+		return path.size() > directory.size() && path[directory.size()] == '/' && path.starts_with(directory);
+	}
+
+#ifdef TARGET_WIN32
+	std::wstring toWide(const std::string & str){
+		auto size = MultiByteToWideChar(CP_UTF8, 0, str.data(), int(str.size()), nullptr, 0);
+		std::wstring wide(size, 0);
+		MultiByteToWideChar(CP_UTF8, 0, str.data(), int(str.size()), &wide[0], size);
+		return wide;
+	}
+
+	std::string toUtf8(const wchar_t * wide){
+		auto size = WideCharToMultiByte(CP_UTF8, 0, wide, -1, nullptr, 0, nullptr, nullptr);
+		std::string str(std::max(size, 1) - 1, 0);
+		WideCharToMultiByte(CP_UTF8, 0, wide, -1, &str[0], size, nullptr, nullptr);
+		return str;
+	}
+
+	std::time_t toTime(const FILETIME & time){
+		// FILETIME counts 100ns intervals since 1601
+		auto intervals = (uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+		return std::time_t((intervals - 116444736000000000ULL) / 10000000ULL);
+	}
+
+	// links to directories are only followed this deep since there's no
+	// cheap way to detect loops
+	const std::size_t maxFollowedDepth = 64;
+#else
+	ofDirectoryEntry::Type typeOf(mode_t mode){
+		if(S_ISREG(mode)) return ofDirectoryEntry::File;
+		if(S_ISDIR(mode)) return ofDirectoryEntry::Directory;
+		if(S_ISLNK(mode)) return ofDirectoryEntry::Symlink;
+		return ofDirectoryEntry::Other;
+	}
+#endif
+
+	// sorts in parallel chunks and merges them in parallel rounds
+	void parallelSort(std::vector<ofDirectoryEntry> & entries, ofTaskPool & pool){
+		auto byPath = [](const ofDirectoryEntry & a, const ofDirectoryEntry & b){
+			return a.path < b.path;
+		};
+		auto numChunks = std::size_t(1);
+		while(numChunks < pool.getNumThreads() + 1 && entries.size() / (numChunks * 2) > 10000){
+			numChunks *= 2;
+		}
+		auto chunk = (entries.size() + numChunks - 1) / numChunks;
+		auto begin = entries.begin();
+		auto size = entries.size();
+		auto at = [&](std::size_t i){
+			return begin + std::min(i, size);
+		};
+		{
+			ofTaskGroup group(pool);
+			for(std::size_t i = 0; i < numChunks; i++){
+				group.run([&, i]{
+					std::sort(at(i * chunk), at((i + 1) * chunk), byPath);
+				});
+			}
+		}
+		for(; chunk < size; chunk *= 2){
+			ofTaskGroup group(pool);
+			for(std::size_t i = 0; i < size; i += chunk * 2){
+				group.run([&, i]{
+					std::inplace_merge(at(i), at(i + chunk), at(i + chunk * 2), byPath);
+				});
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+ofStringView ofDirectoryEntry::getExtension() const{
+	return extensionOf(getFileName());
+}
+
+//--------------------------------------------------------------
+bool ofGlobMatch(ofStringView pattern, ofStringView path){
+	std::size_t p = 0, s = 0;
+	// positions to go back to when what follows the last * or ** doesn't
+	// match, a * can only be extended up to the next '/', then the last **
+	// is extended instead
+	auto npos = ofStringView::npos;
+	auto starPattern = npos, starPath = npos;
+	auto anyPattern = npos, anyPath = npos;
+	while(s < path.size()){
+		if(p < pattern.size() && pattern[p] == '*'){
+			if(p + 1 < pattern.size() && pattern[p + 1] == '*'){
+				p += 2;
+				// "**/" also matches no directory at all
+				if(p < pattern.size() && pattern[p] == '/' && ofGlobMatch(pattern.substr(p + 1), path.substr(s))){
+					return true;
+				}
+				anyPattern = p;
+				anyPath = s;
+				starPattern = npos;
+			}else{
+				p++;
+				starPattern = p;
+				starPath = s;
+			}
+		}else if(p < pattern.size() && (pattern[p] == path[s] || (pattern[p] == '?' && path[s] != '/'))){
+			p++;
+			s++;
+		}else if(starPattern != npos && path[starPath] != '/'){
+			p = starPattern;
+			s = ++starPath;
+		}else if(anyPattern != npos){
+			starPattern = npos;
+			p = anyPattern;
+			s = ++anyPath;
+		}else{
+			return false;
+		}
+	}
+	while(p < pattern.size() && pattern[p] == '*'){
+		p++;
+	}
+	return p == pattern.size();
+}
+
+//--------------------------------------------------------------
+struct ofDirectoryScanner::Filter{
+	Filter(const ofDirectoryScanSettings & settings)
+	:extensions(settings.extensions)
+	,showHidden(settings.showHidden){
+		for(auto & extension: extensions){
+			if(!extension.empty() && extension[0] == '.'){
+				extension.erase(0, 1);
+			}
+		}
+		for(auto & pattern: settings.patterns){
+			(pattern.find('/') == std::string::npos ? namePatterns : pathPatterns).push_back(pattern);
+		}
+		for(auto & pattern: settings.ignore){
+			(pattern.find('/') == std::string::npos ? ignoreNames : ignorePaths).push_back(pattern);
+		}
+	}
+
+	static bool matchesAny(const std::vector<std::string> & patterns, ofStringView str){
+		for(auto & pattern: patterns){
+			if(ofGlobMatch(pattern, str)){
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool isIgnored(ofStringView name, ofStringView relativePath) const{
+		return matchesAny(ignoreNames, name) || matchesAny(ignorePaths, relativePath);
+	}
+
+	// only for files, directories are only checked with isIgnored
+	bool accepts(ofStringView name, ofStringView relativePath) const{
+		if(!extensions.empty()){
+			auto extension = extensionOf(name);
+			if(std::none_of(extensions.begin(), extensions.end(), [&](const std::string & allowed){
+				return equalsIgnoreCase(allowed, extension);
+			})){
+				return false;
+			}
+		}
+		if(namePatterns.empty() && pathPatterns.empty()){
+			return true;
+		}
+		return matchesAny(namePatterns, name) || matchesAny(pathPatterns, relativePath);
+	}
+
+	std::vector<std::string> extensions;
+	std::vector<std::string> namePatterns;
+	std::vector<std::string> pathPatterns;
+	std::vector<std::string> ignoreNames;
+	std::vector<std::string> ignorePaths;
+	bool showHidden;
+};
+
+//--------------------------------------------------------------
+#ifdef TARGET_LINUX
+struct ofDirectoryScanner::Watcher{
+	~Watcher(){
+		if(fd != -1){
+			::close(fd);
+		}
+	}
+
+	bool add(const std::string & root, const std::string & relativePath, bool followSymlinks){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(descriptors.find(relativePath) != descriptors.end()){
+			return true;
+		}
+		uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+		if(!followSymlinks){
+			mask |= IN_DONT_FOLLOW;
+		}
+		auto wd = inotify_add_watch(fd, (root + relativePath).c_str(), mask);
+		if(wd == -1){
+			if(errno == ENOSPC){
+				ofLogError("ofDirectoryScanner") << "watch(): ran out of inotify watches, they can be increased in /proc/sys/fs/inotify/max_user_watches";
+				failed = true;
+			}
+			// other errors are usually the directory being removed already
+			return false;
+		}
+		directories[wd] = relativePath;
+		descriptors[relativePath] = wd;
+		return true;
+	}
+
+	// stops watching a removed directory and everything under it
+	void remove(const std::string & relativePath){
+		for(auto it = descriptors.begin(); it != descriptors.end();){
+			if(it->first == relativePath || isUnder(it->first, relativePath)){
+				inotify_rm_watch(fd, it->second);
+				directories.erase(it->second);
+				it = descriptors.erase(it);
+			}else{
+				++it;
+			}
+		}
+	}
+
+	bool isDirectory(const std::string & relativePath) const{
+		return descriptors.find(relativePath) != descriptors.end();
+	}
+
+	int fd = -1;
+	bool failed = false;
+	// directories are added from the scanning threads
+	std::mutex mutex;
+	std::unordered_map<int, std::string> directories;
+	std::unordered_map<std::string, int> descriptors;
+};
+#else
+struct ofDirectoryScanner::Watcher{
+	bool add(const std::string &, const std::string &, bool){
+		return false;
+	}
+	bool failed = false;
+};
+#endif
+
+//--------------------------------------------------------------
+// one parallel scan of a directory tree, every directory is read in its own
+// task and the tasks for its subdirectories are started from it
+struct ofDirectoryScanner::Scan{
+	Scan(const ofDirectoryScanner & scanner, ofTaskPool & pool)
+	:scanner(scanner)
+	,settings(scanner.settings)
+	,filter(*scanner.filter)
+	,group(pool){}
+
+	void start(const std::string & relativePath, std::size_t depth){
+		group.run([this, relativePath, depth]{
+			read(relativePath, depth);
+		});
+	}
+
+	void read(const std::string & relativePath, std::size_t depth){
+		if(scanner.watcher){
+			scanner.watcher->add(scanner.root, relativePath, settings.followSymlinks);
+		}
+		std::vector<ofDirectoryEntry> found;
+		std::vector<std::string> subdirectories;
+		auto directoryPath = scanner.root + relativePath + (relativePath.empty() ? "" : "/");
+		std::string relativeChild;
+		auto addEntry = [&](ofStringView name, ofDirectoryEntry::Type type, uint64_t size, std::time_t lastModified){
+			ofDirectoryEntry entry;
+			entry.path.reserve(scanner.originalDirectory.size() + relativeChild.size());
+			entry.path = scanner.originalDirectory;
+			entry.path += relativeChild;
+			entry.relativeOffset = uint32_t(scanner.originalDirectory.size());
+			entry.nameOffset = uint32_t(entry.path.size() - name.size());
+			entry.type = type;
+			entry.size = size;
+			entry.lastModified = lastModified;
+			found.push_back(std::move(entry));
+		};
+
+#ifdef TARGET_WIN32
+		WIN32_FIND_DATAW data;
+		auto find = FindFirstFileExW(toWide(directoryPath + "*").c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if(find == INVALID_HANDLE_VALUE){
+			return;
+		}
+		do{
+			auto nameStr = toUtf8(data.cFileName);
+			ofStringView name(nameStr);
+			if(name == "." || name == ".."){
+				continue;
+			}
+			if(!filter.showHidden && (data.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN)){
+				continue;
+			}
+			relativeChild = join(relativePath, name);
+			auto isLink = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) && data.dwReserved0 == IO_REPARSE_TAG_SYMLINK;
+			ofDirectoryEntry::Type type;
+			if(isLink && !settings.followSymlinks){
+				type = ofDirectoryEntry::Symlink;
+			}else if(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY){
+				type = ofDirectoryEntry::Directory;
+			}else{
+				type = ofDirectoryEntry::File;
+			}
+			if(filter.isIgnored(name, relativeChild)){
+				continue;
+			}
+			if(type == ofDirectoryEntry::Directory){
+				if(settings.recursive && (!isLink || depth < maxFollowedDepth)){
+					subdirectories.push_back(relativeChild);
+				}
+				if(!settings.includeDirectories){
+					continue;
+				}
+			}else if(!filter.accepts(name, relativeChild)){
+				continue;
+			}
+			addEntry(name, type, (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow, toTime(data.ftLastWriteTime));
+		}while(FindNextFileW(find, &data));
+		FindClose(find);
+#else
+		auto dir = opendir(directoryPath.c_str());
+		if(!dir){
+			return;
+		}
+		auto fd = dirfd(dir);
+		while(auto dirEntry = readdir(dir)){
+			ofStringView name(dirEntry->d_name);
+			if(name == "." || name == ".."){
+				continue;
+			}
+			if(!filter.showHidden && name[0] == '.'){
+				continue;
+			}
+			struct stat info;
+			bool hasInfo = false;
+			auto doStat = [&]{
+				hasInfo = fstatat(fd, dirEntry->d_name, &info, settings.followSymlinks ? 0 : AT_SYMLINK_NOFOLLOW) == 0;
+				return hasInfo;
+			};
+			// the type from readdir avoids a stat for everything that's
+			// filtered out, when the file system provides it
+			ofDirectoryEntry::Type type;
+			switch(dirEntry->d_type){
+			case DT_REG: type = ofDirectoryEntry::File; break;
+			case DT_DIR: type = ofDirectoryEntry::Directory; break;
+			case DT_LNK:
+				if(settings.followSymlinks){
+					if(!doStat()) continue;
+					type = typeOf(info.st_mode);
+				}else{
+					type = ofDirectoryEntry::Symlink;
+				}
+				break;
+			case DT_UNKNOWN:
+				if(!doStat()) continue;
+				type = typeOf(info.st_mode);
+				break;
+			default: type = ofDirectoryEntry::Other; break;
+			}
+			relativeChild = join(relativePath, name);
+			if(filter.isIgnored(name, relativeChild)){
+				continue;
+			}
+			if(type == ofDirectoryEntry::Directory){
+				if(settings.recursive && (!settings.followSymlinks || firstVisit(fd, dirEntry->d_name, info, hasInfo))){
+					subdirectories.push_back(relativeChild);
+				}
+				if(!settings.includeDirectories){
+					continue;
+				}
+			}else if(!filter.accepts(name, relativeChild)){
+				continue;
+			}
+			if(!hasInfo && !doStat()){
+				// removed while listing
+				continue;
+			}
+			addEntry(name, type, type == ofDirectoryEntry::Directory ? 0 : uint64_t(info.st_size), info.st_mtime);
+		}
+		closedir(dir);
+#endif
+
+		for(auto & subdirectory: subdirectories){
+			start(subdirectory, depth + 1);
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		if(entries.empty()){
+			entries = std::move(found);
+		}else{
+			entries.insert(entries.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+		}
+		directories.push_back(relativePath);
+	}
+
+#ifndef TARGET_WIN32
+	// when following links a directory can be reached more than once,
+	// possibly in a loop
+	bool firstVisit(int fd, const char * name, struct stat & info, bool & hasInfo){
+		if(!hasInfo && fstatat(fd, name, &info, 0) != 0){
+			return false;
+		}
+		hasInfo = true;
+		std::unique_lock<std::mutex> lock(mutex);
+		return visited.insert(std::make_pair(info.st_dev, info.st_ino)).second;
+	}
+
+	std::set<std::pair<dev_t, ino_t>> visited;
+#endif
+
+	const ofDirectoryScanner & scanner;
+	const ofDirectoryScanSettings & settings;
+	const Filter & filter;
+	ofTaskGroup group;
+	std::mutex mutex;
+	std::vector<ofDirectoryEntry> entries;
+	std::vector<std::string> directories;
+};
+
+//--------------------------------------------------------------
+ofDirectoryScanner::ofDirectoryScanner()
+:pool(&ofGetTaskPool())
+,indexed(false){
+}
+
+//--------------------------------------------------------------
+ofDirectoryScanner::ofDirectoryScanner(const std::filesystem::path & path, const ofDirectoryScanSettings & settings)
+:ofDirectoryScanner(){
+	scan(path, settings);
+}
+
+//--------------------------------------------------------------
+ofDirectoryScanner::~ofDirectoryScanner(){
+}
+
+//--------------------------------------------------------------
+std::size_t ofDirectoryScanner::scan(const std::filesystem::path & path, const ofDirectoryScanSettings & settings, ofTaskPool & pool){
+	stopWatching();
+	this->settings = settings;
+	this->pool = &pool;
+	filter.reset(new Filter(settings));
+	originalDirectory = ofFilePath::getPathForDirectory(path.string());
+	root = ofFilePath::getPathForDirectory(ofToDataPath(originalDirectory));
+	return rescan();
+}
+
+//--------------------------------------------------------------
+std::size_t ofDirectoryScanner::rescan(){
+	entries.clear();
+	directories.clear();
+	index.clear();
+	indexed = false;
+	if(originalDirectory.empty()){
+		ofLogError("ofDirectoryScanner") << "rescan(): no directory scanned yet";
+		return 0;
+	}
+	if(!ofDirectory::doesDirectoryExist(root, false)){
+		ofLogError("ofDirectoryScanner") << "scan(): directory does not exist: \"" << originalDirectory << "\"";
+		return 0;
+	}
+	scanTree("", entries, directories);
+	parallelSort(entries, *pool);
+	ofLogVerbose("ofDirectoryScanner") << "listed " << entries.size() << " entries in " << directories.size() << " directories in \"" << originalDirectory << "\"";
+	return entries.size();
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::scanTree(const std::string & relativePath, std::vector<ofDirectoryEntry> & found, std::vector<std::string> & foundDirectories){
+	Scan scan(*this, *pool);
+#ifndef TARGET_WIN32
+	struct stat info;
+	if(settings.followSymlinks && stat((root + relativePath).c_str(), &info) == 0){
+		scan.visited.insert(std::make_pair(info.st_dev, info.st_ino));
+	}
+#endif
+	scan.start(relativePath, 0);
+	scan.group.wait();
+	if(found.empty()){
+		found = std::move(scan.entries);
+	}else{
+		found.insert(found.end(), std::make_move_iterator(scan.entries.begin()), std::make_move_iterator(scan.entries.end()));
+	}
+	foundDirectories.insert(foundDirectories.end(), scan.directories.begin(), scan.directories.end());
+}
+
+//--------------------------------------------------------------
+bool ofDirectoryScanner::watch(){
+#ifdef TARGET_LINUX
+	if(watcher){
+		return true;
+	}
+	if(originalDirectory.empty()){
+		ofLogError("ofDirectoryScanner") << "watch(): no directory scanned yet";
+		return false;
+	}
+	std::unique_ptr<Watcher> newWatcher(new Watcher);
+	newWatcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(newWatcher->fd == -1){
+		ofLogError("ofDirectoryScanner") << "watch(): couldn't start inotify: " << strerror(errno);
+		return false;
+	}
+	for(auto & directory: directories){
+		newWatcher->add(root, directory, settings.followSymlinks);
+		if(newWatcher->failed){
+			return false;
+		}
+	}
+	watcher = std::move(newWatcher);
+	return true;
+#else
+	ofLogVerbose("ofDirectoryScanner") << "watch(): watching directories is only supported on linux";
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::stopWatching(){
+#ifdef TARGET_LINUX
+	if(watcher){
+		// the directories might have changed while watching
+		directories.clear();
+		for(auto & directory: watcher->descriptors){
+			directories.push_back(directory.first);
+		}
+	}
+#endif
+	watcher.reset();
+}
+
+//--------------------------------------------------------------
+bool ofDirectoryScanner::isWatching() const{
+	return watcher != nullptr;
+}
+
+//--------------------------------------------------------------
+ofDirectoryChanges ofDirectoryScanner::update(){
+	if(originalDirectory.empty()){
+		return ofDirectoryChanges();
+	}
+#ifdef TARGET_LINUX
+	if(watcher){
+		bool overflow = false;
+		std::set<std::string> changed;
+		std::vector<int> ignored;
+		alignas(inotify_event) char buffer[64 * 1024];
+		while(true){
+			auto length = ::read(watcher->fd, buffer, sizeof(buffer));
+			if(length <= 0){
+				if(length < 0 && errno == EINTR){
+					continue;
+				}
+				break;
+			}
+			for(auto ptr = buffer; ptr < buffer + length;){
+				auto event = reinterpret_cast<inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+				if(event->mask & IN_Q_OVERFLOW){
+					overflow = true;
+				}else if(event->mask & IN_IGNORED){
+					// the directory was removed, handled after refreshing its
+					// parent so everything under it is removed too
+					ignored.push_back(event->wd);
+				}else if(event->len > 0){
+					auto directory = watcher->directories.find(event->wd);
+					if(directory != watcher->directories.end()){
+						changed.insert(join(directory->second, event->name));
+					}
+				}
+			}
+		}
+
+		if(!overflow && !watcher->failed){
+			ofDirectoryChanges changes;
+			if(!ofDirectory::doesDirectoryExist(root, false)){
+				stopWatching();
+				return diff(std::vector<ofDirectoryEntry>());
+			}
+			// removed paths first, a directory moved inside the tree keeps its
+			// watch and it has to be removed from the old path before adding
+			// it again to the new one
+			std::vector<std::string> existing;
+			for(auto & path: changed){
+				struct stat info;
+				if(lstat((root + path).c_str(), &info) == 0){
+					existing.push_back(path);
+				}else{
+					refresh(path, changes);
+				}
+			}
+			for(auto & path: existing){
+				refresh(path, changes);
+			}
+			for(auto wd: ignored){
+				auto directory = watcher->directories.find(wd);
+				if(directory != watcher->directories.end()){
+					watcher->descriptors.erase(directory->second);
+					watcher->directories.erase(directory);
+				}
+			}
+			return changes;
+		}
+
+		ofLogWarning("ofDirectoryScanner") << "update(): missed some changes, listing \"" << originalDirectory << "\" again";
+		watcher.reset();
+		std::vector<ofDirectoryEntry> current;
+		directories.clear();
+		scanTree("", current, directories);
+		auto changes = diff(std::move(current));
+		watch();
+		return changes;
+	}
+#endif
+	std::vector<ofDirectoryEntry> current;
+	std::vector<std::string> currentDirectories;
+	if(ofDirectory::doesDirectoryExist(root, false)){
+		scanTree("", current, currentDirectories);
+	}
+	directories = std::move(currentDirectories);
+	return diff(std::move(current));
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::refresh(const std::string & relativePath, ofDirectoryChanges & changes){
+#ifdef TARGET_LINUX
+	auto path = originalDirectory + relativePath;
+	ofStringView name(relativePath);
+	auto slash = relativePath.rfind('/');
+	if(slash != std::string::npos){
+		name.remove_prefix(slash + 1);
+	}
+
+	struct stat info;
+	bool exists = lstat((root + relativePath).c_str(), &info) == 0;
+	if(exists && settings.followSymlinks && S_ISLNK(info.st_mode)){
+		exists = stat((root + relativePath).c_str(), &info) == 0;
+	}
+	bool filtered = (!filter->showHidden && name[0] == '.') || filter->isIgnored(name, relativePath);
+	auto type = exists ? typeOf(info.st_mode) : ofDirectoryEntry::File;
+
+	// removed, or replaced by something of another type
+	if(watcher->isDirectory(relativePath) && (!exists || filtered || type != ofDirectoryEntry::Directory)){
+		watcher->remove(relativePath);
+		std::vector<std::string> removed;
+		for(auto & entry: entries){
+			if(isUnder(entry.getRelativePath(), relativePath)){
+				removed.push_back(entry.path);
+			}
+		}
+		for(auto & removedPath: removed){
+			remove(removedPath, changes);
+		}
+	}
+	if(!exists || filtered || (type != ofDirectoryEntry::Directory && !filter->accepts(name, relativePath))){
+		remove(path, changes);
+		return;
+	}
+
+	ofDirectoryEntry entry;
+	entry.path = path;
+	entry.relativeOffset = uint32_t(originalDirectory.size());
+	entry.nameOffset = uint32_t(path.size() - name.size());
+	entry.type = type;
+	entry.size = type == ofDirectoryEntry::Directory ? 0 : uint64_t(info.st_size);
+	entry.lastModified = info.st_mtime;
+
+	if(type == ofDirectoryEntry::Directory){
+		if(settings.recursive && !watcher->isDirectory(relativePath)){
+			// a new directory, or one moved here, with everything in it
+			std::vector<ofDirectoryEntry> found;
+			std::vector<std::string> foundDirectories;
+			scanTree(relativePath, found, foundDirectories);
+			for(auto & foundEntry: found){
+				add(std::move(foundEntry), changes);
+			}
+		}
+		if(!settings.includeDirectories){
+			return;
+		}
+	}
+	add(std::move(entry), changes);
+#endif
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::add(ofDirectoryEntry && entry, ofDirectoryChanges & changes){
+	buildIndex();
+	auto found = index.find(entry.path);
+	if(found == index.end()){
+		changes.added.push_back(entry.path);
+		index[entry.path] = entries.size();
+		entries.push_back(std::move(entry));
+	}else{
+		auto & existing = entries[found->second];
+		if(existing.size != entry.size || existing.lastModified != entry.lastModified || existing.type != entry.type){
+			changes.modified.push_back(entry.path);
+			existing = std::move(entry);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::remove(const std::string & path, ofDirectoryChanges & changes){
+	buildIndex();
+	auto found = index.find(path);
+	if(found == index.end()){
+		return;
+	}
+	auto position = found->second;
+	index.erase(found);
+	changes.removed.push_back(path);
+	if(position != entries.size() - 1){
+		entries[position] = std::move(entries.back());
+		index[entries[position].path] = position;
+	}
+	entries.pop_back();
+}
+
+//--------------------------------------------------------------
+ofDirectoryChanges ofDirectoryScanner::diff(std::vector<ofDirectoryEntry> && current){
+	buildIndex();
+	ofDirectoryChanges changes;
+	std::vector<bool> stillThere(entries.size(), false);
+	for(auto & entry: current){
+		auto found = index.find(entry.path);
+		if(found == index.end()){
+			changes.added.push_back(entry.path);
+		}else{
+			stillThere[found->second] = true;
+			auto & previous = entries[found->second];
+			if(previous.size != entry.size || previous.lastModified != entry.lastModified || previous.type != entry.type){
+				changes.modified.push_back(entry.path);
+			}
+		}
+	}
+	for(std::size_t i = 0; i < entries.size(); i++){
+		if(!stillThere[i]){
+			changes.removed.push_back(entries[i].path);
+		}
+	}
+	entries = std::move(current);
+	parallelSort(entries, *pool);
+	index.clear();
+	indexed = false;
+	return changes;
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::buildIndex() const{
+	if(indexed){
+		return;
+	}
+	index.clear();
+	index.reserve(entries.size());
+	for(std::size_t i = 0; i < entries.size(); i++){
+		index[entries[i].path] = i;
+	}
+	indexed = true;
+}
+
+//--------------------------------------------------------------
+void ofDirectoryScanner::sort(){
+	parallelSort(entries, *pool);
+	index.clear();
+	indexed = false;
+}
+
+//--------------------------------------------------------------
+const ofDirectoryEntry * ofDirectoryScanner::find(const std::string & path) const{
+	buildIndex();
+	auto found = index.find(path);
+	return found == index.end() ? nullptr : &entries[found->second];
+}
+
+//--------------------------------------------------------------
+const std::vector<ofDirectoryEntry> & ofDirectoryScanner::getEntries() const{
+	return entries;
+}
+
+//--------------------------------------------------------------
+const ofDirectoryScanSettings & ofDirectoryScanner::getSettings() const{
+	return settings;
+}
+
+//--------------------------------------------------------------
+std::size_t ofDirectoryScanner::size() const{
+	return entries.size();
+}
+
+//--------------------------------------------------------------
+bool ofDirectoryScanner::empty() const{
+	return entries.empty();
+}
+
+//--------------------------------------------------------------
+const ofDirectoryEntry & ofDirectoryScanner::operator[](std::size_t position) const{
+	return entries[position];
+}
+
+//--------------------------------------------------------------
+std::vector<ofDirectoryEntry>::const_iterator ofDirectoryScanner::begin() const{
+	return entries.begin();
+}
+
+//--------------------------------------------------------------
+std::vector<ofDirectoryEntry>::const_iterator ofDirectoryScanner::end() const{
+	return entries.end();
+}
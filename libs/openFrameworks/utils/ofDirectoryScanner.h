@@ -0,0 +1,219 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include "ofStringView.h"
+#include "ofTaskPool.h"
+#include <ctime>
+
+/// \file
+/// Lists big directory trees quickly.
+///
+/// ~~~~{.cpp}
+/// ofDirectoryScanSettings settings;
+/// settings.extensions = {"jpg", "png"};
+/// settings.ignore = {"thumbnails"};
+/// ofDirectoryScanner library("/media/library", settings);
+/// library.watch();
+/// for(auto & entry: library){
+/// 	ofLogNotice() << entry.path << " " << entry.size;
+/// }
+/// ...
+/// // in update(), applies the changes since the scan
+/// auto changes = library.update();
+/// for(auto & path: changes.added){
+/// 	...
+/// }
+/// ~~~~
+///
+/// Unlike ofDirectory it descends into subdirectories, reads them in
+/// parallel, filters names before querying anything else about them and
+/// keeps only the size, modification time and type of each entry instead
+/// of an ofFile.
+
+/// \brief A file or directory found by an ofDirectoryScanner.
+struct ofDirectoryEntry{
+	enum Type: uint8_t{
+		File,
+		Directory,
+		Symlink,
+		Other,
+	};
+
+	/// Path of the entry, the scanned directory as it was passed to
+	/// ofDirectoryScanner::scan followed by the path relative to it, like
+	/// ofDirectory::getPath.
+	std::string path;
+	uint64_t size = 0;
+	std::time_t lastModified = 0;
+	Type type = File;
+
+	/// \returns the path relative to the scanned directory, ie. "2019/beach.jpg".
+	ofStringView getRelativePath() const{
+		return ofStringView(path).substr(relativeOffset);
+	}
+
+	/// \returns the file name, ie. "beach.jpg".
+	ofStringView getFileName() const{
+		return ofStringView(path).substr(nameOffset);
+	}
+
+	/// \returns the extension without the dot, ie. "jpg".
+	ofStringView getExtension() const;
+
+	bool isDirectory() const{
+		return type == Directory;
+	}
+
+	bool isFile() const{
+		return type == File;
+	}
+
+private:
+	friend class ofDirectoryScanner;
+	uint32_t relativeOffset = 0;
+	uint32_t nameOffset = 0;
+};
+
+/// \brief What an ofDirectoryScanner lists.
+struct ofDirectoryScanSettings{
+	/// Only list files with these extensions, ie. {"jpg", "png"}, case
+	/// insensitive. Empty lists every file.
+	std::vector<std::string> extensions;
+
+	/// Only list files that match one of these patterns, ie. {"IMG_*"},
+	/// see ofGlobMatch. Patterns without a '/' are matched against the file
+	/// name, patterns with a '/' against the path relative to the scanned
+	/// directory. Empty lists every file.
+	std::vector<std::string> patterns;
+
+	/// Skip files and directories that match one of these patterns, in the
+	/// same way as patterns. Ignored directories aren't read at all.
+	std::vector<std::string> ignore;
+
+	/// Descend into subdirectories.
+	bool recursive = true;
+
+	/// List hidden files and descend into hidden directories. Hidden files
+	/// are the ones starting with a period on mac and linux and the ones
+	/// with the hidden attribute on windows.
+	bool showHidden = false;
+
+	/// List directories as entries too, not only the files in them.
+	bool includeDirectories = false;
+
+	/// Descend into symbolic links to directories and list links to files
+	/// with the size of the file they point to. Otherwise links are listed
+	/// as Symlink entries.
+	bool followSymlinks = false;
+};
+
+/// \brief Paths changed since the last scan or update of an
+/// ofDirectoryScanner.
+struct ofDirectoryChanges{
+	std::vector<std::string> added;
+	std::vector<std::string> removed;
+	std::vector<std::string> modified;
+
+	bool empty() const{
+		return added.empty() && removed.empty() && modified.empty();
+	}
+};
+
+/// \brief Recursive directory listing that can be kept up to date.
+///
+/// Entries are sorted by path after a scan. update() adds and removes
+/// entries in place so the order isn't kept after it reports changes, call
+/// sort() if it's needed.
+///
+/// A scanner isn't thread safe, scan and update it from one thread at a
+/// time.
+class ofDirectoryScanner{
+public:
+	ofDirectoryScanner();
+	ofDirectoryScanner(const std::filesystem::path & path, const ofDirectoryScanSettings & settings = ofDirectoryScanSettings());
+	~ofDirectoryScanner();
+	ofDirectoryScanner(const ofDirectoryScanner &) = delete;
+	ofDirectoryScanner & operator=(const ofDirectoryScanner &) = delete;
+
+	/// \brief Lists path, relative to the data folder, reading its
+	/// subdirectories in parallel using pool.
+	///
+	/// Stops watching the previous directory.
+	///
+	/// \returns the number of entries found.
+	std::size_t scan(const std::filesystem::path & path, const ofDirectoryScanSettings & settings = ofDirectoryScanSettings(), ofTaskPool & pool = ofGetTaskPool());
+
+	/// \brief Lists the same directory again from scratch.
+	std::size_t rescan();
+
+	/// \brief Watch the scanned directory so update() only needs to look at
+	/// what changed.
+	///
+	/// Uses inotify, so it's only available on linux. The number of
+	/// directories that can be watched is limited by
+	/// /proc/sys/fs/inotify/max_user_watches.
+	///
+	/// \returns false if watching isn't possible, update() still works
+	/// but lists the whole directory again.
+	bool watch();
+	void stopWatching();
+	bool isWatching() const;
+
+	/// \brief Brings the entries up to date with the file system.
+	///
+	/// When watching only the paths that changed are queried, otherwise
+	/// the whole directory is listed again and compared with the current
+	/// entries.
+	///
+	/// \returns the paths that were added, removed or modified.
+	ofDirectoryChanges update();
+
+	/// \brief Sorts the entries by path.
+	void sort();
+
+	/// \returns the entry for path, as it is in ofDirectoryEntry::path, or
+	/// nullptr if there's none.
+	const ofDirectoryEntry * find(const std::string & path) const;
+
+	const std::vector<ofDirectoryEntry> & getEntries() const;
+	const ofDirectoryScanSettings & getSettings() const;
+	std::size_t size() const;
+	bool empty() const;
+	const ofDirectoryEntry & operator[](std::size_t position) const;
+
+	std::vector<ofDirectoryEntry>::const_iterator begin() const;
+	std::vector<ofDirectoryEntry>::const_iterator end() const;
+
+private:
+	struct Filter;
+	struct Watcher;
+	struct Scan;
+
+	void scanTree(const std::string & relativePath, std::vector<ofDirectoryEntry> & found, std::vector<std::string> & foundDirectories);
+	void buildIndex() const;
+	void add(ofDirectoryEntry && entry, ofDirectoryChanges & changes);
+	void remove(const std::string & path, ofDirectoryChanges & changes);
+	void refresh(const std::string & relativePath, ofDirectoryChanges & changes);
+	ofDirectoryChanges diff(std::vector<ofDirectoryEntry> && current);
+
+	std::string originalDirectory;
+	std::string root;
+	ofDirectoryScanSettings settings;
+	ofTaskPool * pool;
+	std::unique_ptr<Filter> filter;
+	std::vector<ofDirectoryEntry> entries;
+	// built the first time it's needed, big trees are usually only listed
+	mutable std::unordered_map<std::string, std::size_t> index;
+	mutable bool indexed;
+	// relative paths of the directories read by the last scan, to watch
+	// them
+	std::vector<std::string> directories;
+	std::unique_ptr<Watcher> watcher;
+};
+
+/// \brief Matches a path against a glob pattern, ie. "2019/**/*.jpg".
+///
+/// '*' matches any characters except '/', '**' matches any characters
+/// including '/' and '?' matches any one character except '/'.
+bool ofGlobMatch(ofStringView pattern, ofStringView path);
@@ -2,9 +2,15 @@
 #ifndef TARGET_WIN32
 	#include <pwd.h>
 	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#else
+	#include <windows.h>
 #endif
 
 #include "ofUtils.h"
+#include <limits>
 
 
 #ifdef TARGET_OSX
@@ -21,43 +27,178 @@ using namespace std;
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------
+// a read only, copy on write, map of a whole file
+struct ofBuffer::MappedFile{
+	char * data = nullptr;
+	std::size_t size = 0;
+
+	bool open(const std::filesystem::path & path, ofBufferMode mode){
+#ifdef TARGET_EMSCRIPTEN
+		return false;
+#elif defined(TARGET_WIN32)
+		auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			mode == ofBufferMode::MappedRandomAccess ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if(file == INVALID_HANDLE_VALUE){
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || uint64_t(fileSize.QuadPart) > (std::numeric_limits<std::size_t>::max)()){
+			CloseHandle(file);
+			return false;
+		}
+		// the view keeps the file open so the handles aren't needed after mapping it
+		auto fileMapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		CloseHandle(file);
+		if(fileMapping == nullptr){
+			return false;
+		}
+		data = static_cast<char*>(MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0));
+		CloseHandle(fileMapping);
+		if(data == nullptr){
+			return false;
+		}
+		size = fileSize.QuadPart;
+		return true;
+#else
+		auto fd = ::open(path.c_str(), O_RDONLY);
+		if(fd == -1){
+			return false;
+		}
+		struct stat info;
+		if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0 || uint64_t(info.st_size) > std::numeric_limits<std::size_t>::max()){
+			::close(fd);
+			return false;
+		}
+		// private so writing through getData() changes the memory but never the file
+		auto mapped = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if(mapped == MAP_FAILED){
+			return false;
+		}
+		data = static_cast<char*>(mapped);
+		size = info.st_size;
+		if(mode == ofBufferMode::MappedRandomAccess){
+			madvise(mapped, size, MADV_RANDOM);
+		}else{
+			madvise(mapped, size, MADV_SEQUENTIAL);
+			madvise(mapped, size, MADV_WILLNEED);
+		}
+		return true;
+#endif
+	}
+
+	~MappedFile(){
+		if(data == nullptr){
+			return;
+		}
+#ifdef TARGET_WIN32
+		UnmapViewOfFile(data);
+#elif !defined(TARGET_EMSCRIPTEN)
+		munmap(data, size);
+#endif
+	}
+};
+
 //--------------------------------------------------
 ofBuffer::ofBuffer()
-:currentLine(end(),end()){
+:currentLine(buffer.end(),buffer.end()){
 }
 
 //--------------------------------------------------
 ofBuffer::ofBuffer(const char * _buffer, std::size_t size)
 :buffer(_buffer,_buffer+size)
-,currentLine(end(),end()){
+,currentLine(buffer.end(),buffer.end()){
 }
 
 //--------------------------------------------------
 ofBuffer::ofBuffer(istream & stream, size_t ioBlockSize)
-:currentLine(end(),end()){
+:currentLine(buffer.end(),buffer.end()){
 	set(stream, ioBlockSize);
 }
 
+//--------------------------------------------------
+ofBuffer::ofBuffer(const ofBuffer & other)
+:buffer(other.getData(), other.getData() + other.size())
+,currentLine(buffer.end(),buffer.end()){
+}
+
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(const ofBuffer & other){
+	if(&other != this){
+		set(other.getData(), other.size());
+		currentLine = Line(buffer.end(), buffer.end());
+	}
+	return *this;
+}
+
 //--------------------------------------------------
 bool ofBuffer::set(istream & stream, size_t ioBlockSize){
 	if(stream.bad()){
 		clear();
 		return false;
 	}else{
-		buffer.clear();
+		clear();
+	}
+
+	// files and other streams that know their length are read in one go
+	// instead of growing the buffer block by block
+	auto start = stream.tellg();
+	if(start != std::streampos(-1) && stream.seekg(0, ios::end)){
+		auto end = stream.tellg();
+		stream.seekg(start);
+		if(end != std::streampos(-1) && end > start){
+			buffer.resize(end - start);
+			stream.read(buffer.data(), buffer.size());
+			buffer.resize(stream.gcount());
+		}
+		stream.peek();
 	}
+	stream.clear(stream.rdstate() & ~ios::failbit);
 
-	vector<char> aux_buffer(ioBlockSize);
 	while(stream.good()){
-		stream.read(&aux_buffer[0], ioBlockSize);
-		append(aux_buffer.data(), stream.gcount());
+		auto read = buffer.size();
+		buffer.resize(read + ioBlockSize);
+		stream.read(buffer.data() + read, ioBlockSize);
+		buffer.resize(read + stream.gcount());
 	}
 	return true;
 }
 
+//--------------------------------------------------
+bool ofBuffer::map(const std::filesystem::path & path, ofBufferMode mode){
+	clear();
+	if(mode == ofBufferMode::Copy){
+		ofFile file(path, ofFile::ReadOnly, true);
+		return file.exists() && set(file);
+	}
+	auto dataPath = std::filesystem::path(ofToDataPath(path.string()));
+	auto mapped = std::make_shared<MappedFile>();
+	if(mapped->open(dataPath, mode)){
+		mapping = mapped;
+		return true;
+	}
+	// empty files can't be mapped, and some platforms can't map at all
+	ofFile file(path, ofFile::ReadOnly, true);
+	return file.exists() && set(file);
+}
+
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mapping != nullptr;
+}
+
+//--------------------------------------------------
+void ofBuffer::unmap(){
+	if(mapping){
+		buffer.assign(mapping->data, mapping->data + mapping->size);
+		mapping.reset();
+	}
+}
+
 //--------------------------------------------------
 void ofBuffer::setall(char mem){
-	buffer.assign(buffer.size(), mem);
+	std::fill(getData(), getData() + size(), mem);
 }
 
 //--------------------------------------------------
@@ -65,12 +206,13 @@ bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(buffer.data(), buffer.size());
+	stream.write(getData(), size());
 	return stream.good();
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * _buffer, std::size_t _size){
+	mapping.reset();
 	buffer.assign(_buffer, _buffer+_size);
 }
 
@@ -86,16 +228,19 @@ void ofBuffer::append(const string& _buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * _buffer, std::size_t _size){
+	unmap();
 	buffer.insert(buffer.end(), _buffer, _buffer + _size);
 }
 
 //--------------------------------------------------
 void ofBuffer::reserve(size_t size){
+	unmap();
 	buffer.reserve(size);
 }
 
 //--------------------------------------------------
 void ofBuffer::clear(){
+	mapping.reset();
 	buffer.clear();
 }
 
@@ -106,18 +251,19 @@ void ofBuffer::allocate(std::size_t _size){
 
 //--------------------------------------------------
 void ofBuffer::resize(std::size_t _size){
+	unmap();
 	buffer.resize(_size);
 }
 
 
 //--------------------------------------------------
 char * ofBuffer::getData(){
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
 const char * ofBuffer::getData() const{
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
@@ -132,10 +278,10 @@ const char * ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	if(size() == 0){
 		return "";
 	}
-	return std::string(buffer.begin(), buffer.end());
+	return std::string(getData(), getData() + size());
 }
 
 //--------------------------------------------------
@@ -151,7 +297,7 @@ ofBuffer & ofBuffer::operator=(const string & text){
 
 //--------------------------------------------------
 std::size_t ofBuffer::size() const {
-	return buffer.size();
+	return mapping ? mapping->size : buffer.size();
 }
 
 //--------------------------------------------------
@@ -182,42 +328,46 @@ void ofBuffer::resetLineReader(){
 
 //--------------------------------------------------
 vector<char>::iterator ofBuffer::begin(){
+	unmap();
 	return buffer.begin();
 }
 
 //--------------------------------------------------
 vector<char>::iterator ofBuffer::end(){
+	unmap();
 	return buffer.end();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::begin() const{
-	return buffer.begin();
+const char * ofBuffer::begin() const{
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::end() const{
-	return buffer.end();
+const char * ofBuffer::end() const{
+	return getData() + size();
 }
 
 //--------------------------------------------------
 vector<char>::reverse_iterator ofBuffer::rbegin(){
+	unmap();
 	return buffer.rbegin();
 }
 
 //--------------------------------------------------
 vector<char>::reverse_iterator ofBuffer::rend(){
+	unmap();
 	return buffer.rend();
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rbegin() const{
-	return buffer.rbegin();
+std::reverse_iterator<const char *> ofBuffer::rbegin() const{
+	return std::reverse_iterator<const char *>(end());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rend() const{
-	return buffer.rend();
+std::reverse_iterator<const char *> ofBuffer::rend() const{
+	return std::reverse_iterator<const char *>(begin());
 }
 
 //--------------------------------------------------
@@ -386,6 +536,11 @@ ofBuffer::RLines ofBuffer::getReverseLines(){
 	return ofBuffer::RLines(rbegin(), rend());
 }
 
+//--------------------------------------------------
+ofLinesView ofBuffer::lines() const{
+	return ofLinesView(ofStringView(getData(), size()));
+}
+
 //--------------------------------------------------
 ostream & operator<<(ostream & ostr, const ofBuffer & buf){
 	buf.writeTo(ostr);
@@ -404,6 +559,13 @@ ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary){
 	return ofBuffer(f);
 }
 
+//--------------------------------------------------
+ofBuffer ofBufferFromFile(const std::filesystem::path & path, ofBufferMode mode){
+	ofBuffer buffer;
+	buffer.map(path, mode);
+	return buffer;
+}
+
 //--------------------------------------------------
 bool ofBufferToFile(const std::filesystem::path & path, const ofBuffer& buffer, bool binary){
 	ofFile f(path, ofFile::WriteOnly, binary);
@@ -1249,29 +1411,37 @@ std::size_t ofDirectory::listDir(){
 		return 0;
 	}
 	
+	// filter the paths while listing instead of creating an ofFile for
+	// every path and removing the ones that don't pass afterwards
+	bool filterExtensions = !extensions.empty() && !ofContains(extensions, (string)"*");
 	std::filesystem::directory_iterator end_iter;
 	if ( std::filesystem::exists(myDir) && std::filesystem::is_directory(myDir)){
 		for( std::filesystem::directory_iterator dir_iter(myDir) ; dir_iter != end_iter ; ++dir_iter){
-			files.emplace_back(dir_iter->path().string(), ofFile::Reference);
+			auto & path = dir_iter->path();
+#ifndef TARGET_WIN32
+			if(!showHidden){
+				auto fileName = path.filename().string();
+				if(fileName != "." && fileName != ".." && fileName[0] == '.'){
+					continue;
+				}
+			}
+#endif
+			if(filterExtensions){
+				auto extension = path.extension().string();
+				if(!extension.empty() && extension.front() == '.'){
+					extension.erase(0, 1);
+				}
+				if(std::find(extensions.begin(), extensions.end(), ofToLower(extension)) == extensions.end()){
+					continue;
+				}
+			}
+			files.emplace_back(path.string(), ofFile::Reference);
 		}
 	}else{
 		ofLogError("ofDirectory") << "listDir:() source directory does not exist: \"" << myDir << "\"";
 		return 0;
 	}
 
-	if(!showHidden){
-		ofRemove(files, [](ofFile & file){
-			return file.isHidden();
-		});
-	}
-
-
-	if(!extensions.empty() && !ofContains(extensions, (string)"*")){
-		ofRemove(files, [&](ofFile & file){
-			return std::find(extensions.begin(), extensions.end(), ofToLower(file.getExtension())) == extensions.end();
-		});
-	}        
-
 	if(ofGetLogLevel() == OF_LOG_VERBOSE){
 		for(int i = 0; i < (int)size(); i++){
 			ofLogVerbose() << "\t" << getName(i);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofStringView.h"
 #if !_MSC_VER
 #define BOOST_NO_CXX11_SCOPED_ENUMS
 #define BOOST_NO_SCOPED_ENUMS
@@ -14,10 +15,32 @@ namespace std {
 // ofBuffer
 //----------------------------------------------------------
 
+/// How ofBufferFromFile reads a file into an ofBuffer.
+enum class ofBufferMode{
+	/// Read the whole file into memory.
+	Copy,
+	/// Map the file into memory instead of reading it. The OS loads its
+	/// pages the first time they are accessed, so opening is immediate and
+	/// the file doesn't take memory twice. Best for files read from start
+	/// to end.
+	Mapped,
+	/// Same as Mapped but hints the OS that the file will be accessed in
+	/// random order, so it doesn't read ahead. Best for big files of which
+	/// only some parts are used, like indices or LUTs.
+	MappedRandomAccess,
+};
+
 /// \class ofBuffer
 ///
 /// A buffer of data which can be accessed as simple bytes or text.
 ///
+/// A buffer can also be a read only map of a file, see ofBufferMode. Its
+/// contents can then be accessed through getData(), size(), getText() or
+/// writeTo() without copying them. Modifying the data through getData()
+/// doesn't change the file. Const iterators read the map directly, any
+/// other modification and iterating over a non const buffer with begin() /
+/// end() or getLines() copies the contents into memory first.
+///
 class ofBuffer{
 	
 public:
@@ -36,6 +59,12 @@ public:
 	/// \param ioBlockSize the number of bytes to read from the stream in chunks
 	ofBuffer(std::istream & stream, size_t ioBlockSize = 1024);
 
+	/// Copying a mapped buffer copies its contents into memory.
+	ofBuffer(const ofBuffer & other);
+	ofBuffer & operator=(const ofBuffer & other);
+	ofBuffer(ofBuffer && other) = default;
+	ofBuffer & operator=(ofBuffer && other) = default;
+
 	/// Set the contents of the buffer from a raw byte pointer.
 	///
 	/// \warning buffer *must* not be NULL
@@ -51,9 +80,24 @@ public:
 	
 	/// Set contents of the buffer from an input stream.
 	///
+	/// If the stream can be seeked, like files, its remaining contents are
+	/// read in one go.
+	///
 	/// \param stream input stream to copy data from
 	/// \param ioBlockSize the number of bytes to read from the stream in chunks
 	bool set(std::istream & stream, size_t ioBlockSize = 1024);
+
+	/// Map a file into memory as the contents of the buffer.
+	///
+	/// Falls back to reading the file if it can't be mapped.
+	///
+	/// \param path file to map
+	/// \param mode one of the Mapped modes to choose the access hint
+	/// \returns false if the file couldn't be opened
+	bool map(const std::filesystem::path & path, ofBufferMode mode = ofBufferMode::Mapped);
+
+	/// \returns true if the buffer is a map of a file
+	bool isMapped() const;
 	
 	/// Set all bytes in the buffer to a given value.
 	///
@@ -142,12 +186,12 @@ public:
 
 	std::vector<char>::iterator begin();
 	std::vector<char>::iterator end();
-	std::vector<char>::const_iterator begin() const;
-	std::vector<char>::const_iterator end() const;
+	const char * begin() const;
+	const char * end() const;
 	std::vector<char>::reverse_iterator rbegin();
 	std::vector<char>::reverse_iterator rend();
-	std::vector<char>::const_reverse_iterator rbegin() const;
-	std::vector<char>::const_reverse_iterator rend() const;
+	std::reverse_iterator<const char *> rbegin() const;
+	std::reverse_iterator<const char *> rend() const;
 
 	/// A line of text in the buffer.
 	///
@@ -250,8 +294,32 @@ public:
 	/// \returns buffer text lines
 	RLines getReverseLines();
 
+	/// Access the contents of the buffer as a series of text lines without
+	/// copying them.
+	///
+	/// Every line is a view into the buffer, only valid while the buffer
+	/// isn't modified. Unlike getLines() it doesn't copy mapped buffers
+	/// into memory.
+	///
+	/// ~~~~{.cpp}
+	/// auto buffer = ofBufferFromFile("points.csv", ofBufferMode::Mapped);
+	/// for(auto line: buffer.lines()){
+	/// 	ofStringTokenizer tokens(line, ",");
+	/// 	...
+	/// }
+	/// ~~~~
+	///
+	/// \returns buffer text lines
+	ofLinesView lines() const;
+
 private:
+	struct MappedFile;
+
+	// copies a mapped file into buffer and unmaps it
+	void unmap();
+
 	std::vector<char> 	buffer;
+	std::shared_ptr<MappedFile> mapping;
 	Line			currentLine;
 };
 
@@ -265,6 +333,21 @@ private:
 /// split at endline characters automatically
 ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary=true);
 
+//--------------------------------------------------
+/// Read or map the contents of a file at path into a buffer.
+///
+/// Mapped files are always read as binary.
+///
+/// ~~~~{.cpp}
+/// auto points = ofBufferFromFile("points.bin", ofBufferMode::Mapped);
+/// auto data = reinterpret_cast<const glm::vec3*>(points.getData());
+/// auto count = points.size() / sizeof(glm::vec3);
+/// ~~~~
+///
+/// \param path file to open
+/// \param mode whether to read the file into memory or to map it
+ofBuffer ofBufferFromFile(const std::filesystem::path & path, ofBufferMode mode);
+
 //--------------------------------------------------
 /// Write the contents of a buffer to a file at path.
 ///
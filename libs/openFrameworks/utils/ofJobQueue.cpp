@@ -0,0 +1,135 @@
+#include "ofJobQueue.h"
+#include "ofAppRunner.h"
+#include "ofLog.h"
+#include <algorithm>
+#include <chrono>
+
+//--------------------------------------------------------------
+ofJobQueue::ofJobQueue()
+:numJobs(0)
+,maxBudget(2000)
+,minBudget(250)
+,budget(2000)
+,adaptive(true){
+
+}
+
+//--------------------------------------------------------------
+void ofJobQueue::post(std::function<void()> job, ofJobPriority priority){
+	std::unique_lock<std::mutex> lock(mutex);
+	jobs[priority].push_back(std::move(job));
+	numJobs++;
+}
+
+//--------------------------------------------------------------
+std::size_t ofJobQueue::runFrame(){
+	adapt();
+	return run(std::max(uint64_t(budget), uint64_t(1)));
+}
+
+//--------------------------------------------------------------
+std::size_t ofJobQueue::run(uint64_t budgetMicros){
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start + std::chrono::microseconds(budgetMicros);
+	std::size_t ran = 0;
+	std::function<void()> job;
+	while(pop(job)){
+		try{
+			job();
+		}catch(const std::exception & e){
+			ofLogError("ofJobQueue") << "exception in job: " << e.what();
+		}catch(...){
+			ofLogError("ofJobQueue") << "unknown exception in job";
+		}
+		job = nullptr;
+		ran++;
+		if(budgetMicros > 0 && std::chrono::steady_clock::now() >= deadline){
+			break;
+		}
+	}
+	return ran;
+}
+
+//--------------------------------------------------------------
+void ofJobQueue::setFrameBudget(uint64_t budgetMicros){
+	maxBudget = budgetMicros;
+	budget = budgetMicros;
+}
+
+//--------------------------------------------------------------
+uint64_t ofJobQueue::getFrameBudget() const{
+	return budget;
+}
+
+//--------------------------------------------------------------
+void ofJobQueue::setAdaptiveBudget(bool adaptive, uint64_t minBudgetMicros){
+	this->adaptive = adaptive;
+	minBudget = minBudgetMicros;
+	if(!adaptive){
+		budget = maxBudget;
+	}
+}
+
+//--------------------------------------------------------------
+std::size_t ofJobQueue::size() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numJobs;
+}
+
+//--------------------------------------------------------------
+bool ofJobQueue::empty() const{
+	return size() == 0;
+}
+
+//--------------------------------------------------------------
+void ofJobQueue::clear(){
+	std::unique_lock<std::mutex> lock(mutex);
+	for(auto & priorityJobs: jobs){
+		priorityJobs.clear();
+	}
+	numJobs = 0;
+}
+
+//--------------------------------------------------------------
+bool ofJobQueue::pop(std::function<void()> & job){
+	std::unique_lock<std::mutex> lock(mutex);
+	for(auto & priorityJobs: jobs){
+		if(!priorityJobs.empty()){
+			job = std::move(priorityJobs.front());
+			priorityJobs.pop_front();
+			numJobs--;
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void ofJobQueue::adapt(){
+	frames.newFrame();
+	if(!adaptive || frames.getNumFrames() < 2){
+		return;
+	}
+
+	// halve the budget as soon as a frame is late, grow it back slowly
+	// while frames are on time so it settles just below what makes the
+	// application miss its frame rate
+	auto targetFps = ofGetTargetFrameRate();
+	auto targetSecs = 1.0 / (targetFps > 0 ? targetFps : 60.0);
+	if(frames.getLastFrameSecs() > targetSecs * 1.1){
+		budget = std::max(budget * 0.5, double(minBudget));
+	}else{
+		budget = std::min(budget + maxBudget * 0.05, double(maxBudget));
+	}
+}
+
+//--------------------------------------------------------------
+ofJobQueue & ofGetMainJobQueue(){
+	static ofJobQueue * queue = new ofJobQueue;
+	return *queue;
+}
+
+//--------------------------------------------------------------
+void ofRunOnMainThread(std::function<void()> job, ofJobPriority priority){
+	ofGetMainJobQueue().post(std::move(job), priority);
+}
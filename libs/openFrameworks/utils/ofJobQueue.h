@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFpsCounter.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+enum ofJobPriority{
+	OF_JOB_PRIORITY_HIGH,
+	OF_JOB_PRIORITY_NORMAL,
+	OF_JOB_PRIORITY_LOW,
+};
+
+/// \brief Queue of jobs that have to run on a specific thread, run a few
+/// at a time within a time budget.
+///
+/// Things like uploading textures need to happen on the main thread but
+/// are usually the result of work done in other threads. Running all of
+/// them as soon as they are ready makes frames that take much longer than
+/// the rest, ofJobQueue spreads them across frames instead: every call to
+/// runFrame() runs jobs, highest priority first, until the frame budget is
+/// exhausted and leaves the rest for the next frame.
+///
+/// The main queue returned by ofGetMainJobQueue() runs every frame before
+/// update, with any kind of window. ofRunOnMainThread() posts to it.
+///
+/// By default the budget adapts to the frame rate: it shrinks when the
+/// application doesn't reach its target frame rate and grows back, up to
+/// the budget set with setFrameBudget(), while it does.
+///
+/// ~~~~{.cpp}
+/// ofRunOnMainThread([&]{
+/// 	texture.loadData(pixels);
+/// });
+/// ~~~~
+class ofJobQueue{
+public:
+	ofJobQueue();
+	ofJobQueue(const ofJobQueue &) = delete;
+	ofJobQueue & operator=(const ofJobQueue &) = delete;
+
+	/// \brief Run job in a later call to runFrame() or run().
+	///
+	/// Can be called from any thread. Jobs of the same priority run in the
+	/// order they were posted.
+	void post(std::function<void()> job, ofJobPriority priority = OF_JOB_PRIORITY_NORMAL);
+
+	/// \brief Run jobs for at most the current frame budget.
+	///
+	/// Meant to be called once per frame, the time between calls is what
+	/// adapts the budget. At least one job runs on every call, if there's
+	/// any, so a single job longer than the budget doesn't stall the queue.
+	/// \returns the number of jobs that ran.
+	std::size_t runFrame();
+
+	/// \brief Run jobs for at most budgetMicros microseconds.
+	///
+	/// Doesn't adapt the budget, useful to run the queue outside of the
+	/// frame loop. A budget of 0 runs every pending job.
+	/// \returns the number of jobs that ran.
+	std::size_t run(uint64_t budgetMicros);
+
+	/// \brief Maximum time runFrame() spends running jobs, 2ms by default.
+	void setFrameBudget(uint64_t budgetMicros);
+
+	/// \returns the budget the next call to runFrame() will use which can
+	/// be lower than the one set if it's adapting to the frame rate.
+	uint64_t getFrameBudget() const;
+
+	/// \brief Shrink the budget when the frame rate drops below the target
+	/// frame rate, true by default.
+	///
+	/// \param minBudgetMicros the budget never goes below this.
+	void setAdaptiveBudget(bool adaptive, uint64_t minBudgetMicros = 250);
+
+	/// \returns the number of jobs waiting to run.
+	std::size_t size() const;
+	bool empty() const;
+
+	/// \brief Discard every job that didn't run yet.
+	void clear();
+
+private:
+	bool pop(std::function<void()> & job);
+	void adapt();
+
+	mutable std::mutex mutex;
+	std::deque<std::function<void()>> jobs[OF_JOB_PRIORITY_LOW + 1];
+	std::size_t numJobs;
+
+	uint64_t maxBudget;
+	uint64_t minBudget;
+	double budget;
+	bool adaptive;
+	ofFpsCounter frames;
+};
+
+/// \brief Jobs run on the main thread every frame before update.
+ofJobQueue & ofGetMainJobQueue();
+
+/// \brief Run job on the main thread spread over the next frames, see
+/// ofJobQueue.
+void ofRunOnMainThread(std::function<void()> job, ofJobPriority priority = OF_JOB_PRIORITY_NORMAL);
@@ -8,26 +8,165 @@
 using ofJson = nlohmann::json;
 
 
-/// \brief Load Json from the given path.
-/// \param filename The file to load from.
-/// \returns loaded json, or an empty json object on failure.
-inline ofJson ofLoadJson(const std::filesystem::path& filename){
-	ofJson json;
-	ofFile jsonFile(filename);
-	if(jsonFile.exists()){
+// nlohmann json 3.2 added SAX parsing and reading the binary formats
+// straight from memory
+#if defined(NLOHMANN_JSON_VERSION_MAJOR) && (NLOHMANN_JSON_VERSION_MAJOR > 3 || (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 2))
+	#define OF_JSON_HAS_SAX 1
+#else
+	#define OF_JSON_HAS_SAX 0
+#endif
+
+namespace of{
+namespace priv{
+	// maps the file and calls parse with the range of its contents
+	template<typename Parse>
+	bool parseJsonFile(const char * module, const std::filesystem::path & filename, Parse parse){
+		if(!ofFile::doesFileExist(filename)){
+			ofLogError(module) << "Error loading json from " << filename.string() << ": file doesn't exist";
+			return false;
+		}
 		try{
-			jsonFile >> json;
+			// parses straight from the mapped file without copying it into memory
+			auto buffer = ofBufferFromFile(filename, ofBufferMode::Mapped);
+			if(buffer.size() == 0){
+				ofLogError(module) << "Error loading json from " << filename.string() << ": file is empty";
+				return false;
+			}
+			auto data = reinterpret_cast<const uint8_t*>(buffer.getData());
+			return parse(data, data + buffer.size());
 		}catch(std::exception & e){
-			ofLogError("ofLoadJson") << "Error loading json from " << filename.string() << ": " << e.what();
+			ofLogError(module) << "Error loading json from " << filename.string() << ": " << e.what();
 		}catch(...){
-			ofLogError("ofLoadJson") << "Error loading json from " << filename.string();
+			ofLogError(module) << "Error loading json from " << filename.string();
 		}
-	}else{
-		ofLogError("ofLoadJson") << "Error loading json from " << filename.string() << ": file doesn't exist";
+		return false;
+	}
+
+	inline bool saveJsonFile(const char * module, const std::filesystem::path & filename, const std::vector<uint8_t> & data){
+		ofFile jsonFile(filename, ofFile::WriteOnly, true);
+		if(!jsonFile.write(reinterpret_cast<const char*>(data.data()), data.size())){
+			ofLogError(module) << "Error saving json to " << filename.string();
+			return false;
+		}
+		return true;
 	}
+
+	template<typename Parse>
+	ofJson loadBinaryJson(const char * module, const std::filesystem::path & filename, Parse parse){
+		ofJson json;
+		parseJsonFile(module, filename, [&](const uint8_t * first, const uint8_t * last){
+#if OF_JSON_HAS_SAX
+			json = parse(first, last);
+#else
+			json = parse(std::vector<uint8_t>(first, last));
+#endif
+			return true;
+		});
+		return json;
+	}
+}
+}
+
+/// \brief Load Json from the given path.
+/// \param filename The file to load from.
+/// \returns loaded json, or an empty json object on failure.
+inline ofJson ofLoadJson(const std::filesystem::path& filename){
+	ofJson json;
+	of::priv::parseJsonFile("ofLoadJson", filename, [&](const uint8_t * first, const uint8_t * last){
+		json = ofJson::parse(first, last);
+		return true;
+	});
+	return json;
+}
+
+/// \brief Load Json from the given path, calling callback for every value
+/// while it's parsed.
+///
+/// callback receives the depth of the value, the parse event and the value
+/// parsed so far. Returning false from it on a value, object_end or
+/// array_end event discards the value, so big files can be processed one
+/// element at a time without keeping the whole document in memory:
+///
+/// ~~~~{.cpp}
+/// // scene.json is {"nodes": [{...}, {...}, ...]}
+/// ofLoadJson("scene.json", [&](int depth, ofJson::parse_event_t event, ofJson & parsed){
+/// 	if(depth == 2 && event == ofJson::parse_event_t::object_end){
+/// 		addNode(parsed);
+/// 		return false;
+/// 	}
+/// 	return true;
+/// });
+/// ~~~~
+///
+/// \param filename The file to load from.
+/// \param callback Called for every parse event.
+/// \returns the values callback didn't discard, or an empty json object on
+/// failure.
+inline ofJson ofLoadJson(const std::filesystem::path& filename, const ofJson::parser_callback_t & callback){
+	ofJson json;
+	of::priv::parseJsonFile("ofLoadJson", filename, [&](const uint8_t * first, const uint8_t * last){
+		json = ofJson::parse(first, last, callback);
+		return true;
+	});
 	return json;
 }
 
+#if OF_JSON_HAS_SAX
+using ofJsonSax = nlohmann::json_sax<ofJson>;
+
+/// \brief Parse the Json at the given path with a SAX handler, without
+/// creating an ofJson for it.
+///
+/// Every value, key and start or end of an object or array is reported to
+/// sax as it's read from the file, which is the fastest way to extract a
+/// few values from a big file.
+/// \param filename The file to parse.
+/// \param sax The handler for the parse events.
+/// \returns true if the whole file was parsed and sax didn't stop it.
+inline bool ofParseJson(const std::filesystem::path& filename, ofJsonSax & sax){
+	return of::priv::parseJsonFile("ofParseJson", filename, [&](const uint8_t * first, const uint8_t * last){
+		return ofJson::sax_parse(first, last, &sax);
+	});
+}
+#endif
+
+/// \brief Load Json stored as CBOR from the given path.
+/// \param filename The file to load from.
+/// \returns loaded json, or an empty json object on failure.
+inline ofJson ofLoadCbor(const std::filesystem::path& filename){
+	return of::priv::loadBinaryJson("ofLoadCbor", filename, [](auto && ... input){
+		return ofJson::from_cbor(input...);
+	});
+}
+
+/// \brief Load Json stored as MessagePack from the given path.
+/// \param filename The file to load from.
+/// \returns loaded json, or an empty json object on failure.
+inline ofJson ofLoadMsgPack(const std::filesystem::path& filename){
+	return of::priv::loadBinaryJson("ofLoadMsgPack", filename, [](auto && ... input){
+		return ofJson::from_msgpack(input...);
+	});
+}
+
+/// \brief Save Json as CBOR to the given path.
+///
+/// CBOR and MessagePack files are usually smaller than text and store
+/// numbers in binary, so they are read back exactly and without parsing.
+/// \param filename The destination path.
+/// \param json The Json to save.
+/// \returns true if the json was saved successfully.
+inline bool ofSaveCbor(const std::filesystem::path& filename, const ofJson & json){
+	return of::priv::saveJsonFile("ofSaveCbor", filename, ofJson::to_cbor(json));
+}
+
+/// \brief Save Json as MessagePack to the given path.
+/// \param filename The destination path.
+/// \param json The Json to save.
+/// \returns true if the json was saved successfully.
+inline bool ofSaveMsgPack(const std::filesystem::path& filename, const ofJson & json){
+	return of::priv::saveJsonFile("ofSaveMsgPack", filename, ofJson::to_msgpack(json));
+}
+
 /// \brief Save minified Json to the given path.
 /// \param filename The destination path.
 /// \param json The Json to save.
@@ -72,16 +211,14 @@ inline void ofSerialize(ofJson & js, ofAbstractParameter & parameter){
 	if(name == ""){
 		name = "UnknownName";
 	}
-	if(parameter.type() == typeid(ofParameterGroup).name()){
+	if(typeid(parameter) == typeid(ofParameterGroup)){
 		const ofParameterGroup & group = static_cast <const ofParameterGroup &>(parameter);
-		auto jsonGroup = js[name];
+		auto & jsonGroup = js[name];
 		for(auto & p: group){
 			ofSerialize(jsonGroup, *p);
 		}
-		js[name] = jsonGroup;
 	}else{
-		std::string value = parameter.toString();
-		js[name] = value;
+		js[name] = parameter.toString();
 	}
 }
 
@@ -89,26 +226,29 @@ inline void ofDeserialize(const ofJson & json, ofAbstractParameter & parameter){
 	if(!parameter.isSerializable()){
 		return;
 	}
-	std::string name = parameter.getEscapedName();
-	if(json.find(name) != json.end()){
-		if(parameter.type() == typeid(ofParameterGroup).name()){
+	auto it = json.find(parameter.getEscapedName());
+	if(it != json.end()){
+		const ofJson & value = *it;
+		// compare the type_info directly, type() returns a new string
+		const std::type_info & type = typeid(parameter);
+		if(type == typeid(ofParameterGroup)){
 			ofParameterGroup & group = static_cast <ofParameterGroup &>(parameter);
 			for(auto & p: group){
-				ofDeserialize(json[name], *p);
+				ofDeserialize(value, *p);
 			}
 		}else{
-			if(parameter.type() == typeid(ofParameter <int> ).name() && json[name].is_number_integer()){
-				parameter.cast <int>() = json[name].get<int>();
-			}else if(parameter.type() == typeid(ofParameter <float> ).name() && json[name].is_number_float()){
-				parameter.cast <float>() = json[name].get<float>();
-			}else if(parameter.type() == typeid(ofParameter <bool> ).name() && json[name].is_boolean()){
-				parameter.cast <bool>() = json[name].get<bool>();
-			}else if(parameter.type() == typeid(ofParameter <int64_t> ).name() && json[name].is_number_integer()){
-				parameter.cast <int64_t>() = json[name].get<int64_t>();
-			}else if(parameter.type() == typeid(ofParameter <std::string> ).name()){
-				parameter.cast <std::string>() = json[name].get<std::string>();
+			if(type == typeid(ofParameter <int> ) && value.is_number_integer()){
+				parameter.cast <int>() = value.get<int>();
+			}else if(type == typeid(ofParameter <float> ) && value.is_number_float()){
+				parameter.cast <float>() = value.get<float>();
+			}else if(type == typeid(ofParameter <bool> ) && value.is_boolean()){
+				parameter.cast <bool>() = value.get<bool>();
+			}else if(type == typeid(ofParameter <int64_t> ) && value.is_number_integer()){
+				parameter.cast <int64_t>() = value.get<int64_t>();
+			}else if(type == typeid(ofParameter <std::string> )){
+				parameter.cast <std::string>() = value.get<std::string>();
 			}else{
-				parameter.fromString(json[name]);
+				parameter.fromString(value);
 			}
 		}
 	}
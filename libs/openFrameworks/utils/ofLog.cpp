@@ -2,6 +2,10 @@
 #include "ofConstants.h"
 #include <ofUtils.h>
 #include <map>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <limits>
 #ifdef TARGET_ANDROID
 	#include "ofxAndroidLogChannel.h"
 #endif
@@ -9,6 +13,9 @@
 using namespace std;
 
 static ofLogLevel currentLogLevel =  OF_LOG_NOTICE;
+// lowest level of the global and every module level, anything below is
+// discarded without looking up the module
+static ofLogLevel lowestLogLevel = OF_LOG_NOTICE;
 
 bool ofLog::bAutoSpace = false;
 string & ofLog::getPadding() {
@@ -35,14 +42,23 @@ shared_ptr<ofBaseLoggerChannel> & ofLog::channel(){
 	return channel;
 }
 
+static void updateLowestLogLevel(){
+	lowestLogLevel = currentLogLevel;
+	for(auto & module: getModules()){
+		lowestLogLevel = std::min(lowestLogLevel, module.second);
+	}
+}
+
 //--------------------------------------------------
 void ofSetLogLevel(ofLogLevel level){
 	currentLogLevel = level;
+	updateLowestLogLevel();
 }
 
 //--------------------------------------------------
 void ofSetLogLevel(string module, ofLogLevel level){
 	getModules()[module] = level;
+	updateLowestLogLevel();
 }
 
 //--------------------------------------------------
@@ -59,11 +75,32 @@ ofLogLevel ofGetLogLevel(string module){
 	}
 }
 
+//--------------------------------------------------
+bool ofIsLogEnabled(ofLogLevel level, const string & module){
+	if(level < lowestLogLevel){
+		return false;
+	}
+	auto & modules = getModules();
+	if(modules.empty()){
+		return level >= currentLogLevel;
+	}
+	auto it = modules.find(module);
+	return level >= (it == modules.end() ? currentLogLevel : it->second);
+}
+
 //--------------------------------------------------
 void ofLogToFile(const std::filesystem::path & path, bool append){
 	ofLog::setChannel(std::make_shared<ofFileLoggerChannel>(path,append));
 }
 
+//--------------------------------------------------
+void ofLogToFileAsync(const std::filesystem::path & path, bool append){
+	auto file = std::make_shared<ofFileLoggerChannel>(path,append);
+	// the async channel flushes once per batch
+	file->setAutoFlush(false);
+	ofLog::setChannel(std::make_shared<ofAsyncLoggerChannel>(file));
+}
+
 //--------------------------------------------------
 void ofLogToConsole(){
 	ofLog::setChannel(shared_ptr<ofConsoleLoggerChannel>(new ofConsoleLoggerChannel,std::ptr_fun(noopDeleter)));
@@ -80,6 +117,7 @@ ofLog::ofLog(){
 	level = OF_LOG_NOTICE;
 	module = "";
 	bPrinted = false;
+	bEnabled = checkLog(level,module);
 }
 		
 //--------------------------------------------------
@@ -87,12 +125,14 @@ ofLog::ofLog(ofLogLevel _level){
 	level = _level;
 	module = "";
 	bPrinted = false;
+	bEnabled = checkLog(level,module);
 }
 
 //--------------------------------------------------
 ofLog::ofLog(ofLogLevel level, const string & message){
 	_log(level,"",message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -104,6 +144,7 @@ ofLog::ofLog(ofLogLevel level, const char* format, ...){
 		va_end( args );
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -120,18 +161,13 @@ void ofLog::setAutoSpace(bool autoSpace){
 //-------------------------------------------------------
 ofLog::~ofLog(){
 	// don't log if we printed in the constructor already
-	if(!bPrinted){
-		_log(level,module,message.str());
+	if(!bPrinted && bEnabled){
+		channel()->log(level,module,message.str());
 	}
 }
 
 bool ofLog::checkLog(ofLogLevel level, const string & module){
-	if(getModules().find(module)==getModules().end()){
-		if(level >= currentLogLevel) return true;
-	}else{
-		if(level >= getModules()[module]) return true;
-	}
-	return false;
+	return ofIsLogEnabled(level, module);
 }
 
 //-------------------------------------------------------
@@ -146,11 +182,13 @@ ofLogVerbose::ofLogVerbose(const string & _module){
 	level = OF_LOG_VERBOSE;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogVerbose::ofLogVerbose(const string & _module, const string & _message){
 	_log(OF_LOG_VERBOSE,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
@@ -161,6 +199,7 @@ ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -168,11 +207,13 @@ ofLogNotice::ofLogNotice(const string & _module){
 	level = OF_LOG_NOTICE;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogNotice::ofLogNotice(const string & _module, const string & _message){
 	_log(OF_LOG_NOTICE,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
@@ -183,6 +224,7 @@ ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -190,11 +232,13 @@ ofLogWarning::ofLogWarning(const string & _module){
 	level = OF_LOG_WARNING;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogWarning::ofLogWarning(const string & _module, const string & _message){
 	_log(OF_LOG_WARNING,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
@@ -205,6 +249,7 @@ ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -212,11 +257,13 @@ ofLogError::ofLogError(const string & _module){
 	level = OF_LOG_ERROR;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogError::ofLogError(const string & _module, const string & _message){
 	_log(OF_LOG_ERROR,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogError::ofLogError(const string & module, const char* format, ...){
@@ -227,6 +274,7 @@ ofLogError::ofLogError(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -234,11 +282,13 @@ ofLogFatalError::ofLogFatalError(const string &  _module){
 	level = OF_LOG_FATAL_ERROR;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogFatalError::ofLogFatalError(const string & _module, const string & _message){
 	_log(OF_LOG_FATAL_ERROR,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...){
@@ -249,6 +299,15 @@ ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...)
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
+}
+
+//--------------------------------------------------
+ofLogStream::ofLogStream(ofLogLevel _level, const string & _module){
+	level = _level;
+	module = _module;
+	bPrinted = false;
+	bEnabled = checkLog(level,module);
 }
 
 //--------------------------------------------------
@@ -381,7 +440,8 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const str
 	if(module != ""){
 		file << module << ": ";
 	}
-	file << message << endl;
+	file << message;
+	endLine();
 }
 
 void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
@@ -396,5 +456,389 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const cha
 	if(module != ""){
 		file << module << ": ";
 	}
-	file << ofVAArgsToString(format,args) << endl;
+	file << ofVAArgsToString(format,args);
+	endLine();
+}
+
+void ofFileLoggerChannel::setAutoFlush(bool autoFlush){
+	this->autoFlush = autoFlush;
+}
+
+void ofFileLoggerChannel::flush(){
+	file.flush();
+}
+
+void ofFileLoggerChannel::endLine(){
+	file << '\n';
+	if(autoFlush){
+		file.flush();
+	}
+}
+
+//--------------------------------------------------
+namespace{
+	// every message in a thread buffer starts with this header followed by
+	// the module and the message, the whole record padded to 8 bytes. an
+	// external record is followed by a pointer to a heap copy of the module
+	// and message instead
+	struct RecordHeader{
+		uint32_t size;
+		uint32_t messageLength;
+		uint16_t moduleLength;
+		uint8_t level;
+		uint8_t external;
+		uint8_t unused[4];
+		int64_t ticks;
+	};
+	static_assert(sizeof(RecordHeader) == 24, "unexpected log record header size");
+
+	// marks the space left at the end of the buffer when a record didn't
+	// fit, the record continues at the beginning
+	const uint8_t paddingRecord = 0xFF;
+
+	std::size_t recordSize(std::size_t moduleLength, std::size_t messageLength){
+		return (sizeof(RecordHeader) + moduleLength + messageLength + 7) & ~std::size_t(7);
+	}
+
+	std::atomic<uint64_t> nextChannelId{1};
+}
+
+struct ofAsyncLoggerChannel::ThreadBuffer{
+	ThreadBuffer(std::size_t size)
+	:data(new char[size])
+	,size(size)
+	,mask(size - 1){}
+
+	std::unique_ptr<char[]> data;
+	std::size_t size;
+	std::size_t mask;
+	char pad0[64];
+	std::atomic<uint64_t> head{0}; ///< written only by the logging thread
+	char pad1[64];
+	std::atomic<uint64_t> tail{0}; ///< written only while draining
+	char pad2[64];
+	std::atomic<bool> inUse{true};
+	std::thread::id owner;
+};
+
+#ifdef HAS_TLS
+namespace{
+	// the buffer of the calling thread for the last async channel it logged
+	// to, released for other threads to reuse when the thread ends
+	struct ThreadBufferCache{
+		uint64_t channelId = 0;
+		std::shared_ptr<ofAsyncLoggerChannel::ThreadBuffer> buffer;
+
+		~ThreadBufferCache(){
+			if(buffer){
+				buffer->inUse.store(false, std::memory_order_release);
+			}
+		}
+	};
+	thread_local ThreadBufferCache threadBufferCache;
+}
+#endif
+
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel, ofAsyncLoggerPolicy policy, std::size_t size)
+:channel(channel)
+,policy(policy)
+,bufferSize(1024)
+,id(nextChannelId++)
+,steadyStart(std::chrono::steady_clock::now())
+,systemStart(std::chrono::system_clock::now()){
+	while(bufferSize < size){
+		bufferSize <<= 1;
+	}
+#ifndef TARGET_NO_THREADS
+	writer = std::thread(&ofAsyncLoggerChannel::writerLoop, this);
+#endif
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+#ifndef TARGET_NO_THREADS
+	{
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		running = false;
+		wakeUp.notify_all();
+	}
+	writer.join();
+#endif
+	drain();
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	push(level, module, message.c_str(), message.size());
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	log(level, module, format, args);
+	va_end(args);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, va_list args){
+	// most messages fit in the stack buffer and don't need any allocation
+	char message[512];
+	va_list argsCopy;
+	va_copy(argsCopy, args);
+	auto length = vsnprintf(message, sizeof(message), format, argsCopy);
+	va_end(argsCopy);
+	if(length < 0){
+		return;
+	}
+	if(std::size_t(length) < sizeof(message)){
+		push(level, module, message, length);
+	}else{
+		auto longMessage = ofVAArgsToString(format, args);
+		push(level, module, longMessage.c_str(), longMessage.size());
+	}
+}
+
+void ofAsyncLoggerChannel::push(ofLogLevel level, const string & module, const char * message, std::size_t length){
+#ifdef TARGET_NO_THREADS
+	channel->log(level, module, std::string(message, length));
+#else
+	auto & buffer = getThreadBuffer();
+	auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+
+	// a single record never takes more than half the buffer, longer
+	// messages are copied to the heap and the record only points to them
+	auto maxRecord = buffer.size / 2;
+	auto moduleLength = std::min<std::size_t>(module.size(), std::numeric_limits<uint16_t>::max());
+	auto messageLength = std::min<std::size_t>(length, std::numeric_limits<uint32_t>::max());
+	bool external = moduleLength < module.size() || recordSize(moduleLength, messageLength) > maxRecord;
+	auto size = external ? recordSize(0, sizeof(char*)) : recordSize(moduleLength, messageLength);
+
+	uint64_t head;
+	uint64_t skip;
+	auto fits = [&]{
+		head = buffer.head.load(std::memory_order_relaxed);
+		auto tail = buffer.tail.load(std::memory_order_acquire);
+		auto toEnd = buffer.size - (head & buffer.mask);
+		skip = toEnd < size ? toEnd : 0;
+		return head + skip + size - tail <= buffer.size;
+	};
+	if(!fits()){
+		if(policy == OF_ASYNC_LOGGER_DROP){
+			dropped++;
+			wakeWriter();
+			return;
+		}
+		// sleep until the writer drains the buffer, it only notifies when
+		// it sees a blocked thread so the count is raised before checking
+		// for space again
+		std::unique_lock<std::mutex> lock(spaceMutex);
+		blockedThreads++;
+		wakeWriter();
+		spaceAvailable.wait(lock, fits);
+		blockedThreads--;
+	}
+
+	// when there's no space for a header at the end of the buffer the
+	// reader skips it without a padding record
+	if(skip >= sizeof(RecordHeader)){
+		RecordHeader padding{};
+		padding.size = skip;
+		padding.level = paddingRecord;
+		memcpy(buffer.data.get() + (head & buffer.mask), &padding, sizeof(padding));
+	}
+
+	auto record = buffer.data.get() + ((head + skip) & buffer.mask);
+	RecordHeader header{};
+	header.size = size;
+	header.messageLength = messageLength;
+	header.moduleLength = moduleLength;
+	header.level = level;
+	header.external = external;
+	header.ticks = ticks;
+	memcpy(record, &header, sizeof(header));
+	if(external){
+		// freed by drain
+		auto copy = new char[moduleLength + messageLength];
+		memcpy(copy, module.c_str(), moduleLength);
+		memcpy(copy + moduleLength, message, messageLength);
+		memcpy(record + sizeof(header), &copy, sizeof(copy));
+	}else{
+		memcpy(record + sizeof(header), module.c_str(), moduleLength);
+		memcpy(record + sizeof(header) + moduleLength, message, messageLength);
+	}
+	auto newHead = head + skip + size;
+	buffer.head.store(newHead, std::memory_order_release);
+
+	if(level >= OF_LOG_FATAL_ERROR){
+		flush();
+	}else if(newHead - buffer.tail.load(std::memory_order_relaxed) > buffer.size / 2){
+		wakeWriter();
+	}
+#endif
+}
+
+ofAsyncLoggerChannel::ThreadBuffer & ofAsyncLoggerChannel::getThreadBuffer(){
+#ifdef HAS_TLS
+	auto & cache = threadBufferCache;
+	if(cache.channelId == id){
+		return *cache.buffer;
+	}
+#endif
+
+	std::unique_lock<std::mutex> lock(buffersMutex);
+	auto threadId = std::this_thread::get_id();
+#ifndef HAS_TLS
+	// without thread local storage threads keep their buffer forever and
+	// find it by id
+	for(auto & buffer: buffers){
+		if(buffer->owner == threadId){
+			return *buffer;
+		}
+	}
+#endif
+
+	// reuse the buffer of a thread that ended if there's any
+	std::shared_ptr<ThreadBuffer> threadBuffer;
+	for(auto & buffer: buffers){
+		bool inUse = false;
+		if(buffer->inUse.compare_exchange_strong(inUse, true, std::memory_order_acq_rel)){
+			threadBuffer = buffer;
+			break;
+		}
+	}
+	if(!threadBuffer){
+		threadBuffer = std::make_shared<ThreadBuffer>(bufferSize);
+		buffers.push_back(threadBuffer);
+	}
+	threadBuffer->owner = threadId;
+
+#ifdef HAS_TLS
+	if(cache.buffer){
+		cache.buffer->inUse.store(false, std::memory_order_release);
+	}
+	cache.channelId = id;
+	cache.buffer = threadBuffer;
+#endif
+	return *threadBuffer;
+}
+
+void ofAsyncLoggerChannel::flush(){
+	drain();
+}
+
+void ofAsyncLoggerChannel::setTimestamps(bool timestamps){
+	this->timestamps = timestamps;
+}
+
+void ofAsyncLoggerChannel::setFlushInterval(uint64_t millis){
+	flushIntervalMillis = millis;
+}
+
+uint64_t ofAsyncLoggerChannel::getNumDropped() const{
+	return dropped;
+}
+
+void ofAsyncLoggerChannel::wakeWriter(){
+	if(!wakeRequested.exchange(true)){
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeUp.notify_one();
+	}
+}
+
+void ofAsyncLoggerChannel::writerLoop(){
+	std::unique_lock<std::mutex> lock(wakeMutex);
+	while(running){
+		wakeUp.wait_for(lock, std::chrono::milliseconds(flushIntervalMillis.load()), [this]{
+			return wakeRequested || !running;
+		});
+		wakeRequested = false;
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
+}
+
+void ofAsyncLoggerChannel::drain(){
+	struct Entry{
+		int64_t ticks;
+		ofLogLevel level;
+		std::string module;
+		std::string message;
+	};
+
+	std::unique_lock<std::mutex> lock(drainMutex);
+	std::vector<std::shared_ptr<ThreadBuffer>> toDrain;
+	{
+		std::unique_lock<std::mutex> lock(buffersMutex);
+		toDrain = buffers;
+	}
+
+	std::vector<Entry> entries;
+	for(auto & buffer: toDrain){
+		auto tail = buffer->tail.load(std::memory_order_relaxed);
+		auto head = buffer->head.load(std::memory_order_acquire);
+		while(tail < head){
+			auto toEnd = buffer->size - (tail & buffer->mask);
+			if(toEnd < sizeof(RecordHeader)){
+				tail += toEnd;
+				continue;
+			}
+			auto record = buffer->data.get() + (tail & buffer->mask);
+			RecordHeader header;
+			memcpy(&header, record, sizeof(header));
+			if(header.level != paddingRecord){
+				Entry entry;
+				entry.ticks = header.ticks;
+				entry.level = ofLogLevel(header.level);
+				auto text = record + sizeof(header);
+				char * copy = nullptr;
+				if(header.external){
+					memcpy(&copy, text, sizeof(copy));
+					text = copy;
+				}
+				entry.module.assign(text, header.moduleLength);
+				entry.message.assign(text + header.moduleLength, header.messageLength);
+				delete[] copy;
+				entries.push_back(std::move(entry));
+			}
+			tail += header.size;
+		}
+		buffer->tail.store(tail, std::memory_order_release);
+	}
+
+	// a thread that started waiting before the new tails were stored is
+	// counted here, one that starts later sees them
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(blockedThreads > 0){
+		std::unique_lock<std::mutex> lock(spaceMutex);
+		spaceAvailable.notify_all();
+	}
+
+	// messages from different threads are interleaved by the time they
+	// were logged
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry & a, const Entry & b){
+		return a.ticks < b.ticks;
+	});
+
+	bool withTimestamps = timestamps;
+	for(auto & entry: entries){
+		if(withTimestamps){
+			auto sinceStart = std::chrono::steady_clock::duration(entry.ticks) - steadyStart.time_since_epoch();
+			auto time = systemStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceStart);
+			auto t = std::chrono::system_clock::to_time_t(time);
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+			char timestamp[32];
+			auto length = strftime(timestamp, sizeof(timestamp), "%H:%M:%S", std::localtime(&t));
+			snprintf(timestamp + length, sizeof(timestamp) - length, ".%03d ", int(ms));
+			entry.message = timestamp + entry.message;
+		}
+		channel->log(entry.level, entry.module, entry.message);
+	}
+
+	auto droppedNow = dropped.load();
+	if(droppedNow > droppedReported){
+		channel->log(OF_LOG_WARNING, "ofAsyncLoggerChannel", ofToString(droppedNow - droppedReported) + " messages dropped, the log buffer was full");
+		droppedReported = droppedNow;
+	}
+
+	if(!entries.empty()){
+		channel->flush();
+	}
 }
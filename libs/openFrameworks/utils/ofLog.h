@@ -3,6 +3,11 @@
 #include "ofConstants.h"
 #include "ofFileUtils.h"
 #include "ofTypes.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 /// \file
 /// ofLog provides an interface for writing text output from your app.
@@ -93,6 +98,7 @@
 ///
 /// For log redirection see
 /// - ofLogToFile()
+/// - ofLogToFileAsync()
 /// - ofLogToConsole()
 /// - ofSetLoggerChannel()
 
@@ -189,6 +195,15 @@ ofLogLevel ofGetLogLevel();
 /// \returns The currently set specific module logging level.
 ofLogLevel ofGetLogLevel(std::string module);
 
+/// \brief Check if a message would be logged.
+///
+/// Useful to skip building expensive log messages, OF_LOG and ofLogf use
+/// it to skip evaluating their arguments.
+/// \param level The log level of the message.
+/// \param module The module of the message.
+/// \returns true if a message of this level and module would be logged.
+bool ofIsLogEnabled(ofLogLevel level, const std::string & module = "");
+
 /// \brief Get log level name as a string.
 /// \param level The ofLogLevel you want as a string.
 /// \param pad True if you want all log level names to be the same length.
@@ -208,6 +223,15 @@ class ofBaseLoggerChannel;
 /// \param append True if you want to append to the existing file.
 void ofLogToFile(const std::filesystem::path & path, bool append=false);
 
+/// \brief Set the logging to output to a file from a background thread.
+///
+/// Logging calls only copy the message to a buffer, the file is written
+/// in batches by another thread so logging doesn't block on disk I/O. See
+/// ofAsyncLoggerChannel.
+/// \param path The path to the log file to use.
+/// \param append True if you want to append to the existing file.
+void ofLogToFileAsync(const std::filesystem::path & path, bool append=false);
+
 /// \brief Set the logging to ouptut to the console.
 /// 
 /// This is the default state and can be called to reset console logging
@@ -448,7 +472,9 @@ class ofLog{
 		/// \returns A reference to itself.
 		template <class T> 
 			ofLog& operator<<(const T& value){
-			message << value << getPadding();
+			if(bEnabled){
+				message << value << getPadding();
+			}
 			return *this;
 		}
 	
@@ -460,7 +486,9 @@ class ofLog{
 		/// \param func A function pointer that takes a std::ostream as an argument.
 		/// \returns A reference to itself.
 		ofLog& operator<<(std::ostream& (*func)(std::ostream&)){
-			func(message);
+			if(bEnabled){
+				func(message);
+			}
 			return *this;
 		}
 	
@@ -474,6 +502,7 @@ class ofLog{
 
 		ofLogLevel level; ///< Log level.
 		bool bPrinted;	  ///< Has the message been printed in the constructor?
+		bool bEnabled;	  ///< Will the message be logged? Streamed values are ignored otherwise.
 		std::string module;    ///< The destination module for this message.
 		
 		/// \brief Print a log line.
@@ -603,6 +632,117 @@ class ofLogFatalError : public ofLog{
 		ofLogFatalError(const std::string & module, const char* format, ...) OF_PRINTF_ATTR(3, 4);
 };
 
+//--------------------------------------------------
+/// \name Zero cost logging
+/// \{
+
+/// \brief Messages below this level are removed at compile time by OF_LOG
+/// and ofLogf.
+///
+/// Define it before including openFrameworks, usually in the project
+/// settings, for example as OF_LOG_NOTICE in release builds to remove every
+/// verbose message. All levels are compiled in by default.
+#ifndef OF_LOG_MIN_LEVEL
+#define OF_LOG_MIN_LEVEL OF_LOG_VERBOSE
+#endif
+
+/// \brief Stream style logging that doesn't evaluate the streamed values
+/// unless the message is logged.
+///
+/// Works like ofLog but when the level is below OF_LOG_MIN_LEVEL the
+/// whole statement is removed at compile time, and when the level or
+/// module are disabled with ofSetLogLevel none of the streamed values are
+/// evaluated.
+///
+/// ~~~~{.cpp}
+/// OF_LOG(OF_LOG_VERBOSE) << "mesh: " << mesh.getNumVertices();
+/// OF_LOG(OF_LOG_VERBOSE, "MyClass") << "state: " << expensiveDescription();
+/// ~~~~
+#define OF_LOG(level, ...) \
+	if((level) < OF_LOG_MIN_LEVEL || !ofIsLogEnabled((level), std::string(__VA_ARGS__))){}else ofLogStream((level), std::string(__VA_ARGS__))
+
+/// \cond INTERNAL
+
+/// \brief Log stream with a level and module, used by OF_LOG.
+class ofLogStream: public ofLog{
+	public:
+		ofLogStream(ofLogLevel level, const std::string & module);
+};
+
+namespace of{
+namespace priv{
+	// writes format until the next {} and returns a pointer past it or
+	// nullptr if there's none, {{ and }} are written as { and }
+	inline const char * writeUntilPlaceholder(std::ostream & out, const char * format){
+		auto begin = format;
+		for(; *format; format++){
+			if((format[0] == '{' || format[0] == '}') && format[1] == format[0]){
+				out.write(begin, format - begin + 1);
+				format++;
+				begin = format + 1;
+			}else if(format[0] == '{' && format[1] == '}'){
+				out.write(begin, format - begin);
+				return format + 2;
+			}
+		}
+		out.write(begin, format - begin);
+		return nullptr;
+	}
+
+	inline void formatLog(std::ostream & out, const char * format){
+		// placeholders without a value are written as they are
+		while(format && (format = writeUntilPlaceholder(out, format))){
+			out << "{}";
+		}
+	}
+
+	template<typename T, typename... Args>
+	void formatLog(std::ostream & out, const char * format, const T & value, const Args &... args){
+		if(format && (format = writeUntilPlaceholder(out, format))){
+			out << value;
+			formatLog(out, format, args...);
+		}
+	}
+}
+}
+
+/// \endcond
+
+/// \brief Log a message to a module replacing every {} in format with the
+/// next argument, only formatting it if the message is logged.
+///
+/// The module goes first, like in ofSetLogLevel(module, level).
+///
+/// ~~~~{.cpp}
+/// ofLogf("MyClass", OF_LOG_VERBOSE, "position {}", position);
+/// ~~~~
+template<typename... Args>
+void ofLogf(const std::string & module, ofLogLevel level, const char * format, const Args &... args){
+	if(level < OF_LOG_MIN_LEVEL || !ofIsLogEnabled(level, module)){
+		return;
+	}
+	std::ostringstream message;
+	of::priv::formatLog(message, format, args...);
+	ofLogStream(level, module) << message.str();
+}
+
+/// \brief Log a message replacing every {} in format with the next
+/// argument, only formatting it if the message is logged.
+///
+/// Arguments are written with operator<< so anything that can be streamed
+/// to ofLog works. Use {{ and }} to write { and }. Messages below
+/// OF_LOG_MIN_LEVEL are removed at compile time.
+///
+/// ~~~~{.cpp}
+/// ofLogf(OF_LOG_NOTICE, "loaded {} in {}ms", path, elapsed);
+/// ~~~~
+template<typename... Args>
+void ofLogf(ofLogLevel level, const char * format, const Args &... args){
+	ofLogf("", level, format, args...);
+}
+
+/// \}
+
 
 /// \cond INTERNAL
 
@@ -636,6 +776,9 @@ public:
 	/// \param format The printf-style format string.
 	/// \param args the list of printf-style arguments.
 	virtual void log(ofLogLevel level, const std::string & module, const char* format, va_list args)=0;
+
+	/// \brief Write any buffered messages to their destination.
+	virtual void flush(){}
 };
 
 /// \brief A logger channel that logs its messages to the console.
@@ -683,12 +826,117 @@ public:
 	void log(ofLogLevel level, const std::string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
 	void log(ofLogLevel level, const std::string & module, const char* format, va_list args);
 
+	/// \brief Flush the file after every message, true by default.
+	///
+	/// Without it messages are written when the file buffer fills up or
+	/// flush() is called, which is much faster but can lose the last
+	/// messages if the application crashes.
+	void setAutoFlush(bool autoFlush);
+	void flush();
+
 	/// \brief CLose the log file.
 	void close();
 
 private:
+	void endLine();
 	ofFile file; ///< The location of the log file.
-	
+	bool autoFlush = true;
+};
+
+/// \brief What an ofAsyncLoggerChannel does when a thread logs faster
+/// than the messages can be written.
+enum ofAsyncLoggerPolicy{
+	OF_ASYNC_LOGGER_DROP,  ///< Discard the message and report how many were lost.
+	OF_ASYNC_LOGGER_BLOCK, ///< Wait for the writer thread to make space.
+};
+
+/// \brief A logger channel that passes its messages to another channel
+/// from a background thread.
+///
+/// Every thread that logs gets its own preallocated ring buffer, logging
+/// only copies the message and a monotonic timestamp into it without
+/// locks or allocations. Messages longer than half the buffer are copied
+/// to the heap instead of being truncated. A writer thread collects the messages of every
+/// thread in batches, sorts them by time and passes them to the wrapped
+/// channel, flushing it once per batch.
+///
+/// Fatal errors are written before the logging call returns since the
+/// application is probably about to stop.
+///
+/// ~~~~{.cpp}
+/// auto file = std::make_shared<ofFileLoggerChannel>("log.txt", true);
+/// file->setAutoFlush(false);
+/// ofSetLoggerChannel(std::make_shared<ofAsyncLoggerChannel>(file));
+/// ~~~~
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \param channel The channel the messages are written to.
+	/// \param policy What to do when a thread's buffer is full.
+	/// \param bufferSize Size in bytes of the buffer of every thread.
+	ofAsyncLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel,
+		ofAsyncLoggerPolicy policy = OF_ASYNC_LOGGER_DROP,
+		std::size_t bufferSize = 64 * 1024);
+
+	/// \brief Write the pending messages and stop the writer thread.
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const std::string & module, const std::string & message);
+	void log(ofLogLevel level, const std::string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
+	void log(ofLogLevel level, const std::string & module, const char* format, va_list args);
+
+	/// \brief Write every message logged until now before returning.
+	void flush();
+
+	/// \brief Prefix every message with the time it was logged, false by
+	/// default.
+	void setTimestamps(bool timestamps);
+
+	/// \brief Maximum time a message waits before being written, 50ms by
+	/// default. The writer also wakes up when a buffer is half full.
+	void setFlushInterval(uint64_t millis);
+
+	/// \returns the number of messages dropped since the channel was
+	/// created because a buffer was full.
+	uint64_t getNumDropped() const;
+
+	struct ThreadBuffer;
+
+private:
+	void push(ofLogLevel level, const std::string & module, const char * message, std::size_t length);
+	ThreadBuffer & getThreadBuffer();
+	void writerLoop();
+	void drain();
+	void wakeWriter();
+
+	std::shared_ptr<ofBaseLoggerChannel> channel;
+	ofAsyncLoggerPolicy policy;
+	std::size_t bufferSize;
+	uint64_t id;
+
+	std::mutex buffersMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+	std::mutex drainMutex;
+	std::atomic<uint64_t> dropped{0};
+	uint64_t droppedReported = 0;
+	std::atomic<bool> timestamps{false};
+	std::atomic<uint64_t> flushIntervalMillis{50};
+
+	// timestamps are stored as steady clock ticks which are cheap to get
+	// and converted to wall clock time by the writer
+	std::chrono::steady_clock::time_point steadyStart;
+	std::chrono::system_clock::time_point systemStart;
+
+	std::mutex wakeMutex;
+	std::condition_variable wakeUp;
+	std::atomic<bool> wakeRequested{false};
+	bool running = true;
+	std::thread writer;
+
+	// threads waiting for space in their buffer with the block policy
+	std::mutex spaceMutex;
+	std::condition_variable spaceAvailable;
+	std::atomic<int> blockedThreads{0};
 };
 
 /// \endcond
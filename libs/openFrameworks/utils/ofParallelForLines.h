@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ofStringView.h"
+#include "ofTaskPool.h"
+
+/// \brief Call f(line) for every line of text in parallel and wait for all
+/// of them.
+///
+/// The text is split in chunks of whole lines and every chunk is processed
+/// in order by a single thread. To accumulate results per chunk without
+/// locking, use ofSplitLineChunks and ofParallelFor directly.
+///
+/// ~~~~{.cpp}
+/// auto buffer = ofBufferFromFile("samples.csv", ofBufferMode::Mapped);
+/// std::atomic<std::size_t> errors{0};
+/// ofParallelForLines(ofStringView(buffer.getData(), buffer.size()), [&](ofStringView line){
+/// 	if(ofToInt(line) < 0) errors++;
+/// });
+/// ~~~~
+template<typename F>
+void ofParallelForLines(ofStringView text, F f, ofTaskPool & pool = ofGetTaskPool()){
+	auto chunks = ofSplitLineChunks(text, (pool.getNumThreads() + 1) * 4);
+	ofParallelFor(0, chunks.size(), [&](std::size_t i){
+		for(auto line: ofLinesView(chunks[i])){
+			f(line);
+		}
+	}, 1, pool);
+}
@@ -0,0 +1,107 @@
+#include "ofStringView.h"
+
+constexpr std::size_t ofStringView::npos;
+
+namespace{
+	// the whitespace of the classic locale, which is what ofTrim uses by default
+	inline bool isSpace(char c){
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+}
+
+//--------------------------------------------------
+std::size_t ofStringView::find(ofStringView str, std::size_t pos) const{
+	if(str.size() == 1){
+		return find(str[0], pos);
+	}
+	if(pos > len || str.size() > len - pos){
+		return npos;
+	}
+	auto found = std::search(begin() + pos, end(), str.begin(), str.end());
+	return found == end() ? npos : found - begin();
+}
+
+//--------------------------------------------------
+ofStringTokenizer::ofStringTokenizer(ofStringView source, ofStringView delimiter, bool ignoreEmpty, bool trim)
+:rest(source)
+,delimiter(delimiter)
+,ignoreEmpty(ignoreEmpty)
+,trim(trim)
+,finished(false){
+}
+
+//--------------------------------------------------
+bool ofStringTokenizer::next(ofStringView & token){
+	// like ofSplitString, without a delimiter the whole source is the only token
+	if(delimiter.empty()){
+		if(finished){
+			return false;
+		}
+		finished = true;
+		token = rest;
+		return true;
+	}
+	while(!finished){
+		auto pos = rest.find(delimiter);
+		auto sub = rest.substr(0, pos);
+		if(pos == ofStringView::npos){
+			finished = true;
+		}else{
+			rest.remove_prefix(pos + delimiter.size());
+		}
+		if(trim){
+			sub = ofTrimStringView(sub);
+		}
+		if(!ignoreEmpty || !sub.empty()){
+			token = sub;
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------
+std::vector<ofStringView> ofSplitStringView(ofStringView source, ofStringView delimiter, bool ignoreEmpty, bool trim){
+	std::vector<ofStringView> tokens;
+	ofSplitStringView(source, delimiter, tokens, ignoreEmpty, trim);
+	return tokens;
+}
+
+//--------------------------------------------------
+void ofSplitStringView(ofStringView source, ofStringView delimiter, std::vector<ofStringView> & tokens, bool ignoreEmpty, bool trim){
+	tokens.clear();
+	ofStringTokenizer tokenizer(source, delimiter, ignoreEmpty, trim);
+	ofStringView token;
+	while(tokenizer.next(token)){
+		tokens.push_back(token);
+	}
+}
+
+//--------------------------------------------------
+ofStringView ofTrimStringView(ofStringView str){
+	while(!str.empty() && isSpace(str.front())){
+		str.remove_prefix(1);
+	}
+	while(!str.empty() && isSpace(str.back())){
+		str.remove_suffix(1);
+	}
+	return str;
+}
+
+//--------------------------------------------------
+std::vector<ofStringView> ofSplitLineChunks(ofStringView text, std::size_t numChunks){
+	std::vector<ofStringView> chunks;
+	if(text.empty()){
+		return chunks;
+	}
+	numChunks = std::max(numChunks, std::size_t(1));
+	auto chunkSize = (text.size() + numChunks - 1) / numChunks;
+	while(!text.empty()){
+		// move the end of the chunk forward to the end of the line it falls in
+		auto newLine = text.find('\n', std::min(chunkSize, text.size()) - 1);
+		auto end = newLine == ofStringView::npos ? text.size() : newLine + 1;
+		chunks.push_back(text.substr(0, end));
+		text.remove_prefix(end);
+	}
+	return chunks;
+}
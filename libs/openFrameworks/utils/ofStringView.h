@@ -0,0 +1,260 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <iterator>
+
+/// \file
+/// Read only views of strings, to split and parse text without copying it.
+///
+/// ~~~~{.cpp}
+/// auto buffer = ofBufferFromFile("log.csv", ofBufferMode::Mapped);
+/// std::vector<ofStringView> fields;
+/// for(auto line: buffer.lines()){
+/// 	ofSplitStringView(line, ",", fields);
+/// 	float value = ofToFloat(fields[2]);
+/// }
+/// ~~~~
+///
+/// A view doesn't own the characters it points to, it's only valid as long
+/// as the string, buffer or file it was taken from.
+
+/// \brief A pointer and a size into some text.
+///
+/// Has the same interface as a subset of std::string_view so it can be
+/// replaced by it once the minimum supported standard is c++17.
+class ofStringView{
+public:
+	typedef const char * iterator;
+	typedef const char * const_iterator;
+	static constexpr std::size_t npos = std::size_t(-1);
+
+	ofStringView()
+	:ptr(nullptr)
+	,len(0){}
+
+	ofStringView(const char * str)
+	:ptr(str)
+	,len(str ? strlen(str) : 0){}
+
+	ofStringView(const char * str, std::size_t size)
+	:ptr(str)
+	,len(size){}
+
+	ofStringView(const std::string & str)
+	:ptr(str.data())
+	,len(str.size()){}
+
+	const char * data() const{ return ptr; }
+	std::size_t size() const{ return len; }
+	std::size_t length() const{ return len; }
+	bool empty() const{ return len == 0; }
+
+	iterator begin() const{ return ptr; }
+	iterator end() const{ return ptr + len; }
+
+	char operator[](std::size_t pos) const{ return ptr[pos]; }
+	char front() const{ return ptr[0]; }
+	char back() const{ return ptr[len - 1]; }
+
+	void remove_prefix(std::size_t n){ ptr += n; len -= n; }
+	void remove_suffix(std::size_t n){ len -= n; }
+
+	/// \returns the view of count characters from pos, clamped to the end
+	/// of this view.
+	ofStringView substr(std::size_t pos, std::size_t count = npos) const{
+		pos = std::min(pos, len);
+		return ofStringView(ptr + pos, std::min(count, len - pos));
+	}
+
+	std::size_t find(char c, std::size_t pos = 0) const{
+		if(pos >= len){
+			return npos;
+		}
+		auto found = static_cast<const char*>(memchr(ptr + pos, c, len - pos));
+		return found ? found - ptr : npos;
+	}
+
+	std::size_t find(ofStringView str, std::size_t pos = 0) const;
+
+	int compare(ofStringView other) const{
+		auto result = len && other.len ? memcmp(ptr, other.ptr, std::min(len, other.len)) : 0;
+		if(result != 0){
+			return result;
+		}
+		return len < other.len ? -1 : (len > other.len ? 1 : 0);
+	}
+
+	bool starts_with(ofStringView prefix) const{
+		return len >= prefix.len && substr(0, prefix.len).compare(prefix) == 0;
+	}
+
+	bool ends_with(ofStringView suffix) const{
+		return len >= suffix.len && substr(len - suffix.len).compare(suffix) == 0;
+	}
+
+	/// Copies the view into a string.
+	explicit operator std::string() const{
+		return std::string(ptr, len);
+	}
+
+private:
+	const char * ptr;
+	std::size_t len;
+};
+
+inline bool operator==(ofStringView a, ofStringView b){ return a.size() == b.size() && a.compare(b) == 0; }
+inline bool operator!=(ofStringView a, ofStringView b){ return !(a == b); }
+inline bool operator<(ofStringView a, ofStringView b){ return a.compare(b) < 0; }
+inline bool operator>(ofStringView a, ofStringView b){ return a.compare(b) > 0; }
+inline bool operator<=(ofStringView a, ofStringView b){ return a.compare(b) <= 0; }
+inline bool operator>=(ofStringView a, ofStringView b){ return a.compare(b) >= 0; }
+
+inline std::ostream & operator<<(std::ostream & os, ofStringView str){
+	return os.write(str.data(), str.size());
+}
+
+/// \brief The lines of some text.
+///
+/// Lines are split at '\n' and a '\r' before it is removed, like
+/// ofBuffer::getLines() but every line is a view into the text instead of a
+/// new string.
+///
+/// ~~~~{.cpp}
+/// for(auto line: ofLinesView(text)){
+/// 	if(line.starts_with("#")) continue;
+/// 	...
+/// }
+/// ~~~~
+class ofLinesView{
+public:
+	class iterator: public std::iterator<std::forward_iterator_tag, ofStringView>{
+	public:
+		iterator(const char * begin, const char * end)
+		:current(begin)
+		,next(begin)
+		,last(end){
+			if(current != last){
+				auto newLine = static_cast<const char*>(memchr(current, '\n', last - current));
+				auto lineEnd = newLine ? newLine : last;
+				next = newLine ? newLine + 1 : last;
+				if(lineEnd != current && *(lineEnd - 1) == '\r'){
+					--lineEnd;
+				}
+				line = ofStringView(current, lineEnd - current);
+			}
+		}
+
+		const ofStringView & operator*() const{ return line; }
+		const ofStringView * operator->() const{ return &line; }
+
+		iterator & operator++(){
+			*this = iterator(next, last);
+			return *this;
+		}
+
+		iterator operator++(int){
+			auto tmp = *this;
+			operator++();
+			return tmp;
+		}
+
+		bool operator==(const iterator & other) const{ return current == other.current; }
+		bool operator!=(const iterator & other) const{ return current != other.current; }
+
+	private:
+		ofStringView line;
+		const char * current;
+		const char * next;
+		const char * last;
+	};
+
+	ofLinesView(ofStringView text)
+	:text(text){}
+
+	iterator begin() const{ return iterator(text.begin(), text.end()); }
+	iterator end() const{ return iterator(text.end(), text.end()); }
+
+private:
+	ofStringView text;
+};
+
+/// \brief The tokens of a string split by a delimiter, one at a time.
+///
+/// Splits the same way as ofSplitString but without allocating anything:
+///
+/// ~~~~{.cpp}
+/// ofStringTokenizer tokens(line, " ", true);
+/// ofStringView x, y, z;
+/// if(tokens.next(x) && tokens.next(y) && tokens.next(z)){
+/// 	points.emplace_back(ofToFloat(x), ofToFloat(y), ofToFloat(z));
+/// }
+/// ~~~~
+class ofStringTokenizer{
+public:
+	class iterator: public std::iterator<std::input_iterator_tag, ofStringView>{
+	public:
+		iterator(ofStringTokenizer * tokenizer)
+		:tokenizer(tokenizer){
+			operator++();
+		}
+
+		const ofStringView & operator*() const{ return token; }
+		const ofStringView * operator->() const{ return &token; }
+
+		iterator & operator++(){
+			if(tokenizer && !tokenizer->next(token)){
+				tokenizer = nullptr;
+			}
+			return *this;
+		}
+
+		bool operator==(const iterator & other) const{ return tokenizer == other.tokenizer; }
+		bool operator!=(const iterator & other) const{ return tokenizer != other.tokenizer; }
+
+	private:
+		ofStringTokenizer * tokenizer;
+		ofStringView token;
+	};
+
+	/// \param source The string to split.
+	/// \param delimiter The delimiter string.
+	/// \param ignoreEmpty Set to true to skip empty tokens.
+	/// \param trim Set to true to remove whitespace around the tokens.
+	ofStringTokenizer(ofStringView source, ofStringView delimiter, bool ignoreEmpty = false, bool trim = false);
+
+	/// \brief Get the next token.
+	/// \returns false once there are no more tokens.
+	bool next(ofStringView & token);
+
+	/// Iterating consumes the tokens, so a tokenizer can only be iterated
+	/// once.
+	iterator begin(){ return iterator(this); }
+	iterator end(){ return iterator(nullptr); }
+
+private:
+	ofStringView rest;
+	ofStringView delimiter;
+	bool ignoreEmpty;
+	bool trim;
+	bool finished;
+};
+
+/// \brief Splits a string using a delimiter without copying the tokens.
+///
+/// Same as ofSplitString but returns views into source.
+std::vector<ofStringView> ofSplitStringView(ofStringView source, ofStringView delimiter, bool ignoreEmpty = false, bool trim = false);
+
+/// \brief Splits a string into tokens, reusing its memory.
+///
+/// Splitting every line of a file into the same vector doesn't allocate
+/// once it's big enough for the longest line.
+void ofSplitStringView(ofStringView source, ofStringView delimiter, std::vector<ofStringView> & tokens, bool ignoreEmpty = false, bool trim = false);
+
+/// \returns str without the whitespace at its beginning and end.
+ofStringView ofTrimStringView(ofStringView str);
+
+/// \brief Splits text in at most numChunks consecutive chunks of similar
+/// size that only contain whole lines, to process them in parallel.
+///
+/// See ofParallelForLines.
+std::vector<ofStringView> ofSplitLineChunks(ofStringView text, std::size_t numChunks);
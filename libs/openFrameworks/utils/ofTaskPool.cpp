@@ -0,0 +1,307 @@
+#include "ofTaskPool.h"
+#include "ofLog.h"
+#include <chrono>
+
+#ifdef TARGET_ANDROID
+#include <jni.h>
+#include "ofxAndroidUtils.h"
+#endif
+
+#ifdef TARGET_WIN32
+#include <windows.h>
+#elif defined(TARGET_LINUX)
+#include <pthread.h>
+#endif
+
+namespace{
+#ifdef HAS_TLS
+	thread_local const ofTaskPool * currentPool = nullptr;
+	thread_local std::size_t currentIndex = 0;
+#endif
+}
+
+//--------------------------------------------------------------
+ofTaskPool::ofTaskPool(std::size_t threads, bool pinToCores){
+	auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+#ifdef TARGET_NO_THREADS
+	numThreads = 0;
+#else
+	numThreads = threads > 0 ? threads : std::max(cores - 1, 1u);
+#endif
+	for(std::size_t i = 0; i < numThreads + 1; i++){
+		workers.emplace_back(new Worker);
+	}
+
+	// workers wait for this lock before doing anything so they don't see
+	// the thread objects while they are still being assigned
+	std::unique_lock<std::mutex> lock(sleepMutex);
+	for(std::size_t i = 0; i < numThreads; i++){
+		workers[i]->thread = std::thread(&ofTaskPool::workerLoop, this, i);
+		if(pinToCores){
+			pin(i, (i + 1) % cores);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+ofTaskPool::~ofTaskPool(){
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		running = false;
+		wakeUp.notify_all();
+	}
+	for(std::size_t i = 0; i < numThreads; i++){
+		workers[i]->thread.join();
+	}
+	// only left if there's no threads at all
+	while(runPendingTask()){}
+}
+
+//--------------------------------------------------------------
+void ofTaskPool::submit(std::function<void()> task){
+	if(numThreads == 0){
+		runTask(*workers.back(), task);
+		return;
+	}
+
+	auto & worker = *workers[currentWorker()];
+	{
+		std::unique_lock<std::mutex> lock(worker.mutex);
+		worker.tasks.push_back(std::move(task));
+		pending++;
+	}
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(sleeping.load(std::memory_order_relaxed) > 0){
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeUp.notify_one();
+	}
+}
+
+//--------------------------------------------------------------
+bool ofTaskPool::runPendingTask(){
+	auto index = currentWorker();
+	Task task;
+	if(popTask(index, task)){
+		runTask(*workers[index], task);
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+std::size_t ofTaskPool::getNumThreads() const{
+	return numThreads;
+}
+
+//--------------------------------------------------------------
+bool ofTaskPool::isWorkerThread() const{
+	return currentWorker() < numThreads;
+}
+
+//--------------------------------------------------------------
+ofTaskPoolStats ofTaskPool::getStats() const{
+	ofTaskPoolStats stats;
+	stats.numThreads = numThreads;
+	stats.queued = pending;
+	for(auto & worker: workers){
+		stats.executed += worker->executed;
+		stats.steals += worker->steals;
+		stats.busyTimeMicros += worker->busyTimeMicros;
+	}
+	return stats;
+}
+
+//--------------------------------------------------------------
+void ofTaskPool::resetStats(){
+	for(auto & worker: workers){
+		worker->executed = 0;
+		worker->steals = 0;
+		worker->busyTimeMicros = 0;
+	}
+}
+
+//--------------------------------------------------------------
+void ofTaskPool::workerLoop(std::size_t index){
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+	}
+#ifdef HAS_TLS
+	currentPool = this;
+	currentIndex = index;
+#endif
+#ifdef TARGET_ANDROID
+	JNIEnv * env;
+	if(ofGetJavaVMPtr()->AttachCurrentThread(&env,nullptr) != 0){
+		ofLogWarning("ofTaskPool") << "couldn't attach worker thread to java vm";
+	}
+#endif
+
+	auto & worker = *workers[index];
+	Task task;
+	while(true){
+		if(popTask(index, task)){
+			runTask(worker, task);
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleeping++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		wakeUp.wait(lock, [this]{
+			return pending > 0 || !running;
+		});
+		sleeping--;
+		if(!running && pending == 0){
+			break;
+		}
+	}
+
+#ifdef TARGET_ANDROID
+	ofGetJavaVMPtr()->DetachCurrentThread();
+#endif
+}
+
+//--------------------------------------------------------------
+bool ofTaskPool::popTask(std::size_t index, Task & task){
+	// newest task of our own queue first, it's the most likely to have
+	// its data still in cache
+	if(index < numThreads){
+		auto & worker = *workers[index];
+		std::unique_lock<std::mutex> lock(worker.mutex);
+		if(!worker.tasks.empty()){
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			pending--;
+			return true;
+		}
+	}
+
+	// then the oldest tasks submitted from outside the pool and finally
+	// the oldest tasks of the other workers, starting with the next one
+	// so not everybody tries to steal from the same worker
+	for(std::size_t i = 0; i < workers.size(); i++){
+		auto victimIndex = i == 0 ? numThreads : (index + i) % (numThreads + 1);
+		if(victimIndex == index && index < numThreads){
+			continue;
+		}
+		auto & victim = *workers[victimIndex];
+		std::unique_lock<std::mutex> lock(victim.mutex);
+		if(!victim.tasks.empty()){
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			pending--;
+			if(victimIndex < numThreads && index < numThreads){
+				workers[index]->steals++;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void ofTaskPool::runTask(Worker & worker, Task & task){
+	auto start = std::chrono::steady_clock::now();
+	try{
+		task();
+	}catch(const std::exception & e){
+		ofLogError("ofTaskPool") << "exception in task: " << e.what();
+	}catch(...){
+		ofLogError("ofTaskPool") << "unknown exception in task";
+	}
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	worker.busyTimeMicros += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+	worker.executed++;
+}
+
+//--------------------------------------------------------------
+std::size_t ofTaskPool::currentWorker() const{
+#ifdef HAS_TLS
+	if(currentPool == this){
+		return currentIndex;
+	}
+#else
+	auto id = std::this_thread::get_id();
+	for(std::size_t i = 0; i < numThreads; i++){
+		if(workers[i]->thread.get_id() == id){
+			return i;
+		}
+	}
+#endif
+	return numThreads;
+}
+
+//--------------------------------------------------------------
+void ofTaskPool::pin(std::size_t index, std::size_t core){
+	auto & thread = workers[index]->thread;
+#if defined(TARGET_WIN32)
+	if(SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core) == 0){
+		ofLogWarning("ofTaskPool") << "couldn't pin worker " << index << " to core " << core;
+	}
+#elif defined(TARGET_LINUX)
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(core, &cpus);
+	if(pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpus) != 0){
+		ofLogWarning("ofTaskPool") << "couldn't pin worker " << index << " to core " << core;
+	}
+#else
+	ofLogWarning("ofTaskPool") << "pinning threads to cores is not supported on this platform";
+#endif
+}
+
+//--------------------------------------------------------------
+ofTaskPool & ofGetTaskPool(){
+	// never destroyed so tasks still running at exit don't use a
+	// destroyed pool
+	static ofTaskPool * pool = new ofTaskPool;
+	return *pool;
+}
+
+//--------------------------------------------------------------
+ofTaskGroup::ofTaskGroup(ofTaskPool & pool)
+:pool(pool){
+
+}
+
+//--------------------------------------------------------------
+ofTaskGroup::~ofTaskGroup(){
+	wait();
+}
+
+//--------------------------------------------------------------
+void ofTaskGroup::run(std::function<void()> task){
+	pending++;
+	pool.submit([this, task]{
+		try{
+			task();
+		}catch(const std::exception & e){
+			ofLogError("ofTaskGroup") << "exception in task: " << e.what();
+		}catch(...){
+			ofLogError("ofTaskGroup") << "unknown exception in task";
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		if(--pending == 0){
+			done.notify_all();
+		}
+	});
+}
+
+//--------------------------------------------------------------
+void ofTaskGroup::wait(){
+	while(pending > 0){
+		if(pool.runPendingTask()){
+			continue;
+		}
+		// our last tasks are running in other threads, check again from
+		// time to time in case they submit more work we could help with
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait_for(lock, std::chrono::milliseconds(1), [this]{
+			return pending == 0;
+		});
+	}
+	// the last task might still be notifying, wait for it to release the
+	// mutex before the group can be destroyed
+	std::unique_lock<std::mutex> lock(mutex);
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofEventQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/// \brief Statistics of an ofTaskPool since it started or since the last
+/// call to resetStats().
+struct ofTaskPoolStats{
+	/// number of worker threads
+	std::size_t numThreads = 0;
+	/// tasks waiting to run right now
+	std::size_t queued = 0;
+	/// tasks that finished
+	uint64_t executed = 0;
+	/// tasks a worker took from another worker's queue
+	uint64_t steals = 0;
+	/// time spent running tasks summed over every thread
+	uint64_t busyTimeMicros = 0;
+};
+
+/// \brief Pool of threads that run small tasks.
+///
+/// Starting a thread for every job, like ofThread does, is expensive and
+/// many of them running at once oversubscribe the cores. ofTaskPool keeps a
+/// thread per core running tasks from a queue instead. Usually there's no
+/// need to create one, ofGetTaskPool() returns a pool shared by the whole
+/// application which is what ofParallelFor and ofTaskGroup use by default.
+///
+/// Every worker has its own queue: tasks submitted from a worker go to its
+/// queue and idle workers steal tasks from the queues of busy ones, so
+/// tasks that create more tasks, like a nested ofParallelFor, keep every
+/// core busy without fighting over a single queue.
+///
+/// ~~~~{.cpp}
+/// auto future = ofGetTaskPool().async([]{
+/// 	return ofLoadImage(pixels, "big.png");
+/// });
+/// ~~~~
+class ofTaskPool{
+public:
+	/// \param numThreads number of worker threads, 0 uses one less than
+	/// the number of cores since the thread waiting for the tasks usually
+	/// runs some of them too.
+	/// \param pinToCores bind every worker to a different core. Only
+	/// supported on linux and windows.
+	ofTaskPool(std::size_t numThreads = 0, bool pinToCores = false);
+	~ofTaskPool();
+	ofTaskPool(const ofTaskPool &) = delete;
+	ofTaskPool & operator=(const ofTaskPool &) = delete;
+
+	/// \brief Run task in some worker thread.
+	///
+	/// Exceptions thrown by task are logged, use async() to get them back.
+	void submit(std::function<void()> task);
+
+	/// \brief Run f in some worker thread.
+	/// \returns a future to get the result of f or the exception it threw.
+	template<typename F>
+	std::future<typename std::result_of<F()>::type> async(F f){
+		typedef typename std::result_of<F()>::type R;
+		auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+		auto future = task->get_future();
+		submit([task]{
+			(*task)();
+		});
+		return future;
+	}
+
+	/// \brief Run f in some worker thread and then call continuation with
+	/// a ready future holding the result of f or the exception it threw.
+	///
+	/// The continuation runs in the same worker right after f unless a
+	/// queue is passed, then it runs on the thread that drains the queue.
+	/// Passing &ofGetMainEventQueue() runs it on the main thread before the
+	/// next update.
+	template<typename F, typename Continuation>
+	void async(F f, Continuation continuation, ofEventQueue * queue = nullptr){
+		typedef typename std::result_of<F()>::type R;
+		auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+		submit([task, continuation, queue]() mutable{
+			(*task)();
+			auto future = std::make_shared<std::future<R>>(task->get_future());
+			if(queue){
+				queue->post([future, continuation]() mutable{
+					continuation(std::move(*future));
+				});
+			}else{
+				continuation(std::move(*future));
+			}
+		});
+	}
+
+	/// \brief Run one queued task in the calling thread, if there's any.
+	///
+	/// Used by anything waiting for tasks so the waiting thread helps
+	/// instead of just blocking.
+	/// \returns true if a task was run.
+	bool runPendingTask();
+
+	/// \returns the number of worker threads.
+	std::size_t getNumThreads() const;
+
+	/// \returns true if called from one of the worker threads of this pool.
+	bool isWorkerThread() const;
+
+	ofTaskPoolStats getStats() const;
+	void resetStats();
+
+private:
+	typedef std::function<void()> Task;
+
+	struct Worker{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+		std::thread thread;
+		std::atomic<uint64_t> executed{0};
+		std::atomic<uint64_t> steals{0};
+		std::atomic<uint64_t> busyTimeMicros{0};
+	};
+
+	void workerLoop(std::size_t index);
+	bool popTask(std::size_t index, Task & task);
+	void runTask(Worker & worker, Task & task);
+	std::size_t currentWorker() const;
+	void pin(std::size_t index, std::size_t core);
+
+	// one worker per thread plus one last queue for tasks submitted
+	// from threads outside the pool
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::size_t numThreads;
+	std::atomic<std::size_t> pending{0};
+	std::atomic<std::size_t> sleeping{0};
+	std::atomic<bool> running{true};
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+};
+
+/// \brief Task pool shared by the whole application.
+ofTaskPool & ofGetTaskPool();
+
+/// \brief Runs tasks in an ofTaskPool and waits for all of them to finish.
+///
+/// ~~~~{.cpp}
+/// ofTaskGroup group;
+/// group.run([&]{ left.update(); });
+/// group.run([&]{ right.update(); });
+/// group.wait();
+/// ~~~~
+class ofTaskGroup{
+public:
+	ofTaskGroup(ofTaskPool & pool = ofGetTaskPool());
+
+	/// \brief Waits for the remaining tasks.
+	~ofTaskGroup();
+	ofTaskGroup(const ofTaskGroup &) = delete;
+	ofTaskGroup & operator=(const ofTaskGroup &) = delete;
+
+	/// \brief Run task as part of this group.
+	///
+	/// Exceptions thrown by task are logged.
+	void run(std::function<void()> task);
+
+	/// \brief Block until every task run in this group finished, running
+	/// queued tasks of the pool in the meantime.
+	void wait();
+
+private:
+	ofTaskPool & pool;
+	std::atomic<std::size_t> pending{0};
+	std::mutex mutex;
+	std::condition_variable done;
+};
+
+/// \brief Call f(chunkBegin, chunkEnd) for consecutive chunks of
+/// [begin, end) in parallel and wait for all of them.
+///
+/// The calling thread runs part of the work too. Chunks have at least
+/// grainSize indices, use a bigger grainSize when the work per index is
+/// very small.
+template<typename F>
+void ofParallelForRange(std::size_t begin, std::size_t end, F f, std::size_t grainSize = 1, ofTaskPool & pool = ofGetTaskPool()){
+	if(end <= begin){
+		return;
+	}
+	auto count = end - begin;
+	// a few chunks per thread so threads that finish early can steal
+	auto maxChunks = (pool.getNumThreads() + 1) * 4;
+	auto chunk = std::max(std::max(grainSize, std::size_t(1)), (count + maxChunks - 1) / maxChunks);
+	if(chunk >= count){
+		f(begin, end);
+		return;
+	}
+
+	ofTaskGroup group(pool);
+	for(auto chunkBegin = begin + chunk; chunkBegin < end; chunkBegin += chunk){
+		auto chunkEnd = std::min(chunkBegin + chunk, end);
+		group.run([&f, chunkBegin, chunkEnd]{
+			f(chunkBegin, chunkEnd);
+		});
+	}
+	f(begin, begin + chunk);
+	group.wait();
+}
+
+/// \brief Call f(i) for every i in [begin, end) in parallel and wait for
+/// all of them.
+///
+/// ~~~~{.cpp}
+/// ofParallelFor(0, particles.size(), [&](std::size_t i){
+/// 	particles[i].update();
+/// });
+/// ~~~~
+template<typename F>
+void ofParallelFor(std::size_t begin, std::size_t end, F f, std::size_t grainSize = 1, ofTaskPool & pool = ofGetTaskPool()){
+	ofParallelForRange(begin, end, [&f](std::size_t chunkBegin, std::size_t chunkEnd){
+		for(auto i = chunkBegin; i < chunkEnd; i++){
+			f(i);
+		}
+	}, grainSize, pool);
+}
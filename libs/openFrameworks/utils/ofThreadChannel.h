@@ -4,8 +4,20 @@
 #include <mutex>
 #include <queue>
 #include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 #include "ofUtils.h"
 
+#if defined(OF_USE_SSE)
+	#include <emmintrin.h>
+#endif
+
+#ifndef OF_CACHE_LINE_SIZE
+	/// \brief Size in bytes used to keep data written by different threads in different cache lines.
+	#define OF_CACHE_LINE_SIZE 64
+#endif
+
 
 /// \brief Safely send data between threads without additional synchronization.
 ///
@@ -257,6 +269,81 @@ public:
 		return true;
 	}
 
+	/// \brief Send several values at once by making a copy.
+	///
+	/// Locks the channel only once for all the values.
+	///
+	/// \returns true if the values were sent successfully or false if the channel was closed.
+	bool sendBatch(const std::vector<T> & values){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(closed){
+			return false;
+		}
+		for(auto & value: values){
+			queue.push(value);
+		}
+		condition.notify_one();
+		return true;
+	}
+
+	/// \brief Send several values at once without making a copy.
+	///
+	/// Locks the channel only once for all the values. values is left empty
+	/// even if the send fails because the channel is closed.
+	///
+	/// \returns true if the values were sent successfully or false if the channel was closed.
+	bool sendBatch(std::vector<T> && values){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(closed){
+			values.clear();
+			return false;
+		}
+		for(auto & value: values){
+			queue.push(std::move(value));
+		}
+		values.clear();
+		condition.notify_one();
+		return true;
+	}
+
+	/// \brief Block until there's something to receive and then receive
+	/// every available value at once.
+	///
+	/// The values are appended to the end of values.
+	///
+	/// \returns True if new values were received or false if the ofThreadChannel was closed.
+	bool receiveAll(std::vector<T> & values){
+		std::unique_lock<std::mutex> lock(mutex);
+		while(queue.empty() && !closed){
+			condition.wait(lock);
+		}
+		if(closed){
+			return false;
+		}
+		while(!queue.empty()){
+			values.push_back(std::move(queue.front()));
+			queue.pop();
+		}
+		return true;
+	}
+
+	/// \brief Receive every available value at once without blocking.
+	///
+	/// The values are appended to the end of values.
+	///
+	/// \returns True if new values were received or false if there was no new data OR the ofThreadChannel was closed.
+	bool tryReceiveAll(std::vector<T> & values){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(closed || queue.empty()){
+			return false;
+		}
+		while(!queue.empty()){
+			values.push_back(std::move(queue.front()));
+			queue.pop();
+		}
+		return true;
+	}
+
 	/// \brief Close the ofThreadChannel.
 	///
 	/// Closing the ofThreadChannel means that no new messages can be sent or
@@ -293,3 +380,378 @@ private:
 	bool closed;
 
 };
+
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// Spins for a while before sleeping on a condition variable so short
+	// waits don't pay for a context switch and long ones don't burn a core.
+	// Whoever makes the condition true calls notify() which only locks if
+	// somebody is actually sleeping.
+	class SpinThenParkWaiter{
+	public:
+		template<typename Ready>
+		void wait(std::size_t spinCount, Ready ready){
+			if(spin(spinCount, ready)){
+				return;
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			waiting.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			condition.wait(lock, ready);
+			waiting.fetch_sub(1);
+		}
+
+		template<typename Ready>
+		bool waitFor(std::size_t spinCount, int64_t timeoutMs, Ready ready){
+			if(spin(spinCount, ready)){
+				return true;
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			waiting.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto result = condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+			waiting.fetch_sub(1);
+			return result;
+		}
+
+		void notify(){
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(waiting.load(std::memory_order_relaxed) > 0){
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.notify_all();
+			}
+		}
+
+	private:
+		template<typename Ready>
+		static bool spin(std::size_t spinCount, Ready & ready){
+			for(std::size_t i = 0; i < spinCount; i++){
+				if(ready()){
+					return true;
+				}
+#if defined(OF_USE_SSE)
+				_mm_pause();
+#else
+				std::this_thread::yield();
+#endif
+			}
+			return ready();
+		}
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::atomic<int> waiting{0};
+	};
+}
+}
+/*! \endcond */
+
+/// \brief Whether a bounded thread channel can be used from one or many
+/// threads at each end.
+enum ofThreadChannelMode{
+	/// one thread sends, one thread receives
+	OF_THREAD_CHANNEL_SPSC,
+	/// any number of threads send and receive
+	OF_THREAD_CHANNEL_MPMC
+};
+
+/// \brief Lock free version of ofThreadChannel with a fixed capacity.
+///
+/// Works like ofThreadChannel but values are stored in a ring of fixed size
+/// so sending and receiving never lock or allocate. When the ring is full
+/// send blocks until the receiver makes space, use trySend to give up
+/// instead. Threads that have to wait spin for a short while, see
+/// setSpinCount(), and then sleep until they are woken up.
+///
+/// OF_THREAD_CHANNEL_SPSC is the fastest but can only be used with exactly
+/// one sending and one receiving thread. OF_THREAD_CHANNEL_MPMC can be used
+/// from any number of threads on both ends.
+///
+/// T needs to be default constructible since the ring is allocated up
+/// front. Like ofThreadChannel, receive swaps the received value with the
+/// one passed in so memory in values like ofPixels can be reused.
+///
+/// ~~~~{.cpp}
+/// ofBoundedThreadChannel<ofPixels, OF_THREAD_CHANNEL_SPSC> frames(8);
+/// ~~~~
+template<typename T, ofThreadChannelMode Mode = OF_THREAD_CHANNEL_MPMC>
+class ofBoundedThreadChannel{
+public:
+	/// \param capacity maximum number of values in the channel, rounded up
+	/// to a power of 2.
+	ofBoundedThreadChannel(std::size_t capacity = 1024){
+		std::size_t size = 2;
+		while(size < capacity){
+			size <<= 1;
+		}
+		cells.reset(new Cell[size]);
+		mask = size - 1;
+		for(std::size_t i = 0; i < size; i++){
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	ofBoundedThreadChannel(const ofBoundedThreadChannel &) = delete;
+	ofBoundedThreadChannel & operator=(const ofBoundedThreadChannel &) = delete;
+
+	/// \brief Block the receiving thread until a new sent value is available.
+	/// \returns True if a new value was received or false if the channel was closed.
+	bool receive(T & sentValue){
+		auto received = false;
+		notEmpty.wait(spinCount, [&]{
+			return closed || (received = tryPop([&](T & value){ std::swap(sentValue, value); }));
+		});
+		return finishReceive(received);
+	}
+
+	/// \brief If available, receive a new sent value without blocking.
+	/// \returns True if a new value was received or false if there was no new data OR the channel was closed.
+	bool tryReceive(T & sentValue){
+		if(closed){
+			return false;
+		}
+		return finishReceive(tryPop([&](T & value){ std::swap(sentValue, value); }));
+	}
+
+	/// \brief If available, receive a new sent value or wait for a user-specified duration.
+	/// \returns True if a new value was received or false if there was no new data OR the channel was closed.
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		auto received = false;
+		notEmpty.waitFor(spinCount, timeoutMs, [&]{
+			return closed || (received = tryPop([&](T & value){ std::swap(sentValue, value); }));
+		});
+		return finishReceive(received);
+	}
+
+	/// \brief Block until there's something to receive and then receive
+	/// every available value at once.
+	///
+	/// The values are appended to the end of values.
+	/// \returns True if new values were received or false if the channel was closed.
+	bool receiveAll(std::vector<T> & values){
+		auto received = false;
+		notEmpty.wait(spinCount, [&]{
+			return closed || (received = popAll(values));
+		});
+		return finishReceive(received);
+	}
+
+	/// \brief Receive every available value at once without blocking.
+	/// \returns True if new values were received or false if there was no new data OR the channel was closed.
+	bool tryReceiveAll(std::vector<T> & values){
+		if(closed){
+			return false;
+		}
+		return finishReceive(popAll(values));
+	}
+
+	/// \brief Send a value by making a copy, waiting while the channel is full.
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(const T & value){
+		return waitAndPush([&](T & cell){ cell = value; });
+	}
+
+	/// \brief Send a value without making a copy, waiting while the channel is full.
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(T && value){
+		return waitAndPush([&](T & cell){ cell = std::move(value); });
+	}
+
+	/// \brief Send a value by making a copy if there's space in the channel.
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(const T & value){
+		return !closed && finishSend(tryPush([&](T & cell){ cell = value; }));
+	}
+
+	/// \brief Send a value without making a copy if there's space in the channel.
+	///
+	/// value is only moved if it was sent.
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(T && value){
+		return !closed && finishSend(tryPush([&](T & cell){ cell = std::move(value); }));
+	}
+
+	/// \brief Send several values by making a copy, waiting while the
+	/// channel is full.
+	/// \returns true if the values were sent successfully or false if the channel was closed.
+	bool sendBatch(const std::vector<T> & values){
+		for(auto & value: values){
+			if(!pushInBatch([&](T & cell){ cell = value; })){
+				return false;
+			}
+		}
+		notEmpty.notify();
+		return true;
+	}
+
+	/// \brief Send several values without making a copy, waiting while the
+	/// channel is full. values is left empty.
+	/// \returns true if the values were sent successfully or false if the channel was closed.
+	bool sendBatch(std::vector<T> && values){
+		auto sent = true;
+		for(auto & value: values){
+			if(!pushInBatch([&](T & cell){ cell = std::move(value); })){
+				sent = false;
+				break;
+			}
+		}
+		values.clear();
+		notEmpty.notify();
+		return sent;
+	}
+
+	/// \brief Close the channel.
+	///
+	/// All threads waiting to send or receive are woken up and every call
+	/// from now on returns false.
+	void close(){
+		closed = true;
+		notEmpty.notify();
+		notFull.notify();
+	}
+
+	/// \brief Queries empty channel.
+	///
+	/// Like in ofThreadChannel this is only an approximation.
+	bool empty() const{
+		return enqueuePos.load() == dequeuePos.load();
+	}
+
+	/// \returns the maximum number of values the channel can hold.
+	std::size_t capacity() const{
+		return mask + 1;
+	}
+
+	/// \brief Number of times a thread checks the channel before sleeping
+	/// while it waits. 0 sleeps right away. Defaults to 1000.
+	void setSpinCount(std::size_t count){
+		spinCount = count;
+	}
+
+private:
+	struct Cell{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	// Every cell has a sequence number that tells whose turn it is to use
+	// it: pos for the sender that will fill it, pos + 1 for the receiver
+	// that will empty it. With a single sender or receiver the position
+	// doesn't need to be claimed with a CAS.
+	template<typename Assign>
+	bool tryPush(Assign assign){
+		Cell * cell;
+		auto pos = enqueuePos.load(std::memory_order_relaxed);
+		while(true){
+			cell = &cells[pos & mask];
+			auto sequence = cell->sequence.load(std::memory_order_acquire);
+			auto diff = std::intptr_t(sequence) - std::intptr_t(pos);
+			if(diff == 0){
+				if(Mode == OF_THREAD_CHANNEL_SPSC){
+					enqueuePos.store(pos + 1, std::memory_order_relaxed);
+					break;
+				}else if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		assign(cell->value);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename Take>
+	bool tryPop(Take take){
+		Cell * cell;
+		auto pos = dequeuePos.load(std::memory_order_relaxed);
+		while(true){
+			cell = &cells[pos & mask];
+			auto sequence = cell->sequence.load(std::memory_order_acquire);
+			auto diff = std::intptr_t(sequence) - std::intptr_t(pos + 1);
+			if(diff == 0){
+				if(Mode == OF_THREAD_CHANNEL_SPSC){
+					dequeuePos.store(pos + 1, std::memory_order_relaxed);
+					break;
+				}else if(dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+		take(cell->value);
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool popAll(std::vector<T> & values){
+		auto received = false;
+		while(tryPop([&](T & value){ values.push_back(std::move(value)); })){
+			received = true;
+		}
+		return received;
+	}
+
+	template<typename Assign>
+	bool waitAndPush(Assign assign, bool notify = true){
+		auto pushed = false;
+		notFull.wait(spinCount, [&]{
+			return closed || (pushed = tryPush(assign));
+		});
+		if(pushed && notify){
+			notEmpty.notify();
+		}
+		return pushed;
+	}
+
+	// Batches only wake the receiver once at the end but if the ring fills
+	// up before that the receiver has to be woken before waiting for space
+	// or a batch bigger than the capacity would never be received.
+	template<typename Assign>
+	bool pushInBatch(Assign assign){
+		if(closed){
+			return false;
+		}
+		if(tryPush(assign)){
+			return true;
+		}
+		notEmpty.notify();
+		return waitAndPush(assign, false);
+	}
+
+	bool finishReceive(bool received){
+		if(received){
+			notFull.notify();
+		}
+		return received;
+	}
+
+	bool finishSend(bool sent){
+		if(sent){
+			notEmpty.notify();
+		}
+		return sent;
+	}
+
+	std::unique_ptr<Cell[]> cells;
+	std::size_t mask;
+
+	// keeps the positions used by senders and receivers in different
+	// cache lines. the offsets between them stay a line apart even if the
+	// channel is allocated without the requested alignment
+	alignas(OF_CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePos{0};
+	alignas(OF_CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePos{0};
+
+	alignas(OF_CACHE_LINE_SIZE) std::atomic<bool> closed{false};
+	std::size_t spinCount = 1000;
+	of::priv::SpinThenParkWaiter notEmpty;
+	of::priv::SpinThenParkWaiter notFull;
+};
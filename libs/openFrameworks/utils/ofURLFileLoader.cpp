@@ -11,10 +11,11 @@ using namespace std;
 	#include <curl/curl.h>
 	#include "ofThreadChannel.h"
 	#include "ofThread.h"
+	#include "ofJobQueue.h"
 	static bool curlInited = false;
 #endif
 
-int	ofHttpRequest::nextID = 0;
+std::atomic<int> ofHttpRequest::nextID{0};
 
 ofEvent<ofHttpResponse> & ofURLResponseEvent(){
 	static ofEvent<ofHttpResponse> * event = new ofEvent<ofHttpResponse>;
@@ -22,6 +23,135 @@ ofEvent<ofHttpResponse> & ofURLResponseEvent(){
 }
 
 #if !defined(TARGET_IMPLEMENTS_URL_LOADER)
+namespace{
+	struct ofURLTransfer{
+		ofHttpResponse response;
+		CURL * curl = nullptr;
+		curl_slist * headers = nullptr;
+		std::size_t bodySent = 0;
+		ofFile file;
+		// the received callback returned false
+		bool aborted = false;
+		// part of the body was already passed to the received callback
+		bool started = false;
+		// how many times the request failed before this transfer
+		int attempts = 0;
+	};
+
+	// a request waiting to start, retries wait in the queue until retryAt
+	struct ofURLPending{
+		ofHttpRequest request;
+		int attempts = 0;
+		std::chrono::steady_clock::time_point retryAt;
+	};
+
+	// requests that fail with a network error are retried this many times,
+	// waiting twice as long before each new attempt
+	const int maxRetries = 3;
+	const std::chrono::milliseconds firstRetryDelay(500);
+
+	// cancels every request in the queue, sent to the thread by clear()
+	const int allRequests = -1;
+
+	// new requests and cancellations go through the same channel so the
+	// thread sees them in the order they were made
+	struct ofURLCommand{
+		ofHttpRequest request;
+		bool cancel = false;
+		int cancelId = allRequests;
+	};
+
+	size_t receive_cb(char *buffer, size_t size, size_t nmemb, void *userdata){
+		auto transfer = (ofURLTransfer*)userdata;
+		auto & request = transfer->response.request;
+		if(request.received){
+			transfer->started = true;
+			if(!request.received(buffer, size * nmemb)){
+				transfer->aborted = true;
+				return 0;
+			}
+		}else if(request.saveTo){
+			transfer->file.write(buffer, size * nmemb);
+		}else{
+			transfer->response.data.append(buffer, size * nmemb);
+		}
+		return size * nmemb;
+	}
+
+	size_t readBody_cb(char *ptr, size_t size, size_t nmemb, void *userdata){
+		auto transfer = (ofURLTransfer*)userdata;
+		auto & body = transfer->response.request.body;
+		auto sent = std::min(size * nmemb, body.size() - transfer->bodySent);
+		memcpy(ptr, body.data() + transfer->bodySent, sent);
+		transfer->bodySent += sent;
+		return sent;
+	}
+
+	bool setup(ofURLTransfer & transfer){
+		auto curl = transfer.curl;
+		const auto & request = transfer.response.request;
+		curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+
+		// always follow redirections
+		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+
+		// use HTTP/2 with servers that support it over https
+		curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
+		// Set content type and any other header
+		if(request.contentType!=""){
+			transfer.headers = curl_slist_append(transfer.headers, ("Content-Type: " + request.contentType).c_str());
+		}
+		for(auto & header: request.headers){
+			transfer.headers = curl_slist_append(transfer.headers, (header.first + ": " + header.second).c_str());
+		}
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
+
+		// set body if there's any
+		if(request.body!=""){
+			curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, long(request.body.size()));
+			curl_easy_setopt(curl, CURLOPT_READFUNCTION, readBody_cb);
+			curl_easy_setopt(curl, CURLOPT_READDATA, &transfer);
+		}
+		if(request.method == ofHttpRequest::GET){
+			curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+		}else{
+			curl_easy_setopt(curl, CURLOPT_POST, 1L);
+		}
+
+		if(request.timeoutSeconds>0){
+			curl_easy_setopt(curl, CURLOPT_TIMEOUT, long(request.timeoutSeconds));
+		}
+
+		if(request.saveTo && !request.received && !transfer.file.open(request.name, ofFile::WriteOnly, true)){
+			transfer.response.status = -1;
+			transfer.response.error = "couldn't open " + request.name;
+			return false;
+		}
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, receive_cb);
+		return true;
+	}
+
+	void finish(ofURLTransfer & transfer, CURLcode code){
+		if(code==CURLE_OK){
+			long http_code = 0;
+			curl_easy_getinfo(transfer.curl, CURLINFO_RESPONSE_CODE, &http_code);
+			transfer.response.status = http_code;
+		}else{
+			transfer.response.status = -1;
+			transfer.response.error = curl_easy_strerror(code);
+		}
+	}
+
+	// the received callback returned false
+	void cancelled(ofURLTransfer & transfer){
+		transfer.response.status = -1;
+		transfer.response.error = "cancelled";
+	}
+}
+
 class ofURLFileLoaderImpl: public ofThread, public ofBaseURLFileLoader{
 public:
 	ofURLFileLoaderImpl();
@@ -35,34 +165,82 @@ public:
 	void stop();
 	ofHttpResponse handleRequest(const ofHttpRequest & request);
 	int handleRequestAsync(const ofHttpRequest& request); // returns id
+	void setMaxConcurrentRequests(std::size_t max);
+	void setMaxConnectionsPerHost(std::size_t max);
 
 protected:
 	// threading -----------------------------------------------
 	void threadedFunction();
 	void start();
-	void update(ofEventArgs & args);  // notify in update so the notification is thread safe
+	// wakes up the thread if it's waiting for transfers
+	void wakeup();
+	// notify from the main thread so the notification is thread safe
+	static void notifyResponse(std::weak_ptr<ofThreadChannel<ofHttpResponse>> responses);
 
 private:
 	// perform the requests on the thread
-
-	ofThreadChannel<ofHttpRequest> requests;
-	ofThreadChannel<ofHttpResponse> responses;
-	ofThreadChannel<int> cancelRequestQueue;
-	set<int> cancelledRequests;
-	std::unique_ptr<CURL, void(*)(CURL*)> curl;
+	void process(ofURLCommand && command);
+	void enqueue(ofHttpRequest && request, int attempts = 0);
+	void retryLater(ofURLTransfer & transfer);
+	void enqueueRetries();
+	void cancel(int id);
+	void startTransfers();
+	void finishTransfers();
+	void deliver(ofHttpResponse && response);
+	void release(ofURLTransfer & transfer);
+
+	// runs a request on the calling thread
+	ofHttpResponse perform(const ofHttpRequest & request);
+
+	ofThreadChannel<ofURLCommand> commands;
+	// shared with the notifications queued on the main thread which might
+	// run after the loader is destroyed
+	std::shared_ptr<ofThreadChannel<ofHttpResponse>> responses;
+	std::atomic<std::size_t> maxConcurrentRequests;
+	std::atomic<std::size_t> maxConnectionsPerHost;
+	std::atomic<bool> settingsChanged;
+
+	// only accessed from the thread
+	std::unique_ptr<CURLM, CURLMcode(*)(CURLM*)> multi;
+	// ordered by highest priority and then by the order they arrived
+	std::map<std::pair<int, uint64_t>, ofURLPending> waiting;
+	uint64_t nextOrder = 0;
+	// requests that failed with a network error, by the time to retry them
+	std::multimap<std::chrono::steady_clock::time_point, ofURLPending> retries;
+	std::vector<std::unique_ptr<ofURLTransfer>> running;
+	// easy handles are reused so they keep their DNS cache
+	std::vector<CURL*> idleHandles;
+
+	// the same for blocking requests which can run from any thread, they
+	// also keep their connection open for the next request to that host
+	std::mutex blockingHandlesMutex;
+	std::vector<CURL*> blockingHandles;
 };
 
 ofURLFileLoaderImpl::ofURLFileLoaderImpl()
-:curl(nullptr, nullptr){
+:responses(std::make_shared<ofThreadChannel<ofHttpResponse>>())
+,maxConcurrentRequests(16)
+,maxConnectionsPerHost(6)
+,settingsChanged(true)
+,multi(nullptr, nullptr){
 	if(!curlInited){
 		 curl_global_init(CURL_GLOBAL_ALL);
+		 curlInited = true;
 	}
-	curl = std::unique_ptr<CURL, void(*)(CURL*)>(curl_easy_init(), curl_easy_cleanup);
+	multi = std::unique_ptr<CURLM, CURLMcode(*)(CURLM*)>(curl_multi_init(), curl_multi_cleanup);
+	// several requests to the same HTTP/2 server share one connection
+	curl_multi_setopt(multi.get(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
 }
 
 ofURLFileLoaderImpl::~ofURLFileLoaderImpl(){
 	clear();
 	stop();
+	for(auto curl: idleHandles){
+		curl_easy_cleanup(curl);
+	}
+	for(auto curl: blockingHandles){
+		curl_easy_cleanup(curl);
+	}
 }
 
 ofHttpResponse ofURLFileLoaderImpl::get(const string& url) {
@@ -73,9 +251,7 @@ ofHttpResponse ofURLFileLoaderImpl::get(const string& url) {
 
 int ofURLFileLoaderImpl::getAsync(const string& url, const string& name){
 	ofHttpRequest request(url, name.empty() ? url : name);
-	requests.send(request);
-	start();
-	return request.getId();
+	return handleRequestAsync(request);
 }
 
 
@@ -86,176 +262,307 @@ ofHttpResponse ofURLFileLoaderImpl::saveTo(const string& url, const std::filesys
 
 int ofURLFileLoaderImpl::saveAsync(const string& url, const std::filesystem::path& path){
 	ofHttpRequest request(url,path.string(),true);
-	requests.send(request);
-	start();
-	return request.getId();
+	return handleRequestAsync(request);
 }
 
 void ofURLFileLoaderImpl::remove(int id){
-	cancelRequestQueue.send(id);
+	ofURLCommand command;
+	command.cancel = true;
+	command.cancelId = id;
+	commands.send(std::move(command));
+	wakeup();
 }
 
 void ofURLFileLoaderImpl::clear(){
 	ofHttpResponse resp;
-	ofHttpRequest req;
-	while(requests.tryReceive(req)){}
-	while(responses.tryReceive(resp)){}
+	ofURLCommand command;
+	command.cancel = true;
+	commands.send(std::move(command));
+	wakeup();
+	while(responses->tryReceive(resp)){}
+}
+
+void ofURLFileLoaderImpl::setMaxConcurrentRequests(std::size_t max){
+	maxConcurrentRequests = std::max<std::size_t>(max, 1);
+	wakeup();
+}
+
+void ofURLFileLoaderImpl::setMaxConnectionsPerHost(std::size_t max){
+	maxConnectionsPerHost = max;
+	settingsChanged = true;
+	wakeup();
 }
 
 void ofURLFileLoaderImpl::start() {
 	 if (!isThreadRunning()){
-		ofAddListener(ofEvents().update,this,&ofURLFileLoaderImpl::update);
 		startThread();
 	}
 }
 
 void ofURLFileLoaderImpl::stop() {
 	stopThread();
-	requests.close();
-	responses.close();
+	commands.close();
+	responses->close();
+	wakeup();
 	waitForThread();
 }
 
+void ofURLFileLoaderImpl::wakeup(){
+#if LIBCURL_VERSION_NUM >= 0x074400
+	curl_multi_wakeup(multi.get());
+#endif
+}
+
 void ofURLFileLoaderImpl::threadedFunction() {
 	setThreadName("ofURLFileLoader " + ofToString(getThreadId()));
 	while( isThreadRunning() ){
-		int cancelled;
-		while(cancelRequestQueue.tryReceive(cancelled)){
-			cancelledRequests.insert(cancelled);
+		ofURLCommand command;
+		if(waiting.empty() && running.empty() && retries.empty()){
+			// nothing to do, sleep until there's a new request
+			if(!commands.receive(command)){
+				break;
+			}
+			process(std::move(command));
 		}
-		ofHttpRequest request;
-		if(requests.receive(request)){
-			if(cancelledRequests.find(request.getId())==cancelledRequests.end()){
-				ofHttpResponse response(handleRequest(request));
-				int status = response.status;
-				if(!responses.send(move(response))){
-					break;
-				}
-				if(status==-1){
-					// retry
-					requests.send(request);
-				}
+		while(commands.tryReceive(command)){
+			process(std::move(command));
+		}
+		if(settingsChanged.exchange(false)){
+			curl_multi_setopt(multi.get(), CURLMOPT_MAX_HOST_CONNECTIONS, long(maxConnectionsPerHost));
+		}
+
+		enqueueRetries();
+		startTransfers();
+		int numRunning = 0;
+		curl_multi_perform(multi.get(), &numRunning);
+		finishTransfers();
+
+		if(!running.empty() || (waiting.empty() && !retries.empty())){
+			// don't sleep past the next retry
+			int timeoutMs = 1000;
+			if(!retries.empty()){
+				auto untilRetry = std::chrono::duration_cast<std::chrono::milliseconds>(retries.begin()->first - std::chrono::steady_clock::now()).count();
+				timeoutMs = int(std::max<long long>(0, std::min<long long>(untilRetry, timeoutMs)));
+			}
+#if LIBCURL_VERSION_NUM >= 0x074400
+			curl_multi_poll(multi.get(), nullptr, 0, timeoutMs, nullptr);
+#else
+			// without wakeups new and cancelled requests are only seen after
+			// the wait so keep it short
+			if(running.empty()){
+				// curl_multi_wait returns right away without transfers
+				ofSleepMillis(std::min(timeoutMs, 10));
 			}else{
-				cancelledRequests.erase(cancelled);
+				curl_multi_wait(multi.get(), nullptr, 0, std::min(timeoutMs, 10), nullptr);
 			}
-		}else{
-			break;
+#endif
 		}
 	}
-}
 
-namespace{
-	size_t saveToFile_cb(void *buffer, size_t size, size_t nmemb, void *userdata){
-		auto saveTo = (ofFile*)userdata;
-		saveTo->write((const char*)buffer, size * nmemb);
-		return size * nmemb;
+	for(auto & transfer: running){
+		release(*transfer);
 	}
+	running.clear();
+	waiting.clear();
+	retries.clear();
+}
 
-	size_t saveToMemory_cb(void *buffer, size_t size, size_t nmemb, void *userdata){
-		auto response = (ofHttpResponse*)userdata;
-		response->data.append((const char*)buffer, size * nmemb);
-		return size * nmemb;
+void ofURLFileLoaderImpl::process(ofURLCommand && command){
+	if(command.cancel){
+		cancel(command.cancelId);
+	}else{
+		enqueue(std::move(command.request));
 	}
+}
 
-    size_t readBody_cb(void *ptr, size_t size, size_t nmemb, void *userdata){
-        auto body = (std::string*)userdata;
-
-        if(size*nmemb < 1){
-            return 0;
-        }
-
-        if(!body->empty()) {
-            auto sent = std::min(size * nmemb, body->size());
-            memcpy(ptr, body->c_str(), sent);
-            *body = body->substr(sent);
-            return sent;
-        }
-
-        return 0;                          /* no more data left to deliver */
-    }
+void ofURLFileLoaderImpl::enqueue(ofHttpRequest && request, int attempts){
+	auto priority = request.priority;
+	ofURLPending pending;
+	pending.request = std::move(request);
+	pending.attempts = attempts;
+	waiting.emplace(std::make_pair(-priority, nextOrder++), std::move(pending));
 }
 
-ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
-	curl_slist *headers = nullptr;
-	curl_easy_setopt(curl.get(), CURLOPT_URL, request.url.c_str());
+void ofURLFileLoaderImpl::retryLater(ofURLTransfer & transfer){
+	ofURLPending pending;
+	pending.request = transfer.response.request;
+	pending.attempts = transfer.attempts + 1;
+	pending.retryAt = std::chrono::steady_clock::now() + firstRetryDelay * (1 << transfer.attempts);
+	retries.emplace(pending.retryAt, std::move(pending));
+}
 
-	// always follow redirections
-	curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
+void ofURLFileLoaderImpl::enqueueRetries(){
+	auto now = std::chrono::steady_clock::now();
+	while(!retries.empty() && retries.begin()->first <= now){
+		auto & pending = retries.begin()->second;
+		enqueue(std::move(pending.request), pending.attempts);
+		retries.erase(retries.begin());
+	}
+}
 
-	// Set content type and any other header
-	if(request.contentType!=""){
-		headers = curl_slist_append(headers, ("Content-Type: " + request.contentType).c_str());
+void ofURLFileLoaderImpl::cancel(int id){
+	auto isCancelled = [&](const ofHttpRequest & request){
+		return id == allRequests || request.getId() == id;
+	};
+	for(auto it = waiting.begin(); it != waiting.end();){
+		if(isCancelled(it->second.request)){
+			it = waiting.erase(it);
+		}else{
+			++it;
+		}
 	}
-	for(map<string,string>::const_iterator it = request.headers.cbegin(); it!=request.headers.cend(); it++){
-		headers = curl_slist_append(headers, (it->first + ": " +it->second).c_str());
+	for(auto it = retries.begin(); it != retries.end();){
+		if(isCancelled(it->second.request)){
+			it = retries.erase(it);
+		}else{
+			++it;
+		}
 	}
+	for(auto it = running.begin(); it != running.end();){
+		auto & transfer = **it;
+		if(isCancelled(transfer.response.request)){
+			release(transfer);
+			it = running.erase(it);
+		}else{
+			++it;
+		}
+	}
+}
 
-	curl_easy_setopt(curl.get(), CURLOPT_HTTPHEADER, headers);
-
-    std::string body = request.body;
+void ofURLFileLoaderImpl::startTransfers(){
+	while(running.size() < maxConcurrentRequests && !waiting.empty()){
+		auto next = waiting.begin();
+		std::unique_ptr<ofURLTransfer> transfer(new ofURLTransfer);
+		transfer->response = ofHttpResponse(next->second.request, 0, "");
+		transfer->attempts = next->second.attempts;
+		waiting.erase(next);
 
-	// set body if there's any
-	if(request.body!=""){
-		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 1L);
-		curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, request.body.size());
-        //curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, request.body.c_str());
-        curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, readBody_cb);
-        curl_easy_setopt(curl.get(), CURLOPT_READDATA, &body);
-	}else{
-		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 0L);
-		curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, 0);
-        //curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, nullptr);
-        curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, nullptr);
-        curl_easy_setopt(curl.get(), CURLOPT_READDATA, nullptr);
+		if(idleHandles.empty()){
+			transfer->curl = curl_easy_init();
+		}else{
+			transfer->curl = idleHandles.back();
+			idleHandles.pop_back();
+		}
+		if(!setup(*transfer)){
+			// failed before doing any network work, retrying won't help
+			release(*transfer);
+			deliver(std::move(transfer->response));
+			continue;
+		}
+		// wait for a connection that can be multiplexed instead of opening
+		// a new one when the server might support HTTP/2
+		curl_easy_setopt(transfer->curl, CURLOPT_PIPEWAIT, 1L);
+		curl_multi_add_handle(multi.get(), transfer->curl);
+		running.push_back(std::move(transfer));
 	}
-	if(request.method == ofHttpRequest::GET){
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 1);
-	}else{
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 1);
+}
+
+void ofURLFileLoaderImpl::finishTransfers(){
+	CURLMsg * message;
+	int numMessages;
+	while((message = curl_multi_info_read(multi.get(), &numMessages))){
+		if(message->msg != CURLMSG_DONE){
+			continue;
+		}
+		auto code = message->data.result;
+		auto it = std::find_if(running.begin(), running.end(), [&](const std::unique_ptr<ofURLTransfer> & transfer){
+			return transfer->curl == message->easy_handle;
+		});
+		if(it == running.end()){
+			continue;
+		}
+		std::unique_ptr<ofURLTransfer> transfer = std::move(*it);
+		running.erase(it);
+		if(transfer->aborted){
+			cancelled(*transfer);
+		}else{
+			finish(*transfer, code);
+		}
+		release(*transfer);
+		// network errors are retried unless the body was already partly
+		// passed to the received callback
+		if(code != CURLE_OK && !transfer->aborted && transfer->attempts < maxRetries && !transfer->started){
+			retryLater(*transfer);
+			continue;
+		}
+		deliver(std::move(transfer->response));
 	}
+}
 
-    if(request.timeoutSeconds>0){
-        curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, request.timeoutSeconds);
-    }
-
-	// start request and receive response
-	ofHttpResponse response(request, 0, "");
-	auto err = 0;
-	if(request.saveTo){
-		ofFile saveTo(request.name, ofFile::WriteOnly, true);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &saveTo);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToFile_cb);
-		err = curl_easy_perform(curl.get());
-	}else{
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &response);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToMemory_cb);
-		err = curl_easy_perform(curl.get());
+void ofURLFileLoaderImpl::deliver(ofHttpResponse && response){
+	if(!responses->send(std::move(response))){
+		return;
 	}
-	if(err==0){
-		long http_code = 0;
-		curl_easy_getinfo (curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
-		response.status = http_code;
-	}else{
-		response.status = -1;
+	// the main job queue spreads the notifications across
+	// frames instead of delivering every response at once
+	ofRunOnMainThread(std::bind(&ofURLFileLoaderImpl::notifyResponse, std::weak_ptr<ofThreadChannel<ofHttpResponse>>(responses)));
+}
+
+void ofURLFileLoaderImpl::release(ofURLTransfer & transfer){
+	curl_multi_remove_handle(multi.get(), transfer.curl);
+	curl_easy_reset(transfer.curl);
+	idleHandles.push_back(transfer.curl);
+	transfer.curl = nullptr;
+	if(transfer.headers){
+		curl_slist_free_all(transfer.headers);
+		transfer.headers = nullptr;
 	}
+	transfer.file.close();
+}
 
-	if(headers){
-		curl_slist_free_all(headers);
+ofHttpResponse ofURLFileLoaderImpl::perform(const ofHttpRequest & request){
+	ofURLTransfer transfer;
+	transfer.response = ofHttpResponse(request, 0, "");
+	{
+		std::unique_lock<std::mutex> lock(blockingHandlesMutex);
+		if(!blockingHandles.empty()){
+			transfer.curl = blockingHandles.back();
+			blockingHandles.pop_back();
+		}
+	}
+	if(!transfer.curl){
+		transfer.curl = curl_easy_init();
+	}
+	if(setup(transfer)){
+		auto code = curl_easy_perform(transfer.curl);
+		if(transfer.aborted){
+			cancelled(transfer);
+		}else{
+			finish(transfer, code);
+		}
 	}
+	if(transfer.headers){
+		curl_slist_free_all(transfer.headers);
+	}
+	transfer.file.close();
+	curl_easy_reset(transfer.curl);
+	{
+		std::unique_lock<std::mutex> lock(blockingHandlesMutex);
+		blockingHandles.push_back(transfer.curl);
+	}
+	return transfer.response;
+}
 
-	return response;
+ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
+	// blocking requests run right away on the calling thread instead of
+	// waiting behind the queued ones
+	return perform(request);
 }
 
 
 int ofURLFileLoaderImpl::handleRequestAsync(const ofHttpRequest& request){
-	requests.send(request);
+	ofURLCommand command;
+	command.request = request;
+	commands.send(std::move(command));
 	start();
+	wakeup();
 	return request.getId();
 }
 
-void ofURLFileLoaderImpl::update(ofEventArgs & args){
+void ofURLFileLoaderImpl::notifyResponse(std::weak_ptr<ofThreadChannel<ofHttpResponse>> responses){
+	auto channel = responses.lock();
 	ofHttpResponse response;
-	while(responses.tryReceive(response)){
+	if(channel && channel->tryReceive(response)){
 		try{
 			response.request.done(response);
 		}catch(...){
@@ -307,6 +614,14 @@ int ofURLFileLoader::handleRequestAsync(const ofHttpRequest& request){
 	return impl->handleRequestAsync(request);
 }
 
+void ofURLFileLoader::setMaxConcurrentRequests(std::size_t max){
+	impl->setMaxConcurrentRequests(max);
+}
+
+void ofURLFileLoader::setMaxConnectionsPerHost(std::size_t max){
+	impl->setMaxConnectionsPerHost(max);
+}
+
 static bool initialized = false;
 static ofURLFileLoader & getFileLoader(){
 	static ofURLFileLoader * fileLoader = new ofURLFileLoader;
@@ -382,6 +697,10 @@ int ofSaveURLAsync(const string& url, const std::filesystem::path& path){
 	return getFileLoader().saveAsync(url,path);
 }
 
+int ofLoadURLAsync(const ofHttpRequest & request){
+	return getFileLoader().handleRequestAsync(request);
+}
+
 void ofRemoveURLRequest(int id){
 	getFileLoader().remove(id);
 }
@@ -394,6 +713,14 @@ void ofStopURLLoader(){
 	getFileLoader().stop();
 }
 
+void ofSetURLLoaderMaxConcurrentRequests(std::size_t max){
+	getFileLoader().setMaxConcurrentRequests(max);
+}
+
+void ofSetURLLoaderMaxConnectionsPerHost(std::size_t max){
+	getFileLoader().setMaxConnectionsPerHost(max);
+}
+
 void ofURLFileLoaderShutdown(){
 	if(initialized){
 		ofRemoveAllURLRequests();
@@ -2,6 +2,7 @@
 #include "ofEvents.h"
 #include "ofFileUtils.h"
 #include "ofTypes.h"
+#include <atomic>
 class ofHttpResponse;
 
 /// \class ofHttpRequest
@@ -19,6 +20,16 @@ public:
 	std::string				contentType; //< POST data mime type
 	std::function<void(const ofHttpResponse&)> done;
     size_t              timeoutSeconds = 0;
+	/// requests with a higher priority start first when more requests are
+	/// waiting than the loader runs at the same time
+	int					priority = 0;
+	/// if set it's called with each part of the response body as it
+	/// arrives, from the loader thread or from the caller's thread for
+	/// blocking requests, instead of storing the body in the response or
+	/// the file, so big downloads aren't kept in memory. Returning false
+	/// cancels the request, which then finishes with status -1 and the
+	/// error "cancelled" for both blocking and asynchronous requests.
+	std::function<bool(const char * data, std::size_t size)> received;
 
 	/// \return the unique id for this request
 	int getId() const;
@@ -32,7 +43,7 @@ public:
 
 private:
 	int					id; //< unique id for this request
-	static int			nextID; //< global for computing next unique id
+	static std::atomic<int>	nextID; //< global for computing next unique id
 };
 
 /// \class ofHttpResponse
@@ -81,7 +92,20 @@ ofHttpResponse ofSaveURLTo(const std::string& url, const std::filesystem::path&
 /// \returns unique id for the active HTTP request
 int ofSaveURLAsync(const std::string& url, const std::filesystem::path& path);
 
-/// \brief remove an active HTTP request from the queue
+/// \brief make an asynchronous HTTP request
+/// will not block, placed in a queue and run using a background thread
+/// \param request the request to make, see ofHttpRequest::priority and
+/// ofHttpRequest::received
+///
+/// Requests that fail with a network error are retried up to 3 times,
+/// waiting longer before each attempt, and only the last response is
+/// notified. Requests that fail before connecting, like when the file to
+/// save to can't be opened, aren't retried.
+/// \returns unique id for the active HTTP request
+int ofLoadURLAsync(const ofHttpRequest & request);
+
+/// \brief remove an active HTTP request from the queue, or cancel it if it
+/// already started
 /// \param unique HTTP request id
 void ofRemoveURLRequest(int id);
 
@@ -91,6 +115,14 @@ void ofRemoveAllURLRequests();
 /// \brief stop & remove all active and waiting HTTP requests
 void ofStopURLLoader();
 
+/// \brief set how many asynchronous HTTP requests run at the same time,
+/// 16 by default
+void ofSetURLLoaderMaxConcurrentRequests(std::size_t max);
+
+/// \brief set how many connections can be open to the same host, 6 by
+/// default
+void ofSetURLLoaderMaxConnectionsPerHost(std::size_t max);
+
 ofEvent<ofHttpResponse> & ofURLResponseEvent();
 
 template<class T>
@@ -139,7 +171,8 @@ class ofURLFileLoader  {
 		/// \returns unique id for the active HTTP request
         int saveAsync(const std::string& url, const std::filesystem::path& path);
 	
-		/// \brief remove an active HTTP request from the queue
+		/// \brief remove an active HTTP request from the queue, or cancel it
+		/// if it already started
 		/// \param unique HTTP request id
 		void remove(int id);
 	
@@ -148,6 +181,20 @@ class ofURLFileLoader  {
 	
 		/// \brief stop & remove all active and waiting HTTP requests
 		void stop();
+
+		/// \brief set how many requests run at the same time, 16 by default
+		///
+		/// The rest wait in the queue ordered by ofHttpRequest::priority.
+		void setMaxConcurrentRequests(std::size_t max);
+
+		/// \brief set how many connections can be open to the same host,
+		/// 6 by default
+		///
+		/// Connections are kept open and reused by later requests to the same
+		/// host. Requests to HTTP/2 servers are multiplexed over a single
+		/// connection so they don't count towards this limit. Lowering it
+		/// doesn't close connections that are already open.
+		void setMaxConnectionsPerHost(std::size_t max);
 	
 		// \brief low level HTTP request implementation
 		/// blocks until a response is returned or the request times out
@@ -6,6 +6,7 @@
 #include <chrono>
 #include <numeric>
 #include <locale>
+#include <limits>
 #include "uriparser/Uri.h"
 
 #ifdef TARGET_WIN32	 // For ofLaunchBrowser.
@@ -624,9 +625,136 @@ string ofToHex(const char* value) {
 	return ofToHex((string) value);
 }
 
+namespace{
+	inline bool isDigit(char c){
+		return c >= '0' && c <= '9';
+	}
+
+	// whitespace and sign the same way a stream does before a number
+	inline const char * skipSpaceAndSign(const char * it, const char * end, bool & negative){
+		while(it != end && (*it == ' ' || (*it >= '\t' && *it <= '\r'))){
+			++it;
+		}
+		negative = it != end && *it == '-';
+		if(it != end && (*it == '-' || *it == '+')){
+			++it;
+		}
+		return it;
+	}
+
+	// parses like operator>> including clamping to the limits of Int on
+	// overflow, but without copying into a stream
+	template<typename Int>
+	Int parseInt(const ofStringView & str){
+		bool negative;
+		auto it = skipSpaceAndSign(str.begin(), str.end(), negative);
+		uint64_t limit = negative ? uint64_t(std::numeric_limits<Int>::max()) + 1 : uint64_t(std::numeric_limits<Int>::max());
+		uint64_t value = 0;
+		bool overflow = false;
+		for(; it != str.end() && isDigit(*it); ++it){
+			unsigned digit = *it - '0';
+			if(value > (limit - digit) / 10){
+				overflow = true;
+			}else{
+				value = value * 10 + digit;
+			}
+		}
+		if(overflow){
+			return negative ? std::numeric_limits<Int>::min() : std::numeric_limits<Int>::max();
+		}
+		if(negative && value != 0){
+			return -Int(value - 1) - 1;
+		}
+		return Int(value);
+	}
+
+	// decimals with a mantissa that fits in a double and a power of 10
+	// that is exact as a double are the product or quotient of two exact
+	// numbers, so a single operation gives the correctly rounded result.
+	// anything else goes through a stream to get the same result as the
+	// std::string functions. returns false if the number needs the stream.
+	bool parseDoubleFast(const ofStringView & str, double & result){
+		static const double powersOf10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		bool negative;
+		auto it = skipSpaceAndSign(str.begin(), str.end(), negative);
+		uint64_t mantissa = 0;
+		int digits = 0;
+		int exponent = 0;
+		bool anyDigits = false;
+		for(; it != str.end() && isDigit(*it); ++it){
+			anyDigits = true;
+			if(mantissa != 0 || *it != '0'){
+				if(++digits > 19){
+					return false;
+				}
+				mantissa = mantissa * 10 + (*it - '0');
+			}
+		}
+		if(it != str.end() && *it == '.'){
+			for(++it; it != str.end() && isDigit(*it); ++it){
+				anyDigits = true;
+				if(mantissa != 0 || *it != '0'){
+					if(++digits > 19){
+						return false;
+					}
+					mantissa = mantissa * 10 + (*it - '0');
+				}
+				exponent--;
+			}
+		}
+		if(!anyDigits){
+			result = 0;
+			return true;
+		}
+		if(it != str.end() && (*it == 'e' || *it == 'E')){
+			auto expIt = it + 1;
+			bool negativeExponent = expIt != str.end() && *expIt == '-';
+			if(expIt != str.end() && (*expIt == '-' || *expIt == '+')){
+				++expIt;
+			}
+			// an exponent without digits, leave it to the stream
+			if(expIt == str.end() || !isDigit(*expIt)){
+				return false;
+			}
+			int exp = 0;
+			for(; expIt != str.end() && isDigit(*expIt); ++expIt){
+				if(exp < 10000){
+					exp = exp * 10 + (*expIt - '0');
+				}
+			}
+			exponent += negativeExponent ? -exp : exp;
+		}
+		if(mantissa == 0){
+			result = negative ? -0.0 : 0.0;
+			return true;
+		}
+		if(mantissa > (uint64_t(1) << 53) || exponent > 22 || exponent < -22){
+			return false;
+		}
+		result = exponent < 0 ? double(mantissa) / powersOf10[-exponent] : double(mantissa) * powersOf10[exponent];
+		if(negative){
+			result = -result;
+		}
+		return true;
+	}
+}
+
 //----------------------------------------
 int ofToInt(const string& intString) {
-	return ofTo<int>(intString);
+	return parseInt<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(const ofStringView& intString) {
+	return parseInt<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(const char* intString) {
+	return parseInt<int>(intString);
 }
 
 //----------------------------------------
@@ -680,17 +808,61 @@ string ofHexToString(const string& stringHexString) {
 
 //----------------------------------------
 float ofToFloat(const string& floatString) {
-	return ofTo<float>(floatString);
+	return ofToFloat(ofStringView(floatString));
+}
+
+//----------------------------------------
+float ofToFloat(const ofStringView& floatString) {
+	double value;
+	if(parseDoubleFast(floatString, value)){
+		// rounding to double and then to float only differs from rounding
+		// straight to float when the double falls exactly between 2 floats
+		float rounded = float(value);
+		double error = value - double(rounded);
+		if(error == 0 || std::fabs(error) != std::fabs(double(std::nextafter(rounded, error > 0 ? FLT_MAX : -FLT_MAX)) - value)){
+			return rounded;
+		}
+	}
+	return ofTo<float>(std::string(floatString));
+}
+
+//----------------------------------------
+float ofToFloat(const char* floatString) {
+	return ofToFloat(ofStringView(floatString));
 }
 
 //----------------------------------------
 double ofToDouble(const string& doubleString) {
-	return ofTo<double>(doubleString);
+	return ofToDouble(ofStringView(doubleString));
+}
+
+//----------------------------------------
+double ofToDouble(const ofStringView& doubleString) {
+	double value;
+	if(parseDoubleFast(doubleString, value)){
+		return value;
+	}
+	return ofTo<double>(std::string(doubleString));
+}
+
+//----------------------------------------
+double ofToDouble(const char* doubleString) {
+	return ofToDouble(ofStringView(doubleString));
 }
 
 //----------------------------------------
 int64_t ofToInt64(const string& intString) {
-	return ofTo<int64_t>(intString);
+	return parseInt<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(const ofStringView& intString) {
+	return parseInt<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(const char* intString) {
+	return parseInt<int64_t>(intString);
 }
 
 //----------------------------------------
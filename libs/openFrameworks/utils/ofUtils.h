@@ -6,6 +6,8 @@
 #include <chrono>
 
 #include "ofLog.h"
+#include "ofRandomEngine.h"
+#include "ofStringView.h"
 
 
 /// \section Elapsed Time
@@ -256,10 +258,10 @@ void ofSetDataPathRoot(const std::filesystem::path& root);
 /// \brief Randomly reorder the values in a vector.
 /// \tparam T the type contained by the vector.
 /// \param values The vector of values to modify.
-/// \sa http://www.cplusplus.com/reference/algorithm/random_shuffle/
+/// \sa http://en.cppreference.com/w/cpp/algorithm/random_shuffle
 template<class T>
 void ofRandomize(std::vector<T>& values) {
-	random_shuffle(values.begin(), values.end());
+	std::shuffle(values.begin(), values.end(), ofGetRandomEngine());
 }
 
 /// \brief Conditionally remove values from a vector.
@@ -641,6 +643,17 @@ template<typename T> T ofTo(const std::string & str){
 /// \returns the integer represented by the string or 0 on failure.
 int ofToInt(const std::string& intString);
 
+/// \brief Convert a string view to an integer without copying it.
+///
+/// Same result as the std::string version but parses the characters
+/// directly, which is much faster when parsing lots of numbers from the
+/// views returned by ofBuffer::lines() or ofSplitStringView.
+///
+/// \param intString The string representation of the integer.
+/// \returns the integer represented by the string or 0 on failure.
+int ofToInt(const ofStringView& intString);
+int ofToInt(const char* intString);
+
 /// \brief Convert a string to a int64_t.
 ///
 /// Converts a `std::string` representation of a long integer
@@ -649,6 +662,8 @@ int ofToInt(const std::string& intString);
 /// \param intString The string representation of the long integer.
 /// \returns the long integer represented by the string or 0 on failure.
 int64_t ofToInt64(const std::string& intString);
+int64_t ofToInt64(const ofStringView& intString);
+int64_t ofToInt64(const char* intString);
 
 /// \brief Convert a string to a float.
 ///
@@ -659,6 +674,18 @@ int64_t ofToInt64(const std::string& intString);
 /// \returns the float represented by the string or 0 on failure.
 float ofToFloat(const std::string& floatString);
 
+/// \brief Convert a string view to a float without copying it.
+///
+/// Same result as the std::string version. Numbers whose digits, without
+/// the decimal point, form an integer up to 2^53 (at least 15 significant
+/// digits, 16 for most numbers) and whose power of 10 is up to +-22 are
+/// converted directly, others use a stream like the std::string version.
+///
+/// \param floatString string representation of the float.
+/// \returns the float represented by the string or 0 on failure.
+float ofToFloat(const ofStringView& floatString);
+float ofToFloat(const char* floatString);
+
 /// \brief Convert a string to a double.
 ///
 /// Converts a std::string representation of a double (e.g., `"3.14"`) to an
@@ -667,6 +694,8 @@ float ofToFloat(const std::string& floatString);
 /// \param doubleString The string representation of the double.
 /// \returns the double represented by the string or 0 on failure.
 double ofToDouble(const std::string& doubleString);
+double ofToDouble(const ofStringView& doubleString);
+double ofToDouble(const char* doubleString);
 
 /// \brief Convert a string to a boolean.
 ///
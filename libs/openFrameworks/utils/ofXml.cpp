@@ -1,8 +1,47 @@
 #include "ofXml.h"
 #include "ofUtils.h"
 
+#include <mutex>
+
 using namespace std;
 
+namespace{
+	// compiled XPath expressions used by find and findFirst, compiling is
+	// usually much slower than evaluating them
+	class QueryCache{
+	public:
+		std::shared_ptr<const pugi::xpath_query> get(const std::string & path){
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				auto it = queries.find(path);
+				if(it != queries.end()){
+					return it->second;
+				}
+			}
+			// throws pugi::xpath_exception if path isn't valid
+			std::shared_ptr<const pugi::xpath_query> query = std::make_shared<pugi::xpath_query>(path.c_str());
+			std::unique_lock<std::mutex> lock(mutex);
+			// paths built at runtime, ie. with an index, could make it grow
+			// forever
+			if(queries.size() >= maxQueries){
+				queries.clear();
+			}
+			queries[path] = query;
+			return query;
+		}
+
+	private:
+		static const std::size_t maxQueries = 1024;
+		std::mutex mutex;
+		std::unordered_map<std::string, std::shared_ptr<const pugi::xpath_query>> queries;
+	};
+
+	QueryCache & getQueryCache(){
+		static QueryCache * cache = new QueryCache;
+		return *cache;
+	}
+}
+
 ofXml::ofXml()
 :doc(new pugi::xml_document){
 	xml = doc->root();
@@ -26,7 +65,14 @@ bool ofXml::load(const std::filesystem::path & file){
 }
 
 bool ofXml::load(const ofBuffer & buffer){
-	return parse(buffer.getText());
+	auto auxDoc = std::make_shared<pugi::xml_document>();
+	if(auxDoc->load_buffer(buffer.getData(), buffer.size())){
+		doc = auxDoc;
+		xml = doc->root();
+		return true;
+	}else{
+		return false;
+	}
 }
 
 bool ofXml::parse(const std::string & xmlStr){
@@ -164,7 +210,7 @@ ofXml::Attribute ofXml::prependAttribute(const std::string & name){
 
 ofXml ofXml::findFirst(const std::string & path) const{
 	try{
-		return ofXml(doc, this->xml.select_single_node(path.c_str()).node());
+		return ofXml(doc, this->xml.select_single_node(*getQueryCache().get(path)).node());
 	}catch(pugi::xpath_exception & e){
 		return ofXml();
 	}
@@ -172,7 +218,30 @@ ofXml ofXml::findFirst(const std::string & path) const{
 
 ofXml::Search ofXml::find(const std::string & path) const{
 	try{
-		return ofXml::Search(doc, this->xml.select_nodes(path.c_str()));
+		return ofXml::Search(doc, this->xml.select_nodes(*getQueryCache().get(path)));
+	}catch(pugi::xpath_exception & e){
+		ofLogError() << e.what();
+		return ofXml::Search();
+	}
+}
+
+ofXml ofXml::findFirst(const Query & query) const{
+	if(!query){
+		return ofXml();
+	}
+	try{
+		return ofXml(doc, this->xml.select_single_node(*query.query).node());
+	}catch(pugi::xpath_exception & e){
+		return ofXml();
+	}
+}
+
+ofXml::Search ofXml::find(const Query & query) const{
+	if(!query){
+		return ofXml::Search();
+	}
+	try{
+		return ofXml::Search(doc, this->xml.select_nodes(*query.query));
 	}catch(pugi::xpath_exception & e){
 		ofLogError() << e.what();
 		return ofXml::Search();
@@ -220,6 +289,33 @@ ofXml::operator bool() const{
 
 
 
+//--------------------------------------------------------
+// Query
+
+ofXml::Query::Query(const std::string & path)
+:path(path){
+	try{
+		auto compiled = getQueryCache().get(path);
+		if(compiled->return_type() == pugi::xpath_type_node_set){
+			query = compiled;
+		}else{
+			ofLogError("ofXml") << "invalid query " << path << ": doesn't return nodes";
+		}
+	}catch(pugi::xpath_exception & e){
+		ofLogError("ofXml") << "invalid query " << path << ": " << e.what();
+	}
+}
+
+const std::string & ofXml::Query::getPath() const{
+	return path;
+}
+
+ofXml::Query::operator bool() const{
+	return query != nullptr;
+}
+
+
+
 //--------------------------------------------------------
 // Attribute
 
@@ -383,13 +479,15 @@ void ofSerialize(ofXml & xml, const ofAbstractParameter & parameter){
 	if(name == ""){
 		name = "UnknownName";
 	}
-	ofXml child	= xml.findFirst(name);
+	// a child with that name, faster than findFirst which would evaluate
+	// name as an XPath expression
+	ofXml child	= xml.getChild(name);
 	
 	if(!child){
 		child = xml.appendChild(name);
 		ofLogVerbose("ofXml") << "creating group " << name;
 	}
-	if(parameter.type() == typeid(ofParameterGroup).name()){
+	if(typeid(parameter) == typeid(ofParameterGroup)){
 		const ofParameterGroup & group = static_cast <const ofParameterGroup &>(parameter);
 		
 		ofLogVerbose("ofXml") << "group " << name;
@@ -410,21 +508,23 @@ void ofDeserialize(const ofXml & xml, ofAbstractParameter & parameter){
 	}
 	string name = parameter.getEscapedName();
 	
-	ofXml child = xml.findFirst(name);
+	ofXml child = xml.getChild(name);
 	if(child){
-		if(parameter.type() == typeid(ofParameterGroup).name()){
+		// compare the type_info directly, type() returns a new string
+		const std::type_info & type = typeid(parameter);
+		if(type == typeid(ofParameterGroup)){
 			ofParameterGroup & group = static_cast <ofParameterGroup &>(parameter);
 			for(auto & p: group){
 				ofDeserialize(child, *p);
 			}
 		}else{
-			if(parameter.type() == typeid(ofParameter <int> ).name()){
+			if(type == typeid(ofParameter <int> )){
 				parameter.cast <int>() = child.getIntValue();
-			}else if(parameter.type() == typeid(ofParameter <float> ).name()){
+			}else if(type == typeid(ofParameter <float> )){
 				parameter.cast <float>() = child.getFloatValue();
-			}else if(parameter.type() == typeid(ofParameter <bool> ).name()){
+			}else if(type == typeid(ofParameter <bool> )){
 				parameter.cast <bool>() = child.getBoolValue();
-			}else if(parameter.type() == typeid(ofParameter <string> ).name()){
+			}else if(type == typeid(ofParameter <string> )){
 				parameter.cast <string>() = child.getValue();
 			}else{
 				parameter.fromString(child.getValue());
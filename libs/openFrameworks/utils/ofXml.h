@@ -44,6 +44,39 @@ public:
 		friend class ofXml;
 	};
 
+	/// \brief A compiled XPath expression.
+	///
+	/// find and findFirst compile each path the first time it's used and
+	/// keep it in a cache shared by every ofXml. A Query skips even looking
+	/// it up in the cache, for expressions evaluated in a loop:
+	///
+	/// ~~~~{.cpp}
+	/// ofXml::Query position("position");
+	/// for(auto & particle: xml.find("//particle")){
+	/// 	auto p = particle.findFirst(position);
+	/// 	...
+	/// }
+	/// ~~~~
+	///
+	/// Queries can be evaluated from several threads at the same time.
+	class Query{
+	public:
+		Query(){}
+
+		/// Logs an error and creates an invalid query if path isn't a valid
+		/// XPath expression or doesn't return nodes, like count(//a).
+		Query(const std::string & path);
+
+		const std::string & getPath() const;
+
+		/// \returns true if the expression compiled correctly.
+		operator bool() const;
+	private:
+		std::string path;
+		std::shared_ptr<const pugi::xpath_query> query;
+		friend class ofXml;
+	};
+
 	class Attribute{
 	public:
 		Attribute(){}
@@ -147,6 +180,8 @@ public:
 
 	ofXml findFirst(const std::string & path) const;
 	Search find(const std::string & path) const;
+	ofXml findFirst(const Query & query) const;
+	Search find(const Query & query) const;
 
 	template<typename T>
 	T getValue() const{
@@ -202,6 +237,7 @@ private:
 	template<class It>
 	friend class ofXmlIterator;
 	friend class ofXmlSearchIterator;
+	friend class ofXmlReader;
 };
 
 template<class It>
@@ -0,0 +1,496 @@
+#include "ofXmlReader.h"
+#include "ofUtils.h"
+
+namespace{
+	const std::size_t chunkSize = 1 << 16;
+
+	bool isSpace(char c){
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	ofStringView trim(ofStringView str){
+		while(!str.empty() && isSpace(str.front())){
+			str.remove_prefix(1);
+		}
+		while(!str.empty() && isSpace(str.back())){
+			str.remove_suffix(1);
+		}
+		return str;
+	}
+
+	// Replaces entities and normalizes line endings like pugixml does when
+	// loading a document, attribute values also get their whitespace
+	// converted to spaces
+	void decode(ofStringView raw, std::string & decoded, bool attribute){
+		decoded.clear();
+		auto special = [&](char c){
+			return c == '&' || c == '\r' || (attribute && (c == '\n' || c == '\t'));
+		};
+		if(std::find_if(raw.begin(), raw.end(), special) == raw.end()){
+			decoded.assign(raw.data(), raw.size());
+			return;
+		}
+
+		decoded.reserve(raw.size());
+		for(std::size_t i = 0; i < raw.size(); i++){
+			char c = raw[i];
+			if(c == '\r'){
+				if(i + 1 < raw.size() && raw[i + 1] == '\n'){
+					continue;
+				}
+				c = '\n';
+			}
+			if(attribute && (c == '\n' || c == '\t')){
+				c = ' ';
+			}
+			if(c != '&'){
+				decoded += c;
+				continue;
+			}
+
+			auto end = raw.find(';', i);
+			if(end == ofStringView::npos){
+				decoded += c;
+				continue;
+			}
+			auto entity = raw.substr(i + 1, end - i - 1);
+			if(entity == "lt"){
+				decoded += '<';
+			}else if(entity == "gt"){
+				decoded += '>';
+			}else if(entity == "amp"){
+				decoded += '&';
+			}else if(entity == "quot"){
+				decoded += '"';
+			}else if(entity == "apos"){
+				decoded += '\'';
+			}else if(entity.size() > 1 && entity[0] == '#'){
+				bool hex = entity[1] == 'x';
+				auto digits = entity.substr(hex ? 2 : 1);
+				uint32_t code = 0;
+				bool valid = !digits.empty();
+				for(auto d: digits){
+					uint32_t value;
+					if(d >= '0' && d <= '9'){
+						value = d - '0';
+					}else if(hex && d >= 'a' && d <= 'f'){
+						value = d - 'a' + 10;
+					}else if(hex && d >= 'A' && d <= 'F'){
+						value = d - 'A' + 10;
+					}else{
+						valid = false;
+						break;
+					}
+					code = code * (hex ? 16 : 10) + value;
+					if(code > 0x10FFFF){
+						valid = false;
+						break;
+					}
+				}
+				if(valid && code > 0){
+					ofUTF8Append(decoded, code);
+				}else{
+					decoded.append(raw.data() + i, end - i + 1);
+				}
+			}else{
+				// entities declared in a DOCTYPE aren't supported, keep them
+				// as they are
+				decoded.append(raw.data() + i, end - i + 1);
+			}
+			i = end;
+		}
+	}
+}
+
+ofXmlReader::ofXmlReader()
+:position(0)
+,eof(true)
+,numAttributes(0)
+,depth(0)
+,emptyElement(false)
+,keepWhitespace(false)
+,current(End)
+,line(1){}
+
+void ofXmlReader::reset(){
+	input.reset();
+	buffer.clear();
+	position = 0;
+	eof = true;
+	name.clear();
+	text.clear();
+	numAttributes = 0;
+	depth = 0;
+	emptyElement = false;
+	current = End;
+	line = 1;
+	error.clear();
+}
+
+bool ofXmlReader::open(const std::filesystem::path & path){
+	reset();
+	std::unique_ptr<std::ifstream> file(new std::ifstream(ofToDataPath(path).c_str(), std::ios::binary));
+	if(!file->is_open()){
+		fail("couldn't open " + path.string());
+		ofLogError("ofXmlReader") << error;
+		return false;
+	}
+	input = std::move(file);
+	eof = false;
+	return true;
+}
+
+void ofXmlReader::parse(const std::string & xml){
+	reset();
+	buffer = xml;
+}
+
+bool ofXmlReader::fill(){
+	if(eof){
+		return false;
+	}
+	// only what hasn't been read yet is kept
+	buffer.erase(0, position);
+	position = 0;
+	auto size = buffer.size();
+	buffer.resize(size + chunkSize);
+	input->read(&buffer[size], chunkSize);
+	auto read = std::size_t(input->gcount());
+	buffer.resize(size + read);
+	if(read < chunkSize){
+		eof = true;
+	}
+	return read > 0;
+}
+
+bool ofXmlReader::available(std::size_t size){
+	while(buffer.size() - position < size){
+		if(!fill()){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ofXmlReader::find(ofStringView delimiter, std::size_t & offset){
+	// offset is relative to position so it stays valid when filling moves
+	// the buffer
+	std::size_t from = offset;
+	while(true){
+		auto found = buffer.find(delimiter.data(), position + from, delimiter.size());
+		if(found != std::string::npos){
+			offset = found - position;
+			return true;
+		}
+		auto searched = buffer.size() - position;
+		from = std::max(from, searched >= delimiter.size() ? searched - delimiter.size() + 1 : 0);
+		if(!fill()){
+			return false;
+		}
+	}
+}
+
+bool ofXmlReader::startsWith(ofStringView prefix){
+	return available(prefix.size()) && buffer.compare(position, prefix.size(), prefix.data(), prefix.size()) == 0;
+}
+
+void ofXmlReader::consume(std::size_t size){
+	line += std::count(buffer.begin() + position, buffer.begin() + position + size, '\n');
+	position += size;
+}
+
+ofXmlReader::Event ofXmlReader::fail(const std::string & error){
+	this->error = error + " at line " + ofToString(line);
+	return current = Error;
+}
+
+ofXmlReader::Event ofXmlReader::next(){
+	if(current == Error){
+		return Error;
+	}
+	if(emptyElement){
+		emptyElement = false;
+		depth--;
+		return current = EndElement;
+	}
+
+	while(true){
+		if(!available(1)){
+			if(depth > 0){
+				return fail("unexpected end of document, <" + openElements[depth - 1] + "> isn't closed");
+			}
+			return current = End;
+		}
+
+		if(buffer[position] == '<'){
+			if(startsWith("<!--")){
+				std::size_t end = 4;
+				if(!find("-->", end)){
+					return fail("comment isn't closed");
+				}
+				consume(end + 3);
+				continue;
+			}
+			if(startsWith("<![CDATA[")){
+				std::size_t end = 9;
+				if(!find("]]>", end)){
+					return fail("CDATA isn't closed");
+				}
+				if(depth == 0){
+					return fail("CDATA outside of the root element");
+				}
+				text.assign(buffer, position + 9, end - 9);
+				consume(end + 3);
+				return current = Text;
+			}
+			if(startsWith("<?")){
+				std::size_t end = 2;
+				if(!find("?>", end)){
+					return fail("processing instruction isn't closed");
+				}
+				consume(end + 2);
+				continue;
+			}
+			if(startsWith("<!")){
+				// DOCTYPE, which can have declarations between []
+				std::size_t end = 2;
+				int brackets = 0;
+				char quote = 0;
+				while(true){
+					if(!available(end + 1)){
+						return fail("DOCTYPE isn't closed");
+					}
+					char c = buffer[position + end];
+					if(quote){
+						if(c == quote){
+							quote = 0;
+						}
+					}else if(c == '"' || c == '\''){
+						quote = c;
+					}else if(c == '['){
+						brackets++;
+					}else if(c == ']'){
+						brackets--;
+					}else if(c == '>' && brackets == 0){
+						break;
+					}
+					end++;
+				}
+				consume(end + 1);
+				continue;
+			}
+			if(startsWith("</")){
+				return readEndTag();
+			}
+			return readStartTag();
+		}
+
+		std::size_t end = 0;
+		if(!find("<", end)){
+			end = buffer.size() - position;
+		}
+		ofStringView raw(buffer.data() + position, end);
+		bool whitespace = std::all_of(raw.begin(), raw.end(), isSpace);
+		if(!whitespace && depth == 0){
+			return fail("text outside of the root element");
+		}
+		if(depth > 0 && (!whitespace || keepWhitespace)){
+			decode(raw, text, false);
+			consume(end);
+			return current = Text;
+		}
+		consume(end);
+	}
+}
+
+ofXmlReader::Event ofXmlReader::readStartTag(){
+	// find the end of the tag, '>' can be inside attribute values
+	std::size_t end = 1;
+	char quote = 0;
+	while(true){
+		if(!available(end + 1)){
+			return fail("tag isn't closed");
+		}
+		char c = buffer[position + end];
+		if(quote){
+			if(c == quote){
+				quote = 0;
+			}
+		}else if(c == '"' || c == '\''){
+			quote = c;
+		}else if(c == '>'){
+			break;
+		}
+		end++;
+	}
+
+	ofStringView tag(buffer.data() + position + 1, end - 1);
+	emptyElement = !tag.empty() && tag.back() == '/';
+	if(emptyElement){
+		tag.remove_suffix(1);
+	}
+
+	auto nameEnd = std::find_if(tag.begin(), tag.end(), isSpace);
+	if(nameEnd == tag.begin()){
+		return fail("element without name");
+	}
+	name.assign(tag.begin(), nameEnd);
+	tag.remove_prefix(nameEnd - tag.begin());
+
+	numAttributes = 0;
+	while(true){
+		tag = trim(tag);
+		if(tag.empty()){
+			break;
+		}
+		auto equals = tag.find('=');
+		if(equals == ofStringView::npos){
+			return fail("attribute without value in <" + name + ">");
+		}
+		auto attributeName = trim(tag.substr(0, equals));
+		tag = trim(tag.substr(equals + 1));
+		if(attributeName.empty() || tag.empty() || (tag.front() != '"' && tag.front() != '\'')){
+			return fail("invalid attribute in <" + name + ">");
+		}
+		auto valueEnd = tag.find(tag.front(), 1);
+		if(valueEnd == ofStringView::npos){
+			return fail("invalid attribute in <" + name + ">");
+		}
+		if(numAttributes == attributes.size()){
+			attributes.emplace_back();
+		}
+		auto & attribute = attributes[numAttributes++];
+		attribute.first.assign(attributeName.data(), attributeName.size());
+		decode(tag.substr(1, valueEnd - 1), attribute.second, true);
+		tag.remove_prefix(valueEnd + 1);
+	}
+
+	if(depth == openElements.size()){
+		openElements.emplace_back();
+	}
+	openElements[depth++] = name;
+	consume(end + 1);
+	return current = StartElement;
+}
+
+ofXmlReader::Event ofXmlReader::readEndTag(){
+	std::size_t end = 2;
+	if(!find(">", end)){
+		return fail("tag isn't closed");
+	}
+	auto closed = trim(ofStringView(buffer.data() + position + 2, end - 2));
+	if(depth == 0){
+		return fail("unexpected </" + std::string(closed.data(), closed.size()) + ">");
+	}
+	if(closed != openElements[depth - 1]){
+		return fail("expected </" + openElements[depth - 1] + "> but found </" + std::string(closed.data(), closed.size()) + ">");
+	}
+	name = openElements[--depth];
+	numAttributes = 0;
+	consume(end + 1);
+	return current = EndElement;
+}
+
+ofXml ofXmlReader::readElement(){
+	if(current != StartElement){
+		ofLogError("ofXmlReader") << "readElement(): can only be called right after next() returns StartElement";
+		return ofXml();
+	}
+
+	auto doc = std::make_shared<pugi::xml_document>();
+	auto addElement = [&](pugi::xml_node parent){
+		auto node = parent.append_child(name.c_str());
+		for(std::size_t i = 0; i < numAttributes; i++){
+			node.append_attribute(attributes[i].first.c_str()).set_value(attributes[i].second.c_str());
+		}
+		return node;
+	};
+	auto element = addElement(*doc);
+	auto node = element;
+	auto startDepth = depth;
+	while(depth >= startDepth){
+		switch(next()){
+		case StartElement:
+			node = addElement(node);
+			break;
+		case EndElement:
+			node = node.parent();
+			break;
+		case Text:
+			node.append_child(pugi::node_pcdata).set_value(text.c_str());
+			break;
+		case End:
+		case Error:
+			return ofXml();
+		}
+	}
+	return ofXml(doc, element);
+}
+
+void ofXmlReader::skipElement(){
+	if(current != StartElement){
+		ofLogError("ofXmlReader") << "skipElement(): can only be called right after next() returns StartElement";
+		return;
+	}
+	auto startDepth = depth;
+	while(depth >= startDepth){
+		auto event = next();
+		if(event == End || event == Error){
+			return;
+		}
+	}
+}
+
+ofStringView ofXmlReader::getName() const{
+	return name;
+}
+
+ofStringView ofXmlReader::getText() const{
+	return text;
+}
+
+std::size_t ofXmlReader::getNumAttributes() const{
+	return numAttributes;
+}
+
+ofStringView ofXmlReader::getAttributeName(std::size_t i) const{
+	return attributes[i].first;
+}
+
+ofStringView ofXmlReader::getAttributeValue(std::size_t i) const{
+	return attributes[i].second;
+}
+
+ofStringView ofXmlReader::getAttribute(ofStringView name) const{
+	for(std::size_t i = 0; i < numAttributes; i++){
+		if(attributes[i].first == name){
+			return attributes[i].second;
+		}
+	}
+	return ofStringView();
+}
+
+bool ofXmlReader::hasAttribute(ofStringView name) const{
+	for(std::size_t i = 0; i < numAttributes; i++){
+		if(attributes[i].first == name){
+			return true;
+		}
+	}
+	return false;
+}
+
+std::size_t ofXmlReader::getDepth() const{
+	return current == StartElement ? depth - 1 : depth;
+}
+
+std::size_t ofXmlReader::getLine() const{
+	return line;
+}
+
+std::string ofXmlReader::getError() const{
+	return error;
+}
+
+void ofXmlReader::setKeepWhitespace(bool keep){
+	keepWhitespace = keep;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include "ofStringView.h"
+#include "ofXml.h"
+
+/// \file
+/// Reads xml files one element at a time, without loading them.
+///
+/// ~~~~{.cpp}
+/// ofXmlReader reader;
+/// reader.open("export.xml");
+/// while(reader.next() == ofXmlReader::StartElement){
+/// 	if(reader.getName() == "record"){
+/// 		// a whole record as an ofXml, it can be searched with find
+/// 		auto record = reader.readElement();
+/// 		...
+/// 	}
+/// }
+/// ~~~~
+///
+/// Only the current element and the names of its parents are kept in
+/// memory, so files of any size can be read in constant memory. Elements
+/// are checked to be closed in the right order, but DOCTYPEs are skipped so
+/// entities declared in them aren't expanded.
+
+/// \brief Streaming xml reader.
+class ofXmlReader{
+public:
+	enum Event{
+		/// An opening tag, getName and the attributes are available.
+		/// Empty elements like <a/> produce a StartElement and an EndElement.
+		StartElement,
+		/// A closing tag, getName is available.
+		EndElement,
+		/// Text or CDATA between tags, getText is available.
+		Text,
+		/// The end of the document.
+		End,
+		/// The document isn't valid xml, see getError.
+		Error,
+	};
+
+	ofXmlReader();
+
+	/// \brief Starts reading the file at path, relative to the data folder.
+	bool open(const std::filesystem::path & path);
+
+	/// \brief Starts reading xml from a string.
+	void parse(const std::string & xml);
+
+	/// \brief Reads the next element, text or the end of the document.
+	Event next();
+
+	/// \brief Reads the element that has just started and everything in it
+	/// into an ofXml, so it can be queried like a loaded document. After it
+	/// the reader is past the end of the element.
+	///
+	/// Can only be called right after next() returns StartElement.
+	ofXml readElement();
+
+	/// \brief Skips everything until the end of the element that has just
+	/// started.
+	void skipElement();
+
+	/// \returns the name of the element for StartElement and EndElement.
+	ofStringView getName() const;
+
+	/// \returns the text with entities like &amp; replaced.
+	ofStringView getText() const;
+
+	std::size_t getNumAttributes() const;
+	ofStringView getAttributeName(std::size_t i) const;
+	ofStringView getAttributeValue(std::size_t i) const;
+
+	/// \returns the value of the attribute or an empty view if the element
+	/// doesn't have it.
+	ofStringView getAttribute(ofStringView name) const;
+	bool hasAttribute(ofStringView name) const;
+
+	/// \returns the number of elements that contain the current one. 0 for
+	/// the root element.
+	std::size_t getDepth() const;
+
+	/// \returns the line of the document being read, starting at 1.
+	std::size_t getLine() const;
+
+	std::string getError() const;
+
+	/// \brief Whether to report text that is only whitespace, like the
+	/// indentation between elements. False by default, like ofXml::load.
+	void setKeepWhitespace(bool keep);
+
+private:
+	void reset();
+	bool fill();
+	bool find(ofStringView delimiter, std::size_t & offset);
+	bool available(std::size_t size);
+	bool startsWith(ofStringView prefix);
+	void consume(std::size_t size);
+	Event fail(const std::string & error);
+	Event readStartTag();
+	Event readEndTag();
+
+	std::unique_ptr<std::istream> input;
+	std::string buffer;
+	std::size_t position;
+	bool eof;
+
+	std::string name;
+	std::string text;
+	std::vector<std::pair<std::string, std::string>> attributes;
+	std::size_t numAttributes;
+	// names of the elements that are open, the first depth of them, kept
+	// so their memory can be reused
+	std::vector<std::string> openElements;
+	std::size_t depth;
+	bool emptyElement;
+	bool keepWhitespace;
+	Event current;
+	std::size_t line;
+	std::string error;
+};
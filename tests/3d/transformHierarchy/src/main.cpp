@@ -0,0 +1,168 @@
+#include "ofTransformHierarchy.h"
+#include "ofNode.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <thread>
+
+namespace{
+	bool aprox_eq(const glm::vec3 & v1, const glm::vec3 & v2){
+		bool eq = fabs(v1.x - v2.x) < 0.001 &&
+				  fabs(v1.y - v2.y) < 0.001 &&
+				  fabs(v1.z - v2.z) < 0.001;
+		if(!eq){
+			ofLogError() << "value1: " << v1;
+			ofLogError() << "value2: " << v2;
+		}
+		return eq;
+	}
+
+	bool aprox_eq(const glm::vec4 & v1, const glm::vec4 & v2){
+		return aprox_eq(v1.xyz(), v2.xyz()) && fabs(v1.w - v2.w) < 0.001;
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "same results as ofNode";
+			ofTransformHierarchy hierarchy;
+			ofNode n1, n2, n3;
+			n2.setParent(n1);
+			n3.setParent(n2);
+			auto s1 = hierarchy.add();
+			auto s2 = hierarchy.add(s1);
+			auto s3 = hierarchy.add(s2);
+			for(auto transform: { std::make_pair(&n1, s1), std::make_pair(&n2, s2), std::make_pair(&n3, s3) }){
+				transform.first->setPosition({ 10.f, 0.f, 0.f });
+				transform.first->setOrientation(glm::angleAxis(glm::radians(30.f), glm::vec3(0, 1, 0)));
+				transform.first->setScale(1.5f);
+				hierarchy.setTransform(transform.second, transform.first->getPosition(), transform.first->getOrientationQuat(), transform.first->getScale());
+			}
+			auto zero = glm::vec4(0,0,0,1);
+			test(aprox_eq(hierarchy.getGlobalTransformMatrix(s3) * zero, n3.getGlobalTransformMatrix() * zero), "global matrix before update");
+			hierarchy.update();
+			test(!hierarchy.needsUpdate(), "updated");
+			test(aprox_eq(hierarchy.getGlobalTransformMatrix(s3) * zero, n3.getGlobalTransformMatrix() * zero), "global matrix after update");
+			test(aprox_eq(hierarchy.getGlobalScale(s3), n3.getGlobalScale()), "global scale");
+
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "structure changes";
+			// reparenting reorders the internal storage, slots have to keep working
+			auto s0 = hierarchy.add();
+			hierarchy.setPosition(s0, { 0.f, 5.f, 0.f });
+			hierarchy.setParent(s1, s0);
+			hierarchy.update();
+			test(aprox_eq(hierarchy.getGlobalPosition(s3), n3.getGlobalPosition() + glm::vec3(0.f, 5.f, 0.f)), "global position after reparenting");
+			ofLogNotice() << "an error about a cycle is expected";
+			hierarchy.setParent(s0, s3);
+			test_eq(hierarchy.getParent(s0), ofTransformHierarchy::noParent, "cycles are rejected");
+
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "attached nodes";
+			ofNode attached;
+			attached.attachToHierarchy(hierarchy, s2);
+			attached.setPosition({ 0.f, 0.f, 0.f });
+			test(aprox_eq(hierarchy.getPosition(s2), glm::vec3(0.f, 0.f, 0.f)), "attached node writes to its slot");
+			test(aprox_eq(attached.getGlobalPosition(), hierarchy.getGlobalPosition(s2)), "attached node reads global position from its slot");
+
+			// a plain node under an attached one has to follow changes made
+			// through the hierarchy, the attached node doesn't know about them
+			ofNode child, grandChild;
+			child.setParent(attached);
+			grandChild.setParent(child);
+			child.setPosition({ 1.f, 0.f, 0.f });
+			grandChild.setPosition({ 1.f, 0.f, 0.f });
+			grandChild.getGlobalPosition();
+			hierarchy.setPosition(s0, { 0.f, 50.f, 0.f });
+			hierarchy.update();
+			test(aprox_eq(child.getGlobalPosition(), attached.getGlobalTransformMatrix() * glm::vec4(1.f, 0.f, 0.f, 1.f)), "child of attached node after the hierarchy changes");
+			test(aprox_eq(grandChild.getGlobalPosition(), attached.getGlobalTransformMatrix() * glm::vec4(2.f, 0.f, 0.f, 1.f)), "grandchild of attached node after the hierarchy changes");
+
+			// children that already cached their global transform start and
+			// stop following the hierarchy when their parent is attached
+			ofNode late, lateChild;
+			lateChild.setParent(late);
+			lateChild.setPosition({ 1.f, 0.f, 0.f });
+			lateChild.getGlobalPosition();
+			late.attachToHierarchy(hierarchy, s2);
+			hierarchy.setPosition(s0, { 0.f, 20.f, 0.f });
+			test(aprox_eq(lateChild.getGlobalPosition(), late.getGlobalTransformMatrix() * glm::vec4(1.f, 0.f, 0.f, 1.f)), "child of a node attached later follows the hierarchy");
+			late.detachFromHierarchy();
+			test(aprox_eq(lateChild.getGlobalPosition(), late.getLocalTransformMatrix() * glm::vec4(1.f, 0.f, 0.f, 1.f)), "child of a detached node stops following the hierarchy");
+
+			hierarchy.remove(s1);
+			test_eq(hierarchy.getParent(s2), ofTransformHierarchy::noParent, "removing a slot makes its children roots");
+			test(!hierarchy.isValid(s1), "removed slot isn't valid");
+			hierarchy.update();
+			test(aprox_eq(attached.getGlobalPosition(), glm::vec3(0.f, 0.f, 0.f)), "attached node after removing its parent slot");
+			test(aprox_eq(child.getGlobalPosition(), glm::vec3(1.f, 0.f, 0.f)), "child of attached node after removing a parent slot");
+
+			ofLogNotice() << "an error about an invalid slot is expected";
+			ofNode invalid;
+			invalid.attachToHierarchy(hierarchy, s1);
+			test(invalid.getHierarchy() == nullptr, "attaching to a removed slot fails");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "concurrent reads";
+			// const getters fill the cache of every node on the way up, from
+			// all the threads at once
+			std::vector<ofNode> nodes(1000);
+			for(std::size_t i = 1; i < nodes.size(); i++){
+				nodes[i].setParent(nodes[(i - 1) / 4]);
+				nodes[i].setPosition({ 1.f, 0.f, 0.f });
+			}
+			std::atomic<int> wrong{0};
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 4; i++){
+				threads.emplace_back([&]{
+					for(auto node = nodes.rbegin(); node != nodes.rend(); ++node){
+						float depth = 0;
+						for(auto parent = node->getParent(); parent; parent = parent->getParent()){
+							depth++;
+						}
+						if(!aprox_eq(node->getGlobalPosition(), glm::vec3(depth, 0.f, 0.f))){
+							wrong++;
+						}
+					}
+				});
+			}
+			for(auto & thread: threads){
+				thread.join();
+			}
+			test_eq(wrong.load(), 0, "global positions read from several threads");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			const std::size_t numTransforms = 100000;
+			ofTransformHierarchy crowd;
+			std::vector<std::size_t> slots;
+			slots.push_back(crowd.add());
+			for(std::size_t i = 1; i < numTransforms; i++){
+				slots.push_back(crowd.add(slots[(i - 1) / 4]));
+				crowd.setPosition(slots.back(), { 1.f, 0.f, 0.f });
+			}
+			crowd.update();
+			auto then = ofGetElapsedTimeMicros();
+			crowd.setPosition(slots.front(), { 0.f, 1.f, 0.f });
+			crowd.update();
+			ofLogNotice() << "updating " << numTransforms << " transforms took " << ofGetElapsedTimeMicros() - then << "us";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -177,6 +177,161 @@ class ofApp: public ofxUnitTestsApp{
 
 			});
 		}
+
+		{
+			ofEvent<const int> e;
+			int calls = 0;
+			std::vector<ofEventListener> added;
+			auto listener = e.newListener([&](const int &){
+				calls++;
+				if(added.empty()){
+					added.push_back(e.newListener([&](const int &){
+						calls++;
+					}));
+				}
+			});
+			e.notify(1);
+			test_eq(calls, 1, "Listener added during notify isn't called until the next notify");
+			e.notify(2);
+			test_eq(calls, 3, "Listener added during notify is called on the next notify");
+		}
+
+		{
+			auto e = std::make_unique<ofEvent<const int>>();
+			int calls = 0;
+			e->add([&](const int &){
+				calls++;
+				e.reset();
+			}, OF_EVENT_ORDER_APP);
+			e->add([&](const int &){
+				calls++;
+			}, OF_EVENT_ORDER_AFTER_APP);
+			e->notify(1);
+			test_eq(calls, 2, "Listener destroying the event during notify");
+		}
+
+		{
+			ofEvent<const int> e;
+			std::atomic<int> calls{0};
+			std::atomic<bool> done{false};
+			auto listener = e.newListener([&](const int &){
+				calls++;
+			});
+			std::thread notifier([&]{
+				for(int i = 0; i < 100000; i++){
+					e.notify(i);
+				}
+				done = true;
+			});
+			std::size_t changes = 0;
+			while(!done){
+				auto other = e.newListener([](const int &){});
+				other.unsubscribe();
+				changes++;
+			}
+			notifier.join();
+			test_eq(calls.load(), 100000, "Notify from another thread while adding and removing listeners");
+			ofLogNotice() << "added and removed " << changes << " listeners while notifying";
+		}
+
+		{
+			ofEvent<const int> e;
+			int sum = 0;
+			int calls = 0;
+			auto mainThread = std::this_thread::get_id();
+			bool calledFromMainThread = true;
+			auto listener = e.newListener([&](const int & v){
+				sum += v;
+				calls++;
+				calledFromMainThread &= std::this_thread::get_id() == mainThread;
+			});
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 4; i++){
+				threads.emplace_back([&]{
+					for(int j = 0; j < 5000; j++){
+						e.notifyDeferred(1);
+					}
+				});
+			}
+			for(auto & thread: threads){
+				thread.join();
+			}
+			test_eq(calls, 0, "Deferred notifications wait for the queue to be drained");
+			ofGetMainEventQueue().drain();
+			test_eq(sum, 20000, "Deferred notifications from several threads");
+			test(calledFromMainThread, "Deferred notifications run on the draining thread");
+
+			calls = 0;
+			sum = 0;
+			for(int i = 1; i <= 100; i++){
+				e.notifyDeferred(i, OF_EVENT_DEFER_COALESCE);
+			}
+			ofGetMainEventQueue().drain();
+			test_eq(calls, 1, "Coalesced deferred notifications are delivered once");
+			test_eq(sum, 100, "Coalesced deferred notifications deliver the last value");
+
+			calls = 0;
+			{
+				ofEvent<const int> destroyed;
+				auto destroyedListener = destroyed.newListener([&](const int &){
+					calls++;
+				});
+				destroyed.notifyDeferred(1);
+			}
+			ofGetMainEventQueue().drain();
+			test_eq(calls, 0, "Deferred notification of a destroyed event is dropped");
+
+			ofEventQueue queue;
+			ofEvent<void> voidE;
+			auto voidListener = voidE.newListener([&]{
+				calls++;
+			});
+			voidE.notifyDeferred(nullptr, OF_EVENT_DEFER_QUEUE, queue);
+			ofGetMainEventQueue().drain();
+			test_eq(calls, 0, "Deferred notification to a custom queue waits for that queue");
+			queue.drain();
+			test_eq(calls, 1, "Deferred notification to a custom queue");
+
+			// the first notification fills the ring while it's being drained
+			// so the last one overflows before the others run
+			ofEventQueue small(4);
+			std::vector<int> order;
+			small.post([&]{
+				order.push_back(0);
+				for(int i = 2; i < 6; i++){
+					small.post([&, i]{
+						order.push_back(i);
+					});
+				}
+			});
+			small.post([&]{
+				order.push_back(1);
+			});
+			small.drain();
+			small.drain();
+			test(order == std::vector<int>({0, 1, 2, 3, 4, 5}), "Overflowed notifications run in order");
+		}
+
+		{
+			const int numListeners = 10;
+			const int numNotifications = 1000000;
+			ofEvent<const int> e;
+			int sum = 0;
+			std::vector<ofEventListener> listeners;
+			for(int i = 0; i < numListeners; i++){
+				listeners.push_back(e.newListener([&](const int & v){
+					sum += v;
+				}));
+			}
+			auto then = ofGetElapsedTimeMicros();
+			for(int i = 0; i < numNotifications; i++){
+				e.notify(1);
+			}
+			auto elapsed = ofGetElapsedTimeMicros() - then;
+			test_eq(sum, numListeners * numNotifications, "Notify benchmark listeners called");
+			ofLogNotice() << numNotifications << " notifications to " << numListeners << " listeners took "
+				<< elapsed << "us, " << elapsed * 1000. / numNotifications << "ns per notify";
+		}
 	}
 };
 
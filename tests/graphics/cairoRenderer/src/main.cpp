@@ -0,0 +1,88 @@
+#include "ofCairoRenderer.h"
+#include "ofxUnitTests.h"
+
+namespace{
+	// two frames mixing blend modes, with a flush in the middle of the
+	// first one
+	void drawFrames(ofCairoRenderer & renderer){
+		renderer.startRender();
+		renderer.clear(30, 60, 90, 255);
+		renderer.setFillMode(OF_FILLED);
+		renderer.setColor(255, 0, 0, 128);
+		renderer.drawRectangle(10, 10, 0, 150, 100);
+		renderer.setBlendMode(OF_BLENDMODE_ADD);
+		renderer.setColor(0, 200, 0, 200);
+		renderer.drawCircle(150, 100, 0, 80);
+		renderer.flush();
+		renderer.setBlendMode(OF_BLENDMODE_MULTIPLY);
+		renderer.setColor(128, 128, 255);
+		renderer.drawRectangle(100, 50, 0, 180, 120);
+		renderer.setBlendMode(OF_BLENDMODE_ALPHA);
+		renderer.finishRender();
+
+		renderer.startRender();
+		renderer.setFillMode(OF_FILLED);
+		renderer.setBlendMode(OF_BLENDMODE_SUBTRACT);
+		renderer.setColor(50, 50, 50);
+		renderer.drawRectangle(40, 0, 0, 200, 150);
+		renderer.setBlendMode(OF_BLENDMODE_ALPHA);
+		renderer.setColor(255, 255, 255, 100);
+		renderer.drawTriangle(0, 200, 0, 150, 20, 0, 300, 200, 0);
+		renderer.finishRender();
+	}
+
+	int maxDifference(const ofPixels & pixels1, const ofPixels & pixels2){
+		int difference = 0;
+		for(std::size_t i = 0; i < pixels1.size(); i++){
+			difference = std::max(difference, std::abs(int(pixels1[i]) - int(pixels2[i])));
+		}
+		return difference;
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "tiled rendering";
+		ofRectangle size(0, 0, 300, 200);
+
+		ofCairoRenderer untiled;
+		untiled.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, size);
+		drawFrames(untiled);
+
+		ofCairoRenderer tiled;
+		tiled.setTiledRendering(true, 64);
+		tiled.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, size);
+		test(tiled.isTiledRendering(), "tiled rendering enabled");
+		drawFrames(tiled);
+
+		auto & untiledPixels = untiled.getImageSurfacePixels();
+		auto & tiledPixels = tiled.getImageSurfacePixels();
+		test_eq(tiledPixels.size(), untiledPixels.size(), "same size");
+		if(tiledPixels.size() == untiledPixels.size()){
+			// allow for rounding differences when compositing
+			test(maxDifference(tiledPixels, untiledPixels) <= 1, "tiled pixels match untiled ones");
+		}
+
+		auto context = tiled.getCairoContext();
+		auto surface = tiled.getCairoSurface();
+		tiled.setColor(0, 0, 255);
+		tiled.drawRectangle(0, 0, 0, 10, 10);
+		tiled.flush();
+		test(tiled.getCairoContext() == context, "context stays valid after flush");
+		test(tiled.getCairoSurface() == surface, "surface stays valid after flush");
+		test_eq(int(tiled.getImageSurfacePixels().getColor(5, 5).b), 255, "flush renders what was drawn");
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,165 @@
+#include "ofTrueTypeFont.h"
+#include "ofxUnitTests.h"
+
+namespace{
+	// the glyph quads in mesh starting at vertex offset are the ones in
+	// expected
+	bool sameQuads(const ofMesh & mesh, std::size_t offset, const ofMesh & expected){
+		if(mesh.getNumVertices() < offset + expected.getNumVertices()){
+			ofLogError() << "mesh has " << mesh.getNumVertices() << " vertices, expected at least "
+				<< offset + expected.getNumVertices();
+			return false;
+		}
+		for(std::size_t i = 0; i < expected.getNumVertices(); i++){
+			if(mesh.getVertex(offset + i) != expected.getVertex(i) || mesh.getTexCoord(offset + i) != expected.getTexCoord(i)){
+				ofLogError() << "vertex " << offset + i << ": " << mesh.getVertex(offset + i) << ", expected: " << expected.getVertex(i);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool sameQuads(const ofMesh & mesh, const ofMesh & expected){
+		return mesh.getNumVertices() == expected.getNumVertices() && sameQuads(mesh, 0, expected);
+	}
+
+	// lays out str without going through the cache
+	ofMesh uncachedMesh(ofTrueTypeFont & font, const std::string & str, float x, float y, bool vFlipped = true){
+		auto cacheSize = font.getStringMeshCacheSize();
+		font.setStringMeshCacheSize(0);
+		ofMesh mesh = font.getStringMesh(str, x, y, vFlipped);
+		font.setStringMeshCacheSize(cacheSize);
+		return mesh;
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofTrueTypeFont font;
+		test(font.load("mono.ttf", 16), "load font");
+		const std::size_t verticesPerGlyph = 4;
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "string mesh cache";
+			test_eq(font.getStringMeshCacheSize(), std::size_t(0), "cache disabled by default");
+			font.setStringMeshCacheSize(2);
+			auto expectedA = uncachedMesh(font, "first", 10, 20);
+			auto expectedB = uncachedMesh(font, "second", 10, 40);
+			auto expectedC = uncachedMesh(font, "third", 10, 60);
+
+			auto meshA = &font.getStringMesh("first", 10, 20);
+			test(sameQuads(*meshA, expectedA), "cached mesh is the same as an uncached one");
+			test(sameQuads(font.getStringMesh("second", 10, 40), expectedB), "second cached mesh");
+			test(&font.getStringMesh("first", 10, 20) == meshA, "same string and position is a hit");
+			test(&font.getStringMesh("first", 10, 30) != meshA, "a different position is a miss");
+			test(sameQuads(font.getStringMesh("first", 10, 20), expectedA), "hit after a miss");
+
+			// first at 10, 20 is now the most recently used so third replaces
+			// first at 10, 30
+			auto meshC = &font.getStringMesh("third", 10, 60);
+			test(sameQuads(*meshC, expectedC), "mesh for a new string when the cache is full");
+			test(&font.getStringMesh("first", 10, 20) == meshA, "most recently used string is kept");
+			test(sameQuads(*meshA, expectedA), "most recently used mesh isn't modified");
+			test(&font.getStringMesh("third", 10, 60) == meshC, "new string is cached");
+			test(sameQuads(font.getStringMesh("second", 10, 40), expectedB), "least recently used string is laid out again");
+			test(&font.getStringMesh("third", 10, 60) == meshC, "evicting keeps the most recent strings");
+			test(sameQuads(*meshC, expectedC), "evicting keeps the most recent meshes");
+
+			font.setStringMeshCacheSize(1);
+			test(&font.getStringMesh("third", 10, 60) == meshC, "shrinking keeps the most recently used string");
+			test(&font.getStringMesh("second", 10, 40) == meshC, "a new string reuses the only entry");
+			test(sameQuads(*meshC, expectedB), "reused entry has the new string");
+
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "cache invalidation";
+			font.setStringMeshCacheSize(2);
+			auto beforeSpacing = font.getStringMesh("first", 10, 20);
+			font.setLetterSpacing(2);
+			auto afterSpacing = font.getStringMesh("first", 10, 20);
+			test(!sameQuads(afterSpacing, beforeSpacing), "letter spacing invalidates the cache");
+			test(sameQuads(afterSpacing, uncachedMesh(font, "first", 10, 20)), "mesh after changing letter spacing");
+			font.setLetterSpacing(1);
+			test(sameQuads(font.getStringMesh("first", 10, 20), beforeSpacing), "mesh after restoring letter spacing");
+
+			auto beforeLineHeight = font.getStringMesh("first\nsecond", 10, 20);
+			font.setLineHeight(font.getLineHeight() * 2);
+			auto afterLineHeight = font.getStringMesh("first\nsecond", 10, 20);
+			test(!sameQuads(afterLineHeight, beforeLineHeight), "line height invalidates the cache");
+			test(sameQuads(afterLineHeight, uncachedMesh(font, "first\nsecond", 10, 20)), "mesh after changing line height");
+			font.setLineHeight(font.getLineHeight() / 2);
+
+			font.setDirection(ofTrueTypeFont::Settings::Direction::RightToLeft);
+			auto rightToLeft = font.getStringMesh("first", 10, 20);
+			test(sameQuads(rightToLeft, uncachedMesh(font, "first", 10, 20)), "direction invalidates the cache");
+			font.setDirection(ofTrueTypeFont::Settings::Direction::LeftToRight);
+
+			font.clearStringMeshCache();
+			test(sameQuads(font.getStringMesh("first", 10, 20), beforeSpacing), "mesh after clearing the cache");
+			font.setStringMeshCacheSize(0);
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "text layout";
+			ofTextLayout layout(font, "first", 10, 20);
+			test(sameQuads(layout.getMesh(), font.getStringMesh("first", 10, 20)), "layout is aligned with getStringMesh");
+
+			layout.setPosition(30, 50);
+			test(sameQuads(layout.getMesh(), font.getStringMesh("first", 30, 50)), "layout after moving it");
+
+			layout.setText("first\nsecond");
+			auto lines = layout.getMesh();
+			test_eq(lines.getNumVertices(), std::string("firstsecond").size() * verticesPerGlyph, "line breaks don't add glyphs");
+			test(sameQuads(lines, 0, font.getStringMesh("first", 30, 50)), "first line");
+			test(sameQuads(lines, 5 * verticesPerGlyph, font.getStringMesh("second", 30, 50 + font.getLineHeight())),
+				"line break starts the next line below at the layout x");
+
+			layout.setVFlipped(false);
+			test(sameQuads(layout.getMesh(), 5 * verticesPerGlyph, font.getStringMesh("second", 30, 50 - font.getLineHeight(), false)),
+				"line break goes up when not flipped");
+			layout.setVFlipped(true);
+
+			layout.setText("first");
+			layout.getMesh();
+			layout.appendText("\nsecond");
+			test(sameQuads(layout.getMesh(), lines), "appending a line break is the same as setting all the text");
+			layout.appendText("\tthird");
+			test(sameQuads(layout.getMesh(), font.getStringMesh("first\nsecond\tthird", 30, 50)), "appending after a tab");
+
+			font.setLetterSpacing(2);
+			test(sameQuads(layout.getMesh(), font.getStringMesh("first\nsecond\tthird", 30, 50)), "layout follows font setting changes");
+			font.setLetterSpacing(1);
+
+			font.setDirection(ofTrueTypeFont::Settings::Direction::RightToLeft);
+			layout.setText("first");
+			auto rightToLeft = layout.getMesh();
+			test(sameQuads(rightToLeft, font.getStringMesh("first", 30, 50)), "right to left layout");
+			test(rightToLeft.getVertex(4 * verticesPerGlyph).x < rightToLeft.getVertex(0).x, "right to left layout ends left of where it starts");
+			font.setDirection(ofTrueTypeFont::Settings::Direction::LeftToRight);
+			test(layout.getMesh().getVertex(4 * verticesPerGlyph).x > layout.getMesh().getVertex(0).x, "layout follows direction changes");
+
+			ofTextLayout second(font, "second", 30, 80);
+			ofMesh both;
+			layout.appendTo(both);
+			second.appendTo(both);
+			test_eq(both.getNumVertices(), layout.getMesh().getNumVertices() + second.getMesh().getNumVertices(), "appending layouts");
+			test(sameQuads(both, layout.getMesh().getNumVertices(), font.getStringMesh("second", 30, 80)), "appended layout keeps its position");
+
+			layout.clear();
+			test_eq(layout.getMesh().getNumVertices(), std::size_t(0), "cleared layout");
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
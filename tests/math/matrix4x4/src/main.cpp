@@ -0,0 +1,222 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+namespace{
+	// plain loops, the same operations ofMatrix4x4 did before using simd
+	ofMatrix4x4 multiply(const ofMatrix4x4 & a, const ofMatrix4x4 & b){
+		ofMatrix4x4 m;
+		for(int r = 0; r < 4; r++){
+			for(int c = 0; c < 4; c++){
+				m(r, c) = a(r, 0) * b(0, c) + a(r, 1) * b(1, c) + a(r, 2) * b(2, c) + a(r, 3) * b(3, c);
+			}
+		}
+		return m;
+	}
+
+	ofMatrix4x4 randomMatrix(){
+		ofMatrix4x4 m;
+		for(int r = 0; r < 4; r++){
+			for(int c = 0; c < 4; c++){
+				m(r, c) = ofRandom(-2, 2);
+			}
+		}
+		return m;
+	}
+
+	bool aprox_eq(const ofMatrix4x4 & m1, const ofMatrix4x4 & m2, float tolerance = 0.001f){
+		for(int r = 0; r < 4; r++){
+			for(int c = 0; c < 4; c++){
+				if(fabs(m1(r, c) - m2(r, c)) > tolerance){
+					ofLogError() << "value1: " << m1;
+					ofLogError() << "value2: " << m2;
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool aprox_eq(const ofVec3f & v1, const ofVec3f & v2){
+		return v1.distance(v2) < 0.001f;
+	}
+
+	bool aprox_eq(const ofVec4f & v1, const ofVec4f & v2){
+		return v1.distance(v2) < 0.001f;
+	}
+
+	template<typename F>
+	uint64_t microsFor(F f){
+		auto then = ofGetElapsedTimeMicros();
+		f();
+		return ofGetElapsedTimeMicros() - then;
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofSeedRandom(42);
+
+		{
+			ofLogNotice() << "multiplication";
+			bool productOk = true, postOk = true, preOk = true, selfOk = true;
+			for(int i = 0; i < 1000; i++){
+				auto a = randomMatrix();
+				auto b = randomMatrix();
+				auto expected = multiply(a, b);
+				productOk &= aprox_eq(a * b, expected, 0.00001f);
+
+				auto post = a;
+				post.postMult(b);
+				postOk &= aprox_eq(post, expected, 0.00001f);
+
+				auto pre = b;
+				pre.preMult(a);
+				preOk &= aprox_eq(pre, expected, 0.00001f);
+
+				auto self = a;
+				self *= self;
+				selfOk &= aprox_eq(self, multiply(a, a), 0.00001f);
+			}
+			test(productOk, "\toperator *");
+			test(postOk, "\tpostMult");
+			test(preOk, "\tpreMult");
+			test(selfOk, "\tmultiply by itself");
+		}
+
+		{
+			ofLogNotice() << "inverse";
+			bool generalOk = true;
+			for(int i = 0; i < 1000; i++){
+				auto m = randomMatrix();
+				// keep it well conditioned
+				for(int j = 0; j < 4; j++){
+					m(j, j) += 5;
+				}
+				generalOk &= aprox_eq(m * m.getInverse(), ofMatrix4x4());
+			}
+			test(generalOk, "\tgeneral matrix");
+
+			ofMatrix4x4 affine;
+			affine.rotate(30, 1, 2, 3);
+			affine.scale(2, 1, 0.5);
+			affine.translate(10, -5, 3);
+			test(aprox_eq(affine * affine.getInverse(), ofMatrix4x4()), "\taffine matrix");
+
+			auto projection = ofMatrix4x4::newPerspectiveMatrix(60, 1.5, 0.1, 1000);
+			test(aprox_eq(projection * projection.getInverse(), ofMatrix4x4()), "\tprojection matrix");
+
+			ofMatrix4x4 illConditioned(1, 2, 3, 4,
+			                           2, 4.001, 6, 8,
+			                           0, 1, 0, 1,
+			                           1, 1, 1, 2);
+			test(aprox_eq(illConditioned * illConditioned.getInverse(), ofMatrix4x4()), "\till conditioned matrix");
+
+			ofMatrix4x4 singular(1, 2, 3, 4,
+			                     2, 4, 6, 8,
+			                     0, 1, 0, 1,
+			                     1, 1, 1, 1);
+			ofMatrix4x4 inverse;
+			test(!inverse.makeInvertOf(singular), "\tsingular matrix");
+		}
+
+		{
+			ofLogNotice() << "vectors";
+			auto m = randomMatrix();
+			std::vector<ofVec3f> points;
+			std::vector<ofVec4f> points4;
+			for(int i = 0; i < 1001; i++){
+				points.emplace_back(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+				points4.emplace_back(points.back().x, points.back().y, points.back().z, ofRandom(-1, 1));
+			}
+
+			std::vector<ofVec3f> out(points.size());
+			std::vector<ofVec4f> out4(points.size());
+			bool preOk = true, postOk = true, pre4Ok = true, post4Ok = true, rotateOk = true, rotatePostOk = true;
+			m.preMult(points.data(), out.data(), points.size());
+			for(std::size_t i = 0; i < points.size(); i++){
+				preOk &= aprox_eq(out[i], m.preMult(points[i]));
+			}
+			m.postMult(points.data(), out.data(), points.size());
+			for(std::size_t i = 0; i < points.size(); i++){
+				postOk &= aprox_eq(out[i], m.postMult(points[i]));
+			}
+			m.preMult(points4.data(), out4.data(), points4.size());
+			for(std::size_t i = 0; i < points4.size(); i++){
+				pre4Ok &= aprox_eq(out4[i], m.preMult(points4[i]));
+			}
+			m.postMult(points4.data(), out4.data(), points4.size());
+			for(std::size_t i = 0; i < points4.size(); i++){
+				post4Ok &= aprox_eq(out4[i], m.postMult(points4[i]));
+			}
+			ofMatrix4x4::transform3x3(points.data(), out.data(), points.size(), m);
+			for(std::size_t i = 0; i < points.size(); i++){
+				rotateOk &= aprox_eq(out[i], ofMatrix4x4::transform3x3(points[i], m));
+			}
+			ofMatrix4x4::transform3x3(m, points.data(), out.data(), points.size());
+			for(std::size_t i = 0; i < points.size(); i++){
+				rotatePostOk &= aprox_eq(out[i], ofMatrix4x4::transform3x3(m, points[i]));
+			}
+			test(preOk, "\tpreMult vec3");
+			test(postOk, "\tpostMult vec3");
+			test(pre4Ok, "\tpreMult vec4");
+			test(post4Ok, "\tpostMult vec4");
+			test(rotateOk, "\ttransform3x3 v * M");
+			test(rotatePostOk, "\ttransform3x3 M * v");
+
+			auto inPlace = points;
+			m.preMult(inPlace.data(), inPlace.data(), inPlace.size());
+			m.preMult(points.data(), out.data(), points.size());
+			test(inPlace == out, "\tin place");
+		}
+
+		{
+			ofLogNotice() << "benchmark";
+			const std::size_t count = 1000000;
+			std::vector<ofMatrix4x4> matrices(64);
+			for(auto & m: matrices){
+				m = randomMatrix();
+			}
+			ofMatrix4x4 result;
+			auto plainMultiply = microsFor([&]{
+				for(std::size_t i = 0; i < count; i++){
+					result = multiply(matrices[i % 64], matrices[(i + 1) % 64]);
+				}
+			});
+			auto simdMultiply = microsFor([&]{
+				for(std::size_t i = 0; i < count; i++){
+					result.makeFromMultiplicationOf(matrices[i % 64], matrices[(i + 1) % 64]);
+				}
+			});
+			auto inverse = microsFor([&]{
+				for(std::size_t i = 0; i < count; i++){
+					result.makeInvertOf(matrices[i % 64]);
+				}
+			});
+
+			std::vector<ofVec3f> points(count, ofVec3f(1, 2, 3)), transformed(count);
+			auto oneByOne = microsFor([&]{
+				for(std::size_t i = 0; i < count; i++){
+					transformed[i] = result.preMult(points[i]);
+				}
+			});
+			auto batch = microsFor([&]{
+				result.preMult(points.data(), transformed.data(), count);
+			});
+			ofLogNotice() << "\t" << count << " multiplications took " << plainMultiply << "us with plain loops and "
+				<< simdMultiply << "us with ofMatrix4x4";
+			ofLogNotice() << "\t" << count << " inverses took " << inverse << "us";
+			ofLogNotice() << "\ttransforming " << count << " points took " << oneByOne << "us one by one and "
+				<< batch << "us batched";
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
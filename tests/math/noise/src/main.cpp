@@ -0,0 +1,103 @@
+#include "ofBatchNoise.h"
+#include "ofMath.h"
+#include "ofPixels.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "batch noise";
+			std::vector<glm::vec3> points;
+			std::vector<glm::vec2> points2d;
+			for(int i = 0; i < 1003; i++){
+				points.emplace_back(ofRandom(-300, 300), ofRandom(-300, 300), ofRandom(-300, 300));
+				points2d.emplace_back(ofRandom(-300, 300), ofRandom(-300, 300));
+			}
+			points.emplace_back(0.f, 0.f, 0.f);
+			points2d.emplace_back(-1.f, 2.f);
+
+			std::vector<float> noise;
+			ofNoise(points, noise);
+			bool noiseOk = noise.size() == points.size();
+			for(std::size_t i = 0; i < points.size() && noiseOk; i++){
+				noiseOk = fabs(noise[i] - ofNoise(points[i])) < 0.0001;
+			}
+			test(noiseOk, "3d points");
+
+			ofSignedNoise(points2d, noise);
+			bool signedOk = noise.size() == points2d.size();
+			for(std::size_t i = 0; i < points2d.size() && signedOk; i++){
+				signedOk = fabs(noise[i] - ofSignedNoise(points2d[i])) < 0.0001;
+			}
+			test(signedOk, "2d signed points");
+
+			const std::size_t width = 37, height = 23, depth = 5;
+			glm::vec3 origin(-3.f, 1.f, 2.f), step(0.1f, 0.2f, 0.3f);
+			std::vector<float> grid(width * height * depth);
+			ofNoiseGrid3D(grid.data(), width, height, depth, origin, step);
+			bool gridOk = true;
+			for(std::size_t z = 0; z < depth && gridOk; z++){
+				for(std::size_t y = 0; y < height && gridOk; y++){
+					for(std::size_t x = 0; x < width && gridOk; x++){
+						auto expected = ofNoise(origin + glm::vec3(x, y, z) * step);
+						gridOk = fabs(grid[(z * height + y) * width + x] - expected) < 0.0001;
+					}
+				}
+			}
+			test(gridOk, "3d grid layout");
+
+			ofFloatPixels pixels;
+			pixels.allocate(1001, 300, OF_PIXELS_RGB);
+			ofNoiseSettings settings;
+			settings.octaves = 5;
+			ofNoiseGrid2D(pixels, { -5.f, -5.f }, { 0.01f, 0.01f }, settings);
+			bool rangeOk = true;
+			bool channelsOk = true;
+			for(std::size_t i = 0; i < pixels.size(); i += 3){
+				rangeOk &= pixels[i] >= 0.f && pixels[i] <= 1.f;
+				channelsOk &= pixels[i] == pixels[i + 1] && pixels[i] == pixels[i + 2];
+			}
+			test(rangeOk, "fbm range");
+			test(channelsOk, "fbm every channel");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			std::vector<glm::vec3> cloud(1000000);
+			for(std::size_t i = 0; i < cloud.size(); i++){
+				cloud[i] = { i * 0.01f, i * 0.02f, i * 0.03f };
+			}
+			std::vector<float> cloudNoise(cloud.size());
+			auto then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < cloud.size(); i++){
+				cloudNoise[i] = ofNoise(cloud[i]);
+			}
+			auto scalarTime = ofGetElapsedTimeMicros() - then;
+			ofNoiseSettings settings;
+			settings.parallel = false;
+			then = ofGetElapsedTimeMicros();
+			ofNoise(cloud, cloudNoise, settings);
+			auto batchTime = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			ofNoise(cloud, cloudNoise);
+			auto parallelTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "noise at " << cloud.size() << " points took " << scalarTime << "us one by one, "
+				<< batchTime << "us batched and " << parallelTime << "us in parallel";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
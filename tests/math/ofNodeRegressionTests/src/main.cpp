@@ -139,6 +139,50 @@ public:
 			ofLogNotice() << "end add / clear parent and keep global transform";
 		}
 
+		{
+			ofLogNotice() << "cached global transform in deep hierarchy";
+			const size_t depth = 1000;
+			std::vector<ofNode> nodes(depth);
+			for(size_t i = 1; i < depth; i++){
+				nodes[i].setParent(nodes[i-1]);
+				nodes[i].setPosition(1.f, 0.f, 0.f);
+			}
+			auto & root = nodes.front();
+			auto & leaf = nodes.back();
+			test(aprox_eq(leaf.getGlobalPosition(), { float(depth - 1), 0.f, 0.f }), "\tleaf position");
+
+			root.setPosition(0.f, 10.f, 0.f);
+			test(aprox_eq(leaf.getGlobalPosition(), { float(depth - 1), 10.f, 0.f }), "\tleaf position after moving root");
+
+			nodes[depth / 2].setScale(2.f);
+			test(aprox_eq(leaf.getGlobalScale(), { 2.f, 2.f, 2.f }), "\tleaf scale after scaling middle node");
+			test(aprox_eq(leaf.getGlobalPosition(), { float(depth / 2 + (depth / 2 - 1) * 2), 10.f, 0.f }), "\tleaf position after scaling middle node");
+
+			ofNode other;
+			other.setPosition(0.f, 0.f, 5.f);
+			nodes[depth / 2].setParent(other);
+			test(aprox_eq(leaf.getGlobalPosition(), { float(1 + (depth / 2 - 1) * 2), 0.f, 5.f }), "\tleaf position after reparenting middle node");
+			nodes[depth / 2].setParent(nodes[depth / 2 - 1]);
+
+			const int numQueries = 10000;
+			glm::vec3 accum(0.f);
+			auto then = ofGetElapsedTimeMicros();
+			for(int i = 0; i < numQueries; i++){
+				accum += leaf.getGlobalPosition();
+			}
+			auto cachedTime = ofGetElapsedTimeMicros() - then;
+
+			then = ofGetElapsedTimeMicros();
+			for(int i = 0; i < numQueries; i++){
+				root.move(0.f, 0.f, 0.f);
+				accum += leaf.getGlobalPosition();
+			}
+			auto dirtyTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "\t" << numQueries << " leaf queries at depth " << depth << ": "
+				<< cachedTime << "us cached, " << dirtyTime << "us with the root changing every query";
+			ofLogNotice() << "end cached global transform in deep hierarchy";
+		}
+
 
     }
 };
@@ -0,0 +1,181 @@
+#include "ofMath.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+namespace{
+	// average time per value of generating count values
+	template<typename F>
+	double nanosPerValue(std::size_t count, F generate){
+		auto start = std::chrono::steady_clock::now();
+		generate();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::nano>(elapsed).count() / count;
+	}
+
+	template<typename Iterator>
+	void meanAndDeviation(Iterator begin, Iterator end, double & mean, double & deviation){
+		double sum = 0, sumSquares = 0;
+		std::size_t count = 0;
+		for(auto it = begin; it != end; ++it){
+			sum += *it;
+			sumSquares += double(*it) * *it;
+			count++;
+		}
+		mean = sum / count;
+		deviation = std::sqrt(sumSquares / count - mean * mean);
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "seeding";
+			ofSeedRandom(42);
+			std::vector<float> first;
+			for(int i = 0; i < 100; i++){
+				first.push_back(ofRandom(-10, 10));
+			}
+			ofSeedRandom(42);
+			std::vector<float> second;
+			for(int i = 0; i < 100; i++){
+				second.push_back(ofRandom(-10, 10));
+			}
+			test(first == second, "same seed repeats the same sequence");
+
+			ofSeedRandom(43);
+			test(ofRandom(-10, 10) != first[0], "different seeds give different sequences");
+
+			ofRandomEngine engine(42, 1), sameEngine(42, 1), otherStream(42, 2);
+			auto value = engine();
+			test_eq(value, sameEngine(), "engines with the same seed and stream");
+			test(value != otherStream(), "engines with different streams");
+
+			std::vector<int> values(100), shuffled;
+			std::iota(values.begin(), values.end(), 0);
+			ofSeedRandom(42);
+			ofRandomize(values);
+			shuffled = values;
+			std::sort(values.begin(), values.end());
+			ofSeedRandom(42);
+			ofRandomize(values);
+			test(values == shuffled, "ofRandomize follows ofSeedRandom");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ranges";
+			bool rangeOk = true, reversedOk = true, unitOk = true, signedOk = true;
+			for(int i = 0; i < 100000; i++){
+				auto r = ofRandom(5);
+				rangeOk &= r >= 0 && r < 5;
+				r = ofRandom(3, -2);
+				reversedOk &= r >= -2 && r < 3;
+				r = ofRandomuf();
+				unitOk &= r >= 0 && r < 1;
+				r = ofRandomf();
+				signedOk &= r >= -1 && r < 1;
+			}
+			test(rangeOk, "ofRandom(max)");
+			test(reversedOk, "ofRandom(max, min)");
+			test(unitOk, "ofRandomuf");
+			test(signedOk, "ofRandomf");
+
+			std::vector<float> fill(100003);
+			ofRandomFill(fill, 5, 6);
+			double mean, deviation;
+			meanAndDeviation(fill.begin(), fill.end(), mean, deviation);
+			auto minmax = std::minmax_element(fill.begin(), fill.end());
+			test(*minmax.first >= 5 && *minmax.second < 6, "ofRandomFill range");
+			test(fabs(mean - 5.5) < 0.01, "ofRandomFill mean");
+
+			ofRandomGaussianFill(fill, 2, 3);
+			meanAndDeviation(fill.begin(), fill.end(), mean, deviation);
+			test(fabs(mean - 2) < 0.05 && fabs(deviation - 3) < 0.05, "ofRandomGaussianFill distribution");
+
+			std::vector<glm::vec3> directions(10001);
+			ofRandomUnitVectorFill(directions);
+			glm::vec3 center;
+			bool lengthOk = true;
+			for(auto & d: directions){
+				lengthOk &= fabs(glm::length(d) - 1.f) < 0.0001f;
+				center += d;
+			}
+			center /= directions.size();
+			test(lengthOk, "ofRandomUnitVectorFill length");
+			test(glm::length(center) < 0.05, "ofRandomUnitVectorFill distribution");
+			test(fabs(glm::length(ofRandomUnitVector()) - 1.f) < 0.0001f, "ofRandomUnitVector");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "threads";
+			ofSeedRandom(42);
+			std::vector<std::thread> threads;
+			std::vector<double> means(4);
+			std::vector<float> firstValues(4);
+			for(std::size_t i = 0; i < means.size(); i++){
+				threads.emplace_back([&, i]{
+					firstValues[i] = ofRandomuf();
+					double sum = firstValues[i];
+					for(int j = 1; j < 100000; j++){
+						sum += ofRandomuf();
+					}
+					means[i] = sum / 100000;
+				});
+			}
+			for(auto & thread: threads){
+				thread.join();
+			}
+			bool meansOk = true;
+			for(auto mean: means){
+				meansOk &= fabs(mean - 0.5) < 0.01;
+			}
+			test(meansOk, "ofRandom from several threads");
+			std::sort(firstValues.begin(), firstValues.end());
+			test(std::unique(firstValues.begin(), firstValues.end()) == firstValues.end(), "every thread has its own sequence");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			const std::size_t count = 10000000;
+			float sum = 0;
+			auto randTime = nanosPerValue(count, [&]{
+				for(std::size_t i = 0; i < count; i++){
+					sum += rand() / float(RAND_MAX);
+				}
+			});
+			auto ofRandomTime = nanosPerValue(count, [&]{
+				for(std::size_t i = 0; i < count; i++){
+					sum += ofRandomuf();
+				}
+			});
+			std::vector<float> values(count);
+			auto fillTime = nanosPerValue(count, [&]{
+				ofRandomFill(values, 0, 1);
+			});
+			ofLogNotice() << "rand(): " << randTime << "ns per value";
+			ofLogNotice() << "ofRandomuf(): " << ofRandomTime << "ns per value";
+			ofLogNotice() << "ofRandomFill: " << fillTime << "ns per value";
+			ofLogVerbose() << sum;
+			// timings depend on the machine, they are only reported
+			ofLogNotice() << "ofRandomFill is " << ofRandomTime / fillTime << " times faster than ofRandomuf()";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
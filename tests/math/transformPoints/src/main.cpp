@@ -0,0 +1,125 @@
+#include "ofTransformPoints.h"
+#include "ofNode.h"
+#include "ofMesh.h"
+#include "ofPolyline.h"
+#include "ofMath.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+namespace{
+	bool aprox_eq(const glm::vec3 & v1, const glm::vec3 & v2){
+		bool eq = fabs(v1.x - v2.x) < 0.001 &&
+				  fabs(v1.y - v2.y) < 0.001 &&
+				  fabs(v1.z - v2.z) < 0.001;
+		if(!eq){
+			ofLogError() << "value1: " << v1;
+			ofLogError() << "value2: " << v2;
+		}
+		return eq;
+	}
+
+	glm::mat4 testMatrix(){
+		ofNode node;
+		node.setPosition({ 10.f, -5.f, 3.f });
+		node.setOrientation(glm::angleAxis(glm::radians(30.f), glm::normalize(glm::vec3(1.f, 2.f, 3.f))));
+		node.setScale({ 2.f, 1.f, 0.5f });
+		return node.getGlobalTransformMatrix();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "batch transform";
+			auto m = testMatrix();
+
+			std::vector<glm::vec3> points;
+			for(int i = 0; i < 1001; i++){
+				points.emplace_back(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+			}
+			std::vector<glm::vec3> transformed;
+			ofTransformPoints(m, points, transformed);
+			bool pointsOk = transformed.size() == points.size();
+			for(std::size_t i = 0; i < points.size() && pointsOk; i++){
+				pointsOk = aprox_eq(transformed[i], glm::vec3(m * glm::vec4(points[i], 1.f)));
+			}
+			test(pointsOk, "points");
+
+			auto inPlace = points;
+			ofTransformPoints(m, inPlace);
+			test(inPlace == transformed, "in place");
+
+			std::vector<glm::vec3> normals;
+			ofTransformNormals(m, points, normals);
+			auto normalMatrix = glm::inverseTranspose(glm::mat3(m));
+			bool normalsOk = true;
+			for(std::size_t i = 0; i < points.size() && normalsOk; i++){
+				normalsOk = aprox_eq(normals[i], glm::normalize(normalMatrix * points[i]));
+			}
+			test(normalsOk, "normals");
+
+			auto projection = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 1000.f);
+			std::vector<glm::vec3> projected;
+			ofTransformPointsProjective(projection, transformed, projected);
+			bool projectedOk = true;
+			for(std::size_t i = 0; i < points.size() && projectedOk; i++){
+				auto p = projection * glm::vec4(transformed[i], 1.f);
+				projectedOk = aprox_eq(projected[i], glm::vec3(p) / p.w);
+			}
+			test(projectedOk, "projective");
+
+			auto affine = glm::mat3(glm::vec3(0.f, 1.f, 0.f), glm::vec3(-2.f, 0.f, 0.f), glm::vec3(5.f, 7.f, 1.f));
+			std::vector<glm::vec2> points2d = { { 1.f, 0.f }, { 0.f, 1.f }, { 2.f, 3.f } };
+			ofTransformPoints(affine, points2d);
+			test(aprox_eq(glm::vec3(points2d[0], 0.f), { 5.f, 8.f, 0.f }), "2d affine");
+			test(aprox_eq(glm::vec3(points2d[1], 0.f), { 3.f, 7.f, 0.f }), "2d affine");
+			test(aprox_eq(glm::vec3(points2d[2], 0.f), { -1.f, 9.f, 0.f }), "2d affine odd count");
+
+			ofMesh mesh;
+			mesh.addVertices(points);
+			mesh.addNormals(points);
+			mesh.transform(m);
+			test(mesh.getVertices() == transformed, "mesh vertices");
+			test(mesh.getNormals() == normals, "mesh normals");
+
+			ofPolyline polyline(points);
+			polyline.transform(m);
+			test(polyline.getVertices() == transformed, "polyline");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			auto m = testMatrix();
+			std::vector<glm::vec3> crowd(1000000, glm::vec3(1.f, 2.f, 3.f));
+			std::vector<glm::vec3> crowdTransformed(crowd.size());
+			auto then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < crowd.size(); i++){
+				crowdTransformed[i] = glm::vec3(m * glm::vec4(crowd[i], 1.f));
+			}
+			auto glmTime = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			ofTransformPoints(m, crowd, crowdTransformed);
+			auto batchTime = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			ofTransformPointsParallel(m, crowd.data(), crowdTransformed.data(), crowd.size());
+			auto parallelTime = ofGetElapsedTimeMicros() - then;
+			test(aprox_eq(crowdTransformed.back(), glm::vec3(m * glm::vec4(crowd.back(), 1.f))), "parallel");
+			ofLogNotice() << "transforming " << crowd.size() << " points took " << glmTime << "us with glm, "
+				<< batchTime << "us batched and " << parallelTime << "us in parallel";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,241 @@
+#include "ofParameter.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofParameter<float> speed{"speed", 1};
+		ofParameter<int> count{"particle count", 10};
+		ofParameter<bool> enabled{"enabled", true};
+		ofParameter<float> radius{"radius", 5};
+		ofParameterGroup emitter{"emitter", radius};
+		ofParameterGroup settings{"settings", speed, count, enabled, emitter};
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "get";
+			test(settings.contains("speed"), "contains");
+			test(settings.contains("particle count"), "contains with spaces");
+			test(settings.contains("particle_count"), "contains escaped");
+			test(!settings.contains("particle"), "doesn't contain a prefix");
+			test_eq(settings.getPosition("enabled"), 2, "getPosition");
+			test_eq(settings.getPosition("missing"), -1, "getPosition missing");
+			test_eq(settings.getFloat("speed").get(), 1.f, "get by name");
+			test_eq(settings.getInt("particle_count").get(), 10, "get by escaped name");
+
+			bool thrown = false;
+			try{
+				settings.get("missing");
+			}catch(std::out_of_range &){
+				thrown = true;
+			}
+			test(thrown, "get throws for missing names");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "find";
+			std::string buffer = "xspeedx";
+			auto parameter = settings.find(ofStringView(buffer).substr(1, 5));
+			test(parameter != nullptr && parameter->isReferenceTo(speed), "find from a view");
+			test(settings.find("missing") == nullptr, "find missing");
+
+			parameter = settings.findPath("emitter/radius");
+			test(parameter != nullptr && parameter->isReferenceTo(radius), "findPath");
+			parameter = settings.findPath("emitter/radius");
+			test(parameter != nullptr && parameter->isReferenceTo(radius), "findPath cached");
+			test(settings.findPath("emitter") == &settings.get("emitter"), "findPath group");
+			test(settings.findPath("/emitter//radius/") != nullptr, "findPath ignores empty components");
+			test(settings.findPath("speed/radius") == nullptr, "findPath through a parameter that isn't a group");
+			test(settings.findPath("emitter/missing") == nullptr, "findPath missing");
+
+			ofParameter<float> rate{"rate", 2};
+			emitter.add(rate);
+			test(settings.findPath("emitter/rate") != nullptr, "findPath after adding to a subgroup");
+			emitter.remove(radius);
+			test(settings.findPath("emitter/radius") == nullptr, "findPath after removing from a subgroup");
+			emitter.add(radius);
+			parameter = settings.findPath("emitter/radius");
+			test(parameter != nullptr && parameter->isReferenceTo(radius), "findPath after adding again");
+			const auto & constSettings = settings;
+			test(constSettings.findPath("emitter/radius") == parameter, "const findPath");
+
+			rate.setName("emission rate");
+			test(emitter.contains("emission_rate") && !emitter.contains("rate"), "contains after renaming");
+			test(settings.findPath("emitter/emission_rate") != nullptr, "findPath after renaming in a subgroup");
+			test(settings.findPath("emitter/rate") == nullptr, "findPath with the old name after renaming");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "remove";
+			ofParameterGroup group{"group", speed, count, enabled};
+			group.remove("speed");
+			test_eq(group.size(), std::size_t(2), "remove by name");
+			test_eq(group.getPosition("enabled"), 1, "positions after removing");
+			test(group.getBool("enabled").get(), "get after removing");
+			group.remove(count);
+			test_eq(group.getPosition("enabled"), 0, "remove by reference");
+			group.remove(std::size_t(1));
+			test_eq(group.size(), std::size_t(1), "removing out of range does nothing");
+			group.remove(std::size_t(0));
+			test(group.size() == 0 && !group.contains("enabled"), "remove by position");
+
+			ofParameter<int> first{"value", 1};
+			ofParameter<int> second{"value", 2};
+			group.add(first);
+			ofLogNotice() << "a warning about adding a parameter with the same name is expected";
+			group.add(second);
+			test_eq(group.getInt("value").get(), 2, "the last parameter added with a name wins");
+			group.remove(std::size_t(1));
+			test_eq(group.getInt("value").get(), 1, "the first one is found again after removing the last");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "batch";
+			int speedChanges = 0;
+			int groupChanges = 0;
+			std::vector<ofParameterChanges> batches;
+			auto speedListener = speed.newListener([&](float &){
+				speedChanges++;
+			});
+			auto groupListener = settings.parameterChangedE().newListener([&](ofAbstractParameter &){
+				groupChanges++;
+			});
+			auto batchListener = settings.batchChangedE().newListener([&](const ofParameterChanges & changes){
+				batches.push_back(changes);
+			});
+
+			{
+				ofParameterBatch batch(settings);
+				test(settings.isInBatch(), "in batch");
+				for(int i = 0; i < 100; i++){
+					speed = i;
+					radius = i;
+				}
+				test_eq(speed.get(), 99.f, "values are set during the batch");
+				test_eq(speedChanges + groupChanges, 0, "no events during the batch");
+			}
+			test(!settings.isInBatch(), "batch ended");
+			test_eq(speedChanges, 1, "parameter listeners notified once");
+			test_eq(groupChanges, 0, "parameterChangedE not notified");
+			test_eq(batches.size(), std::size_t(1), "one batch event");
+			test(batches.size() == 1 && batches[0].parameters.size() == 2
+				&& batches[0].parameters[0]->isReferenceTo(speed)
+				&& batches[0].parameters[1]->isReferenceTo(radius), "changed parameters, once each");
+
+			batches.clear();
+			speedChanges = 0;
+			int emitterBatches = 0;
+			int radiusChanges = 0;
+			int radiusChangesBeforeEmitterBatch = -1;
+			auto radiusListener = radius.newListener([&](float &){
+				radiusChanges++;
+			});
+			auto emitterBatchListener = emitter.batchChangedE().newListener([&](const ofParameterChanges &){
+				emitterBatches++;
+				radiusChangesBeforeEmitterBatch = radiusChanges;
+			});
+			settings.beginBatch();
+			emitter.beginBatch();
+			radius = 1;
+			emitter.endBatch();
+			test(batches.empty(), "nested batch notifies when the outer one ends");
+			test_eq(emitterBatches, 0, "nested group's batch event waits for the outer batch");
+			speed = 1;
+			settings.endBatch();
+			test(batches.size() == 1 && batches[0].parameters.size() == 2 && speedChanges == 1, "outer batch");
+			test_eq(emitterBatches, 1, "nested group's batch event after the outer batch");
+			test_eq(radiusChangesBeforeEmitterBatch, 1, "nested group's batch event after the parameter listeners");
+			radiusListener.unsubscribe();
+			emitterBatchListener.unsubscribe();
+
+			settings.beginBatch();
+			settings.endBatch();
+			test_eq(batches.size(), std::size_t(1), "empty batches aren't notified");
+
+			batches.clear();
+			speedChanges = 0;
+			emitter.beginBatch();
+			radius = 2;
+			settings.beginBatch();
+			speed = 3;
+			emitter.endBatch();
+			test(batches.empty(), "overlapping batch notifies when the last one ends");
+			settings.endBatch();
+			test(batches.size() == 1 && batches[0].parameters.size() == 2 && speedChanges == 1, "changes before the outer batch started");
+
+			{
+				ofParameterGroup cleared{"cleared"};
+				ofParameterBatch batch(cleared);
+				cleared.clear();
+				test(cleared.isInBatch(), "clearing a group keeps its batch");
+			}
+
+			speed = 2;
+			test(speedChanges == 2 && groupChanges == 1, "events after the batch");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			ofParameterGroup big{"big"};
+			std::vector<ofParameter<float>> parameters(1000);
+			std::vector<std::string> names;
+			for(std::size_t i = 0; i < parameters.size(); i++){
+				parameters[i].set("parameter " + ofToString(i), float(i));
+				big.add(parameters[i]);
+				names.push_back("parameter " + ofToString(i));
+			}
+			ofParameterGroup root{"root", big};
+
+			double sum = 0;
+			auto getTime = millisFor([&]{
+				for(int n = 0; n < 100; n++){
+					for(auto & name: names){
+						sum += big.getFloat(name);
+					}
+				}
+			});
+
+			std::vector<std::string> paths;
+			for(auto & name: names){
+				paths.push_back("big/" + name);
+			}
+			auto pathTime = millisFor([&]{
+				for(int n = 0; n < 100; n++){
+					for(auto & path: paths){
+						sum += root.findPath(path)->cast<float>();
+					}
+				}
+			});
+			test_eq(sum, 2 * 100 * 999 * 1000 / 2., "benchmark values");
+			ofLogNotice() << "get by name: " << getTime * 1000000 / (100 * names.size()) << "ns";
+			ofLogNotice() << "findPath: " << pathTime * 1000000 / (100 * paths.size()) << "ns";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
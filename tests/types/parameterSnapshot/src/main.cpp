@@ -0,0 +1,174 @@
+#include "ofParameterSnapshot.h"
+#include "ofJson.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofParameter<float> speed{"speed", 1};
+		ofParameter<int> count{"count", 10};
+		ofParameter<std::string> label{"label", "particles"};
+		ofParameter<ofFloatColor> color{"color", ofFloatColor::red};
+		ofParameter<glm::vec3> position{"position", {1, 2, 3}};
+		ofParameter<void> reset{"reset"};
+		ofParameterGroup emitter{"emitter", color, position};
+		ofParameterGroup settings{"settings", speed, count, label, reset, emitter};
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "capture and restore";
+			ofParameterSnapshot snapshot(settings);
+			test_eq(snapshot.size(), std::size_t(5), "only serializable parameters");
+			test(!snapshot.isDelta(), "full snapshot");
+			auto paths = snapshot.getPaths();
+			test(paths.size() == 5 && paths[3] == "emitter/color", "paths");
+
+			speed = 2;
+			label = "changed";
+			position = {4, 5, 6};
+			test_eq(snapshot.restore(settings), std::size_t(5), "restore");
+			test_eq(speed.get(), 1.f, "float restored");
+			test_eq(label.get(), std::string("particles"), "string restored");
+			test(position.get() == glm::vec3(1, 2, 3), "vector restored");
+
+			int notified = 0;
+			auto listener = speed.newListener([&](float &){
+				notified++;
+			});
+			speed = 3;
+			snapshot.restore(settings);
+			test_eq(notified, 2, "restoring notifies listeners");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "diff and apply";
+			ofParameterSnapshot base(settings);
+			count = 20;
+			color = ofFloatColor::blue;
+			ofParameterSnapshot current(settings);
+			auto changes = current.diff(base);
+			test(changes.isDelta(), "diff is a delta");
+			test_eq(changes.size(), std::size_t(2), "only changed values");
+			auto paths = changes.getPaths();
+			test(paths.size() == 2 && paths[0] == "count" && paths[1] == "emitter/color", "changed paths");
+			test(current.diff(current).empty(), "no changes");
+
+			base.restore(settings);
+			test_eq(changes.restore(settings), std::size_t(2), "restore a delta");
+			test(count == 20 && color.get() == ofFloatColor::blue && speed == 1, "delta only sets changed values");
+
+			base.apply(changes);
+			test(!base.isDelta() && base.diff(current).empty(), "apply a delta to a full snapshot");
+
+			speed = 5;
+			ofParameterSnapshot next(settings);
+			auto moreChanges = next.diff(current);
+			changes.apply(moreChanges);
+			test(changes.isDelta() && changes.size() == 3, "merge deltas");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "save and load";
+			ofParameterSnapshot saved(settings);
+			test(saved.save("snapshot.bin"), "save");
+			speed = 0;
+			label = "";
+
+			ofParameterSnapshot loaded;
+			test(loaded.load("snapshot.bin"), "load");
+			test_eq(loaded.size(), saved.size(), "loaded size");
+			test_eq(loaded.restore(settings), std::size_t(5), "restore after loading");
+			test(speed == 5 && label.get() == "particles", "loaded values");
+
+			ofParameter<bool> added{"added", true};
+			settings.add(added);
+			speed = 0;
+			test_eq(loaded.restore(settings), std::size_t(5), "restore by path after the group changed");
+			test(speed == 5 && added, "parameters not in the snapshot are kept");
+			settings.remove(added);
+
+			ofBuffer buffer = saved.toBuffer();
+			ofBuffer truncated(buffer.getData(), buffer.size() - 1);
+			ofLogNotice() << "an error about a corrupted snapshot is expected";
+			test(!loaded.fromBuffer(truncated), "corrupted snapshots are rejected");
+
+			ofParameter<bool> flag{"flag", false};
+			char invalidBool = 2;
+			ofStringView invalidData(&invalidBool, 1);
+			test(!flag.fromBinary(invalidData) && !flag, "invalid bools are rejected");
+			ofFile::removeFile("snapshot.bin");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			const std::size_t numParameters = 50000;
+			std::vector<ofParameter<float>> parameters(numParameters);
+			std::vector<ofParameterGroup> groups(numParameters / 100);
+			ofParameterGroup big{"big"};
+			for(std::size_t i = 0; i < groups.size(); i++){
+				groups[i].setName("group " + ofToString(i));
+				for(std::size_t j = 0; j < 100; j++){
+					auto & parameter = parameters[i * 100 + j];
+					parameter.set("parameter " + ofToString(j), float(i + j));
+					groups[i].add(parameter);
+				}
+				big.add(groups[i]);
+			}
+
+			ofJson json;
+			auto serializeTime = millisFor([&]{
+				ofSerialize(json, big);
+			});
+			auto deserializeTime = millisFor([&]{
+				ofDeserialize(json, big);
+			});
+
+			ofParameterSnapshot snapshot;
+			auto firstCaptureTime = millisFor([&]{
+				snapshot.capture(big);
+			});
+			auto captureTime = millisFor([&]{
+				snapshot.capture(big);
+			});
+			auto restoreTime = millisFor([&]{
+				snapshot.restore(big);
+			});
+			parameters[12345] = -1;
+			ofParameterSnapshot changed(big);
+			auto diffTime = millisFor([&]{
+				test_eq(changed.diff(snapshot).size(), std::size_t(1), "benchmark diff");
+			});
+
+			ofLogNotice() << numParameters << " parameters";
+			ofLogNotice() << "ofSerialize json: " << serializeTime << "ms, ofDeserialize json: " << deserializeTime << "ms";
+			ofLogNotice() << "json size: " << json.dump().size() << " bytes, snapshot size: " << snapshot.toBuffer().size() << " bytes";
+			ofLogNotice() << "first capture: " << firstCaptureTime << "ms, capture: " << captureTime << "ms, restore: " << restoreTime << "ms, diff: " << diffTime << "ms";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
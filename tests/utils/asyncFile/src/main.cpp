@@ -0,0 +1,167 @@
+#include "ofAsyncFile.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	std::vector<char> testData(std::size_t size){
+		std::vector<char> data(size);
+		for(std::size_t i = 0; i < size; i++){
+			data[i] = char(i * 31 + i / 7);
+		}
+		return data;
+	}
+
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void testService(ofAsyncFileService & service){
+		const std::size_t chunk = 1 << 16;
+		auto data = testData(64 * chunk);
+
+		{
+			ofAsyncFile file("async.bin", ofFile::WriteOnly, service);
+			test(file.isOpen(), "open for writing");
+			std::vector<std::future<ofAsyncFileResult>> writes;
+			for(std::size_t offset = 0; offset < data.size(); offset += chunk){
+				writes.push_back(file.write(data.data() + offset, chunk, offset));
+			}
+			bool writesOk = true;
+			for(auto & write: writes){
+				auto result = write.get();
+				writesOk &= result.success() && result.bytes == chunk;
+			}
+			test(writesOk, "concurrent writes");
+			test_eq(file.getSize(), uint64_t(data.size()), "file size after writing");
+		}
+
+		{
+			ofAsyncFile file("async.bin", ofFile::ReadOnly, service);
+			std::vector<char> read(data.size() + 100);
+			auto result = file.read(read.data(), read.size(), 0).get();
+			test(result.success(), "read whole file");
+			test_eq(result.bytes, data.size(), "read stops at the end of the file");
+			test(memcmp(read.data(), data.data(), data.size()) == 0, "read back what was written");
+
+			result = file.read(read.data(), 10, data.size() + 10).get();
+			test(result.success() && result.bytes == 0, "read past the end of the file");
+
+			ofEventQueue queue;
+			std::fill(read.begin(), read.end(), 0);
+			int completed = 0;
+			bool callbacksOk = true;
+			for(int i = 0; i < 100; i++){
+				file.read(read.data() + i * 1000, 1000, i * 1000, [&](const ofAsyncFileResult & result){
+					callbacksOk &= result.success() && result.bytes == 1000;
+					completed++;
+				}, &queue);
+			}
+			while(completed < 100){
+				queue.drain();
+			}
+			test(callbacksOk, "callbacks through an event queue");
+			test(memcmp(read.data(), data.data(), 100 * 1000) == 0, "callback reads");
+
+			std::fill(read.begin(), read.end(), 0);
+			std::vector<std::future<ofAsyncFileResult>> reads;
+			{
+				ofAsyncFileBatch batch(service);
+				for(std::size_t offset = 0; offset < data.size(); offset += chunk){
+					reads.push_back(file.read(read.data() + offset, chunk, offset));
+				}
+			}
+			for(auto & pending: reads){
+				pending.wait();
+			}
+			test(memcmp(read.data(), data.data(), data.size()) == 0, "batched reads");
+
+			file.close();
+			ofLogNotice() << "an error about reading a file that isn't open is expected";
+			test(!file.read(read.data(), 10, 0).get().success(), "reading a closed file fails");
+		}
+
+		auto buffer = ofBufferFromFileAsync("async.bin", service).get();
+		test_eq(buffer.size(), data.size(), "ofBufferFromFileAsync size");
+		test(memcmp(buffer.getData(), data.data(), data.size()) == 0, "ofBufferFromFileAsync contents");
+		test(ofBufferToFileAsync("async_copy.bin", buffer, service).get(), "ofBufferToFileAsync");
+		test(ofBufferFromFile("async_copy.bin").getText() == buffer.getText(), "ofBufferToFileAsync contents");
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "default service";
+			ofLogNotice() << (ofGetAsyncFileService().isUsingIoUring() ? "using io_uring" : "using threads");
+			testService(ofGetAsyncFileService());
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "threads";
+			ofAsyncFileSettings settings;
+			settings.useIoUring = false;
+			settings.queueDepth = 4;
+			ofAsyncFileService service(settings);
+			test(!service.isUsingIoUring(), "io_uring disabled");
+			testService(service);
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			const std::size_t blockSize = 4096;
+			auto data = testData(64 << 20);
+			ofBufferToFile("async.bin", ofBuffer(data.data(), data.size()), true);
+
+			std::vector<char> read(data.size());
+			auto syncTime = millisFor([&]{
+				ofFile file("async.bin", ofFile::ReadOnly, true);
+				for(std::size_t offset = 0; offset < data.size(); offset += blockSize){
+					file.read(read.data() + offset, blockSize);
+				}
+			});
+
+			std::fill(read.begin(), read.end(), 0);
+			auto asyncTime = millisFor([&]{
+				ofAsyncFile file("async.bin");
+				std::vector<std::future<ofAsyncFileResult>> reads;
+				reads.reserve(data.size() / blockSize);
+				{
+					ofAsyncFileBatch batch;
+					for(std::size_t offset = 0; offset < data.size(); offset += blockSize){
+						reads.push_back(file.read(read.data() + offset, blockSize, offset));
+					}
+				}
+				for(auto & pending: reads){
+					pending.wait();
+				}
+			});
+			test(read == data, "benchmark reads");
+			ofLogNotice() << "reading " << (data.size() >> 20) << "MB in " << blockSize << " byte blocks";
+			ofLogNotice() << "ofFile: " << syncTime << "ms, " << data.size() / syncTime / 1000 << "MB/s";
+			ofLogNotice() << "ofAsyncFile: " << asyncTime << "ms, " << data.size() / asyncTime / 1000 << "MB/s";
+		}
+
+		ofFile::removeFile("async.bin");
+		ofFile::removeFile("async_copy.bin");
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -211,6 +211,77 @@ class ofApp: public ofxUnitTestsApp{
 			test(allLinesEqual, "all lines are correct");
 			test_eq(numLines,lines.size(),"lines iterator correct numLines");
 		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "lines view";
+			ofBuffer buffer;
+			buffer.set("first\r\nsecond\n\nfourth\n");
+			std::vector<std::string> expected, viewLines;
+			for(auto line: buffer.getLines()){
+				expected.push_back(line);
+			}
+			for(auto line: buffer.lines()){
+				viewLines.push_back(std::string(line));
+			}
+			test(viewLines == expected, "lines view same as lines iterator");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "mapped files";
+			ofBuffer src4(src.data(), src.size());
+			for(int i=0;i<4;i++){
+				src4.append(src.data(), src.size());
+			}
+			ofBufferToFile("mapped.bin", src4);
+			{
+				auto copied = ofBufferFromFile("mapped.bin", ofBufferMode::Copy);
+				test(!copied.isMapped(), "copy mode reads the file into memory");
+				test_eq(copied.getText(), src4.getText(), "copy mode data is correct");
+
+				auto mapped = ofBufferFromFile("mapped.bin", ofBufferMode::Mapped);
+				test(mapped.isMapped(), "mapped mode maps the file");
+				test_eq(mapped.size(), src4.size(), "mapped size");
+				test(memcmp(mapped.getData(), src4.getData(), src4.size()) == 0, "mapped data is correct");
+
+				mapped.getData()[0] = ~mapped.getData()[0];
+				test(mapped.isMapped(), "writing to mapped data keeps it mapped");
+				test_eq(ofBufferFromFile("mapped.bin").getText(), src4.getText(), "writing to mapped data doesn't change the file");
+
+				ofBuffer copy = mapped;
+				test(!copy.isMapped() && copy.getText() == mapped.getText(), "copying a mapped buffer");
+
+				auto random = ofBufferFromFile("mapped.bin", ofBufferMode::MappedRandomAccess);
+				random.append(src.data(), src.size());
+				test(!random.isMapped(), "appending to a mapped buffer copies it");
+				test_eq(random.size(), src4.size() + src.size(), "appending to a mapped buffer size");
+				test(memcmp(random.getData(), src4.getData(), src4.size()) == 0, "appending to a mapped buffer data");
+
+				ofBufferToFile("empty.bin", ofBuffer());
+				auto empty = ofBufferFromFile("empty.bin", ofBufferMode::Mapped);
+				test_eq(empty.size(), 0, "mapping an empty file");
+				auto missing = ofBufferFromFile("doesnt_exist.bin", ofBufferMode::Mapped);
+				test_eq(missing.size(), 0, "mapping a file that doesn't exist");
+
+				ofBufferToFile("lines.txt", ofBuffer("a\nb\nc", 5));
+				auto mappedLines = ofBufferFromFile("lines.txt", ofBufferMode::Mapped);
+				std::size_t numLines = 0;
+				for(auto line: mappedLines.lines()){
+					numLines += line.size();
+				}
+				test(numLines == 3 && mappedLines.isMapped(), "lines view doesn't copy mapped buffers");
+
+				const auto & constLines = mappedLines;
+				test_eq(std::string(constLines.begin(), constLines.end()), std::string("a\nb\nc"), "const iterators over a mapped buffer");
+				test_eq(std::string(constLines.rbegin(), constLines.rend()), std::string("c\nb\na"), "const reverse iterators over a mapped buffer");
+				test(mappedLines.isMapped(), "const iterators don't copy mapped buffers");
+			}
+			// the files can only be removed once they aren't mapped anymore
+			ofFile::removeFile("mapped.bin");
+			ofFile::removeFile("empty.bin");
+			ofFile::removeFile("lines.txt");
+		}
 	}
 };
 
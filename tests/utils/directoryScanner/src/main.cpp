@@ -0,0 +1,191 @@
+#include "ofDirectoryScanner.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	void createFile(const std::string & path, const std::string & contents = "x"){
+		ofBufferToFile(path, ofBuffer(contents.data(), contents.size()));
+	}
+
+	bool contains(const std::vector<std::string> & paths, const std::string & path){
+		return std::find(paths.begin(), paths.end(), path) != paths.end();
+	}
+
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofDirectory::removeDirectory("tree", true);
+		ofDirectory::removeDirectory("big", true);
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ofGlobMatch";
+			test(ofGlobMatch("*.jpg", "beach.jpg"), "* matches a name");
+			test(!ofGlobMatch("*.jpg", "2019/beach.jpg"), "* doesn't match across directories");
+			test(ofGlobMatch("**/*.jpg", "2019/summer/beach.jpg"), "** matches across directories");
+			test(ofGlobMatch("**/*.jpg", "beach.jpg"), "**/ matches no directory");
+			test(ofGlobMatch("**/x*/y", "x1/x2/x3/y"), "** extended after *");
+			test(ofGlobMatch("IMG_????.jpg", "IMG_0042.jpg"), "?");
+			test(!ofGlobMatch("a?c", "a/c"), "? doesn't match /");
+		}
+
+		for(int d = 0; d < 10; d++){
+			auto directory = "tree/d" + ofToString(d);
+			ofDirectory::createDirectory(directory + "/sub", true, true);
+			for(int f = 0; f < 20; f++){
+				createFile(directory + "/f" + ofToString(f) + (f % 2 ? ".JPG" : ".txt"));
+				createFile(directory + "/sub/g" + ofToString(f) + ".jpg");
+			}
+		}
+		ofDirectory::createDirectory("tree/thumbnails", true, true);
+		createFile("tree/thumbnails/t.jpg");
+#ifndef TARGET_WIN32
+		ofDirectory::createDirectory("tree/.hidden", true, true);
+		createFile("tree/.hidden/h.jpg");
+		createFile("tree/.h.jpg");
+#endif
+
+		ofDirectoryScanSettings settings;
+		settings.extensions = {"jpg"};
+		settings.ignore = {"thumbnails"};
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "scan";
+			ofDirectoryScanner scanner("tree", settings);
+			test_eq(scanner.size(), std::size_t(10 * 10 + 10 * 20), "filtered by extension, hidden and ignored");
+			test(std::is_sorted(scanner.begin(), scanner.end(), [](const ofDirectoryEntry & a, const ofDirectoryEntry & b){
+				return a.path < b.path;
+			}), "sorted by path");
+
+			auto entry = scanner.find("tree/d3/f7.JPG");
+			test(entry != nullptr, "find");
+			if(entry){
+				test_eq(entry->size, uint64_t(1), "size");
+				test_eq(std::string(entry->getRelativePath()), std::string("d3/f7.JPG"), "relative path");
+				test_eq(std::string(entry->getFileName()), std::string("f7.JPG"), "file name");
+				test_eq(std::string(entry->getExtension()), std::string("JPG"), "extension");
+				test(entry->isFile(), "type");
+			}
+
+			auto patterns = settings;
+			patterns.patterns = {"d1/**"};
+			test_eq(ofDirectoryScanner("tree", patterns).size(), std::size_t(30), "path patterns");
+
+			ofDirectoryScanSettings flat;
+			flat.recursive = false;
+			flat.includeDirectories = true;
+			test_eq(ofDirectoryScanner("tree", flat).size(), std::size_t(11), "not recursive");
+
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "update";
+			createFile("tree/d1/new.jpg");
+			ofFile::removeFile("tree/d2/f1.JPG");
+			createFile("tree/d3/f7.JPG", "modified");
+			auto changes = scanner.update();
+			test(changes.added.size() == 1 && contains(changes.added, "tree/d1/new.jpg"), "added");
+			test(changes.removed.size() == 1 && contains(changes.removed, "tree/d2/f1.JPG"), "removed");
+			test(changes.modified.size() == 1 && contains(changes.modified, "tree/d3/f7.JPG"), "modified");
+			test(scanner.update().empty(), "no changes");
+
+#ifdef TARGET_LINUX
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "watch";
+			test(scanner.watch(), "watch");
+			createFile("tree/d1/new2.jpg");
+			createFile("tree/d1/ignored.txt");
+			ofFile::removeFile("tree/d1/new.jpg");
+			ofDirectory::createDirectory("tree/new/a", true, true);
+			createFile("tree/new/a/n.jpg");
+			createFile("tree/new/m.jpg");
+			changes = scanner.update();
+			test_eq(changes.added.size(), std::size_t(3), "added files and directories");
+			test(contains(changes.added, "tree/new/a/n.jpg"), "files in new directories");
+			test(contains(changes.removed, "tree/d1/new.jpg"), "removed while watching");
+
+			ofFile::moveFromTo("tree/new", "tree/d5/moved");
+			changes = scanner.update();
+			test(changes.added.size() == 2 && changes.removed.size() == 2, "moved directory");
+			createFile("tree/d5/moved/a/n2.jpg");
+			changes = scanner.update();
+			test(contains(changes.added, "tree/d5/moved/a/n2.jpg"), "moved directories are still watched");
+
+			ofDirectory::removeDirectory("tree/d6", true);
+			changes = scanner.update();
+			test_eq(changes.removed.size(), std::size_t(30), "removed directory");
+
+			ofDirectoryScanner fresh("tree", settings);
+			scanner.sort();
+			bool same = fresh.size() == scanner.size();
+			for(std::size_t i = 0; same && i < fresh.size(); i++){
+				same &= fresh[i].path == scanner[i].path;
+			}
+			test(same, "watching keeps the same entries as scanning again");
+#endif
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			for(int d = 0; d < 100; d++){
+				auto directory = "big/" + ofToString(d % 10) + "/" + ofToString(d);
+				ofDirectory::createDirectory(directory, true, true);
+				for(int f = 0; f < 200; f++){
+					createFile(directory + "/" + ofToString(f) + (f % 4 ? ".dat" : ".jpg"));
+				}
+			}
+
+			std::size_t listed = 0;
+			auto directoryTime = millisFor([&]{
+				std::function<void(const std::string &)> list = [&](const std::string & path){
+					ofDirectory dir(path);
+					dir.allowExt("jpg");
+					dir.listDir();
+					listed += dir.size();
+					ofDirectory subdirectories(path);
+					subdirectories.listDir();
+					for(auto & file: subdirectories){
+						if(file.isDirectory()){
+							list(path + "/" + file.getFileName());
+						}
+					}
+				};
+				list("big");
+			});
+
+			std::size_t scanned = 0;
+			auto scannerTime = millisFor([&]{
+				ofDirectoryScanSettings jpgs;
+				jpgs.extensions = {"jpg"};
+				scanned = ofDirectoryScanner("big", jpgs).size();
+			});
+			test_eq(scanned, listed, "same files as ofDirectory");
+			ofLogNotice() << "ofDirectory: " << directoryTime << "ms";
+			ofLogNotice() << "ofDirectoryScanner: " << scannerTime << "ms";
+		}
+
+		ofDirectory::removeDirectory("tree", true);
+		ofDirectory::removeDirectory("big", true);
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,79 @@
+#include "ofJobQueue.h"
+#include "ofEvents.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "priorities";
+			ofJobQueue jobs;
+			std::vector<int> order;
+			jobs.post([&]{ order.push_back(3); }, OF_JOB_PRIORITY_LOW);
+			jobs.post([&]{ order.push_back(2); });
+			jobs.post([&]{ order.push_back(1); }, OF_JOB_PRIORITY_HIGH);
+			jobs.post([&]{ order.push_back(4); }, OF_JOB_PRIORITY_LOW);
+			test_eq(jobs.size(), 4, "size");
+			test_eq(jobs.run(0), 4, "runs every job without budget");
+			test(order == std::vector<int>({1, 2, 3, 4}), "jobs run by priority and in order");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "budget";
+			ofJobQueue jobs;
+			for(int i = 0; i < 10; i++){
+				jobs.post([]{
+					ofSleepMillis(2);
+				});
+			}
+			// every job takes longer than the budget so only the first runs
+			test_eq(jobs.run(1000), 1, "stops when the budget is exhausted");
+			test_eq(jobs.size(), 9, "the rest waits for the next run");
+			jobs.clear();
+			test(jobs.empty(), "clear");
+
+			jobs.setFrameBudget(4000);
+			jobs.post([]{
+				ofSleepMillis(100);
+			});
+			jobs.runFrame();
+			jobs.runFrame();
+			test(jobs.getFrameBudget() < 4000, "budget shrinks after a late frame");
+			jobs.setAdaptiveBudget(false);
+			test_eq(jobs.getFrameBudget(), 4000, "budget without adapting");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "main queue";
+			// windows that run their own loop only go through the core
+			// events so the main queue has to run from there
+			ofCoreEvents events;
+			auto ran = false;
+			auto ranBeforeUpdate = false;
+			ofEventListener listener = events.update.newListener([&](ofEventArgs &){
+				ranBeforeUpdate = ran;
+			});
+			ofRunOnMainThread([&]{
+				ran = true;
+			});
+			events.notifyUpdate();
+			test(ran, "main queue runs on update");
+			test(ranBeforeUpdate, "main queue runs before update");
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,284 @@
+#include "ofJson.h"
+#include "ofMath.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+#ifndef TARGET_WIN32
+	#include <sys/resource.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+namespace{
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+
+	struct Measurement{
+		double millis = 0;
+		// how much the peak resident memory grew while loading, in KB, -1
+		// when it wasn't measured
+		long peakKB = -1;
+		// what load returned
+		std::size_t count = 0;
+	};
+
+#ifndef TARGET_WIN32
+	long peakResidentKB(){
+		rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+#ifdef TARGET_OSX
+		return usage.ru_maxrss / 1024;
+#else
+		return usage.ru_maxrss;
+#endif
+	}
+#endif
+
+	// runs load, which returns how many values it found, in this process or
+	// in a child one. a child can't reuse what earlier loads in other
+	// children freed and their allocator kept, so its peak only grows by
+	// what this load needs as long as the parent doesn't load anything big
+	template<typename F>
+	Measurement measure(bool ownProcess, F load){
+		Measurement measurement;
+#ifndef TARGET_WIN32
+		int fds[2];
+		if(ownProcess && pipe(fds) == 0){
+			auto pid = fork();
+			if(pid == 0){
+				close(fds[0]);
+				auto before = peakResidentKB();
+				measurement.millis = millisFor([&]{
+					measurement.count = load();
+				});
+				measurement.peakKB = peakResidentKB() - before;
+				auto written = write(fds[1], &measurement, sizeof(measurement));
+				_exit(written == sizeof(measurement) ? 0 : 1);
+			}
+			close(fds[1]);
+			if(pid > 0){
+				if(read(fds[0], &measurement, sizeof(measurement)) != sizeof(measurement)){
+					measurement = Measurement();
+				}
+				waitpid(pid, nullptr, 0);
+				close(fds[0]);
+				return measurement;
+			}
+			close(fds[0]);
+			ofLogError("json") << "couldn't start a process to measure memory, loading in this one";
+		}
+#endif
+		measurement.millis = millisFor([&]{
+			measurement.count = load();
+		});
+		return measurement;
+	}
+
+	std::string toString(const Measurement & measurement){
+		auto str = ofToString(measurement.millis) + "ms";
+		if(measurement.peakKB >= 0){
+			str += ", peak memory +" + ofToString(measurement.peakKB / 1024.) + "MB";
+		}
+		return str;
+	}
+
+	// a scene like a big export, written as text directly so building it
+	// doesn't affect the measurements
+	std::size_t writeScene(const std::string & path, std::size_t sceneSize){
+		std::size_t numNodes = 0;
+		ofFile file(path, ofFile::WriteOnly);
+		file << "{\"name\":\"scene\",\"nodes\":[";
+		while(std::size_t(file.tellp()) < sceneSize){
+			if(numNodes > 0){
+				file << ",";
+			}
+			file << "{\"name\":\"node " << numNodes << "\",\"mesh\":\"mesh " << numNodes % 100 << "\""
+				<< ",\"position\":[" << ofRandom(-100, 100) << "," << ofRandom(-100, 100) << "," << ofRandom(-100, 100) << "]"
+				<< ",\"rotation\":[0,0,0,1],\"scale\":[1,1,1],\"visible\":true}";
+			numNodes++;
+		}
+		file << "]}";
+		return numNodes;
+	}
+
+#if OF_JSON_HAS_SAX
+	struct NumberCounter: public ofJsonSax{
+		std::size_t numbers = 0;
+		std::size_t keys = 0;
+
+		bool null() override{ return true; }
+		bool boolean(bool) override{ return true; }
+		bool number_integer(number_integer_t) override{ numbers++; return true; }
+		bool number_unsigned(number_unsigned_t) override{ numbers++; return true; }
+		bool number_float(number_float_t, const string_t &) override{ numbers++; return true; }
+		bool string(string_t &) override{ return true; }
+		bool start_object(std::size_t) override{ return true; }
+		bool key(string_t &) override{ keys++; return true; }
+		bool end_object() override{ return true; }
+		bool start_array(std::size_t) override{ return true; }
+		bool end_array() override{ return true; }
+		bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override{ return false; }
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || NLOHMANN_JSON_VERSION_MINOR >= 8
+		bool binary(binary_t &) override{ return true; }
+#endif
+	};
+#endif
+}
+
+class ofApp: public ofxUnitTestsApp{
+	// loads scene.json in every way and its binary versions, logging how
+	// long each takes. with ownProcess every load runs in its own process,
+	// where the peak memory it needed is measured too
+	void loadScene(std::size_t numNodes, bool ownProcess){
+		// converting loads the whole scene, in a process of its own so the
+		// memory it frees doesn't hide what the loads below need
+		measure(ownProcess, []{
+			auto scene = ofLoadJson("scene.json");
+			ofSaveCbor("scene.cbor", scene);
+			ofSaveMsgPack("scene.msgpack", scene);
+			return scene["nodes"].size();
+		});
+
+		auto streamed = measure(ownProcess, []{
+			std::size_t streamedNodes = 0;
+			ofLoadJson("scene.json", [&](int depth, ofJson::parse_event_t event, ofJson &){
+				if(depth == 2 && event == ofJson::parse_event_t::object_end){
+					streamedNodes++;
+					return false;
+				}
+				return true;
+			});
+			return streamedNodes;
+		});
+		test_eq(streamed.count, numNodes, "streamed every node");
+
+		auto text = measure(ownProcess, []{
+			return ofLoadJson("scene.json")["nodes"].size();
+		});
+		test_eq(text.count, numNodes, "loaded every node");
+
+		auto cbor = measure(ownProcess, []{
+			return ofLoadCbor("scene.cbor")["nodes"].size();
+		});
+		test_eq(cbor.count, numNodes, "loaded every node from cbor");
+
+		auto msgpack = measure(ownProcess, []{
+			return ofLoadMsgPack("scene.msgpack")["nodes"].size();
+		});
+		test_eq(msgpack.count, numNodes, "loaded every node from msgpack");
+
+		ofLogNotice() << numNodes << " nodes";
+		ofLogNotice() << "json: " << ofFile("scene.json").getSize() << " bytes, cbor: " << ofFile("scene.cbor").getSize()
+			<< " bytes, msgpack: " << ofFile("scene.msgpack").getSize() << " bytes";
+		ofLogNotice() << "ofLoadJson: " << toString(text);
+		ofLogNotice() << "ofLoadJson with callback: " << toString(streamed);
+		ofLogNotice() << "ofLoadCbor: " << toString(cbor);
+		ofLogNotice() << "ofLoadMsgPack: " << toString(msgpack);
+
+#if OF_JSON_HAS_SAX
+		auto sax = measure(ownProcess, []{
+			NumberCounter counter;
+			ofParseJson("scene.json", counter);
+			return counter.numbers;
+		});
+		test_eq(sax.count, numNodes * 10, "sax numbers");
+		ofLogNotice() << "ofParseJson: " << toString(sax);
+#endif
+	}
+
+	void run(){
+		ofJson scene = {
+			{"name", "scene"},
+			{"nodes", {
+				{{"name", "a"}, {"position", {1, 2, 3}}, {"visible", true}},
+				{{"name", "b"}, {"position", {4.5, 5, 6}}, {"visible", false}},
+			}},
+		};
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "streaming";
+			test(ofSaveJson("scene.json", scene), "save json");
+			test(ofLoadJson("scene.json") == scene, "load json");
+
+			std::size_t numNodes = 0;
+			float x = 0;
+			auto kept = ofLoadJson("scene.json", [&](int depth, ofJson::parse_event_t event, ofJson & parsed){
+				if(depth == 2 && event == ofJson::parse_event_t::object_end){
+					numNodes++;
+					x += parsed["position"][0].get<float>();
+					return false;
+				}
+				return true;
+			});
+			test_eq(numNodes, std::size_t(2), "callback for every node");
+			test_eq(x, 5.5f, "node values");
+			test(kept["nodes"].empty() && kept["name"] == "scene", "discarded values aren't kept");
+
+#if OF_JSON_HAS_SAX
+			NumberCounter counter;
+			test(ofParseJson("scene.json", counter), "sax parse");
+			test_eq(counter.numbers, std::size_t(6), "sax numbers");
+			test_eq(counter.keys, std::size_t(8), "sax keys");
+#endif
+
+			{
+				ofFile broken("broken.json", ofFile::WriteOnly);
+				broken << "{\"name\": ";
+			}
+			ofLogNotice() << "an error about a broken file is expected";
+			test(ofLoadJson("broken.json").is_null(), "broken json");
+			ofFile::removeFile("broken.json");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "binary";
+			test(ofSaveCbor("scene.cbor", scene), "save cbor");
+			test(ofLoadCbor("scene.cbor") == scene, "load cbor");
+			test(ofSaveMsgPack("scene.msgpack", scene), "save msgpack");
+			test(ofLoadMsgPack("scene.msgpack") == scene, "load msgpack");
+			ofLogNotice() << "an error about an invalid file is expected";
+			test(ofLoadCbor("scene.json").is_null(), "json isn't cbor");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "many nodes";
+			auto numNodes = writeScene("scene.json", 256 * 1024);
+			loadScene(numNodes, false);
+		}
+
+		// loading a scene of 200MB takes a while and a lot of memory so it
+		// only runs when asked to, measuring the memory every loader needs
+		if(!ofGetEnv("OF_JSON_BENCHMARK").empty()){
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			auto numNodes = writeScene("scene.json", 200 * 1024 * 1024);
+			loadScene(numNodes, true);
+		}else{
+			ofLogNotice() << "set OF_JSON_BENCHMARK to load a scene of 200MB";
+		}
+
+		ofFile::removeFile("scene.json");
+		ofFile::removeFile("scene.cbor");
+		ofFile::removeFile("scene.msgpack");
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,212 @@
+#include "ofLog.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	class ofMemoryLoggerChannel: public ofBaseLoggerChannel{
+	public:
+		void log(ofLogLevel level, const std::string & module, const std::string & message){
+			std::unique_lock<std::mutex> lock(mutex);
+			messages.push_back(module + ": " + message);
+		}
+
+		void log(ofLogLevel level, const std::string & module, const char* format, ...){
+			va_list args;
+			va_start(args, format);
+			log(level, module, format, args);
+			va_end(args);
+		}
+
+		void log(ofLogLevel level, const std::string & module, const char* format, va_list args){
+			log(level, module, ofVAArgsToString(format, args));
+		}
+
+		void flush(){
+			flushes++;
+		}
+
+		std::mutex mutex;
+		std::vector<std::string> messages;
+		int flushes = 0;
+	};
+
+	// average time per call of logging count messages from one thread
+	template<typename F>
+	double nanosPerCall(std::size_t count, F log){
+		auto start = std::chrono::steady_clock::now();
+		for(std::size_t i = 0; i < count; i++){
+			log(i);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::nano>(elapsed).count() / count;
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		auto previousChannel = ofGetLoggerChannel();
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "async logger channel";
+			auto memory = std::make_shared<ofMemoryLoggerChannel>();
+			auto async = std::make_shared<ofAsyncLoggerChannel>(memory, OF_ASYNC_LOGGER_BLOCK, 4096);
+			ofSetLoggerChannel(async);
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 4; i++){
+				threads.emplace_back([i]{
+					for(int j = 0; j < 10000; j++){
+						ofLogNotice("thread" + ofToString(i)) << "message " << j;
+					}
+				});
+			}
+			for(auto & thread: threads){
+				thread.join();
+			}
+			ofLogNotice("format", "%d %s", 42, "formatted");
+			async->flush();
+			ofSetLoggerChannel(previousChannel);
+
+			test_eq(memory->messages.size(), 40001, "async channel with block policy writes every message");
+			test_eq(memory->messages.back(), "format: 42 formatted", "printf style messages");
+			test(memory->flushes > 0, "async channel flushes the wrapped channel");
+			bool ordered = true;
+			int last = -1;
+			for(auto & message: memory->messages){
+				if(ofIsStringInString(message, "thread0:")){
+					auto n = ofToInt(ofSplitString(message, " ").back());
+					ordered &= n == last + 1;
+					last = n;
+				}
+			}
+			test(ordered, "messages from the same thread keep their order");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "drop policy";
+			auto memory = std::make_shared<ofMemoryLoggerChannel>();
+			ofAsyncLoggerChannel async(memory, OF_ASYNC_LOGGER_DROP, 1024);
+			async.setFlushInterval(1000);
+			for(int i = 0; i < 100; i++){
+				async.log(OF_LOG_NOTICE, "drop", std::string(100, 'x'));
+			}
+			test(async.getNumDropped() > 0, "full buffer drops messages");
+			async.flush();
+			test(ofIsStringInString(memory->messages.back(), "messages dropped"), "dropped messages are reported");
+
+			std::string longMessage(5000, 'y');
+			async.log(OF_LOG_NOTICE, "long", longMessage);
+			async.log(OF_LOG_NOTICE, "long", "short");
+			async.flush();
+			test_eq(memory->messages[memory->messages.size() - 2], "long: " + longMessage, "messages longer than the buffer aren't truncated");
+			test_eq(memory->messages.back(), "long: short", "messages after a long one");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "timestamps and files";
+			auto memory = std::make_shared<ofMemoryLoggerChannel>();
+			{
+				ofAsyncLoggerChannel async(memory);
+				async.setTimestamps(true);
+				async.log(OF_LOG_NOTICE, "time", "message");
+			}
+			test_eq(memory->messages.size(), 1, "destroying the channel writes the pending messages");
+			test_eq(memory->messages.back().size(), std::string("time: 00:00:00.000 message").size(), "timestamp format");
+
+			auto path = ofToDataPath("async.log", true);
+			auto file = std::make_shared<ofFileLoggerChannel>(path, false);
+			file->setAutoFlush(false);
+			{
+				ofAsyncLoggerChannel async(file);
+				async.log(OF_LOG_WARNING, "file", "async file message");
+			}
+			file->close();
+			test(ofIsStringInString(ofBufferFromFile(path).getText(), "[warning] file: async file message"), "async file logging");
+			ofFile::removeFile(path);
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "lazy logging";
+			auto memory = std::make_shared<ofMemoryLoggerChannel>();
+			ofSetLoggerChannel(memory);
+			int evaluated = 0;
+			auto expensive = [&]{
+				evaluated++;
+				return 42;
+			};
+			OF_LOG(OF_LOG_VERBOSE) << expensive();
+			OF_LOG(OF_LOG_VERBOSE, "lazy") << expensive();
+			ofLogf(OF_LOG_VERBOSE, "{}", "not formatted");
+			auto notLogged = memory->messages.size();
+			OF_LOG(OF_LOG_NOTICE, "lazy") << "value " << expensive();
+			ofSetLogLevel("lazy", OF_LOG_VERBOSE);
+			OF_LOG(OF_LOG_VERBOSE, "lazy") << "verbose " << expensive();
+			ofLogf("lazy", OF_LOG_VERBOSE, "{} and {}", 1, "two");
+			ofLogf(OF_LOG_NOTICE, "{{}} {} {}", 3);
+			ofSetLogLevel("lazy", OF_LOG_NOTICE);
+			ofSetLoggerChannel(previousChannel);
+
+			test_eq(notLogged, 0, "disabled messages aren't logged");
+			test_eq(evaluated, 2, "disabled messages don't evaluate their values");
+			test_eq(memory->messages.size(), 4, "enabled messages are logged");
+			test_eq(memory->messages[0], "lazy: value 42", "OF_LOG with module");
+			test_eq(memory->messages[1], "lazy: verbose 42", "OF_LOG with module level");
+			test_eq(memory->messages[2], "lazy: 1 and two", "ofLogf with module");
+			test_eq(memory->messages[3], ": {} 3 {}", "ofLogf escapes and missing arguments");
+			test(!ofIsLogEnabled(OF_LOG_VERBOSE), "ofIsLogEnabled");
+			test(ofIsLogEnabled(OF_LOG_ERROR, "lazy"), "ofIsLogEnabled with module");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			// measured through ofLog, the way applications log
+			const std::size_t count = 20000;
+			auto path = ofToDataPath("benchmark.log", true);
+			auto file = std::make_shared<ofFileLoggerChannel>(path, false);
+			ofSetLoggerChannel(file);
+			auto sync = nanosPerCall(count, [&](std::size_t i){
+				ofLogNotice("benchmark") << "message " << i;
+			});
+
+			auto asyncFile = std::make_shared<ofFileLoggerChannel>(path, false);
+			asyncFile->setAutoFlush(false);
+			auto async = std::make_shared<ofAsyncLoggerChannel>(asyncFile, OF_ASYNC_LOGGER_BLOCK, 4 * 1024 * 1024);
+			ofSetLoggerChannel(async);
+			auto asyncCall = nanosPerCall(count, [&](std::size_t i){
+				ofLogNotice("benchmark") << "message " << i;
+			});
+			async->flush();
+
+			std::string message = "a typical log message";
+			auto asyncNoFormat = nanosPerCall(count, [&](std::size_t){
+				ofLogNotice("benchmark") << message;
+			});
+			ofSetLoggerChannel(previousChannel);
+			async.reset();
+			file->close();
+			asyncFile->close();
+			ofFile::removeFile(path);
+
+			ofLogNotice() << "file channel: " << sync << "ns per message";
+			ofLogNotice() << "async file channel: " << asyncCall << "ns per message";
+			ofLogNotice() << "async file channel without formatting: " << asyncNoFormat << "ns per message";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -70,6 +70,70 @@ class ofApp: public ofxUnitTestsApp{
 		strs.push_back("join");
 		strs.push_back("test");
 		test_eq(ofJoinString(strs,","),"hi,this,is,a,join,test","test #4363");
+
+		// string views
+		std::string source = " hi      this is a split test ";
+		bool viewsEqual = true;
+		for(auto ignoreEmpty: {false, true}){
+			for(auto trim: {false, true}){
+				auto strings = ofSplitString(source, " ", ignoreEmpty, trim);
+				auto views = ofSplitStringView(source, " ", ignoreEmpty, trim);
+				viewsEqual &= strings.size() == views.size();
+				for(std::size_t i = 0; i < strings.size() && i < views.size(); i++){
+					viewsEqual &= strings[i] == std::string(views[i]);
+				}
+			}
+		}
+		test(viewsEqual, "split string view same as split string");
+		test_eq(ofSplitStringView("a,,b", "").size(), 1u, "split string view without delimiter");
+
+		std::vector<ofStringView> tokens;
+		ofSplitStringView("1;2;3", ";", tokens);
+		ofSplitStringView("4;5", ";", tokens);
+		test_eq(tokens.size(), 2u, "split string view reusing tokens");
+
+		ofStringTokenizer tokenizer("10, 20,,30", ",", true, true);
+		int sum = 0;
+		for(auto token: tokenizer){
+			sum += ofToInt(token);
+		}
+		test_eq(sum, 60, "tokenizer");
+		test_eq(std::string(ofTrimStringView("\t trim this view \r\n")), "trim this view", "trim string view");
+
+		std::vector<std::string> lines;
+		for(auto line: ofLinesView("first\r\nsecond\n\nfourth\n")){
+			lines.push_back(std::string(line));
+		}
+		test(lines == std::vector<std::string>({"first", "second", "", "fourth"}), "lines view");
+
+		std::string text;
+		for(int i = 0; i < 1000; i++){
+			text += ofToString(i) + "\n";
+		}
+		std::atomic<int> linesSum{0};
+		ofParallelForLines(text, [&](ofStringView line){
+			linesSum += ofToInt(line);
+		});
+		test_eq(linesSum.load(), 999 * 1000 / 2, "parallel for lines");
+
+		// number parsing, compared against the stream based conversion
+		bool numbersOk = true;
+		for(auto number: {"0", "-0", "12", " -12abc", "+5", "3.7", "2147483647", "2147483648", "-2147483649",
+		                  ".5", "5.", "-.5", "1e5", "1E-3", "1e400", "3.14159265358979", "0.1", "16777217",
+		                  "123456789012345678901234", "1.5.3", "1,5"}){
+			auto str = std::string(number);
+			numbersOk &= ofToInt(ofStringView(str)) == ofTo<int>(str);
+			numbersOk &= ofToInt64(ofStringView(str)) == ofTo<int64_t>(str);
+			numbersOk &= ofToFloat(ofStringView(str)) == ofTo<float>(str);
+			numbersOk &= ofToDouble(ofStringView(str)) == ofTo<double>(str);
+		}
+		for(int i = 0; i < 100000 && numbersOk; i++){
+			auto str = ofToString(ofRandom(-1000, 1000), 7);
+			numbersOk &= ofToFloat(ofStringView(str)) == ofTo<float>(str);
+			numbersOk &= ofToDouble(ofStringView(str)) == ofTo<double>(str);
+		}
+		test(numbersOk, "string view numbers same as stream");
+		test_eq(ofToFloat("2.5"), 2.5f, "ofToFloat c string");
 	}
 };
 
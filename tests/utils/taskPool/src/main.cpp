@@ -0,0 +1,139 @@
+#include "ofTaskPool.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <cmath>
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		auto & pool = ofGetTaskPool();
+		ofLogNotice() << "task pool with " << pool.getNumThreads() << " threads";
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "parallel for";
+			std::vector<int> values(1000000);
+			ofParallelFor(0, values.size(), [&](std::size_t i){
+				values[i] = i % 7;
+			});
+			bool allSet = true;
+			for(std::size_t i = 0; i < values.size(); i++){
+				allSet &= values[i] == int(i % 7);
+			}
+			test(allSet, "every index is visited once");
+
+			std::atomic<uint64_t> sum{0};
+			ofParallelForRange(0, values.size(), [&](std::size_t begin, std::size_t end){
+				uint64_t chunkSum = 0;
+				for(auto i = begin; i < end; i++){
+					chunkSum += values[i];
+				}
+				sum += chunkSum;
+			}, 1024);
+			uint64_t expected = 0;
+			for(auto v: values){
+				expected += v;
+			}
+			test_eq(sum.load(), expected, "parallel for range covers the whole range");
+
+			std::atomic<int> nested{0};
+			ofParallelFor(0, 64, [&](std::size_t){
+				ofParallelFor(0, 100, [&](std::size_t){
+					nested++;
+				});
+			});
+			test_eq(nested.load(), 6400, "nested parallel for");
+
+			int empty = 0;
+			ofParallelFor(10, 10, [&](std::size_t){
+				empty++;
+			});
+			test_eq(empty, 0, "empty range");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "task groups and futures";
+			std::atomic<int> count{0};
+			{
+				ofTaskGroup group;
+				for(int i = 0; i < 1000; i++){
+					group.run([&]{
+						count++;
+					});
+				}
+				group.wait();
+				test_eq(count.load(), 1000, "task group waits for every task");
+			}
+
+			auto future = pool.async([]{
+				return 42;
+			});
+			test_eq(future.get(), 42, "async result");
+
+			auto failing = pool.async([]() -> int{
+				throw std::runtime_error("task failed");
+			});
+			bool caught = false;
+			try{
+				failing.get();
+			}catch(const std::runtime_error &){
+				caught = true;
+			}
+			test(caught, "async forwards exceptions");
+
+			std::promise<int> continued;
+			pool.async([]{
+				return 21;
+			}, [&](std::future<int> result){
+				continued.set_value(result.get() * 2);
+			});
+			test_eq(continued.get_future().get(), 42, "continuation gets the result");
+
+			ofEventQueue queue;
+			bool ranOnQueue = false;
+			pool.async([]{
+				return 1;
+			}, [&](std::future<int> result){
+				ranOnQueue = result.get() == 1;
+			}, &queue);
+			while(queue.drain() == 0){
+				std::this_thread::yield();
+			}
+			test(ranOnQueue, "continuation runs on the thread draining the queue");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			pool.resetStats();
+			std::vector<float> values(1 << 22);
+			auto work = [&](std::size_t i){
+				values[i] = std::sqrt(float(i)) * std::sin(float(i));
+			};
+			auto then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < values.size(); i++){
+				work(i);
+			}
+			auto serial = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			ofParallelFor(0, values.size(), work, 4096);
+			auto parallel = ofGetElapsedTimeMicros() - then;
+			auto stats = pool.getStats();
+			ofLogNotice() << values.size() << " items took " << serial << "us serial, " << parallel << "us in parallel";
+			ofLogNotice() << "executed " << stats.executed << " tasks, " << stats.steals << " steals, "
+				<< stats.busyTimeMicros << "us busy, " << stats.queued << " queued";
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
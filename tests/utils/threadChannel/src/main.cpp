@@ -0,0 +1,183 @@
+#include "ofThreadChannel.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <algorithm>
+#include <chrono>
+
+namespace{
+	using Clock = std::chrono::steady_clock;
+
+	struct BenchmarkResult{
+		std::size_t received = 0;
+		uint64_t sum = 0;
+		double itemsPerSecond = 0;
+		uint64_t p50Ns = 0;
+		uint64_t p99Ns = 0;
+		uint64_t maxNs = 0;
+	};
+
+	// every value is the time it was sent so the receivers can measure
+	// how long it took to arrive
+	template<typename Channel>
+	BenchmarkResult benchmark(Channel & channel, std::size_t senders, std::size_t receivers, std::size_t itemsPerSender){
+		std::vector<std::vector<uint64_t>> latencies(receivers);
+		std::atomic<std::size_t> received{0};
+		auto total = senders * itemsPerSender;
+		auto start = Clock::now();
+
+		std::vector<std::thread> threads;
+		for(std::size_t i = 0; i < receivers; i++){
+			threads.emplace_back([&, i]{
+				auto & threadLatencies = latencies[i];
+				threadLatencies.reserve(total);
+				int64_t sent;
+				while(channel.receive(sent)){
+					auto now = Clock::now().time_since_epoch().count();
+					threadLatencies.push_back(now - sent);
+					if(++received == total){
+						channel.close();
+					}
+				}
+			});
+		}
+		for(std::size_t i = 0; i < senders; i++){
+			threads.emplace_back([&]{
+				for(std::size_t j = 0; j < itemsPerSender; j++){
+					channel.send(int64_t(Clock::now().time_since_epoch().count()));
+				}
+			});
+		}
+		for(auto & thread: threads){
+			thread.join();
+		}
+		auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+		std::vector<uint64_t> all;
+		for(auto & threadLatencies: latencies){
+			all.insert(all.end(), threadLatencies.begin(), threadLatencies.end());
+		}
+		std::sort(all.begin(), all.end());
+		auto nsPerTick = double(Clock::period::num) * 1e9 / Clock::period::den;
+
+		BenchmarkResult result;
+		result.received = all.size();
+		result.itemsPerSecond = all.size() / elapsed;
+		if(!all.empty()){
+			result.p50Ns = all[all.size() / 2] * nsPerTick;
+			result.p99Ns = all[all.size() * 99 / 100] * nsPerTick;
+			result.maxNs = all.back() * nsPerTick;
+		}
+		return result;
+	}
+
+	void log(const std::string & name, const BenchmarkResult & result){
+		ofLogNotice() << name << ": " << uint64_t(result.itemsPerSecond) << " items/s, latency p50 "
+			<< result.p50Ns << "ns p99 " << result.p99Ns << "ns max " << result.maxNs << "ns";
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "bounded channel";
+			ofBoundedThreadChannel<std::string, OF_THREAD_CHANNEL_SPSC> channel(4);
+			test_eq(channel.capacity(), 4, "capacity");
+			test(channel.empty(), "starts empty");
+			test(channel.trySend("a"), "trySend");
+			test(channel.send("b"), "send");
+			std::string value;
+			test(channel.tryReceive(value), "tryReceive");
+			test_eq(value, "a", "values arrive in order");
+			test(channel.receive(value), "receive");
+			test_eq(value, "b", "values arrive in order");
+			test(!channel.tryReceive(value), "tryReceive on empty channel");
+			test(!channel.tryReceive(value, 10), "tryReceive with timeout on empty channel");
+
+			for(int i = 0; i < 4; i++){
+				channel.send(ofToString(i));
+			}
+			test(!channel.trySend("full"), "trySend on full channel");
+
+			std::vector<std::string> all;
+			test(channel.tryReceiveAll(all), "tryReceiveAll");
+			test_eq(all.size(), 4, "tryReceiveAll receives everything");
+			test_eq(all.back(), "3", "tryReceiveAll keeps the order");
+
+			std::vector<std::string> batch{"x", "y", "z"};
+			test(channel.sendBatch(std::move(batch)), "sendBatch");
+			test(batch.empty(), "sendBatch moves the values");
+			all.clear();
+			test(channel.receiveAll(all), "receiveAll");
+			test_eq(all.size(), 3, "receiveAll receives the whole batch");
+
+			// a batch bigger than the capacity while the receiver is
+			// already waiting
+			std::vector<std::string> received;
+			std::thread receiver([&]{
+				std::string value;
+				while(received.size() < 16 && channel.receive(value)){
+					received.push_back(value);
+				}
+			});
+			ofSleepMillis(50);
+			std::vector<std::string> bigBatch;
+			for(int i = 0; i < 16; i++){
+				bigBatch.push_back(ofToString(i));
+			}
+			test(channel.sendBatch(bigBatch), "sendBatch bigger than the capacity");
+			receiver.join();
+			test_eq(received.size(), 16, "receive a batch bigger than the capacity");
+			test(received == bigBatch, "big batch keeps the order");
+
+			channel.close();
+			test(!channel.send("closed"), "send on closed channel");
+			test(!channel.receive(value), "receive on closed channel");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "batches on ofThreadChannel";
+			ofThreadChannel<int> channel;
+			test(channel.sendBatch({1, 2, 3}), "sendBatch");
+			std::vector<int> all;
+			test(channel.receiveAll(all), "receiveAll");
+			test_eq(all.size(), 3, "receiveAll receives the whole batch");
+			test(!channel.tryReceiveAll(all), "tryReceiveAll on empty channel");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "throughput and latency";
+			const std::size_t items = 1000000;
+
+			ofThreadChannel<int64_t> mutexChannel;
+			auto mutexSPSC = benchmark(mutexChannel, 1, 1, items);
+			ofBoundedThreadChannel<int64_t, OF_THREAD_CHANNEL_SPSC> spscChannel(4096);
+			auto spsc = benchmark(spscChannel, 1, 1, items);
+			test_eq(spsc.received, items, "spsc channel receives everything");
+			log("ofThreadChannel 1 to 1", mutexSPSC);
+			log("spsc 1 to 1", spsc);
+
+			ofThreadChannel<int64_t> mutexChannel4;
+			auto mutexMPMC = benchmark(mutexChannel4, 4, 4, items / 4);
+			ofBoundedThreadChannel<int64_t, OF_THREAD_CHANNEL_MPMC> mpmcChannel(4096);
+			auto mpmc = benchmark(mpmcChannel, 4, 4, items / 4);
+			test_eq(mpmc.received, items, "mpmc channel receives everything");
+			log("ofThreadChannel 4 to 4", mutexMPMC);
+			log("mpmc 4 to 4", mpmc);
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,304 @@
+#include "ofURLFileLoader.h"
+#include "ofJobQueue.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/ServerSocket.h"
+#include <chrono>
+
+namespace{
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+
+	struct ServerStats{
+		std::atomic<int> active{0};
+		std::atomic<int> maxActive{0};
+		std::atomic<int> delayed{0};
+	};
+
+	class Handler: public Poco::Net::HTTPRequestHandler{
+	public:
+		Handler(ServerStats & stats)
+		:stats(stats){}
+
+		void handleRequest(Poco::Net::HTTPServerRequest & request, Poco::Net::HTTPServerResponse & response){
+			auto uri = ofSplitString(request.getURI(), "?");
+			std::map<std::string, std::string> query;
+			if(uri.size() > 1){
+				for(auto & parameter: ofSplitString(uri[1], "&")){
+					auto keyValue = ofSplitString(parameter, "=");
+					query[keyValue[0]] = keyValue.size() > 1 ? keyValue[1] : "";
+				}
+			}
+
+			std::string body;
+			if(uri[0] == "/delay"){
+				auto active = ++stats.active;
+				auto maxActive = stats.maxActive.load();
+				while(active > maxActive && !stats.maxActive.compare_exchange_weak(maxActive, active)){}
+				ofSleepMillis(ofToInt(query["ms"]));
+				stats.active--;
+				stats.delayed++;
+				body = query["id"];
+			}else if(uri[0] == "/size"){
+				body.assign(ofToInt(query["bytes"]), 'x');
+			}else{
+				response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+			}
+			response.setContentLength(body.size());
+			response.send() << body;
+		}
+
+	private:
+		ServerStats & stats;
+	};
+
+	class HandlerFactory: public Poco::Net::HTTPRequestHandlerFactory{
+	public:
+		HandlerFactory(ServerStats & stats)
+		:stats(stats){}
+
+		Poco::Net::HTTPRequestHandler * createRequestHandler(const Poco::Net::HTTPServerRequest &){
+			return new Handler(stats);
+		}
+
+	private:
+		ServerStats & stats;
+	};
+
+	// a local server that answers:
+	// /delay?ms=100&id=a after waiting ms with the id as the body
+	// /size?bytes=1000 with a body of that many bytes
+	// anything else with a 404
+	class TestServer{
+	public:
+		TestServer()
+		:server(new HandlerFactory(stats), Poco::Net::ServerSocket(0), new Poco::Net::HTTPServerParams){
+			server.start();
+		}
+
+		~TestServer(){
+			server.stop();
+		}
+
+		std::string url(const std::string & path) const{
+			return "http://127.0.0.1:" + ofToString(server.port()) + path;
+		}
+
+		int getConnections() const{
+			return server.totalConnections();
+		}
+
+		// the most requests that ran at the same time since the last call
+		int getMaxActive(){
+			return stats.maxActive.exchange(0);
+		}
+
+		// requests to /delay running right now
+		int getActive() const{
+			return stats.active;
+		}
+
+		// requests to /delay that finished
+		int getDelayed() const{
+			return stats.delayed;
+		}
+
+	private:
+		ServerStats stats;
+		Poco::Net::HTTPServer server;
+	};
+}
+
+class ofApp: public ofxUnitTestsApp{
+	std::vector<ofHttpResponse> responses;
+
+	void urlResponse(ofHttpResponse & response){
+		responses.push_back(response);
+	}
+
+	// responses are notified from the main job queue so run it until they
+	// arrive
+	void waitForResponses(std::size_t numResponses, uint64_t timeoutMillis = 10000){
+		auto start = ofGetElapsedTimeMillis();
+		while(responses.size() < numResponses && ofGetElapsedTimeMillis() - start < timeoutMillis){
+			ofGetMainJobQueue().run(0);
+			ofSleepMillis(1);
+		}
+	}
+
+	void run(){
+		TestServer server;
+		ofRegisterURLNotification(this);
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "blocking requests";
+			ofURLFileLoader loader;
+			auto response = loader.get(server.url("/size?bytes=1000"));
+			test_eq(response.status, 200, "get");
+			test_eq(response.data.size(), std::size_t(1000), "body");
+			test_eq(loader.get(server.url("/missing")).status, 404, "not found");
+
+			// blocking requests don't wait for the queued ones
+			loader.setMaxConcurrentRequests(1);
+			auto delayed = server.getDelayed();
+			for(int i = 0; i < 4; i++){
+				loader.getAsync(server.url("/delay?ms=500"));
+			}
+			test_eq(loader.get(server.url("/size?bytes=10")).status, 200, "get while requests are queued");
+			test(server.getDelayed() - delayed < 4, "blocking request runs before the queued ones");
+			loader.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "concurrent requests";
+			ofURLFileLoader loader;
+			loader.setMaxConcurrentRequests(4);
+			loader.setMaxConnectionsPerHost(4);
+			server.getMaxActive();
+			auto connections = server.getConnections();
+			auto time = millisFor([&]{
+				for(int i = 0; i < 16; i++){
+					loader.getAsync(server.url("/delay?ms=100&id=" + ofToString(i)));
+				}
+				waitForResponses(16);
+			});
+			test_eq(responses.size(), std::size_t(16), "every response arrives");
+			test(time < 16 * 100, "requests run at the same time");
+			test_eq(server.getMaxActive(), 4, "concurrency limit");
+			test(server.getConnections() - connections <= 4, "connections are reused");
+			ofLogNotice() << "16 requests of 100ms: " << time << "ms";
+			responses.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "connections per host";
+			ofURLFileLoader loader;
+			loader.setMaxConnectionsPerHost(2);
+			server.getMaxActive();
+			for(int i = 0; i < 6; i++){
+				loader.getAsync(server.url("/delay?ms=50"));
+			}
+			waitForResponses(6);
+			test_eq(responses.size(), std::size_t(6), "every response arrives");
+			test_eq(server.getMaxActive(), 2, "connections per host limit");
+			responses.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "priorities";
+			ofURLFileLoader loader;
+			loader.setMaxConcurrentRequests(1);
+			loader.getAsync(server.url("/delay?ms=200&id=first"));
+			// queue the rest once the first one is running so they are all
+			// waiting for it to finish
+			auto start = ofGetElapsedTimeMillis();
+			while(server.getActive() == 0 && ofGetElapsedTimeMillis() - start < 10000){
+				ofSleepMillis(1);
+			}
+			for(int i = 0; i < 3; i++){
+				loader.getAsync(server.url("/delay?ms=10&id=low" + ofToString(i)));
+			}
+			ofHttpRequest urgent(server.url("/delay?ms=10&id=urgent"), "urgent");
+			urgent.priority = 1;
+			loader.handleRequestAsync(urgent);
+			waitForResponses(5);
+			test_eq(responses.size(), std::size_t(5), "every response arrives");
+			if(responses.size() == 5){
+				test_eq(responses[1].data.getText(), std::string("urgent"), "higher priority first");
+				test_eq(responses[2].data.getText(), std::string("low0"), "same priority in order");
+			}
+			responses.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "cancel";
+			ofURLFileLoader loader;
+			loader.setMaxConcurrentRequests(2);
+			auto running = loader.getAsync(server.url("/delay?ms=300&id=running"));
+			loader.getAsync(server.url("/delay?ms=300&id=kept"));
+			auto waiting = loader.getAsync(server.url("/delay?ms=300&id=waiting"));
+			ofSleepMillis(50);
+			loader.remove(running);
+			loader.remove(waiting);
+			waitForResponses(3, 1000);
+			test_eq(responses.size(), std::size_t(1), "cancelled requests aren't notified");
+			if(responses.size() == 1){
+				test_eq(responses[0].data.getText(), std::string("kept"), "other requests continue");
+			}
+			responses.clear();
+
+			for(int i = 0; i < 4; i++){
+				loader.getAsync(server.url("/delay?ms=100"));
+			}
+			loader.clear();
+			waitForResponses(1, 500);
+			test(responses.empty(), "clear cancels every request");
+
+			loader.getAsync(server.url("/delay?ms=10&id=after"));
+			waitForResponses(1);
+			test_eq(responses.size(), std::size_t(1), "requests made after clear run");
+			responses.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "streaming";
+			ofURLFileLoader loader;
+			std::atomic<std::size_t> received{0};
+			ofHttpRequest download(server.url("/size?bytes=10000000"), "download");
+			download.received = [&](const char *, std::size_t size){
+				received += size;
+				return true;
+			};
+			loader.handleRequestAsync(download);
+			waitForResponses(1);
+			test_eq(responses.size(), std::size_t(1), "streamed response");
+			if(responses.size() == 1){
+				test_eq(responses[0].status, 200, "streamed status");
+				test_eq(responses[0].data.size(), std::size_t(0), "body isn't stored");
+			}
+			test_eq(received.load(), std::size_t(10000000), "body is received");
+			responses.clear();
+
+			received = 0;
+			ofHttpRequest stopped(server.url("/size?bytes=10000000"), "stopped");
+			stopped.received = [&](const char *, std::size_t size){
+				received += size;
+				return received < 1000000;
+			};
+			loader.handleRequestAsync(stopped);
+			waitForResponses(1, 1000);
+			test(responses.empty() && received < 10000000, "returning false cancels");
+		}
+
+		ofUnregisterURLNotification(this);
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
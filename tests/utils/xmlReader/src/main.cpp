@@ -0,0 +1,154 @@
+#include "ofXmlReader.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+namespace{
+	template<typename F>
+	double millisFor(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "queries";
+			ofXml xml;
+			xml.parse("<scene><particle><position>1</position></particle><particle><position>2</position></particle></scene>");
+			ofXml::Query position("position");
+			test(position, "valid query");
+			test_eq(position.getPath(), std::string("position"), "query path");
+
+			int sum = 0;
+			for(auto & particle: xml.find("//particle")){
+				sum += particle.findFirst(position).getIntValue();
+			}
+			test_eq(sum, 3, "findFirst with a query");
+			test_eq(xml.find(ofXml::Query("//position")).size(), std::size_t(2), "find with a query");
+
+			ofLogNotice() << "an error about an invalid query is expected";
+			ofXml::Query invalid("//[");
+			test(!invalid, "invalid query");
+			test(!xml.findFirst(invalid), "invalid queries find nothing");
+			test(!ofXml::Query(), "empty query");
+
+			ofLogNotice() << "an error about a query that doesn't return nodes is expected";
+			ofXml::Query count("count(//position)");
+			test(!count, "queries have to return nodes");
+			test_eq(xml.find(count).size(), std::size_t(0), "queries that don't return nodes find nothing");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "events";
+			ofXmlReader reader;
+			reader.parse(
+				"<?xml version=\"1.0\"?>\n"
+				"<!DOCTYPE root [<!ENTITY custom \"value\">]>\n"
+				"<!-- comment -->\n"
+				"<root a=\"1 &amp; 2\" b='x>y'>\n"
+				"\t<item id=\"3\"/>\n"
+				"\t<text>a &lt;b&gt; &#65; &custom;</text><![CDATA[<raw>]]>\n"
+				"</root>\n");
+			test(reader.next() == ofXmlReader::StartElement && reader.getName() == "root", "start element");
+			test_eq(reader.getDepth(), std::size_t(0), "root depth");
+			test_eq(reader.getNumAttributes(), std::size_t(2), "attributes");
+			test(reader.getAttribute("a") == "1 & 2", "attribute entities");
+			test(reader.getAttribute("b") == "x>y", "single quoted attribute");
+			test(!reader.hasAttribute("c"), "missing attribute");
+			test(reader.next() == ofXmlReader::StartElement && reader.getName() == "item" && reader.getDepth() == 1, "empty element start");
+			test(reader.next() == ofXmlReader::EndElement && reader.getName() == "item", "empty element end");
+			test(reader.next() == ofXmlReader::StartElement && reader.getName() == "text", "text element");
+			test(reader.next() == ofXmlReader::Text && reader.getText() == "a <b> A &custom;", "text entities");
+			test(reader.next() == ofXmlReader::EndElement && reader.getName() == "text", "text element end");
+			test(reader.next() == ofXmlReader::Text && reader.getText() == "<raw>", "cdata");
+			test(reader.next() == ofXmlReader::EndElement && reader.getName() == "root", "end element");
+			test(reader.next() == ofXmlReader::End, "end of document");
+
+			reader.parse("<a><b></a>");
+			reader.next();
+			reader.next();
+			test(reader.next() == ofXmlReader::Error, "mismatched end tag");
+			reader.parse("<a><b>");
+			reader.next();
+			reader.next();
+			test(reader.next() == ofXmlReader::Error, "unclosed element");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "elements";
+			ofXmlReader reader;
+			reader.parse("<list><record n=\"1\"><x>1</x></record><skip><a><b/></a></skip><record n=\"2\"><x>2</x></record></list>");
+			reader.next();
+			int sum = 0;
+			while(reader.next() == ofXmlReader::StartElement){
+				if(reader.getName() == "record"){
+					auto record = reader.readElement();
+					sum += record.getAttribute("n").getIntValue() + record.getChild("x").getIntValue();
+				}else{
+					reader.skipElement();
+				}
+			}
+			test_eq(sum, 6, "read and skip elements");
+			test(reader.getName() == "list", "after the last element");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			const int numRecords = 200000;
+			{
+				ofFile file("records.xml", ofFile::WriteOnly);
+				file << "<?xml version=\"1.0\"?>\n<records>\n";
+				for(int i = 0; i < numRecords; i++){
+					file << "\t<record id=\"" << i << "\">\n\t\t<value>" << i << "</value>\n\t</record>\n";
+				}
+				file << "</records>\n";
+			}
+
+			long long loadedSum = 0;
+			auto loadTime = millisFor([&]{
+				ofXml xml;
+				xml.load("records.xml");
+				for(auto & value: xml.find("//value")){
+					loadedSum += value.getIntValue();
+				}
+			});
+
+			long long readSum = 0;
+			auto readTime = millisFor([&]{
+				ofXmlReader reader;
+				reader.open("records.xml");
+				ofXmlReader::Event event;
+				while((event = reader.next()) != ofXmlReader::End && event != ofXmlReader::Error){
+					if(event == ofXmlReader::Text){
+						readSum += ofToInt(reader.getText());
+					}
+				}
+			});
+			test_eq(readSum, loadedSum, "same values streamed and loaded");
+
+			ofLogNotice() << numRecords << " records, " << ofFile("records.xml").getSize() << " bytes";
+			ofLogNotice() << "ofXml::load and find: " << loadTime << "ms, ofXmlReader: " << readTime << "ms";
+			ofFile::removeFile("records.xml");
+		}
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}